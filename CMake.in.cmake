@@ -192,6 +192,10 @@ SET(OPENFLUID_ENABLE_LANDR 1)
 
 SET(OPENFLUID_ENABLE_MARKET 0)
 
+# set this to 1 to remove the per-call validation of simulation primitives (stage checks) in release builds.
+# When set to 0, this validation can be disabled at runtime using the --trusted option of the openfluid command
+SET(OPENFLUID_ENABLE_TRUSTEDPRIMITIVES 0)
+
 
 ################### applications build ###################
 
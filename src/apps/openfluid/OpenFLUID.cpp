@@ -39,10 +39,12 @@
 
 #include <iostream>
 #include <string>
+#include <memory>
 
 
 #include <QElapsedTimer>
 
+#include <openfluid/config.hpp>
 #include <openfluid/fluidx/FluidXDescriptor.hpp>
 #include <openfluid/base/RuntimeEnv.hpp>
 #include <openfluid/base/ProjectManager.hpp>
@@ -57,8 +59,16 @@
 #include <openfluid/machine/ObserverInstance.hpp>
 #include <openfluid/machine/MonitoringInstance.hpp>
 #include <openfluid/machine/Factory.hpp>
+#include <openfluid/machine/DomainPartitioner.hpp>
+#include <openfluid/machine/HaloExchange.hpp>
 #include <openfluid/buddies.hpp>
 
+#if defined(OPENFLUID_OS_LINUX)
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 #include "OpenFLUID.hpp"
 #include "DefaultIOListener.hpp"
 #include "DefaultMachineListener.hpp"
@@ -91,7 +101,7 @@ std::string msecsToString(qint64 MSecs)
 
 
 OpenFLUIDApp::OpenFLUIDApp() :
-  mp_RunEnv(NULL)
+  mp_RunEnv(NULL), m_DomainPartsCount(1)
 {
   m_RunType = None;
   mp_Engine = NULL;
@@ -618,6 +628,68 @@ void OpenFLUIDApp::printEnvInfos()
 // =====================================================================
 // =====================================================================
 
+
+int OpenFLUIDApp::forkDomainParts(openfluid::machine::HaloExchange& Exchange)
+{
+#if defined(OPENFLUID_OS_LINUX)
+
+  std::vector<pid_t> PartsPIDs;
+
+  std::cout.flush();
+
+  for (unsigned int Part = 0; Part < m_DomainPartsCount; Part++)
+  {
+    pid_t PID = fork();
+
+    if (PID == 0)
+      return Part;
+
+    if (PID < 0)
+    {
+      Exchange.abort();
+      break;
+    }
+
+    PartsPIDs.push_back(PID);
+  }
+
+
+  // a failing part aborts the exchange so that the other parts do not wait for it
+
+  unsigned int FailedCount = m_DomainPartsCount-PartsPIDs.size();
+
+  for (unsigned int i = 0; i < PartsPIDs.size(); i++)
+  {
+    int Status = 0;
+
+    if (wait(&Status) > 0 && !(WIFEXITED(Status) && WEXITSTATUS(Status) == 0))
+    {
+      FailedCount++;
+      Exchange.abort();
+    }
+  }
+
+  if (FailedCount)
+    throw openfluid::base::ApplicationException(
+        openfluid::base::ApplicationException::computeContext("openfluid","domain decomposition"),
+        "simulation failed in " + std::to_string(FailedCount) + " part(s) of the spatial domain");
+
+  return -1;
+
+#else
+
+  throw openfluid::base::ApplicationException(
+      openfluid::base::ApplicationException::computeContext("openfluid","domain decomposition"),
+      "domain decomposition is only available on Linux systems");
+
+#endif
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 void OpenFLUIDApp::runSimulation()
 {
   QElapsedTimer FullTimer;
@@ -663,10 +735,59 @@ void OpenFLUIDApp::runSimulation()
   FXDesc.loadFromDirectory(openfluid::base::RuntimeEnvironment::instance()->getInputDir());
 
 
+  std::unique_ptr<openfluid::machine::DomainPartitioner> Partitioner;
+  std::unique_ptr<openfluid::machine::HaloExchange> Exchange;
+  int DomainPart = -1;
+
+  if (m_DomainPartsCount > 1)
+  {
+    std::cout << "* Partitioning spatial domain... "; std::cout.flush();
+    Partitioner.reset(new openfluid::machine::DomainPartitioner(FXDesc.spatialDomainDescriptor(),
+                                                                 m_DomainPartsCount));
+    Exchange.reset(new openfluid::machine::HaloExchange(*Partitioner,m_HaloVariables));
+    std::cout << "[OK]" << std::endl;
+
+    std::cout << "  " << m_DomainPartsCount << " parts, "
+              << Partitioner->getCutConnectionsCount() << " connections between parts, "
+              << Partitioner->boundaryUnits().size() << " boundary units" << std::endl;
+    std::cout << "  Halo exchange through shared memory " << Exchange->getName() << std::endl;
+
+    // the calling process waits for the processes of all parts
+    DomainPart = forkDomainParts(*Exchange);
+
+    if (DomainPart < 0)
+    {
+      std::cout << std::endl << "**** Simulation completed in " << m_DomainPartsCount << " parts ****"
+                << std::endl << std::endl;
+      std::cout << "     Total run time: " << msecsToString(FullTimer.elapsed()) << std::endl;
+      std::cout << std::endl;
+      return;
+    }
+
+    openfluid::fluidx::SpatialDomainDescriptor PartDescriptor;
+    Partitioner->buildPartDescriptor(DomainPart,FXDesc.spatialDomainDescriptor(),PartDescriptor);
+    FXDesc.spatialDomainDescriptor() = PartDescriptor;
+
+    openfluid::base::RuntimeEnvironment::instance()->setOutputDir(
+        openfluid::base::RuntimeEnvironment::instance()->getOutputDir()+"/part"+std::to_string(DomainPart));
+
+    std::cout << "* Simulating part " << DomainPart << " (" << Partitioner->getPartSize(DomainPart)
+              << " units, output in " << openfluid::base::RuntimeEnvironment::instance()->getOutputDir() << ")"
+              << std::endl;
+  }
+
+
   std::cout << "* Building spatial domain... "; std::cout.flush();
   openfluid::machine::Factory::buildSimulationBlobFromDescriptors(FXDesc,m_SimBlob);
   std::cout << "[OK]" << std::endl; std::cout.flush();
 
+  if (openfluid::base::RuntimeEnvironment::instance()->isUnitsReorderingEnabled())
+  {
+    std::cout << "  Mean distance between connected units: "
+              << openfluid::machine::Factory::computeUnitsConnectionsDistance(m_SimBlob.spatialGraph())
+              << std::endl;
+  }
+
 
   std::cout << "* Building model... "; std::cout.flush();
   openfluid::machine::Factory::buildModelInstanceFromDescriptor(FXDesc.modelDescriptor(),
@@ -680,6 +801,12 @@ void OpenFLUIDApp::runSimulation()
 
   mp_Engine = new openfluid::machine::Engine(m_SimBlob, Model, Monitoring, MListener);
 
+  if (Exchange)
+  {
+    Exchange->bindPart(DomainPart,*Partitioner,m_SimBlob.spatialGraph());
+    mp_Engine->setHaloExchange(Exchange.get());
+  }
+
   mp_Engine->initialize();
 
   std::cout << "* Initializing parameters... "; std::cout.flush();
@@ -789,6 +916,19 @@ void OpenFLUIDApp::processOptions(int ArgC, char **ArgV)
     openfluid::utils::CommandLineOption("quiet","q","quiet display during simulation"),
     openfluid::utils::CommandLineOption("verbose","v","verbose display during simulation"),
     openfluid::utils::CommandLineOption("profiling","k","enable simulation profiling"),
+    openfluid::utils::CommandLineOption("pipelined-observers","o",
+                                        "run observers in a separate thread, one time step behind simulators"),
+    openfluid::utils::CommandLineOption("trusted","",
+                                        "run wares in trusted mode, without validation of each primitive call"
+                                        " (release builds only)"),
+    openfluid::utils::CommandLineOption("reorder-units","",
+                                        "reorder spatial units to place connected units close to each other"),
+    openfluid::utils::CommandLineOption("domain-parts","",
+                                        "partition the spatial domain and simulate each part in a separate process"
+                                        " (Linux only)",true),
+    openfluid::utils::CommandLineOption("halo-variables","",
+                                        "set the variables exchanged between parts of the spatial domain"
+                                        " (comma separated)",true),
     openfluid::utils::CommandLineOption("clean-output-dir","c","clean output directory before simulation"),
     openfluid::utils::CommandLineOption("auto-output-dir","a","create automatic output directory"),
     openfluid::utils::CommandLineOption("max-threads","t",
@@ -945,6 +1085,44 @@ void OpenFLUIDApp::processOptions(int ArgC, char **ArgV)
       openfluid::base::RuntimeEnvironment::instance()->setSimulationProfilingEnabled(true);
     }
 
+    if (Parser.command(ActiveCommandStr).isOptionActive("pipelined-observers"))
+    {
+      openfluid::base::RuntimeEnvironment::instance()->setPipelinedMonitoringEnabled(true);
+    }
+
+    if (Parser.command(ActiveCommandStr).isOptionActive("trusted"))
+    {
+      openfluid::base::RuntimeEnvironment::instance()->setTrustedModeEnabled(true);
+
+#if !defined(NDEBUG)
+      std::cout << "Warning: trusted mode has no effect in debug builds, primitives calls are always validated"
+                << std::endl;
+#elif OPENFLUID_TRUSTEDPRIMITIVES_ENABLED
+      std::cout << "Warning: trusted mode has no effect, primitives calls are never validated in this build"
+                << std::endl;
+#endif
+    }
+
+    if (Parser.command(ActiveCommandStr).isOptionActive("reorder-units"))
+    {
+      openfluid::base::RuntimeEnvironment::instance()->setUnitsReorderingEnabled(true);
+    }
+
+    if (Parser.command(ActiveCommandStr).isOptionActive("domain-parts"))
+    {
+      if (!openfluid::tools::convertString(Parser.command(ActiveCommandStr).getOptionValue("domain-parts"),
+                                           &m_DomainPartsCount) || !m_DomainPartsCount)
+        throw openfluid::base::ApplicationException(
+            openfluid::base::ApplicationException::computeContext("openfluid","command line parsing"),
+                "wrong value for domain parts number");
+    }
+
+    if (Parser.command(ActiveCommandStr).isOptionActive("halo-variables"))
+    {
+      m_HaloVariables =
+          openfluid::tools::splitString(Parser.command(ActiveCommandStr).getOptionValue("halo-variables"),",");
+    }
+
     m_RunType = Simulation;
     return;
   }
@@ -51,6 +51,7 @@ class RuntimeEnvironment;
 }
 namespace machine {
 class Engine;
+class HaloExchange;
 }
 }
 
@@ -73,6 +74,10 @@ class OpenFLUIDApp
     openfluid::machine::SimulationBlob m_SimBlob;
     openfluid::machine::Engine* mp_Engine;
 
+    unsigned int m_DomainPartsCount;
+
+    std::vector<openfluid::core::VariableName_t> m_HaloVariables;
+
 
     void printlnExecMessagesStats();
 
@@ -105,6 +110,13 @@ class OpenFLUIDApp
 
     void printObserversReport(const std::string& Pattern);
 
+    /**
+      Starts one process per part of the partitioned domain
+      @return the index of the part to simulate in the started processes,
+      -1 in the calling process once all parts processes are terminated
+    */
+    int forkDomainParts(openfluid::machine::HaloExchange& Exchange);
+
     /**
       Runs simulation
     */
@@ -44,6 +44,7 @@
 #include <ogrsf_frmts.h>
 #include <openfluid/tools/Filesystem.hpp>
 #include <openfluid/utils/ExternalProgram.hpp>
+#include <openfluid/utils/ZipArchiveWriter.hpp>
 
 #include <openfluid/ware/PluggableObserver.hpp>
 #include <QProcess>
@@ -96,7 +97,6 @@ class KmlObserverBase : public openfluid::ware::PluggableObserver
   protected:
 
     std::string m_TmpSubDir;
-    std::string m_KmzSubDir;
     const std::string m_KmzDataSubDir;
 
     std::string m_Title;
@@ -109,6 +109,8 @@ class KmlObserverBase : public openfluid::ware::PluggableObserver
 
     bool m_OKToGo;
 
+    openfluid::utils::ZipArchiveWriter* mp_KmzArchive;
+
     template<class T>
     bool transformVectorLayerToKmlGeometry(KmlLayerInfo<T>& LayerInfo)
     {
@@ -154,7 +156,9 @@ class KmlObserverBase : public openfluid::ware::PluggableObserver
       {
         openfluid::core::UnitID_t UnitID = Feature->GetFieldAsInteger(OfldIDFieldIndex);
 
-        if (OPENFLUID_IsUnitExist(LayerInfo.UnitsClass,UnitID))
+        // halo units of a partitioned domain are exported by the part owning them
+        if (OPENFLUID_IsUnitExist(LayerInfo.UnitsClass,UnitID) &&
+            !OPENFLUID_GetUnit(LayerInfo.UnitsClass,UnitID)->isHalo())
         {
 
           OGRGeometry *Geometry;
@@ -248,6 +252,13 @@ class KmlObserverBase : public openfluid::ware::PluggableObserver
       OGRDataSource::DestroyDataSource(DataSource);
 
 
+      if (LayerInfo.UnitsInfos.empty())
+      {
+        OPENFLUID_LogWarning("No unit of class " + LayerInfo.UnitsClass + " found in " + LayerInfo.SourceFilename +
+                               ". This Kml output is ignored.");
+        return false;
+      }
+
       return true;
     }
 
@@ -256,23 +267,57 @@ class KmlObserverBase : public openfluid::ware::PluggableObserver
     // =====================================================================
 
 
-    void buildKmzFile()
+    /**
+      Creates the kmz output file, in which the kml contents are directly written during the simulation
+    */
+    void openKmzArchive()
     {
-      std::string InputDir = m_TmpDir+"/"+m_KmzSubDir+"/";
       std::string KmzFilePath = m_OutputDir + "/"+ m_OutputFileName;
 
       openfluid::tools::Filesystem::removeDirectory(KmzFilePath);
 
-      openfluid::utils::ExternalProgram SevenZProgram =
-          openfluid::utils::ExternalProgram::getRegisteredProgram(openfluid::utils::ExternalProgram::SevenZipProgram);
+      try
+      {
+        mp_KmzArchive = new openfluid::utils::ZipArchiveWriter(KmzFilePath);
+      }
+      catch (openfluid::base::FrameworkException& E)
+      {
+        OPENFLUID_LogWarning(E.getMessage());
+        m_OKToGo = false;
+      }
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
 
-      if (SevenZProgram.isFound())
+    void addToKmzArchive(const std::string& EntryPath, const std::string& Content)
+    {
+      try
+      {
+        mp_KmzArchive->addEntry(EntryPath,Content);
+      }
+      catch (openfluid::base::FrameworkException& E)
       {
-        QString SevenZCommand = QString("\"%1\" a -tzip \"%2\" \"%3\"*").arg(SevenZProgram.getFullProgramPath())
-                                                                        .arg(QString::fromStdString(KmzFilePath))
-                                                                        .arg(QString::fromStdString(InputDir));
+        OPENFLUID_LogWarning(E.getMessage());
+      }
+    }
+
 
-        QProcess::execute(SevenZCommand);
+    // =====================================================================
+    // =====================================================================
+
+
+    void addFileToKmzArchive(const std::string& EntryPath, const std::string& FilePath)
+    {
+      try
+      {
+        mp_KmzArchive->addFile(EntryPath,FilePath);
+      }
+      catch (openfluid::base::FrameworkException& E)
+      {
+        OPENFLUID_LogWarning(E.getMessage());
       }
     }
 
@@ -281,6 +326,17 @@ class KmlObserverBase : public openfluid::ware::PluggableObserver
     // =====================================================================
 
 
+    void closeKmzArchive()
+    {
+      delete mp_KmzArchive;
+      mp_KmzArchive = NULL;
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
     void tryOpenGEarth()
     {
       if (m_TryOpenGEarth)
@@ -325,43 +381,34 @@ class KmlObserverBase : public openfluid::ware::PluggableObserver
         m_OKToGo = false;
         return;
       }
-
-      openfluid::tools::Filesystem::removeDirectory(m_TmpDir+"/"+m_KmzSubDir);
-      openfluid::tools::Filesystem::makeDirectory(m_TmpDir+"/"+m_KmzSubDir);
-
-      if (!openfluid::tools::Filesystem::isDirectory(m_TmpDir+"/"+m_KmzSubDir))
-      {
-        OPENFLUID_LogWarning("Cannot initialize kmz temporary directory");
-        m_OKToGo = false;
-        return;
-      }
-
-
-      openfluid::tools::Filesystem::makeDirectory(m_TmpDir+"/"+m_KmzSubDir+"/"+m_KmzDataSubDir);
-
-      if (!openfluid::tools::Filesystem::isDirectory(m_TmpDir+"/"+m_KmzSubDir+"/"+m_KmzDataSubDir))
-      {
-        OPENFLUID_LogWarning("Cannot initialize kmz data temporary directory");
-        m_OKToGo = false;
-        return;
-      }
     }
 
 
   public:
 
     KmlObserverBase() : openfluid::ware::PluggableObserver(),
-      m_KmzSubDir("kmz"),m_KmzDataSubDir("data"),
+      m_KmzDataSubDir("data"),
       m_Title("OpenFLUID simulation with time animation"),
       m_OutputFileName(""),
       m_InputDir(""), m_OutputDir(""), m_TmpDir(""),
       m_TryOpenGEarth(false),
-      m_OKToGo(false)
+      m_OKToGo(false),
+      mp_KmzArchive(NULL)
     {
 
     }
 
 
+    // =====================================================================
+    // =====================================================================
+
+
+    ~KmlObserverBase()
+    {
+      closeKmzArchive();
+    }
+
+
 };
 
 
@@ -173,6 +173,11 @@ class DotFilesObserver : public openfluid::ware::PluggableObserver
         for (itUnitsList=UnitsList->begin();itUnitsList!=UnitsList->end();++itUnitsList)
         {
           TheUnit = const_cast<openfluid::core::SpatialUnit*>(&(*itUnitsList));
+
+          // halo units of a partitioned domain are exported by the part owning them
+          if (TheUnit->isHalo())
+            continue;
+
           std::string IDStr = "";
           openfluid::tools::convertValue(TheUnit->getID(),&IDStr);
           DotFile << generateDotNode(ClassStr,IDStr,Options) << "\n";
@@ -189,6 +194,10 @@ class DotFilesObserver : public openfluid::ware::PluggableObserver
         for (itUnitsList=UnitsList->begin();itUnitsList!=UnitsList->end();++itUnitsList)
         {
           TheUnit = const_cast<openfluid::core::SpatialUnit*>(&(*itUnitsList));
+
+          if (TheUnit->isHalo())
+            continue;
+
           std::string SrcClassStr = TheUnit->getClass();
           std::string SrcIDStr = "";
           openfluid::tools::convertValue(TheUnit->getID(),&SrcIDStr);
@@ -0,0 +1,728 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+
+/**
+  @file AggregatesFilesObs.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@supagro.inra.fr>
+ */
+
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+
+#include <QtGlobal>
+
+#if QT_VERSION >= QT_VERSION_CHECK(5,0,0)
+#include <QtConcurrent>
+#endif
+
+#include <QtConcurrentRun>
+#include <QFutureSynchronizer>
+#include <QThread>
+
+#include <openfluid/ware/PluggableObserver.hpp>
+#include <openfluid/ware/WareParamsTree.hpp>
+#include <openfluid/tools/DataHelpers.hpp>
+
+
+// =====================================================================
+// =====================================================================
+
+
+BEGIN_OBSERVER_SIGNATURE("export.vars.files.aggregates")
+  DECLARE_NAME("输出模拟变量的空间聚合值到CSV文件");
+  DECLARE_DESCRIPTION("这个观察者在模拟过程中计算变量在单元类上的聚合值, 每个组输出一个CSV文件\n"
+      "可接受的参数有\n"
+      "  aggregate.<聚合名称>.unitsclass : 聚合的单元类\n"
+      "  aggregate.<聚合名称>.var : 聚合的变量 (实数或整数)\n"
+      "  aggregate.<聚合名称>.reductions : 聚合运算, 使用分号分隔: sum, mean, min, max, count, "
+         "q<百分位> (例如 q50)。默认为 sum\n"
+      "  aggregate.<聚合名称>.weight : 用于加权 sum 和 mean 的单元属性 (可选)\n"
+      "  aggregate.<聚合名称>.groupby : 按父单元类分组 (可选)。每个父单元输出一个文件\n"
+      "  general.date : 日期格式, ISO, 6cols, timeindex 或者标准C格式 (默认为 ISO)\n"
+      "  general.precision : 浮点数的精度 (默认为 5)\n"
+      "  general.threads : 计算所用的线程数 (默认为处理器数)");
+
+  DECLARE_VERSION(openfluid::config::FULL_VERSION);
+  DECLARE_STATUS(openfluid::ware::EXPERIMENTAL);
+
+END_OBSERVER_SIGNATURE
+
+
+// =====================================================================
+// =====================================================================
+
+
+class Reduction
+{
+  public:
+
+    enum Type { SUM, MEAN, MIN, MAX, COUNT, QUANTILE };
+
+    Type RedType;
+
+    double Quantile;
+
+    std::string Name;
+
+    Reduction() : RedType(SUM), Quantile(0.0)
+    { }
+};
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Partial reduction of a contiguous range of units of a group, computed by a single thread
+*/
+class AggregateChunk
+{
+  public:
+
+    std::size_t Begin;
+
+    std::size_t End;
+
+    double Sum;
+
+    double WeightedSum;
+
+    double WeightsSum;
+
+    double Min;
+
+    double Max;
+
+    unsigned int Count;
+
+    AggregateChunk(std::size_t B, std::size_t E) :
+      Begin(B), End(E), Sum(0.0), WeightedSum(0.0), WeightsSum(0.0), Min(0.0), Max(0.0), Count(0)
+    { }
+};
+
+
+// =====================================================================
+// =====================================================================
+
+
+class AggregateGroup
+{
+  public:
+
+    std::vector<openfluid::core::SpatialUnit*> Units;
+
+    std::vector<double> Weights;
+
+    std::vector<double> Values;
+
+    std::vector<AggregateChunk> Chunks;
+
+    char* FileBuffer;
+
+    std::ofstream FileHandle;
+
+    std::string FileName;
+
+    AggregateGroup() :
+      FileBuffer(NULL)
+    { }
+
+    ~AggregateGroup()
+    {
+      if (FileHandle.is_open()) FileHandle.close();
+      delete [] FileBuffer;
+    }
+};
+
+
+// =====================================================================
+// =====================================================================
+
+
+class AggregateDefinition
+{
+  public:
+
+    openfluid::core::UnitsClass_t UnitsClass;
+
+    openfluid::core::VariableName_t VarName;
+
+    openfluid::core::AttributeName_t WeightAttr;
+
+    openfluid::core::UnitsClass_t GroupClass;
+
+    std::vector<Reduction> Reductions;
+
+    bool HasQuantiles;
+
+    std::list<AggregateGroup*> Groups;
+
+    AggregateDefinition() : HasQuantiles(false)
+    { }
+};
+
+
+// =====================================================================
+// =====================================================================
+
+
+class AggregatesFilesObserver : public openfluid::ware::PluggableObserver
+{
+  private:
+
+    typedef std::map<std::string,AggregateDefinition> AggregatesMap_t;
+
+    AggregatesMap_t m_Aggregates;
+
+    std::string m_OutputDir;
+
+    std::string m_DateFormat;
+
+    bool m_IsTimeIndexDateFormat;
+
+    unsigned int m_Precision;
+
+    unsigned int m_ThreadsCount;
+
+    unsigned int m_BufferSize;
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    static bool parseReduction(const std::string& Str, Reduction& Red)
+    {
+      Red.Name = Str;
+
+      if (Str == "sum")
+        Red.RedType = Reduction::SUM;
+      else if (Str == "mean")
+        Red.RedType = Reduction::MEAN;
+      else if (Str == "min")
+        Red.RedType = Reduction::MIN;
+      else if (Str == "max")
+        Red.RedType = Reduction::MAX;
+      else if (Str == "count")
+        Red.RedType = Reduction::COUNT;
+      else if (Str.size() > 1 && Str[0] == 'q')
+      {
+        double Percent;
+
+        if (!openfluid::tools::convertString(Str.substr(1),&Percent) || Percent < 0.0 || Percent > 100.0)
+          return false;
+
+        Red.RedType = Reduction::QUANTILE;
+        Red.Quantile = Percent/100.0;
+      }
+      else
+        return false;
+
+      return true;
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    /**
+      Reads the values of the units of a chunk and computes its partial reduction.
+      Chunks of a group cover distinct ranges of units, they can be processed concurrently.
+    */
+    static void processChunk(const openfluid::core::VariableName_t& VarName,
+                             openfluid::core::TimeIndex_t Index,
+                             AggregateGroup* Group, AggregateChunk* Chunk)
+    {
+      const bool Weighted = !Group->Weights.empty();
+
+      Chunk->Sum = 0.0;
+      Chunk->WeightedSum = 0.0;
+      Chunk->WeightsSum = 0.0;
+      Chunk->Count = 0;
+
+      for (std::size_t i = Chunk->Begin; i < Chunk->End; i++)
+      {
+        const openfluid::core::Value* Val = Group->Units[i]->variables()->value(VarName,Index);
+        double Value = std::numeric_limits<double>::quiet_NaN();
+
+        if (Val != NULL)
+        {
+          if (Val->isDoubleValue())
+            Value = Val->asDoubleValue().get();
+          else if (Val->isIntegerValue())
+            Value = Val->asIntegerValue().get();
+        }
+
+        Group->Values[i] = Value;
+
+        if (std::isnan(Value))
+          continue;
+
+        if (!Chunk->Count || Value < Chunk->Min)
+          Chunk->Min = Value;
+        if (!Chunk->Count || Value > Chunk->Max)
+          Chunk->Max = Value;
+
+        Chunk->Sum += Value;
+
+        if (Weighted)
+        {
+          Chunk->WeightedSum += Group->Weights[i]*Value;
+          Chunk->WeightsSum += Group->Weights[i];
+        }
+
+        Chunk->Count++;
+      }
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    static double computeQuantile(std::vector<double>& Values, double Quantile)
+    {
+      // nearest rank on the partially sorted values
+      const std::size_t Rank =
+          std::min<std::size_t>(Values.size()-1,static_cast<std::size_t>(std::ceil(Quantile*Values.size()))-
+                                                (Quantile > 0.0 ? 1 : 0));
+
+      std::nth_element(Values.begin(),Values.begin()+Rank,Values.end());
+
+      return Values[Rank];
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    void writeGroup(const AggregateDefinition& Aggregate, AggregateGroup* Group, const std::string& DateStr)
+    {
+      AggregateChunk Total(0,Group->Units.size());
+
+      for (const AggregateChunk& Chunk : Group->Chunks)
+      {
+        if (!Chunk.Count)
+          continue;
+
+        if (!Total.Count || Chunk.Min < Total.Min)
+          Total.Min = Chunk.Min;
+        if (!Total.Count || Chunk.Max > Total.Max)
+          Total.Max = Chunk.Max;
+
+        Total.Sum += Chunk.Sum;
+        Total.WeightedSum += Chunk.WeightedSum;
+        Total.WeightsSum += Chunk.WeightsSum;
+        Total.Count += Chunk.Count;
+      }
+
+      // no unit of the group produced a value at the current time index
+      if (!Total.Count)
+        return;
+
+      std::vector<double> Values;
+
+      if (Aggregate.HasQuantiles)
+      {
+        Values.reserve(Total.Count);
+        for (double Value : Group->Values)
+        {
+          if (!std::isnan(Value))
+            Values.push_back(Value);
+        }
+      }
+
+      const bool Weighted = !Group->Weights.empty();
+
+      Group->FileHandle << DateStr;
+
+      for (const Reduction& Red : Aggregate.Reductions)
+      {
+        Group->FileHandle << ";";
+
+        switch (Red.RedType)
+        {
+          case Reduction::SUM:
+            Group->FileHandle << (Weighted ? Total.WeightedSum : Total.Sum);
+            break;
+          case Reduction::MEAN:
+            if (Weighted)
+              Group->FileHandle << (Total.WeightsSum != 0.0 ? Total.WeightedSum/Total.WeightsSum :
+                                                              std::numeric_limits<double>::quiet_NaN());
+            else
+              Group->FileHandle << Total.Sum/Total.Count;
+            break;
+          case Reduction::MIN:
+            Group->FileHandle << Total.Min;
+            break;
+          case Reduction::MAX:
+            Group->FileHandle << Total.Max;
+            break;
+          case Reduction::COUNT:
+            Group->FileHandle << Total.Count;
+            break;
+          case Reduction::QUANTILE:
+            Group->FileHandle << computeQuantile(Values,Red.Quantile);
+            break;
+        }
+      }
+
+      Group->FileHandle << "\n";
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    void saveToFiles()
+    {
+      const openfluid::core::TimeIndex_t Index = OPENFLUID_GetCurrentTimeIndex();
+
+      std::string DateStr;
+
+      if (m_IsTimeIndexDateFormat)
+        DateStr = std::to_string(Index);
+      else
+        DateStr = OPENFLUID_GetCurrentDate().getAsString(m_DateFormat);
+
+
+      // values of all chunks of all aggregates are read and reduced in parallel
+
+      if (m_ThreadsCount > 1)
+      {
+        QFutureSynchronizer<void> Synchronizer;
+
+        for (auto& Aggregate : m_Aggregates)
+        {
+          for (AggregateGroup* Group : Aggregate.second.Groups)
+          {
+            for (AggregateChunk& Chunk : Group->Chunks)
+              Synchronizer.addFuture(QtConcurrent::run(&AggregatesFilesObserver::processChunk,
+                                                       Aggregate.second.VarName,Index,Group,&Chunk));
+          }
+        }
+
+        Synchronizer.waitForFinished();
+      }
+      else
+      {
+        for (auto& Aggregate : m_Aggregates)
+        {
+          for (AggregateGroup* Group : Aggregate.second.Groups)
+          {
+            for (AggregateChunk& Chunk : Group->Chunks)
+              processChunk(Aggregate.second.VarName,Index,Group,&Chunk);
+          }
+        }
+      }
+
+
+      for (auto& Aggregate : m_Aggregates)
+      {
+        for (AggregateGroup* Group : Aggregate.second.Groups)
+          writeGroup(Aggregate.second,Group,DateStr);
+      }
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    void prepareGroup(const std::string& AggregateName, AggregateDefinition& Aggregate,
+                      AggregateGroup* Group, const std::string& GroupSuffix, std::size_t ChunkSize)
+    {
+      Group->Values.resize(Group->Units.size());
+
+      for (std::size_t i = 0; i < Group->Units.size(); i += ChunkSize)
+        Group->Chunks.push_back(AggregateChunk(i,std::min(i+ChunkSize,Group->Units.size())));
+
+      if (!Aggregate.WeightAttr.empty())
+      {
+        for (openfluid::core::SpatialUnit* Unit : Group->Units)
+        {
+          if (!OPENFLUID_IsAttributeExist(Unit,Aggregate.WeightAttr))
+            OPENFLUID_RaiseError("Weight attribute "+Aggregate.WeightAttr+" does not exist for unit "+
+                                 Unit->getClass()+"#"+std::to_string(Unit->getID()));
+
+          Group->Weights.push_back(OPENFLUID_GetAttribute<double>(Unit,Aggregate.WeightAttr));
+        }
+      }
+
+      Group->FileBuffer = new char[m_BufferSize];
+      Group->FileHandle.rdbuf()->pubsetbuf(Group->FileBuffer,m_BufferSize);
+
+      Group->FileName = m_OutputDir+"/"+AggregateName+"_"+Aggregate.VarName+GroupSuffix+".csv";
+      Group->FileHandle.open(Group->FileName.c_str(),std::ios::out);
+
+      Group->FileHandle << "#datetime";
+      for (const Reduction& Red : Aggregate.Reductions)
+        Group->FileHandle << ";" << Red.Name;
+      Group->FileHandle << "\n";
+
+      Group->FileHandle << std::fixed << std::setprecision(m_Precision);
+
+      Aggregate.Groups.push_back(Group);
+    }
+
+
+  public:
+
+    AggregatesFilesObserver() : PluggableObserver(),
+      m_OutputDir(""), m_DateFormat("%Y%m%dT%H%M%S"), m_IsTimeIndexDateFormat(false),
+      m_Precision(5), m_ThreadsCount(1), m_BufferSize(2*1024)
+    {
+
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    ~AggregatesFilesObserver()
+    {
+      onFinalizedRun();
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    void initParams(const openfluid::ware::WareParams_t& Params)
+    {
+      openfluid::ware::WareParamsTree ParamsTree;
+
+      try
+      {
+        ParamsTree.setParams(Params);
+      }
+      catch (openfluid::base::FrameworkException& E)
+      {
+        OPENFLUID_RaiseError(E.getMessage());
+      }
+
+
+      std::string DateFormat = ParamsTree.getValueUsingFullKey("general.date","ISO").get();
+
+      if (DateFormat == "ISO")
+        m_DateFormat = "%Y%m%dT%H%M%S";
+      else if (DateFormat == "6cols")
+        m_DateFormat = "%Y\t%m\t%d\t%H\t%M\t%S";
+      else if (DateFormat == "timeindex")
+        m_IsTimeIndexDateFormat = true;
+      else
+        m_DateFormat = DateFormat;
+
+      long Precision;
+      if (ParamsTree.getValueUsingFullKey("general.precision","5").toInteger(Precision) && Precision >= 0)
+        m_Precision = Precision;
+
+      long ThreadsCount;
+      if (ParamsTree.getValueUsingFullKey("general.threads",
+                                          std::to_string(QThread::idealThreadCount())).toInteger(ThreadsCount))
+        m_ThreadsCount = std::max(1L,ThreadsCount);
+
+
+      if (ParamsTree.root().hasChild("aggregate"))
+      {
+        for (auto& Aggr : ParamsTree.root().child("aggregate"))
+        {
+          AggregateDefinition& Aggregate = m_Aggregates[Aggr.first];
+
+          Aggregate.UnitsClass = Aggr.second.getChildValue("unitsclass","").get();
+          Aggregate.VarName = Aggr.second.getChildValue("var","").get();
+          Aggregate.WeightAttr = Aggr.second.getChildValue("weight","").get();
+          Aggregate.GroupClass = Aggr.second.getChildValue("groupby","").get();
+
+          if (Aggregate.UnitsClass.empty())
+            OPENFLUID_RaiseError("Units class for aggregate " + Aggr.first + " is undefined");
+
+          if (Aggregate.VarName.empty())
+            OPENFLUID_RaiseError("Variable for aggregate " + Aggr.first + " is undefined");
+
+          for (const std::string& RedStr :
+               openfluid::tools::splitString(Aggr.second.getChildValue("reductions","sum").get(),";"))
+          {
+            Reduction Red;
+
+            if (!parseReduction(RedStr,Red))
+              OPENFLUID_RaiseError("Wrong reduction " + RedStr + " for aggregate " + Aggr.first);
+
+            Aggregate.HasQuantiles = Aggregate.HasQuantiles || (Red.RedType == Reduction::QUANTILE);
+            Aggregate.Reductions.push_back(Red);
+          }
+
+          if (Aggregate.Reductions.empty())
+            OPENFLUID_RaiseError("No reduction for aggregate " + Aggr.first);
+        }
+      }
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    void onPrepared()
+    {
+      OPENFLUID_GetRunEnvironment("dir.output",m_OutputDir);
+
+      openfluid::core::SpatialUnit* TmpU;
+
+      for (auto& Aggr : m_Aggregates)
+      {
+        AggregateDefinition& Aggregate = Aggr.second;
+
+        if (!OPENFLUID_IsUnitsClassExist(Aggregate.UnitsClass))
+        {
+          OPENFLUID_LogWarning("Unit class "+Aggregate.UnitsClass+" does not exist. Ignored.");
+          continue;
+        }
+
+        const std::size_t UnitsCount = mp_SpatialData->spatialUnits(Aggregate.UnitsClass)->list()->size();
+
+        // chunks are large enough to amortize the scheduling of threads
+        const std::size_t ChunkSize = std::max<std::size_t>(256,(UnitsCount+m_ThreadsCount-1)/m_ThreadsCount);
+
+        if (Aggregate.GroupClass.empty())
+        {
+          AggregateGroup* Group = new AggregateGroup();
+
+          OPENFLUID_UNITS_ORDERED_LOOP(Aggregate.UnitsClass,TmpU)
+          {
+            // halo units of a partitioned domain are aggregated by the part owning them
+            if (!TmpU->isHalo())
+              Group->Units.push_back(TmpU);
+          }
+
+          prepareGroup(Aggr.first,Aggregate,Group,"",ChunkSize);
+        }
+        else
+        {
+          std::map<openfluid::core::UnitID_t,AggregateGroup*> GroupsByParent;
+          unsigned int OrphansCount = 0;
+
+          OPENFLUID_UNITS_ORDERED_LOOP(Aggregate.UnitsClass,TmpU)
+          {
+            if (TmpU->isHalo())
+              continue;
+
+            const openfluid::core::UnitsPtrList_t* Parents = TmpU->parentSpatialUnits(Aggregate.GroupClass);
+
+            if (Parents == NULL || Parents->empty())
+            {
+              OrphansCount++;
+              continue;
+            }
+
+            // a unit with several parents contributes to each parent group
+            for (openfluid::core::SpatialUnit* Parent : *Parents)
+            {
+              AggregateGroup*& Group = GroupsByParent[Parent->getID()];
+
+              if (Group == NULL)
+                Group = new AggregateGroup();
+
+              Group->Units.push_back(TmpU);
+            }
+          }
+
+          if (OrphansCount)
+            OPENFLUID_LogWarning(std::to_string(OrphansCount)+" units of class "+Aggregate.UnitsClass+
+                                 " have no parent of class "+Aggregate.GroupClass+
+                                 " and are ignored by aggregate "+Aggr.first);
+
+          for (auto& GroupByParent : GroupsByParent)
+            prepareGroup(Aggr.first,Aggregate,GroupByParent.second,
+                         "_"+Aggregate.GroupClass+std::to_string(GroupByParent.first),ChunkSize);
+        }
+      }
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    void onInitializedRun()
+    {
+      saveToFiles();
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    void onStepCompleted()
+    {
+      saveToFiles();
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    void onFinalizedRun()
+    {
+      for (auto& Aggregate : m_Aggregates)
+      {
+        for (AggregateGroup* Group : Aggregate.second.Groups)
+          delete Group;
+
+        Aggregate.second.Groups.clear();
+      }
+    }
+
+};
+
+
+// =====================================================================
+// =====================================================================
+
+
+DEFINE_OBSERVER_CLASS(AggregatesFilesObserver)
+
+DEFINE_WARE_LINKUID(WARE_LINKUID)
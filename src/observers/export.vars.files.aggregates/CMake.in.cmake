@@ -0,0 +1,6 @@
+SET(OBS_INSTALL_ENABLED ON)
+
+IF (Qt5Concurrent_FOUND)
+  INCLUDE_DIRECTORIES(Qt5Concurrent_INCLUDE_DIRS)
+  SET(OBS_EXTRA_LINKS ${QT_QTCONCURRENT_LIBRARIES})
+ENDIF()
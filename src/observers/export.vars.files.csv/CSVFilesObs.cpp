@@ -134,10 +134,17 @@ class CSVFilesObserver : public openfluid::ware::PluggableObserver
 
     typedef std::map<std::string, CSVSetFiles> SetFilesMap_t;
 
+    typedef std::vector<std::pair<CSVSetFiles*,CSVFile*> > SetFilesPtrList_t;
+
+    typedef std::map<const openfluid::core::SpatialUnit*,
+                     std::map<openfluid::core::VariableName_t,SetFilesPtrList_t> > FilesByVariableMap_t;
+
     FormatMap_t m_Formats;
 
     SetFilesMap_t m_SetsFiles;
 
+    FilesByVariableMap_t m_FilesByVariable;
+
     std::string m_OutputDir;
 
     unsigned int m_BufferSize;
@@ -272,6 +279,9 @@ class CSVFilesObserver : public openfluid::ware::PluggableObserver
 
             OPENFLUID_UNITS_ORDERED_LOOP(SetFiles.second.SetDefinition.UnitsClass,TmpU)
             {
+              // halo units of a partitioned domain are exported by the part owning them
+              if (TmpU->isHalo())
+                continue;
 
               for (unsigned int i = 0; i < VarArray.size(); i++)
               {
@@ -300,6 +310,9 @@ class CSVFilesObserver : public openfluid::ware::PluggableObserver
                 TmpU = mp_SpatialData->spatialUnit(SetFiles.second.SetDefinition.UnitsClass,UID);
                 if (TmpU != NULL)
                 {
+                  if (TmpU->isHalo())
+                    continue;
+
                   for (unsigned int i = 0; i < VarArray.size(); i++)
                   {
                     CSVFile* CF = new CSVFile();
@@ -343,9 +356,12 @@ class CSVFilesObserver : public openfluid::ware::PluggableObserver
           // set precision
           File->FileHandle << std::fixed << std::setprecision(SetFiles.second.Format->Precision);
 
+          m_FilesByVariable[File->Unit][File->VarName].push_back(std::make_pair(&SetFiles.second,File));
         }
 
       }
+
+      OPENFLUID_EnableVariablesChangesTracking();
     }
 
 
@@ -355,31 +371,39 @@ class CSVFilesObserver : public openfluid::ware::PluggableObserver
 
     void saveToFiles()
     {
-      SetFilesMap_t::iterator SetItE = m_SetsFiles.end();
-      SetFilesMap_t::iterator SetItB = m_SetsFiles.begin();
-      SetFilesMap_t::iterator SetIt;
-
+      // only the variables changed at the current time index are visited
+      openfluid::core::ChangedVariablesList_t Changes = OPENFLUID_GetChangedVariables();
 
-      for (SetIt=SetItB;SetIt!=SetItE;++SetIt)
+      for (const openfluid::core::ChangedVariable& Change : Changes)
       {
-        CSVSetFiles::CSVFilePtrList_t::iterator FLItB = (*SetIt).second.Files.begin();
-        CSVSetFiles::CSVFilePtrList_t::iterator FLItE = (*SetIt).second.Files.end();;
-        CSVSetFiles::CSVFilePtrList_t::iterator FLIt;
+        FilesByVariableMap_t::const_iterator UnitIt = m_FilesByVariable.find(Change.unit());
 
-        for (FLIt=FLItB;FLIt!=FLItE;++FLIt)
-        {
-          openfluid::core::Value* Val =
-              (*FLIt)->Unit->variables()->currentValueIfIndex((*FLIt)->VarName,OPENFLUID_GetCurrentTimeIndex());
+        if (UnitIt == m_FilesByVariable.end())
+          continue;
+
+        std::map<openfluid::core::VariableName_t,SetFilesPtrList_t>::const_iterator VarIt =
+            UnitIt->second.find(Change.getVariableName());
 
-          if (Val!=NULL)
+        if (VarIt == UnitIt->second.end())
+          continue;
+
+        const openfluid::core::Value* Val =
+            Change.unit()->variables()->value(Change.getVariableName(),OPENFLUID_GetCurrentTimeIndex());
+
+        if (Val!=NULL)
+        {
+          for (auto& SetFile : VarIt->second)
           {
-            if ((*SetIt).second.Format->IsTimeIndexDateFormat)
-              (*FLIt)->FileHandle << OPENFLUID_GetCurrentTimeIndex();
+            CSVFormat* Format = SetFile.first->Format;
+            CSVFile* File = SetFile.second;
+
+            if (Format->IsTimeIndexDateFormat)
+              File->FileHandle << OPENFLUID_GetCurrentTimeIndex();
             else
-              (*FLIt)->FileHandle << OPENFLUID_GetCurrentDate().getAsString((*SetIt).second.Format->DateFormat);
-            (*FLIt)->FileHandle << (*SetIt).second.Format->ColSeparator;
-            Val->writeQuotedToStream((*FLIt)->FileHandle);
-            (*FLIt)->FileHandle << "\n";
+              File->FileHandle << OPENFLUID_GetCurrentDate().getAsString(Format->DateFormat);
+            File->FileHandle << Format->ColSeparator;
+            Val->writeQuotedToStream(File->FileHandle);
+            File->FileHandle << "\n";
           }
         }
       }
@@ -428,6 +452,8 @@ class CSVFilesObserver : public openfluid::ware::PluggableObserver
 
         (*SetIt).second.Files.clear();
       }
+
+      m_FilesByVariable.clear();
     }
 
 
@@ -38,11 +38,14 @@
  */
 
 
+#include <algorithm>
+
 #include <QStringList>
 #include <QDir>
 #include <ogrsf_frmts.h>
 
 #include <openfluid/utils/GDALHelpers.hpp>
+#include <openfluid/core/ValuesBuffer.hpp>
 #include <openfluid/ware/PluggableObserver.hpp>
 #include <openfluid/ware/WareParamsTree.hpp>
 
@@ -57,6 +60,10 @@ BEGIN_OBSERVER_SIGNATURE("export.vars.files.geovector")
       "接受如下参数\n"
       "  format : 输出文件的GDAL格式 (必填)"
       "  outsubdir : 输出文件的子目录, 相对于输出目录 (可选)\n"
+      "  singlefile : 将每个序列的所有输出写入单个GeoPackage文件 (可选). "
+      "rows则每个输出时间步写为新的记录, fields则每个输出时间步写为新的字段. "
+      "fields模式下, 字段数超过GeoPackage的限制(每个图层2000列)的序列改为按rows模式写入. "
+      "设置此参数时忽略format参数\n"
       "  geoserie.<序列名>.sourcefile : 序列的几何数据源 (必填)\n"
       "  geoserie.<序列名>.unitsclass : 序列的单元类 (必填)\n"
       "  geoserie.<序列名>.vars : 序列的参数列表 (必填)."
@@ -86,6 +93,33 @@ class GeoVectorSerie
 
     typedef std::map<openfluid::core::VariableName_t,std::string> VariablesSet_t;
 
+    /**
+      Source feature cached at run initialization, matching an existing spatial unit
+    */
+    struct CachedFeature
+    {
+      openfluid::core::SpatialUnit* Unit;
+
+      int ID;
+
+      OGRGeometry* Geometry;
+
+      /**
+        Values buffer of each variable of the serie, in the order of the variables set,
+        NULL if the variable does not exist or is not a double value
+      */
+      std::vector<const openfluid::core::ValuesBuffer*> VariablesBuffers;
+
+      /**
+        FID of the feature in the single output layer, used when time steps are written as fields
+      */
+      GIntBig OutputFID;
+
+      CachedFeature(openfluid::core::SpatialUnit* U, int UID, OGRGeometry* Geom) :
+        Unit(U), ID(UID), Geometry(Geom), OutputFID(-1)
+      { }
+    };
+
 
     std::string SerieName;
 
@@ -109,6 +143,26 @@ class GeoVectorSerie
 
     int OFLDIDFieldIndex;
 
+    bool HasChangedValues;
+
+    OGRwkbGeometryType GeometryType;
+
+    std::vector<CachedFeature> Features;
+
+    bool AreVariablesChecked;
+
+    OGRDataSource* OutputSource;
+
+    OGRLayer* OutputLayer;
+
+    std::vector<int> OutputFieldsIndexes;
+
+    /**
+      True if the time steps are written as rows while the fields layout is requested,
+      the fields count of the layer being limited
+    */
+    bool IsRowsFallback;
+
 
     GeoVectorSerie(const std::string& SName,
                    const std::string& SrcFilePath,
@@ -124,20 +178,15 @@ class GeoVectorSerie
       WhenMode(Mode), WhenContinuousDelay(ContModeDelay), LatestContinuousIndex(0),
       GeoSource(NULL), GeoLayer(NULL),
       OutfilePattern(SName+"_"+"%1"+"."+OutfileExt),
-      OFLDIDFieldIndex(-1)
+      OFLDIDFieldIndex(-1), HasChangedValues(true),
+      GeometryType(wkbUnknown), AreVariablesChecked(false),
+      OutputSource(NULL), OutputLayer(NULL), IsRowsFallback(false)
     {
 
     }
 
-
-    // =====================================================================
-    // =====================================================================
-
-
-    ~GeoVectorSerie()
-    {
-      OGRDataSource::DestroyDataSource(GeoSource);
-    }
+    // opened sources and cached geometries are released by the observer (see closeSerie()),
+    // as series are copied when stored
 
 };
 
@@ -150,12 +199,18 @@ class GeoVectorFilesObserver : public openfluid::ware::PluggableObserver
 {
   private:
 
+    enum OutputLayout {LAYOUTFILES, LAYOUTROWS, LAYOUTFIELDS};
+
     std::string m_GDALFormat;
 
     std::string m_InputPath;
 
     std::string m_OutputPath;
 
+    OutputLayout m_Layout;
+
+    const unsigned int m_MaxFieldsCount;
+
     std::vector<GeoVectorSerie> m_Series;
 
 
@@ -306,7 +361,6 @@ class GeoVectorFilesObserver : public openfluid::ware::PluggableObserver
       // opening and checking of source files
       Serie.GeoSource = OGRSFDriverRegistrar::Open(Serie.GeoSourceFilePath.c_str(),FALSE);
 
-
       if (Serie.GeoSource)
       {
         Serie.GeoLayer = Serie.GeoSource->GetLayer(0);
@@ -315,7 +369,7 @@ class GeoVectorFilesObserver : public openfluid::ware::PluggableObserver
         {
           // checking of OFLD_ID
           Serie.OFLDIDFieldIndex = Serie.GeoLayer->GetLayerDefn()->GetFieldIndex("OFLD_ID");
-
+          Serie.GeometryType = Serie.GeoLayer->GetLayerDefn()->GetGeomType();
         }
       }
     }
@@ -325,144 +379,452 @@ class GeoVectorFilesObserver : public openfluid::ware::PluggableObserver
     // =====================================================================
 
 
-    void processSerie(GeoVectorSerie& Serie)
+    /**
+      Reads the source features once, keeping the geometries of features matching an existing spatial unit
+      and the values buffers of their variables.
+      Spatial units cannot be added nor deleted after the CHECKCONSISTENCY stage,
+      so the features are cached at the INITIALIZERUN stage.
+      The source is released afterwards as it is not used anymore.
+    */
+    void cacheSerieFeatures(GeoVectorSerie& Serie)
     {
-      QString IndexStr = "init";
+      OGRFeature* SourceFeature;
 
-      openfluid::base::SimulationStatus::SimulationStage CurrentStage =
-          OPENFLUID_GetCurrentStage();
+      Serie.GeoLayer->ResetReading();
+      while ((SourceFeature = Serie.GeoLayer->GetNextFeature()) != NULL)
+      {
+        int SourceID = SourceFeature->GetFieldAsInteger(Serie.OFLDIDFieldIndex);
+        openfluid::core::SpatialUnit* UU = OPENFLUID_GetUnit(Serie.UnitsClass,SourceID);
 
-      bool OKToWrite = false;
+        // halo units of a partitioned domain are exported by the part owning them
+        if (UU && !UU->isHalo() && SourceFeature->GetGeometryRef())
+        {
+          Serie.Features.push_back(GeoVectorSerie::CachedFeature(UU,SourceID,
+                                                                  SourceFeature->GetGeometryRef()->clone()));
 
-      if (CurrentStage == openfluid::base::SimulationStatus::INITIALIZERUN)
-      {
-        OKToWrite = Serie.WhenMode == GeoVectorSerie::WHENINIT ||
-                    Serie.WhenMode == GeoVectorSerie::WHENCONTINUOUS;
+          for (auto& Var : Serie.VariablesSet)
+            Serie.Features.back().VariablesBuffers.push_back(UU->variables()->valuesBuffer(Var.first));
+        }
 
+        OGRFeature::DestroyFeature(SourceFeature);
       }
-      else if (CurrentStage == openfluid::base::SimulationStatus::RUNSTEP)
+
+      OGRDataSource::DestroyDataSource(Serie.GeoSource);
+      Serie.GeoSource = NULL;
+      Serie.GeoLayer = NULL;
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    /**
+      Checks once which variables of the serie can be written for each cached feature.
+      Variables are checked at the first writing as their values types are not known before.
+    */
+    void checkSerieVariables(GeoVectorSerie& Serie)
+    {
+      for (auto& Feature : Serie.Features)
       {
-        if (Serie.WhenMode == GeoVectorSerie::WHENCONTINUOUS)
+        unsigned int i = 0;
+
+        for (auto itV = Serie.VariablesSet.begin(); itV != Serie.VariablesSet.end(); ++itV,++i)
         {
-          openfluid::core::TimeIndex_t CurrentIndex = OPENFLUID_GetCurrentTimeIndex();
-          IndexStr = QString("%1").arg(CurrentIndex);
+          const auto& Var = *itV;
+          const openfluid::core::ValuesBuffer*& Buffer = Feature.VariablesBuffers[i];
 
-          if (Serie.LatestContinuousIndex + Serie.WhenContinuousDelay < CurrentIndex)
+          if (Buffer)
           {
-            OKToWrite = true;
-            Serie.LatestContinuousIndex = CurrentIndex;
+            const openfluid::core::Value* CurrentValue = Buffer->currentValue();
+
+            if (CurrentValue && !CurrentValue->isDoubleValue())
+            {
+              Buffer = NULL;
+
+              QString Msg("Variable %1 on unit %2#%3 is not a double. Only double are currently supported");
+              OPENFLUID_LogWarning(Msg.arg(Var.first.c_str()).arg(Serie.UnitsClass.c_str()).arg(Feature.ID)
+                                   .toStdString());
+            }
+          }
+          else
+          {
+            QString Msg("Variable %1 does not exist on unit %2#%3");
+            OPENFLUID_LogWarning(Msg.arg(Var.first.c_str()).arg(Serie.UnitsClass.c_str()).arg(Feature.ID)
+                                 .toStdString());
           }
         }
       }
-      else if (CurrentStage == openfluid::base::SimulationStatus::FINALIZERUN)
+
+      Serie.AreVariablesChecked = true;
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    /**
+      Creates the output layer of a serie, with the OFLD_ID field and optionnally the step field
+    */
+    static OGRLayer* createOutputLayer(OGRDataSource* DataSource, const std::string& LayerName,
+                                       const GeoVectorSerie& Serie, bool WithStepField)
+    {
+      OGRLayer* CreatedLayer = DataSource->CreateLayer(LayerName.c_str(),NULL,Serie.GeometryType,NULL);
+
+      if (!CreatedLayer)
+        return NULL;
+
+      OGRFieldDefn IDField("OFLD_ID",OFTInteger);
+      CreatedLayer->CreateField(&IDField);
+
+      if (WithStepField)
       {
-        IndexStr = "final";
-        OKToWrite = Serie.WhenMode == GeoVectorSerie::WHENCONTINUOUS ||
-                    Serie.WhenMode == GeoVectorSerie::WHENFINAL;
+        OGRFieldDefn StepField("OFLD_STEP",OFTString);
+        CreatedLayer->CreateField(&StepField);
       }
-      else
+
+      return CreatedLayer;
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    /**
+      Creates the fields of the variables of the serie in the given layer, with the given suffix.
+      @return the indexes of the created fields, in the order of the variables set
+    */
+    static std::vector<int> createVariablesFields(OGRLayer* Layer, const GeoVectorSerie& Serie,
+                                                  const std::string& Suffix)
+    {
+      std::vector<int> FieldsIndexes;
+
+      for (auto& Var : Serie.VariablesSet)
       {
-        OPENFLUID_LogWarning("Internal stage error when processing geographic series");
-        return;
+        std::string FieldName = Var.second;
+
+        if (FieldName.empty())
+          FieldName = Var.first;
+
+        FieldName += Suffix;
+
+        OGRFieldDefn VarField(FieldName.c_str(),OFTReal);
+        VarField.SetWidth(24);
+        VarField.SetPrecision(15);
+
+        Layer->CreateField(&VarField);
+        FieldsIndexes.push_back(Layer->GetLayerDefn()->GetFieldIndex(FieldName.c_str()));
       }
 
+      return FieldsIndexes;
+    }
 
 
-      if (OKToWrite)
+    // =====================================================================
+    // =====================================================================
+
+
+    /**
+      Sets the current values of the variables of a cached feature into the given output feature
+    */
+    void setVariablesFields(const GeoVectorSerie& Serie, const GeoVectorSerie::CachedFeature& Feature,
+                            const std::vector<int>& FieldsIndexes, OGRFeature* OutputFeature)
+    {
+      for (unsigned int i = 0; i < Feature.VariablesBuffers.size(); i++)
       {
-        std::string FullFilePath =
-            m_OutputPath + "/" + QString(QString::fromStdString(Serie.OutfilePattern).arg(IndexStr)).toStdString();
+        if (Feature.VariablesBuffers[i])
+        {
+          const openfluid::core::Value* CurrentValue = Feature.VariablesBuffers[i]->currentValue();
 
+          if (CurrentValue && CurrentValue->isDoubleValue())
+            OutputFeature->SetField(FieldsIndexes[i],CurrentValue->asDoubleValue().get());
+        }
+      }
+    }
 
-        OGRSFDriver* Driver = OGRSFDriverRegistrar::GetRegistrar()->GetDriverByName(m_GDALFormat.c_str());
-        OGRDataSource* CreatedFile = Driver->CreateDataSource(FullFilePath.c_str());
 
-        std::string CreatedLayerName = QFileInfo(QString::fromStdString(FullFilePath)).completeBaseName().toStdString();
+    // =====================================================================
+    // =====================================================================
 
-        OGRLayer* CreatedLayer = CreatedFile->CreateLayer(CreatedLayerName.c_str(),NULL,
-                                                          Serie.GeoLayer->GetLayerDefn()->GetGeomType(),
-                                                          NULL);
 
-        OGRFieldDefn IDField("OFLD_ID",OFTInteger);
-        CreatedLayer->CreateField(&IDField);
+    /**
+      Writes the cached features with the current values of the variables into the given layer,
+      adding new features
+    */
+    void writeSerieFeatures(const GeoVectorSerie& Serie, OGRLayer* Layer,
+                            const std::vector<int>& FieldsIndexes, const std::string& StepStr)
+    {
+      OGRFeatureDefn* LayerDefn = Layer->GetLayerDefn();
+      int IDFieldIndex = LayerDefn->GetFieldIndex("OFLD_ID");
+      int StepFieldIndex = LayerDefn->GetFieldIndex("OFLD_STEP");
+
+      Layer->StartTransaction();
 
+      for (auto& Feature : Serie.Features)
+      {
+        OGRFeature* CreatedFeature = OGRFeature::CreateFeature(LayerDefn);
 
-        GeoVectorSerie::VariablesSet_t::const_iterator itV;
-        GeoVectorSerie::VariablesSet_t::const_iterator itVb = Serie.VariablesSet.begin();
-        GeoVectorSerie::VariablesSet_t::const_iterator itVe = Serie.VariablesSet.end();
+        // the cached geometry is lent to the created feature then taken back, avoiding a copy at each step
+        CreatedFeature->SetGeometryDirectly(Feature.Geometry);
+        CreatedFeature->SetField(IDFieldIndex,Feature.ID);
 
-        for (itV = itVb; itV != itVe; ++itV)
+        if (StepFieldIndex >= 0)
+          CreatedFeature->SetField(StepFieldIndex,StepStr.c_str());
+
+        setVariablesFields(Serie,Feature,FieldsIndexes,CreatedFeature);
+
+        Layer->CreateFeature(CreatedFeature);
+
+        CreatedFeature->StealGeometry();
+        OGRFeature::DestroyFeature(CreatedFeature);
+      }
+
+      Layer->CommitTransaction();
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    bool isRowsLayout(const GeoVectorSerie& Serie) const
+    {
+      return m_Layout == LAYOUTROWS || Serie.IsRowsFallback;
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    /**
+      Returns the maximum count of writings of the serie, assuming time points spaced by the default DeltaT
+    */
+    unsigned long long getMaxWritingsCount(const GeoVectorSerie& Serie) const
+    {
+      if (Serie.WhenMode != GeoVectorSerie::WHENCONTINUOUS)
+        return 1;
+
+      // written at initialization, at most once per delay during the run, and at the end
+      openfluid::core::Duration_t MinSpacing = std::max(OPENFLUID_GetDefaultDeltaT(),Serie.WhenContinuousDelay+1);
+
+      return OPENFLUID_GetSimulationDuration()/MinSpacing + 2;
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    bool openSingleOutput(GeoVectorSerie& Serie)
+    {
+      if (Serie.OutputLayer)
+        return true;
+
+      std::string FullFilePath = m_OutputPath + "/" + Serie.SerieName + ".gpkg";
+
+      OGRSFDriver* Driver = OGRSFDriverRegistrar::GetRegistrar()->GetDriverByName("GPKG");
+
+      if (!Driver)
+      {
+        OPENFLUID_LogWarning("GeoPackage format is not available for serie "+Serie.SerieName);
+        return false;
+      }
+
+      Serie.OutputSource = Driver->CreateDataSource(FullFilePath.c_str());
+
+      if (!Serie.OutputSource)
+      {
+        OPENFLUID_LogWarning("Cannot create output file for serie "+Serie.SerieName);
+        return false;
+      }
+
+      Serie.OutputLayer = createOutputLayer(Serie.OutputSource,Serie.SerieName,Serie,isRowsLayout(Serie));
+
+      if (!Serie.OutputLayer)
+        return false;
+
+      if (isRowsLayout(Serie))
+        Serie.OutputFieldsIndexes = createVariablesFields(Serie.OutputLayer,Serie,"");
+      else
+      {
+        // features are created once with their geometries, each written step adds fields to them
+        OGRFeatureDefn* LayerDefn = Serie.OutputLayer->GetLayerDefn();
+
+        Serie.OutputLayer->StartTransaction();
+
+        for (auto& Feature : Serie.Features)
         {
-          std::string FieldName = (*itV).second;
+          OGRFeature* CreatedFeature = OGRFeature::CreateFeature(LayerDefn);
+
+          CreatedFeature->SetGeometryDirectly(Feature.Geometry);
+          CreatedFeature->SetField(0,Feature.ID);
+          Serie.OutputLayer->CreateFeature(CreatedFeature);
+          Feature.OutputFID = CreatedFeature->GetFID();
+
+          CreatedFeature->StealGeometry();
+          OGRFeature::DestroyFeature(CreatedFeature);
+        }
+
+        Serie.OutputLayer->CommitTransaction();
+      }
+
+      return true;
+    }
+
+
+    // =====================================================================
+    // =====================================================================
 
-          OGRFieldDefn VarField(FieldName.c_str(),OFTReal);
-          VarField.SetWidth(24);
-          VarField.SetPrecision(15);
 
-          CreatedLayer->CreateField(&VarField);
+    void writeSerie(GeoVectorSerie& Serie, const std::string& StepStr)
+    {
+      if (!Serie.AreVariablesChecked)
+        checkSerieVariables(Serie);
+
+      if (m_Layout == LAYOUTFILES)
+      {
+        std::string FullFilePath =
+            m_OutputPath + "/" + QString(QString::fromStdString(Serie.OutfilePattern).arg(StepStr.c_str()))
+                                 .toStdString();
+
+        OGRSFDriver* Driver = OGRSFDriverRegistrar::GetRegistrar()->GetDriverByName(m_GDALFormat.c_str());
+        OGRDataSource* CreatedFile = Driver->CreateDataSource(FullFilePath.c_str());
+
+        if (!CreatedFile)
+        {
+          OPENFLUID_LogWarning("Cannot create output file "+FullFilePath);
+          return;
         }
 
+        std::string CreatedLayerName = QFileInfo(QString::fromStdString(FullFilePath)).completeBaseName().toStdString();
+
+        OGRLayer* CreatedLayer = createOutputLayer(CreatedFile,CreatedLayerName,Serie,false);
 
-        OGRFeature* SourceFeature;
-        openfluid::core::SpatialUnit* UU;
+        if (CreatedLayer)
+          writeSerieFeatures(Serie,CreatedLayer,createVariablesFields(CreatedLayer,Serie,""),StepStr);
 
-        Serie.GeoLayer->ResetReading();
-        while ((SourceFeature = Serie.GeoLayer->GetNextFeature()) != NULL)
+        OGRDataSource::DestroyDataSource(CreatedFile);
+      }
+      else if (openSingleOutput(Serie))
+      {
+        // the steps remaining to write are written as rows in another layer if the fields count limit is reached
+        if (!isRowsLayout(Serie) &&
+            Serie.OutputLayer->GetLayerDefn()->GetFieldCount()+Serie.VariablesSet.size() > m_MaxFieldsCount)
         {
-          int SourceID = SourceFeature->GetFieldAsInteger(Serie.OFLDIDFieldIndex);
-          openfluid::core::DoubleValue CreatedValue = 0.0;
+          OPENFLUID_LogWarning("Too many fields for serie "+Serie.SerieName+", time steps from "+StepStr+
+                               " are written as rows in layer "+Serie.SerieName+"_rows");
 
-          UU = OPENFLUID_GetUnit(Serie.UnitsClass,SourceID);
+          OGRLayer* RowsLayer = createOutputLayer(Serie.OutputSource,Serie.SerieName+"_rows",Serie,true);
 
-          if (UU)
-          {
-            CreatedLayer->GetLayerDefn();
+          if (!RowsLayer)
+            return;
 
-            OGRFeature* CreatedFeature = OGRFeature::CreateFeature(CreatedLayer->GetLayerDefn());
+          Serie.OutputLayer = RowsLayer;
+          Serie.OutputFieldsIndexes = createVariablesFields(Serie.OutputLayer,Serie,"");
+          Serie.IsRowsFallback = true;
+        }
 
-            CreatedFeature->SetGeometry(SourceFeature->GetGeometryRef()->clone());
-            CreatedFeature->SetField("OFLD_ID",SourceID);
+        if (isRowsLayout(Serie))
+          writeSerieFeatures(Serie,Serie.OutputLayer,Serie.OutputFieldsIndexes,StepStr);
+        else
+        {
+          std::vector<int> FieldsIndexes = createVariablesFields(Serie.OutputLayer,Serie,"_"+StepStr);
 
+          Serie.OutputLayer->StartTransaction();
 
+          for (auto& Feature : Serie.Features)
+          {
+            OGRFeature* OutputFeature = Serie.OutputLayer->GetFeature(Feature.OutputFID);
 
-            for (itV = itVb; itV != itVe; ++itV)
+            if (OutputFeature)
             {
-              std::string VarName = (*itV).first;
-              std::string FieldName = (*itV).second;
-
-              if (FieldName.empty())
-                FieldName = VarName;
-
-              openfluid::core::IndexedValue VarValue;
-
-              if (OPENFLUID_IsVariableExist(UU,VarName))
-                OPENFLUID_GetLatestVariable(UU,VarName,VarValue);
-              else
-              {
-                QString Msg("Variable %1 does not exist on unit %2#%3");
-                Msg.arg(VarName.c_str()).arg(UU->getClass().c_str()).arg(UU->getID());
-                OPENFLUID_LogWarning(Msg.toStdString());
-              }
-
-              if (VarValue.value()->isDoubleValue())
-                CreatedValue = VarValue.value()->asDoubleValue();
-              else
-              {
-                QString Msg("Variable %1 on unit %2#%3 is not a double. Only double are currently supported");
-                Msg.arg(VarName.c_str()).arg(UU->getClass().c_str()).arg(UU->getID());
-                OPENFLUID_LogWarning(Msg.toStdString());
-              }
-
-              CreatedFeature->SetField(FieldName.c_str(),VarValue.value()->asDoubleValue());
+              setVariablesFields(Serie,Feature,FieldsIndexes,OutputFeature);
+              Serie.OutputLayer->SetFeature(OutputFeature);
+              OGRFeature::DestroyFeature(OutputFeature);
             }
+          }
+
+          Serie.OutputLayer->CommitTransaction();
+        }
+      }
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
 
-            CreatedLayer->CreateFeature(CreatedFeature);
+    void processSerie(GeoVectorSerie& Serie)
+    {
+      QString IndexStr = "init";
 
-            OGRFeature::DestroyFeature(CreatedFeature);
+      openfluid::base::SimulationStatus::SimulationStage CurrentStage =
+          OPENFLUID_GetCurrentStage();
+
+      bool OKToWrite = false;
 
+      if (CurrentStage == openfluid::base::SimulationStatus::INITIALIZERUN)
+      {
+        OKToWrite = Serie.WhenMode == GeoVectorSerie::WHENINIT ||
+                    Serie.WhenMode == GeoVectorSerie::WHENCONTINUOUS;
+
+      }
+      else if (CurrentStage == openfluid::base::SimulationStatus::RUNSTEP)
+      {
+        if (Serie.WhenMode == GeoVectorSerie::WHENCONTINUOUS)
+        {
+          openfluid::core::TimeIndex_t CurrentIndex = OPENFLUID_GetCurrentTimeIndex();
+          IndexStr = QString("%1").arg(CurrentIndex);
+
+          // no file is written if the tracked changes only concern variables of other series
+          // since the latest written file
+          if (Serie.HasChangedValues && Serie.LatestContinuousIndex + Serie.WhenContinuousDelay < CurrentIndex)
+          {
+            OKToWrite = true;
+            Serie.LatestContinuousIndex = CurrentIndex;
           }
         }
-        OGRDataSource::DestroyDataSource(CreatedFile);
+      }
+      else if (CurrentStage == openfluid::base::SimulationStatus::FINALIZERUN)
+      {
+        IndexStr = "final";
+        OKToWrite = Serie.WhenMode == GeoVectorSerie::WHENCONTINUOUS ||
+                    Serie.WhenMode == GeoVectorSerie::WHENFINAL;
+      }
+      else
+      {
+        OPENFLUID_LogWarning("Internal stage error when processing geographic series");
+        return;
+      }
+
+
+      if (OKToWrite)
+      {
+        writeSerie(Serie,IndexStr.toStdString());
+        Serie.HasChangedValues = false;
+      }
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    void updateChangedSeries()
+    {
+      // changes are always tracked when series are configured, a step without any change leaves the series unchanged
+      openfluid::core::ChangedVariablesList_t Changes = OPENFLUID_GetChangedVariables();
+
+      for (auto& Serie : m_Series)
+      {
+        for (auto itC = Changes.begin(); !Serie.HasChangedValues && itC != Changes.end(); ++itC)
+        {
+          Serie.HasChangedValues = ((*itC).unit()->getClass() == Serie.UnitsClass &&
+                                    Serie.VariablesSet.find((*itC).getVariableName()) != Serie.VariablesSet.end());
+        }
       }
     }
 
@@ -477,7 +839,20 @@ class GeoVectorFilesObserver : public openfluid::ware::PluggableObserver
       {
         OGRDataSource::DestroyDataSource(Serie.GeoSource);
         Serie.GeoSource = NULL;
+        Serie.GeoLayer = NULL;
       }
+
+      if (Serie.OutputSource)
+      {
+        OGRDataSource::DestroyDataSource(Serie.OutputSource);
+        Serie.OutputSource = NULL;
+        Serie.OutputLayer = NULL;
+      }
+
+      for (auto& Feature : Serie.Features)
+        OGRGeometryFactory::destroyGeometry(Feature.Geometry);
+
+      Serie.Features.clear();
     }
 
 
@@ -487,7 +862,8 @@ class GeoVectorFilesObserver : public openfluid::ware::PluggableObserver
 
   public:
 
-    GeoVectorFilesObserver() : PluggableObserver()
+    GeoVectorFilesObserver() : PluggableObserver(), m_Layout(LAYOUTFILES),
+      m_MaxFieldsCount(1998) // GeoPackage layers are limited to 2000 columns, including FID and geometry
     {
       OGRRegisterAll();
     }
@@ -523,8 +899,22 @@ class GeoVectorFilesObserver : public openfluid::ware::PluggableObserver
         OPENFLUID_RaiseError(E.getMessage());
       }
 
+      // process of parameter for optional single output file
+      std::string SingleFileMode = ParamsTree.root().getChildValue("singlefile","");
+
+      if (SingleFileMode == "rows")
+        m_Layout = LAYOUTROWS;
+      else if (SingleFileMode == "fields")
+        m_Layout = LAYOUTFIELDS;
+      else if (!SingleFileMode.empty())
+      {
+        OPENFLUID_LogWarning("Unknown single file mode for output files");
+        return;
+      }
+
+
       // checking of mandatory parameters
-      if (!ParamsTree.root().hasChild("format"))
+      if (m_Layout == LAYOUTFILES && !ParamsTree.root().hasChild("format"))
       {
         OPENFLUID_LogWarning("Missing GDAL format for output files");
         return;
@@ -540,6 +930,9 @@ class GeoVectorFilesObserver : public openfluid::ware::PluggableObserver
       // process of format parameter
       m_GDALFormat = ParamsTree.root().getChildValue("format","");
 
+      if (m_Layout != LAYOUTFILES)
+        m_GDALFormat = "GPKG";
+
       openfluid::utils::GDALDriversFilesExts_t ValidVectorDrivers =
           openfluid::utils::getOGRFilesDriversForOpenFLUID();
 
@@ -665,6 +1058,23 @@ class GeoVectorFilesObserver : public openfluid::ware::PluggableObserver
       for (it=m_Series.begin();it!=m_Series.end(); ++it)
          updateFieldNamesUsingFormat((*it).VariablesSet);
 
+
+      // series exceeding the fields count limit of the output layer are written as rows from the beginning
+      if (m_Layout == LAYOUTFIELDS)
+      {
+        for (it=m_Series.begin();it!=m_Series.end(); ++it)
+        {
+          if (1+(*it).VariablesSet.size()*getMaxWritingsCount(*it) > m_MaxFieldsCount)
+          {
+            OPENFLUID_LogWarning("Too many fields for serie "+(*it).SerieName+", time steps are written as rows");
+            (*it).IsRowsFallback = true;
+          }
+        }
+      }
+
+      if (!m_Series.empty())
+        OPENFLUID_EnableVariablesChangesTracking();
+
     }
 
 
@@ -678,6 +1088,10 @@ class GeoVectorFilesObserver : public openfluid::ware::PluggableObserver
 
       std::vector<GeoVectorSerie>::iterator it;
 
+      // caching of source features, sources are not read anymore during the simulation
+      for (it = m_Series.begin();it!=m_Series.end(); ++it)
+        cacheSerieFeatures(*it);
+
       for (it = m_Series.begin();it!=m_Series.end(); ++it)
         processSerie(*it);
 
@@ -692,6 +1106,8 @@ class GeoVectorFilesObserver : public openfluid::ware::PluggableObserver
     {
       if (m_Series.empty()) return;
 
+      updateChangedSeries();
+
       std::vector<GeoVectorSerie>::iterator it;
 
       for (it = m_Series.begin();it!=m_Series.end(); ++it)
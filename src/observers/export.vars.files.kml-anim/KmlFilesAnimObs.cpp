@@ -127,7 +127,11 @@ class KmlFilesAnimObserver : public KmlObserverBase
 {
   private:
 
-    std::ofstream m_KmlFile;
+    std::ostringstream m_KmlDoc;
+
+    std::ostringstream m_KmlFrames;
+
+    const std::string m_KmlFramesFileName;
 
     KmlAnimLayerInfo m_AnimLayerInfo;
 
@@ -155,8 +159,7 @@ class KmlFilesAnimObserver : public KmlObserverBase
 
       openfluid::tools::convertValue(CurrentTI,&CurrentTIStr);
 
-      std::ofstream CurrentKmlFile(std::string(m_TmpDir+"/"+m_KmzSubDir+"/"+
-                                               m_KmzDataSubDir+"/t_"+ CurrentTIStr+".kml").c_str());
+      std::ostringstream CurrentKmlFile;
 
       CurrentKmlFile << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
       CurrentKmlFile << "<kml xmlns=\"http://www.opengis.net/kml/2.2\" "
@@ -274,17 +277,18 @@ class KmlFilesAnimObserver : public KmlObserverBase
       CurrentKmlFile << "</Document>\n";
       CurrentKmlFile << "</kml>\n";
 
-      CurrentKmlFile.close();
+      addToKmzArchive(m_KmzDataSubDir+"/t_"+ CurrentTIStr+".kml",CurrentKmlFile.str());
 
       openfluid::core::DateTime EndDateTime = OPENFLUID_GetCurrentDate();
 
-      m_KmlFile << "<NetworkLink>\n";
-      m_KmlFile << "  <name>" << m_AnimLayerInfo.UnitsClass << " at " << EndDateTime.getAsString("%Y-%m-%d %H:%M:%S")
-                << "</name>\n";
-      m_KmlFile << "  <TimeSpan><begin>" << m_UpdateBeginDate.getAsString("%Y-%m-%dT%H:%M:%SZ") << "</begin><end>"
-                << EndDateTime.getAsString("%Y-%m-%dT%H:%M:%SZ") << "</end></TimeSpan>\n";
-      m_KmlFile << "  <Link><href>" << m_KmzDataSubDir << "/t_" << CurrentTIStr << ".kml</href></Link>\n";
-      m_KmlFile << "</NetworkLink>\n";
+      // links are relative to the frames file, located in the same directory as the frames
+      m_KmlFrames << "<NetworkLink>\n";
+      m_KmlFrames << "  <name>" << m_AnimLayerInfo.UnitsClass << " at "
+                  << EndDateTime.getAsString("%Y-%m-%d %H:%M:%S") << "</name>\n";
+      m_KmlFrames << "  <TimeSpan><begin>" << m_UpdateBeginDate.getAsString("%Y-%m-%dT%H:%M:%SZ") << "</begin><end>"
+                  << EndDateTime.getAsString("%Y-%m-%dT%H:%M:%SZ") << "</end></TimeSpan>\n";
+      m_KmlFrames << "  <Link><href>t_" << CurrentTIStr << ".kml</href></Link>\n";
+      m_KmlFrames << "</NetworkLink>\n";
 
       m_UpdateBeginDate = OPENFLUID_GetCurrentDate();
 
@@ -294,7 +298,7 @@ class KmlFilesAnimObserver : public KmlObserverBase
   public:
 
     KmlFilesAnimObserver() : KmlObserverBase(),
-      m_MinSamplingDelay(0),m_LatestSamplingIndex(0)
+      m_KmlFramesFileName("frames.kml"),m_MinSamplingDelay(0),m_LatestSamplingIndex(0)
     {
       m_OutputFileName = "kmlanim.kmz";
       m_TmpSubDir = "export.vars.files.kml-anim";
@@ -493,8 +497,6 @@ class KmlFilesAnimObserver : public KmlObserverBase
       }
 
       m_OKToGo = true;
-
-      m_KmzSubDir = m_OutputFileName + "_kmz-dir";
     }
 
 
@@ -511,72 +513,92 @@ class KmlFilesAnimObserver : public KmlObserverBase
       if(!m_OKToGo) return;
 
 
-      prepareTempDirectory();
+      openKmzArchive();
 
       if(!m_OKToGo) return;
 
 
-      // open and initialize doc.kml file
-      m_KmlFile.open(std::string(m_TmpDir+"/"+m_KmzSubDir+"/doc.kml").c_str());
+      // doc.kml must be the first entry of the kmz file, it is written before the frames
+      // and links to the frames file written at the end of the simulation
+      m_KmlDoc.str("");
 
-      m_KmlFile << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
-      m_KmlFile << "<kml xmlns=\"http://www.opengis.net/kml/2.2\" "
+      m_KmlDoc << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+      m_KmlDoc << "<kml xmlns=\"http://www.opengis.net/kml/2.2\" "
                    "xmlns:gx=\"http://www.google.com/kml/ext/2.2\" "
                    "xmlns:kml=\"http://www.opengis.net/kml/2.2\" xmlns:atom=\"http://www.w3.org/2005/Atom\">\n";
 
-      m_KmlFile << "<Document>\n";
-      m_KmlFile << "  <name>" << m_Title << "</name>\n";
+      m_KmlDoc << "<Document>\n";
+      m_KmlDoc << "  <name>" << m_Title << "</name>\n";
 
       for (std::list<KmlStaticLayerInfo>::iterator it=m_StaticLayersInfo.begin();it!=m_StaticLayersInfo.end();++it)
       {
 
         std::string TmpStyleID = "static_" + (*it).UnitsClass +"_style";
 
-        m_KmlFile << "    <Style id=\"" << TmpStyleID << "\"><LineStyle><color>"<< (*it).Color
+        m_KmlDoc << "    <Style id=\"" << TmpStyleID << "\"><LineStyle><color>"<< (*it).Color
                   << "</color><width>" << (*it).LineWidth
                   << "</width></LineStyle><PolyStyle><fill>0</fill></PolyStyle></Style>\n";
 
-        m_KmlFile << "    <Folder>\n";
-        m_KmlFile << "      <name>" << (*it).UnitsClass << "</name>\n";
+        m_KmlDoc << "    <Folder>\n";
+        m_KmlDoc << "      <name>" << (*it).UnitsClass << "</name>\n";
 
         for (std::map<openfluid::core::UnitID_t,KmlUnitInfo>::iterator it2=(*it).UnitsInfos.begin();
             it2!=(*it).UnitsInfos.end();
             ++it2)
         {
-          m_KmlFile << "    <Placemark>\n";
+          m_KmlDoc << "    <Placemark>\n";
 
 
-          m_KmlFile << "      <name>" << (*it).UnitsClass << " " << (*it2).second.UnitID << "</name>\n";
+          m_KmlDoc << "      <name>" << (*it).UnitsClass << " " << (*it2).second.UnitID << "</name>\n";
 
-          m_KmlFile << "      <description>\n<![CDATA[\n";
-          m_KmlFile << "Unit class: " << (*it).UnitsClass << "<br/>\n";
-          m_KmlFile << "Unit ID: " << (*it2).second.UnitID << "<br/>\n";
-          m_KmlFile << "\n]]>\n      </description>\n";
+          m_KmlDoc << "      <description>\n<![CDATA[\n";
+          m_KmlDoc << "Unit class: " << (*it).UnitsClass << "<br/>\n";
+          m_KmlDoc << "Unit ID: " << (*it2).second.UnitID << "<br/>\n";
+          m_KmlDoc << "\n]]>\n      </description>\n";
 
 
-          m_KmlFile << "      <styleUrl>#" << TmpStyleID << "</styleUrl>\n";
+          m_KmlDoc << "      <styleUrl>#" << TmpStyleID << "</styleUrl>\n";
 
 
           if ((*it2).second.GeometryType == wkbPolygon)
           {
-            m_KmlFile << "<Polygon><tessellate>1</tessellate><outerBoundaryIs><LinearRing><coordinates>"
+            m_KmlDoc << "<Polygon><tessellate>1</tessellate><outerBoundaryIs><LinearRing><coordinates>"
                       << (*it2).second.CoordsStr << "</coordinates></LinearRing></outerBoundaryIs></Polygon>\n";
           }
 
           if ((*it2).second.GeometryType == wkbLineString)
           {
-            m_KmlFile << "<LineString><tessellate>1</tessellate><coordinates>" << (*it2).second.CoordsStr
+            m_KmlDoc << "<LineString><tessellate>1</tessellate><coordinates>" << (*it2).second.CoordsStr
                       << "</coordinates></LineString>\n";
           }
 
 
-          m_KmlFile << "    </Placemark>\n";
+          m_KmlDoc << "    </Placemark>\n";
         }
 
-        m_KmlFile << "    </Folder>\n";
+        m_KmlDoc << "    </Folder>\n";
       }
 
+      m_KmlDoc << "<NetworkLink>\n";
+      m_KmlDoc << "  <name>" << m_AnimLayerInfo.UnitsClass << "</name>\n";
+      m_KmlDoc << "  <Link><href>" << m_KmzDataSubDir << "/" << m_KmlFramesFileName << "</href></Link>\n";
+      m_KmlDoc << "</NetworkLink>\n";
+
+      m_KmlDoc << "</Document>\n";
+      m_KmlDoc << "</kml>\n";
+
+      addToKmzArchive("doc.kml",m_KmlDoc.str());
+
+
+      m_KmlFrames.str("");
+
+      m_KmlFrames << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+      m_KmlFrames << "<kml xmlns=\"http://www.opengis.net/kml/2.2\" "
+                     "xmlns:gx=\"http://www.google.com/kml/ext/2.2\" "
+                     "xmlns:kml=\"http://www.opengis.net/kml/2.2\" xmlns:atom=\"http://www.w3.org/2005/Atom\">\n";
 
+      m_KmlFrames << "<Document>\n";
+      m_KmlFrames << "  <name>" << m_AnimLayerInfo.UnitsClass << "</name>\n";
     }
 
 
@@ -617,12 +639,12 @@ class KmlFilesAnimObserver : public KmlObserverBase
     {
       if(!m_OKToGo) return;
 
-      m_KmlFile << "</Document>\n";
-      m_KmlFile << "</kml>\n";
+      m_KmlFrames << "</Document>\n";
+      m_KmlFrames << "</kml>\n";
 
-      m_KmlFile.close();
+      addToKmzArchive(m_KmzDataSubDir+"/"+m_KmlFramesFileName,m_KmlFrames.str());
 
-      buildKmzFile();
+      closeKmzArchive();
 
       tryOpenGEarth();
 
@@ -131,8 +131,38 @@ class KmlFilesPlotObserver : public KmlObserverBase
     // =====================================================================
 
 
-    void buildGnuplotImages(std::string WorkDir, std::string DestDir)
+    /**
+      Renders the plots of all units using a single gnuplot process fed through a pipe,
+      then adds the rendered images to the kmz file
+    */
+    void buildGnuplotImages(std::string WorkDir)
     {
+      QProcess GNUPlotProcess;
+
+      // "-" runs gnuplot in interactive mode so that an error on a plot does not stop the next ones
+      GNUPlotProcess.start(m_PlotProgram.getFullProgramPath(),QStringList() << "-");
+
+      if (!GNUPlotProcess.waitForStarted())
+      {
+        OPENFLUID_LogWarning("Cannot start GNUplot program");
+        return;
+      }
+
+      std::ostringstream CommonScript;
+      CommonScript << "set terminal png size 640,480 small\n";
+      CommonScript << "set nokey\n";
+      CommonScript << "set xdata time\n";
+      CommonScript << "set timefmt \"%Y%m%d-%H%M%S\"\n";
+      CommonScript << "set datafile separator \";\"\n";
+      CommonScript << "set datafile commentschars \"#\"\n";
+      CommonScript << "set format x \"%Y-%m-%d\\n%H:%M:%S\"\n";
+      CommonScript << "set xtics " << m_PlotXTics << " font \",7\"\n";
+      CommonScript << "set ytics autofreq font \",7\"\n";
+      CommonScript << "set origin 0,0\n";
+
+      GNUPlotProcess.write(CommonScript.str().c_str());
+
+
       for (std::list<KmlSerieInfo>::iterator it=m_KmlSeriesInfos.begin();it!=m_KmlSeriesInfos.end();++it)
       {
         for (std::map<openfluid::core::UnitID_t,KmlUnitInfoExtra>::iterator it2=(*it).UnitsInfos.begin();
@@ -142,10 +172,9 @@ class KmlFilesPlotObserver : public KmlObserverBase
 
           if ((*it2).second.IsPlotted)
           {
-            std::string ScriptFilename = WorkDir+"/tmpscript.gp";
             std::string DataFilename = buildFilePath(WorkDir,(*it).UnitsClass,
                                                      (*it2).second.UnitID,(*it).GroupName,"dat");
-            std::string OutputFilename = buildFilePath(DestDir,(*it).UnitsClass,
+            std::string OutputFilename = buildFilePath(WorkDir,(*it).UnitsClass,
                                                        (*it2).second.UnitID,(*it).GroupName,"png");
 
 
@@ -159,48 +188,44 @@ class KmlFilesPlotObserver : public KmlObserverBase
             }
 
 
-            std::ofstream ScriptFile(ScriptFilename.c_str());
-            ScriptFile << "set terminal png size 640,480 small\n";
-            ScriptFile << "set output \"" << OutputFilename << "\"\n";
-            ScriptFile << "set nokey\n";
-            ScriptFile << "set xdata time\n";
-            ScriptFile << "set timefmt \"%Y%m%d-%H%M%S\"\n";
-            ScriptFile << "set datafile separator \";\"\n";
-            ScriptFile << "set datafile commentschars \"#\"\n";
-            ScriptFile << "set format x \"%Y-%m-%d\\n%H:%M:%S\"\n";
-            ScriptFile << "set xtics " << m_PlotXTics << " font \",7\"\n";
-            ScriptFile << "set ytics autofreq font \",7\"\n";
-
-            ScriptFile << "set origin 0,0\n";
-            ScriptFile << "set multiplot layout " << Rows << "," << Columns << " rowsfirst scale 1,1\n";
+            std::ostringstream Script;
+            Script << "set output \"" << OutputFilename << "\"\n";
+            Script << "set multiplot layout " << Rows << "," << Columns << " rowsfirst scale 1,1\n";
 
             for (unsigned int i=0; i< (*it).VarsList.size();i++)
             {
-              ScriptFile << "set title \"" << (*it).VarsList[i] << "\" font \",9\"\n";
-              ScriptFile << "plot \""<< DataFilename << "\" using 1:"<< (i+2) <<" with lines\n";
+              Script << "set title \"" << (*it).VarsList[i] << "\" font \",9\"\n";
+              Script << "plot \""<< DataFilename << "\" using 1:"<< (i+2) <<" with lines\n";
             }
 
-            ScriptFile << "unset multiplot\n";
-
-    //        ScriptFile << "set title \"" << (*it).VarName << "\" font \",9\"\n";
-    //        ScriptFile << "plot \""<< DataFilename << "\" using 1:2 with lines\n";
-            ScriptFile.close();
+            Script << "unset multiplot\n";
 
+            GNUPlotProcess.write(Script.str().c_str());
+            GNUPlotProcess.waitForBytesWritten(-1);
+          }
+        }
+      }
 
-            // execution of the script
+      // closing the last output and quitting gnuplot
+      GNUPlotProcess.write("unset output\nquit\n");
+      GNUPlotProcess.closeWriteChannel();
+      GNUPlotProcess.waitForFinished(-1);
 
-            if (m_PlotProgram.isFound())
-            {
 
-              QString GNUPlotCommand = QString("\"%1\" \"%2\"").arg(m_PlotProgram.getFullProgramPath())
-                                                               .arg(QString::fromStdString(ScriptFilename));
-              QProcess::execute(GNUPlotCommand);
-            }
-
-          }
+      // images are added to the kmz file once all are rendered
+      for (std::list<KmlSerieInfo>::iterator it=m_KmlSeriesInfos.begin();it!=m_KmlSeriesInfos.end();++it)
+      {
+        for (std::map<openfluid::core::UnitID_t,KmlUnitInfoExtra>::iterator it2=(*it).UnitsInfos.begin();
+            it2!=(*it).UnitsInfos.end();
+            ++it2)
+        {
+          if ((*it2).second.IsPlotted)
+            addFileToKmzArchive(buildFilePath(m_KmzDataSubDir,(*it).UnitsClass,
+                                              (*it2).second.UnitID,(*it).GroupName,"png"),
+                                buildFilePath(WorkDir,(*it).UnitsClass,
+                                              (*it2).second.UnitID,(*it).GroupName,"png"));
         }
       }
-
     }
 
 
@@ -208,9 +233,9 @@ class KmlFilesPlotObserver : public KmlObserverBase
     // =====================================================================
 
 
-    void writeKmlFile(const std::string& DocFilePath)
+    void writeKmlFile()
     {
-      std::ofstream KmlFile(DocFilePath.c_str());
+      std::ostringstream KmlFile;
 
       KmlFile << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
       KmlFile << "<kml xmlns=\"http://www.opengis.net/kml/2.2\" "
@@ -307,7 +332,8 @@ class KmlFilesPlotObserver : public KmlObserverBase
 
       KmlFile << "</Document>\n";
       KmlFile << "</kml>\n";
-      KmlFile.close();
+
+      addToKmzArchive("doc.kml",KmlFile.str());
     }
 
 
@@ -435,7 +461,6 @@ class KmlFilesPlotObserver : public KmlObserverBase
 
       m_OKToGo = true;
 
-      m_KmzSubDir = m_OutputFileName + "_kmz-dir";
       m_GNUPlotSubDir = m_OutputFileName + "_gnuplot-dir";
     }
 
@@ -624,12 +649,15 @@ class KmlFilesPlotObserver : public KmlObserverBase
       }
 
 
-      buildGnuplotImages(m_TmpDir+"/"+m_GNUPlotSubDir,m_TmpDir+"/"+m_KmzSubDir+"/"+m_KmzDataSubDir);
+      openKmzArchive();
+
+      if (!m_OKToGo) return;
 
+      writeKmlFile();
 
-      writeKmlFile(m_TmpDir+"/"+m_KmzSubDir+"/doc.kml");
+      buildGnuplotImages(m_TmpDir+"/"+m_GNUPlotSubDir);
 
-      buildKmzFile();
+      closeKmzArchive();
 
       tryOpenGEarth();
 
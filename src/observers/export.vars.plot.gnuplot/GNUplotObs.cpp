@@ -234,7 +234,9 @@ class GNUplotObserver : public openfluid::ware::PluggableObserver
         {
           openfluid::core::SpatialUnit* TmpU;
           TmpU = mp_SpatialData->spatialUnit(SInfo.UnitsClass,SInfo.UnitID);
-          if (TmpU != NULL)
+
+          // halo units of a partitioned domain are plotted by the part owning them
+          if (TmpU != NULL && !TmpU->isHalo())
           {
             SInfo.Type = SerieInfo::SERIE_VAR;
             SInfo.Unit = TmpU;
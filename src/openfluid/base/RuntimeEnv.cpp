@@ -66,7 +66,8 @@ RuntimeEnvironment::RuntimeEnvironment() :
   m_InstallPrefix(openfluid::config::INSTALL_PREFIX),
   m_Arch(OPENFLUID_OS_STRLABEL),
   m_SimulatorsMaxNumThreads(openfluid::config::SIMULATORS_MAXNUMTHREADS),
-  m_Profiling(false), m_IsLinkedToProject(false)
+  m_Profiling(false), m_PipelinedMonitoring(false), m_TrustedMode(false), m_UnitsReordering(false),
+  m_IsLinkedToProject(false)
 {
 
   char *INSTALLEnvVar;
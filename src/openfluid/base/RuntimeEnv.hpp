@@ -113,6 +113,12 @@ class OPENFLUID_API RuntimeEnvironment
 
     bool m_Profiling;
 
+    bool m_PipelinedMonitoring;
+
+    bool m_TrustedMode;
+
+    bool m_UnitsReordering;
+
     unsigned int m_ValuesBufferSize;
 
     bool m_IsUserValuesBufferSize;
@@ -517,6 +523,36 @@ class OPENFLUID_API RuntimeEnvironment
     void setSimulationProfilingEnabled(bool Profiling)
     { m_Profiling = Profiling; };
 
+    /**
+      Returns true if observers are run in pipelined mode, i.e. in a separate thread
+      processing the step t while the simulators compute the step t+1
+    */
+    bool isPipelinedMonitoringEnabled() const
+    { return m_PipelinedMonitoring; };
+
+    void setPipelinedMonitoringEnabled(bool Pipelined)
+    { m_PipelinedMonitoring = Pipelined; };
+
+    /**
+      Returns true if wares are run in trusted mode, i.e. without validation of each primitive call
+      in release builds. The simulation stage is then checked once per ware call by the engine.
+    */
+    bool isTrustedModeEnabled() const
+    { return m_TrustedMode; };
+
+    void setTrustedModeEnabled(bool Trusted)
+    { m_TrustedMode = Trusted; };
+
+    /**
+      Returns true if spatial units are reordered at domain build time to place connected units
+      close to each other, for units sharing the same process order
+    */
+    bool isUnitsReorderingEnabled() const
+    { return m_UnitsReordering; };
+
+    void setUnitsReorderingEnabled(bool Reordering)
+    { m_UnitsReordering = Reordering; };
+
     void processWareParams(openfluid::ware::WareParams_t& Params) const;
 };
 
@@ -69,7 +69,7 @@ SimulationLogger::~SimulationLogger()
 
 void SimulationLogger::add(LogType LType, const std::string& ContextStr, const std::string& Msg)
 {
-  if (LType == LOG_WARNING)
+  if (LType == LOG_WARNING && isLogTypeEnabled(LType))
     m_CurrentWarningFlag = true;
 
   FileLogger::add(LType,ContextStr,Msg);
@@ -42,6 +42,8 @@
 #define __OPENFLUID_BASE_SIMULATIONLOGGER_HPP__
 
 
+#include <atomic>
+
 #include <openfluid/dllexport.hpp>
 #include <openfluid/core/TypeDefs.hpp>
 #include <openfluid/core/DateTime.hpp>
@@ -61,7 +63,7 @@ class OPENFLUID_API SimulationLogger : public openfluid::tools::FileLogger
 
   private:
 
-    bool m_CurrentWarningFlag;
+    std::atomic<bool> m_CurrentWarningFlag;
 
 
   public:
@@ -60,6 +60,7 @@
 #include <openfluid/core/UnitsCollection.hpp>
 #include <openfluid/core/ValuesBuffer.hpp>
 #include <openfluid/core/Variables.hpp>
+#include <openfluid/core/VariablesChangesLog.hpp>
 #include <openfluid/core/Vector.hpp>
 #include <openfluid/core/TreeValue.hpp>
 
@@ -0,0 +1,289 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+/**
+  @file ArrayOperations.hpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@supagro.inra.fr>
+*/
+
+
+#ifndef __OPENFLUID_CORE_ARRAYOPERATIONS_HPP__
+#define __OPENFLUID_CORE_ARRAYOPERATIONS_HPP__
+
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+
+namespace openfluid { namespace core {
+
+
+/**
+  Alignment in bytes of the contiguous data arrays of vectors and matrices.
+  It matches a cache line and the widest SIMD registers, so that elementwise loops can be vectorized
+  using aligned loads and stores.
+*/
+constexpr std::size_t ArrayAlignment = 64;
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Allocates an array of Size default-initialized elements, aligned on openfluid::core::ArrayAlignment
+  @param[in] Size the number of elements
+  @return a pointer to the first element, or nullptr if Size is 0
+  @throw std::bad_alloc if the memory cannot be allocated
+*/
+template<typename T>
+T* allocateAlignedArray(std::size_t Size)
+{
+  if (Size == 0)
+    return nullptr;
+
+  // the address of the raw block is stored just before the aligned data, in order to free it
+  void* RawPtr = ::operator new(Size*sizeof(T) + ArrayAlignment + sizeof(void*));
+
+  std::uintptr_t DataAddr = reinterpret_cast<std::uintptr_t>(RawPtr) + sizeof(void*);
+  DataAddr = (DataAddr + ArrayAlignment - 1) & ~(static_cast<std::uintptr_t>(ArrayAlignment) - 1);
+
+  reinterpret_cast<void**>(DataAddr)[-1] = RawPtr;
+
+  T* Data = reinterpret_cast<T*>(DataAddr);
+
+  for (std::size_t i=0; i<Size; i++)
+    new (Data+i) T;
+
+  return Data;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Destroys and frees an array allocated using openfluid::core::allocateAlignedArray()
+  @param[in] Data the pointer to the first element, can be nullptr
+  @param[in] Size the number of elements
+*/
+template<typename T>
+void freeAlignedArray(T* Data, std::size_t Size)
+{
+  if (Data == nullptr)
+    return;
+
+  for (std::size_t i=0; i<Size; i++)
+    Data[i].~T();
+
+  ::operator delete(reinterpret_cast<void**>(Data)[-1]);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Returns the sum of the Size elements of Data.
+  Four independent partial sums are used to break the dependency chain of the additions,
+  which allows the loop to be vectorized without relaxing floating point semantics.
+*/
+template<typename T>
+T sumOfArray(const T* Data, std::size_t Size)
+{
+  T S0 = T(0), S1 = T(0), S2 = T(0), S3 = T(0);
+  std::size_t i = 0;
+
+  for (; i+4<=Size; i+=4)
+  {
+    S0 += Data[i];
+    S1 += Data[i+1];
+    S2 += Data[i+2];
+    S3 += Data[i+3];
+  }
+
+  for (; i<Size; i++)
+    S0 += Data[i];
+
+  return (S0+S1)+(S2+S3);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Returns the dot product of the Size elements of X and Y
+*/
+template<typename T>
+T dotOfArrays(const T* X, const T* Y, std::size_t Size)
+{
+  T S0 = T(0), S1 = T(0), S2 = T(0), S3 = T(0);
+  std::size_t i = 0;
+
+  for (; i+4<=Size; i+=4)
+  {
+    S0 += X[i]*Y[i];
+    S1 += X[i+1]*Y[i+1];
+    S2 += X[i+2]*Y[i+2];
+    S3 += X[i+3]*Y[i+3];
+  }
+
+  for (; i<Size; i++)
+    S0 += X[i]*Y[i];
+
+  return (S0+S1)+(S2+S3);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Returns the minimum of the Size elements of Data, Size must be greater than 0
+*/
+template<typename T>
+T minOfArray(const T* Data, std::size_t Size)
+{
+  T Min = Data[0];
+
+  for (std::size_t i=1; i<Size; i++)
+    Min = (Data[i] < Min ? Data[i] : Min);
+
+  return Min;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Returns the maximum of the Size elements of Data, Size must be greater than 0
+*/
+template<typename T>
+T maxOfArray(const T* Data, std::size_t Size)
+{
+  T Max = Data[0];
+
+  for (std::size_t i=1; i<Size; i++)
+    Max = (Data[i] > Max ? Data[i] : Max);
+
+  return Max;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Computes Y = A*X + Y on the Size elements of X and Y
+*/
+template<typename T>
+void axpyOfArrays(const T& A, const T* X, T* Y, std::size_t Size)
+{
+  for (std::size_t i=0; i<Size; i++)
+    Y[i] += A*X[i];
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Computes Y = Y + X on the Size elements of X and Y
+*/
+template<typename T>
+void addArrays(const T* X, T* Y, std::size_t Size)
+{
+  for (std::size_t i=0; i<Size; i++)
+    Y[i] += X[i];
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Computes Y = Y - X on the Size elements of X and Y
+*/
+template<typename T>
+void subtractArrays(const T* X, T* Y, std::size_t Size)
+{
+  for (std::size_t i=0; i<Size; i++)
+    Y[i] -= X[i];
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Computes Y = Y * X (elementwise) on the Size elements of X and Y
+*/
+template<typename T>
+void multiplyArrays(const T* X, T* Y, std::size_t Size)
+{
+  for (std::size_t i=0; i<Size; i++)
+    Y[i] *= X[i];
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Computes Y = A * Y on the Size elements of Y
+*/
+template<typename T>
+void scaleArray(const T& A, T* Y, std::size_t Size)
+{
+  for (std::size_t i=0; i<Size; i++)
+    Y[i] *= A;
+}
+
+
+} }  // namespaces
+
+
+#endif /* __OPENFLUID_CORE_ARRAYOPERATIONS_HPP__ */
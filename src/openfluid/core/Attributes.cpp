@@ -77,7 +77,7 @@ bool Attributes::setValue(const AttributeName_t& aName, const Value& aValue)
   if (isAttributeExist(aName))
     return false;
 
-  m_Data[aName].reset(aValue.clone());
+  m_Data[aName].set(aValue);
 
   return true;
 }
@@ -92,7 +92,7 @@ bool Attributes::setValue(const AttributeName_t& aName, const std::string& aValu
   if (isAttributeExist(aName))
     return false;
 
-  m_Data[aName].reset(new StringValue(aValue));
+  m_Data[aName].set(StringValue(aValue));
 
   return true;
 }
@@ -116,7 +116,7 @@ bool Attributes::setValueFromRawString(const AttributeName_t& aName, const std::
       double TmpVal;
       if (!TmpStrValue.toDouble(TmpVal))
         return false;
-      m_Data[aName].reset(new DoubleValue(TmpVal));
+      m_Data[aName].set(DoubleValue(TmpVal));
       break;
     }
 
@@ -126,7 +126,7 @@ bool Attributes::setValueFromRawString(const AttributeName_t& aName, const std::
       long TmpVal;
       if (!TmpStrValue.toInteger(TmpVal))
         return false;
-      m_Data[aName].reset(new IntegerValue(TmpVal));
+      m_Data[aName].set(IntegerValue(TmpVal));
       break;
     }
 
@@ -135,13 +135,13 @@ bool Attributes::setValueFromRawString(const AttributeName_t& aName, const std::
       bool TmpVal;
       if (!TmpStrValue.toBoolean(TmpVal))
         return false;
-      m_Data[aName].reset(new BooleanValue(TmpVal));
+      m_Data[aName].set(BooleanValue(TmpVal));
       break;
     }
 
     case Value::STRING :
     {
-      m_Data[aName].reset(new StringValue(aValue));
+      m_Data[aName].set(StringValue(aValue));
       break;
     }
 
@@ -150,7 +150,7 @@ bool Attributes::setValueFromRawString(const AttributeName_t& aName, const std::
       VectorValue TmpVal;
       if (!TmpStrValue.toVectorValue(TmpVal))
         return false;
-      m_Data[aName].reset(TmpVal.clone());
+      m_Data[aName].set(TmpVal);
       break;
     }
 
@@ -159,7 +159,7 @@ bool Attributes::setValueFromRawString(const AttributeName_t& aName, const std::
       MatrixValue TmpVal;
       if (!TmpStrValue.toMatrixValue(TmpVal))
         return false;
-      m_Data[aName].reset(TmpVal.clone());
+      m_Data[aName].set(TmpVal);
       break;
     }
 
@@ -168,7 +168,7 @@ bool Attributes::setValueFromRawString(const AttributeName_t& aName, const std::
       MapValue TmpVal;
       if (!TmpStrValue.toMapValue(TmpVal))
         return false;
-      m_Data[aName].reset(TmpVal.clone());
+      m_Data[aName].set(TmpVal);
       break;
     }
 
@@ -177,7 +177,7 @@ bool Attributes::setValueFromRawString(const AttributeName_t& aName, const std::
       TreeValue TmpVal;
       if (!TmpStrValue.toTreeValue(TmpVal))
         return false;
-      m_Data[aName].reset(TmpVal.clone());
+      m_Data[aName].set(TmpVal);
       break;
     }
 
@@ -186,7 +186,7 @@ bool Attributes::setValueFromRawString(const AttributeName_t& aName, const std::
       NullValue TmpVal;
       if (!TmpStrValue.toNullValue(TmpVal))
         return false;
-      m_Data[aName].reset(TmpVal.clone());
+      m_Data[aName].set(TmpVal);
       break;
     }
 
@@ -321,7 +321,7 @@ bool Attributes::replaceValue(const AttributeName_t& aName, const StringValue& a
 {
   if(isAttributeExist(aName))
   {
-    m_Data[aName].reset(new StringValue(aValue));
+    m_Data[aName].set(StringValue(aValue));
 
     return true;
   }
@@ -338,7 +338,7 @@ bool Attributes::replaceValue(const AttributeName_t& aName, const std::string& a
 {
   if(isAttributeExist(aName))
   {
-    m_Data[aName].reset(new StringValue(aValue));
+    m_Data[aName].set(StringValue(aValue));
 
     return true;
   }
@@ -49,6 +49,7 @@
 #include <openfluid/core/Value.hpp>
 #include <openfluid/core/StringValue.hpp>
 #include <openfluid/core/IntegerValue.hpp>
+#include <openfluid/core/ValueStorage.hpp>
 
 
 namespace openfluid { namespace core {
@@ -58,7 +59,7 @@ class OPENFLUID_API Attributes
 {
   private:
 
-    typedef std::map<AttributeName_t,std::shared_ptr<Value>> AttributesMap_t;
+    typedef std::map<AttributeName_t,ValueStorage> AttributesMap_t;
 
     AttributesMap_t m_Data;
 
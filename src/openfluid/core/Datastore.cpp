@@ -38,6 +38,7 @@
 #include "Datastore.hpp"
 
 #include <openfluid/core/DatastoreItem.hpp>
+#include <openfluid/core/GeoValue.hpp>
 
 namespace openfluid {
 namespace core {
@@ -108,7 +109,14 @@ void Datastore::addItem(const DatastoreItem* Item)
   if (it != m_ItemsById.end())
     delete it->second;
 
-  m_ItemsById[Item->getID()] = const_cast<DatastoreItem*>(Item);
+  DatastoreItem* StoredItem = const_cast<DatastoreItem*>(Item);
+
+  GeoValue* GeoData = dynamic_cast<GeoValue*>(StoredItem->value());
+
+  if (GeoData)
+    GeoData->setDatasetsCache(&m_DatasetsCache);
+
+  m_ItemsById[Item->getID()] = StoredItem;
 }
 
 
@@ -41,6 +41,7 @@
 #include <map>
 #include <string>
 #include <openfluid/dllexport.hpp>
+#include <openfluid/core/GeoDatasetsCache.hpp>
 
 
 namespace openfluid { namespace core {
@@ -65,6 +66,8 @@ class OPENFLUID_API Datastore
 
     DataItemsById_t m_ItemsById;
 
+    GeoDatasetsCache m_DatasetsCache;
+
   public:
 
     /**
@@ -99,10 +102,20 @@ class OPENFLUID_API Datastore
     /**
      Adds an item to the datastore.
      If an item already exists with the ID of the given <tt>Item</tt>,it is deleted before adding.
+     Geospatial items are then opened through the datasets cache of the datastore.
 
      @param[in] Item The item to add.
     */
     void addItem(const DatastoreItem* Item);
+
+    /**
+      Gets the cache of geospatial datasets used by the items of the datastore.
+      Geospatial items are opened lazily through this cache on their first access,
+      so that items that are never used are never opened.
+      @return The datasets cache owned by the datastore
+    */
+    GeoDatasetsCache* datasetsCache()
+    { return &m_DatasetsCache; }
 };
 
 } } // namespaces
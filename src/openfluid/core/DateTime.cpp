@@ -39,12 +39,13 @@
 
 
 #include <openfluid/core/DateTime.hpp>
+#include <openfluid/core/DateTimeParser.hpp>
 
 #include <iostream>
 #include <sstream>
 #include <iomanip>
-
-#include <boost/date_time/posix_time/posix_time.hpp>
+#include <cstdio>
+#include <cstring>
 
 
 namespace openfluid { namespace core {
@@ -139,27 +140,7 @@ bool DateTime::setFromISOString(const std::string& DateTimeStr)
 
 bool DateTime::setFromString(const std::string& DateTimeStr, const std::string& FormatStr)
 {
-  // TODO Should be replaced by C++11 features when available. Example:
-  /*
-  std::tm CTime;
-  std::istringstream StrS(DateTimeStr);
-  StrS.imbue(std::locale(std::locale::classic()));
-  StrS >> std::get_time(&CTime,FormatStr.c_str());
-
-  return (set(CTime.tm_year+1900, CTime.tm_mon+1,CTime.tm_mday,
-              CTime.tm_hour,CTime.tm_min,CTime.tm_sec));
-  */
-
-  boost::posix_time::time_input_facet* Facet = new  boost::posix_time::time_input_facet(FormatStr);
-
-  std::istringstream StrS(DateTimeStr);
-  StrS.imbue(std::locale(std::locale::classic(),Facet));
-  boost::posix_time::ptime Time(boost::posix_time::not_a_date_time);
-  StrS >> Time;
-
-  return (Time != boost::posix_time::not_a_date_time &&
-          set(Time.date().year(), Time.date().month(),Time.date().day(),Time.time_of_day().hours(),
-              Time.time_of_day().minutes(), Time.time_of_day().seconds()));
+  return DateTimeParser(FormatStr).parse(DateTimeStr,*this);
 }
 
 
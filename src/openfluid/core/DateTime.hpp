@@ -203,6 +203,7 @@ class OPENFLUID_API DateTime
 
     /**
       Sets the date and time from a string using the given format
+      @see openfluid::core::DateTimeParser for repeated parsing using the same format
     */
     bool setFromString(const std::string& DateTimeStr, const std::string& FormatStr);
 
@@ -0,0 +1,187 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+
+/**
+  @file DateTimeParser.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@supagro.inra.fr>
+ */
+
+
+#include <sstream>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <openfluid/core/DateTimeParser.hpp>
+
+
+namespace openfluid { namespace core {
+
+
+inline bool isSpaceChar(char C)
+{
+  return (C == ' ' || C == '\t' || C == '\r' || C == '\n' || C == '\v' || C == '\f');
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+DateTimeParser::DateTimeParser(const std::string& FormatStr) :
+  m_FormatStr(FormatStr), m_IsCompiled(false)
+{
+  bool HasYear = false;
+  bool HasMonth = false;
+  bool HasDay = false;
+
+  for (std::string::size_type i = 0; i < FormatStr.size(); i++)
+  {
+    char C = FormatStr[i];
+
+    if (C == '%')
+    {
+      i++;
+      if (i == FormatStr.size())
+        return;
+
+      switch (FormatStr[i])
+      {
+        case 'Y' : m_Items.push_back(FormatItem(YEAR)); HasYear = true; break;
+        case 'm' : m_Items.push_back(FormatItem(MONTH)); HasMonth = true; break;
+        case 'd' : m_Items.push_back(FormatItem(DAY)); HasDay = true; break;
+        case 'H' : m_Items.push_back(FormatItem(HOUR)); break;
+        case 'M' : m_Items.push_back(FormatItem(MINUTE)); break;
+        case 'S' : m_Items.push_back(FormatItem(SECOND)); break;
+        case '%' : m_Items.push_back(FormatItem(LITERAL,'%')); break;
+        default : m_Items.clear(); return; // not compilable directive
+      }
+    }
+    else if (isSpaceChar(C))
+      m_Items.push_back(FormatItem(SPACE));
+    else
+      m_Items.push_back(FormatItem(LITERAL,C));
+  }
+
+  m_IsCompiled = (HasYear && HasMonth && HasDay);
+
+  if (!m_IsCompiled)
+    m_Items.clear();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool DateTimeParser::parseWithFacet(const std::string& DateTimeStr, DateTime& DT) const
+{
+  boost::posix_time::time_input_facet* Facet = new  boost::posix_time::time_input_facet(m_FormatStr);
+
+  std::istringstream StrS(DateTimeStr);
+  StrS.imbue(std::locale(std::locale::classic(),Facet));
+  boost::posix_time::ptime Time(boost::posix_time::not_a_date_time);
+  StrS >> Time;
+
+  return (Time != boost::posix_time::not_a_date_time &&
+          DT.set(Time.date().year(), Time.date().month(),Time.date().day(),Time.time_of_day().hours(),
+                 Time.time_of_day().minutes(), Time.time_of_day().seconds()));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool DateTimeParser::parse(const char* Begin, const char* End, DateTime& DT) const
+{
+  if (m_IsCompiled && parseCompiled(Begin,End,DT))
+    return true;
+
+  // inputs not strictly matching the compiled format are parsed using the facet rules
+  return parseWithFacet(std::string(Begin,End),DT);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool DateTimeParser::parseCompiled(const char* Begin, const char* End, DateTime& DT) const
+{
+  int Fields[8] = {0,0,0,0,0,0,0,0};
+  const char* Current = Begin;
+
+  for (const FormatItem& Item : m_Items)
+  {
+    if (Item.Type == LITERAL)
+    {
+      if (Current == End || *Current != Item.Literal)
+        return false;
+      ++Current;
+    }
+    else if (Item.Type == SPACE)
+    {
+      if (Current == End || !isSpaceChar(*Current))
+        return false;
+      ++Current;
+    }
+    else
+    {
+      // numeric field, 4 digits for year, 2 digits for others
+      const unsigned int Digits = (Item.Type == YEAR ? 4 : 2);
+      int Value = 0;
+
+      for (unsigned int i = 0; i < Digits; i++)
+      {
+        if (Current == End || *Current < '0' || *Current > '9')
+          return false;
+
+        Value = Value*10 + (*Current - '0');
+        ++Current;
+      }
+
+      Fields[Item.Type] = Value;
+    }
+  }
+
+  // years out of the range of the boost::gregorian calendar are left to the facet
+  if (Current != End || Fields[YEAR] < 1400)
+    return false;
+
+  return DT.set(Fields[YEAR],Fields[MONTH],Fields[DAY],Fields[HOUR],Fields[MINUTE],Fields[SECOND]);
+}
+
+
+} }  // namespaces
+
@@ -0,0 +1,157 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+/**
+  @file DateTimeParser.hpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@supagro.inra.fr>
+ */
+
+
+#ifndef __OPENFLUID_CORE_DATETIMEPARSER_HPP__
+#define __OPENFLUID_CORE_DATETIMEPARSER_HPP__
+
+
+#include <string>
+#include <vector>
+
+#include <openfluid/core/DateTime.hpp>
+#include <openfluid/dllexport.hpp>
+
+
+namespace openfluid { namespace core {
+
+/**
+  @brief Parser for date-time strings using a given format, compiled once at construction.
+
+  Parsing results are the ones of the boost::posix_time input facet. The format string is analysed once,
+  then each call to parse() extracts the fields of well-formed inputs directly from the input characters,
+  without any memory allocation. The following directives are compiled:
+  @li %Y : year (4 digits)
+  @li %m : month [01-12] (2 digits)
+  @li %d : day of month [01-31] (2 digits)
+  @li %H : hour [00-23] (2 digits)
+  @li %M : minute [00-59] (2 digits)
+  @li %S : second [00-59] (2 digits)
+  @li %% : the % character
+
+  Each whitespace in the format matches exactly one whitespace in the input string,
+  other characters must match exactly, and the whole input must be consumed.
+  Inputs that do not strictly match a compiled format, and all inputs of formats using other directives
+  or not including the %Y, %m and %d directives, are parsed by the boost::posix_time input facet.
+  The facet is more tolerant: it ignores characters remaining after the end of the format
+  and accepts inputs ending before the time fields, which are then set to 0.
+
+  <I>Example</I>
+  @code
+  openfluid::core::DateTimeParser Parser("%Y-%m-%dT%H:%M:%S");
+  openfluid::core::DateTime DT;
+
+  if (Parser.parse("2013-08-06T17:37:53",DT))
+    std::cout << DT.getAsISOString() << std::endl;
+  @endcode
+*/
+class OPENFLUID_API DateTimeParser
+{
+  private:
+
+    enum FieldType { LITERAL, SPACE, YEAR, MONTH, DAY, HOUR, MINUTE, SECOND };
+
+    struct FormatItem
+    {
+      FieldType Type;
+
+      char Literal;
+
+      FormatItem(FieldType T, char L = 0) : Type(T), Literal(L)
+      { }
+    };
+
+    std::string m_FormatStr;
+
+    std::vector<FormatItem> m_Items;
+
+    bool m_IsCompiled;
+
+    bool parseCompiled(const char* Begin, const char* End, DateTime& DT) const;
+
+    bool parseWithFacet(const std::string& DateTimeStr, DateTime& DT) const;
+
+
+  public:
+
+    /**
+      Constructor
+      @param[in] FormatStr the format of the date-time strings to parse
+    */
+    DateTimeParser(const std::string& FormatStr);
+
+    /**
+      Returns the format of the date-time strings parsed by this parser
+    */
+    const std::string& getFormat() const
+    { return m_FormatStr; }
+
+    /**
+      Returns true if the format has been compiled for allocation-free parsing of well-formed inputs,
+      false if parsing is always delegated to the boost::posix_time input facet
+    */
+    bool isCompiled() const
+    { return m_IsCompiled; }
+
+    /**
+      Parses the characters in the given range and sets the date-time if parsing succeeded,
+      following the rules of the boost::posix_time input facet.
+      @param[in] Begin pointer to the first character to parse
+      @param[in] End pointer after the last character to parse
+      @param[out] DT the date-time to set, unchanged if parsing failed
+      @return true if the input matches the format and the date-time is valid, false otherwise
+    */
+    bool parse(const char* Begin, const char* End, DateTime& DT) const;
+
+    /**
+      Parses the given string and sets the date-time if parsing succeeded,
+      following the rules of the boost::posix_time input facet.
+      @param[in] DateTimeStr the string to parse
+      @param[out] DT the date-time to set, unchanged if parsing failed
+      @return true if the input matches the format and the date-time is valid, false otherwise
+    */
+    bool parse(const std::string& DateTimeStr, DateTime& DT) const
+    { return parse(DateTimeStr.data(),DateTimeStr.data()+DateTimeStr.size(),DT); }
+
+};
+
+
+} }  // namespaces
+
+
+#endif /* __OPENFLUID_CORE_DATETIMEPARSER_HPP__ */
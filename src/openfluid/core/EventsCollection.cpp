@@ -38,12 +38,30 @@
 */
 
 #include <openfluid/core/EventsCollection.hpp>
+#include <openfluid/core/ValuesBufferProperties.hpp>
 #include <iostream>
+#include <mutex>
 
 namespace openfluid { namespace core
 {
 
 
+/**
+  Mutex shared by all events collections, used while observers run concurrently with simulators.
+  A single mutex is enough since events are rarely added during simulations
+*/
+static std::mutex EventsMutex;
+
+
+static std::unique_lock<std::mutex> lockEvents()
+{
+  if (ValuesBufferProperties::isConcurrentAccess())
+    return std::unique_lock<std::mutex>(EventsMutex);
+
+  return std::unique_lock<std::mutex>();
+}
+
+
 
 EventsCollection::EventsCollection()
 {
@@ -75,6 +93,8 @@ bool EventsCollection::addEvent(const Event* Ev)
 
 bool EventsCollection::addEvent(const Event& Ev)
 {
+  std::unique_lock<std::mutex> Lock = lockEvents();
+
   // empty list
   if (m_Events.empty())
   {
@@ -134,17 +154,25 @@ bool EventsCollection::getEventsBetween(const DateTime& BeginDate, const DateTim
 bool EventsCollection::getEventsBetween(const DateTime& BeginDate, const DateTime& EndDate,
     EventsCollection& Events) const
 {
+  EventsList_t Matching;
 
-  EventsList_t::const_iterator DEiter;
-
-  for(DEiter=m_Events.begin(); DEiter != m_Events.end(); ++DEiter)
   {
-    if ((*DEiter).getDateTime().isBetween(BeginDate,EndDate))
+    std::unique_lock<std::mutex> Lock = lockEvents();
+
+    EventsList_t::const_iterator DEiter;
+
+    for(DEiter=m_Events.begin(); DEiter != m_Events.end(); ++DEiter)
     {
-      Events.addEvent(*DEiter);
+      if ((*DEiter).getDateTime().isBetween(BeginDate,EndDate))
+      {
+        Matching.push_back(*DEiter);
+      }
     }
   }
 
+  for (const Event& Ev : Matching)
+    Events.addEvent(Ev);
+
   return true;
 }
 
@@ -102,7 +102,8 @@ class OPENFLUID_API EventsCollection
     bool getEventsBetween(const DateTime& BeginDate, const DateTime& EndDate, EventsCollection& Events) const;
 
     /**
-      Returns the event collection as a list
+      Returns the event collection as a list.
+      Accesses through the returned list are not synchronized with addEvent() and getEventsBetween()
     */
     inline EventsList_t* eventsList()
     { return &m_Events; };
@@ -0,0 +1,280 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+/**
+  @file GeoDatasetsCache.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@supagro.inra.fr>
+*/
+
+
+#include <climits>
+#include <cstdlib>
+
+#include <ogrsf_frmts.h>
+#include <gdal_priv.h>
+
+#include <openfluid/global.hpp>
+#include <openfluid/core/GeoDatasetsCache.hpp>
+#include <openfluid/base/FrameworkException.hpp>
+
+
+namespace openfluid { namespace core {
+
+
+GeoDatasetsCache::GeoDatasetsCache()
+{
+  OGRRegisterAll();
+  GDALAllRegister();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+GeoDatasetsCache::~GeoDatasetsCache()
+{
+  for (auto& Dataset : m_Datasets)
+    closeDataset(Dataset.second);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void GeoDatasetsCache::closeDataset(const CachedDataset& Dataset)
+{
+  if (Dataset.Kind == Vector)
+    OGRDataSource::DestroyDataSource(static_cast<OGRDataSource*>(Dataset.Handle));
+  else
+    GDALClose(static_cast<GDALDatasetH>(Dataset.Handle));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::string GeoDatasetsCache::canonicalPath(const std::string& Path)
+{
+#if defined(OPENFLUID_OS_WINDOWS)
+  char Resolved[_MAX_PATH];
+
+  if (_fullpath(Resolved,Path.c_str(),_MAX_PATH) != NULL)
+    return std::string(Resolved);
+#else
+  char Resolved[PATH_MAX];
+
+  if (realpath(Path.c_str(),Resolved) != NULL)
+    return std::string(Resolved);
+#endif
+
+  // paths which cannot be resolved (GDAL virtual paths, missing files) are kept as given
+  return Path;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void* GeoDatasetsCache::acquire(DatasetKind Kind, const std::string& AbsolutePath, OpenMode Mode)
+{
+  // the same file reached through different paths (relative parts, symbolic links) shares the same dataset
+  DatasetKey_t Key(canonicalPath(AbsolutePath),Mode);
+
+  std::lock_guard<std::mutex> Lock(m_Mutex);
+
+  if (Kind == Vector)
+  {
+    // a released datasource is reused, with the reading cursors of its layers reset
+    auto itIdle = m_IdleVectorHandles.find(Key);
+
+    if (itIdle != m_IdleVectorHandles.end())
+    {
+      OGRDataSource* DataSource = static_cast<OGRDataSource*>(itIdle->second);
+      m_IdleVectorHandles.erase(itIdle);
+
+      for (int i = 0; i < DataSource->GetLayerCount(); i++)
+        DataSource->GetLayer(i)->ResetReading();
+
+      m_Datasets[DataSource].RefCount = 1;
+      return DataSource;
+    }
+  }
+  else
+  {
+    auto itHandle = m_RasterHandles.find(Key);
+
+    if (itHandle != m_RasterHandles.end())
+    {
+      m_Datasets[itHandle->second].RefCount++;
+      return itHandle->second;
+    }
+  }
+
+
+  // not in cache, the dataset is opened while holding the lock
+  // so that concurrent first acquisitions of a raster do not open the same file twice
+  void* Handle = NULL;
+
+  if (Kind == Vector)
+  {
+    Handle = OGRSFDriverRegistrar::Open(AbsolutePath.c_str(),Mode == Update);
+
+    if (!Handle)
+      throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                                "Error while trying to open file " + AbsolutePath);
+  }
+  else
+  {
+    // GDALOpenShared to allow copy then close of this raster in virtual format (see http://www.gdal.org/gdal_vrttut.html)
+    Handle = GDALOpenShared(AbsolutePath.c_str(),(Mode == Update) ? GA_Update : GA_ReadOnly);
+
+    if (!Handle)
+      throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                                "Error while trying to open file " + AbsolutePath +
+                                                " (" + CPLGetLastErrorMsg() + ")");
+  }
+
+  CachedDataset Dataset;
+  Dataset.Handle = Handle;
+  Dataset.Kind = Kind;
+  Dataset.Key = Key;
+  Dataset.RefCount = 1;
+
+  if (Kind == Raster)
+    m_RasterHandles[Key] = Handle;
+  m_Datasets[Handle] = Dataset;
+
+  return Handle;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+OGRDataSource* GeoDatasetsCache::acquireVector(const std::string& AbsolutePath, OpenMode Mode)
+{
+  return static_cast<OGRDataSource*>(acquire(Vector,AbsolutePath,Mode));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+GDALDataset* GeoDatasetsCache::acquireRaster(const std::string& AbsolutePath, OpenMode Mode)
+{
+  return static_cast<GDALDataset*>(acquire(Raster,AbsolutePath,Mode));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void GeoDatasetsCache::release(const void* Handle)
+{
+  std::lock_guard<std::mutex> Lock(m_Mutex);
+
+  auto itDataset = m_Datasets.find(Handle);
+
+  if (itDataset == m_Datasets.end())
+    return;
+
+  CachedDataset& Dataset = itDataset->second;
+
+  if (!Dataset.RefCount)
+    return;
+
+  if (--Dataset.RefCount > 0)
+    return;
+
+  if (Dataset.Kind == Vector)
+  {
+    // kept opened for the next consumer of the same file
+    m_IdleVectorHandles.insert(std::make_pair(Dataset.Key,Dataset.Handle));
+    return;
+  }
+
+  closeDataset(Dataset);
+  m_RasterHandles.erase(Dataset.Key);
+  m_Datasets.erase(itDataset);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool GeoDatasetsCache::isCached(const void* Handle) const
+{
+  std::lock_guard<std::mutex> Lock(m_Mutex);
+
+  return (m_Datasets.find(Handle) != m_Datasets.end());
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+unsigned int GeoDatasetsCache::getReferencesCount(const void* Handle) const
+{
+  std::lock_guard<std::mutex> Lock(m_Mutex);
+
+  auto itDataset = m_Datasets.find(Handle);
+
+  if (itDataset == m_Datasets.end())
+    return 0;
+
+  return itDataset->second.RefCount;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+unsigned int GeoDatasetsCache::getDatasetsCount() const
+{
+  std::lock_guard<std::mutex> Lock(m_Mutex);
+
+  return m_Datasets.size();
+}
+
+
+} }  // namespaces
@@ -0,0 +1,169 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+/**
+  @file GeoDatasetsCache.hpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@supagro.inra.fr>
+*/
+
+
+#ifndef __OPENFLUID_CORE_GEODATASETSCACHE_HPP__
+#define __OPENFLUID_CORE_GEODATASETSCACHE_HPP__
+
+#include <map>
+#include <mutex>
+#include <string>
+
+#include <openfluid/dllexport.hpp>
+
+
+class OGRDataSource;
+class GDALDataset;
+
+
+namespace openfluid { namespace core {
+
+/**
+  Cache of opened GDAL/OGR datasets, owned by a openfluid::core::Datastore and used by its geospatial items.
+  Datasets are keyed by their canonical path and open mode, and are opened on first acquisition.
+  @li GDAL raster datasets are shared and reference-counted: a raster dataset is closed
+  when its last reference is released.
+  @li As OGR layers keep their own reading cursor, an OGR datasource is never shared between consumers:
+  each acquisition gets a datasource of its own, so that nested or concurrent features loops
+  do not interfere. Released datasources are kept opened and reused by the next acquisitions
+  of the same file and mode, until the cache is destroyed.
+
+  Acquisitions and releases are thread-safe.
+*/
+class OPENFLUID_API GeoDatasetsCache
+{
+  public:
+
+    enum OpenMode { ReadOnly, Update };
+
+
+  private:
+
+    enum DatasetKind { Vector, Raster };
+
+    typedef std::pair<std::string,OpenMode> DatasetKey_t;
+
+    struct CachedDataset
+    {
+      void* Handle;
+
+      DatasetKind Kind;
+
+      DatasetKey_t Key;
+
+      unsigned int RefCount;
+    };
+
+    std::multimap<DatasetKey_t,void*> m_IdleVectorHandles;
+
+    std::map<DatasetKey_t,void*> m_RasterHandles;
+
+    std::map<const void*,CachedDataset> m_Datasets;
+
+    mutable std::mutex m_Mutex;
+
+    void* acquire(DatasetKind Kind, const std::string& AbsolutePath, OpenMode Mode);
+
+    static void closeDataset(const CachedDataset& Dataset);
+
+    static std::string canonicalPath(const std::string& Path);
+
+
+  public:
+
+    GeoDatasetsCache();
+
+    /**
+      Destroys the cache and closes all the datasets it manages
+    */
+    ~GeoDatasetsCache();
+
+    GeoDatasetsCache(const GeoDatasetsCache&) = delete;
+
+    GeoDatasetsCache& operator=(const GeoDatasetsCache&) = delete;
+
+    /**
+      Acquires an OGR datasource for the given path and mode, reusing a released one if any,
+      opening it otherwise. The datasource is used by the caller only until it is released.
+      Each acquisition must be balanced by a call to release().
+      @param[in] AbsolutePath The absolute path of the vector file(s)
+      @param[in] Mode The open mode
+      @return The opened OGR datasource
+      @throw openfluid::base::FrameworkException if OGR doesn't succeed to open the datasource
+    */
+    OGRDataSource* acquireVector(const std::string& AbsolutePath, OpenMode Mode = ReadOnly);
+
+    /**
+      Acquires the GDAL dataset for the given path and mode, opening it if not already in the cache.
+      Each acquisition must be balanced by a call to release().
+      @param[in] AbsolutePath The absolute path of the raster file
+      @param[in] Mode The open mode
+      @return The opened GDAL dataset
+      @throw openfluid::base::FrameworkException if GDAL doesn't succeed to open the dataset
+    */
+    GDALDataset* acquireRaster(const std::string& AbsolutePath, OpenMode Mode = ReadOnly);
+
+    /**
+      Releases a reference to a cached dataset. A raster dataset is closed if it was the last reference,
+      a vector datasource is kept opened for reuse. Handles which are not managed by the cache are ignored.
+      @param[in] Handle The acquired OGR datasource or GDAL dataset
+    */
+    void release(const void* Handle);
+
+    /**
+      Returns true if the given handle is managed by the cache
+    */
+    bool isCached(const void* Handle) const;
+
+    /**
+      Returns the number of references to a cached dataset,
+      0 if the handle is not managed by the cache or is a released vector datasource
+    */
+    unsigned int getReferencesCount(const void* Handle) const;
+
+    /**
+      Returns the number of currently opened datasets, including the released vector datasources kept for reuse
+    */
+    unsigned int getDatasetsCount() const;
+};
+
+
+} }  // namespaces
+
+
+#endif /* __OPENFLUID_CORE_GEODATASETSCACHE_HPP__ */
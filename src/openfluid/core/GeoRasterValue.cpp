@@ -38,6 +38,7 @@
 
 
 #include <openfluid/core/GeoRasterValue.hpp>
+#include <openfluid/core/GeoDatasetsCache.hpp>
 #include <openfluid/base/FrameworkException.hpp>
 
 namespace openfluid {
@@ -60,9 +61,26 @@ GeoRasterValue::GeoRasterValue(const std::string& FilePath, const std::string& F
 
 
 GeoRasterValue::~GeoRasterValue()
+{
+  closeSource();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void GeoRasterValue::closeSource()
 {
   if (mp_Data)
-    GDALClose(mp_Data);
+  {
+    if (mp_DatasetsCache)
+      mp_DatasetsCache->release(mp_Data);
+    else
+      GDALClose(mp_Data);
+
+    mp_Data = 0;
+  }
 }
 
 
@@ -95,6 +113,15 @@ GDALDataset* GeoRasterValue::data()
 
 void GeoRasterValue::tryToOpenSource()
 {
+  if (mp_Data)
+    return;
+
+  if (mp_DatasetsCache)
+  {
+    mp_Data = mp_DatasetsCache->acquireRaster(m_AbsolutePath);
+    return;
+  }
+
   // GDALOpenShared to allow copy then close of this raster in virtual format (see http://www.gdal.org/gdal_vrttut.html)
   mp_Data = static_cast<GDALDataset*>(GDALOpenShared(m_AbsolutePath.c_str(),
                                                GA_ReadOnly));
@@ -105,7 +132,6 @@ void GeoRasterValue::tryToOpenSource()
                                               "Error while trying to open file " + m_AbsolutePath +
                                               " (" + CPLGetLastErrorMsg() + ")");
   }
-
 }
 
 
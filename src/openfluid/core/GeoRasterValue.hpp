@@ -63,11 +63,13 @@ class OPENFLUID_API GeoRasterValue: public openfluid::core::GeoValue
     GDALDataset* mp_Data;
 
     /**
-      Open the GDALDataset of this GeoRasterValue.
+      Open the GDALDataset of this GeoRasterValue, through the datasets cache if any.
       @throw openfluid::base::FrameworkException if GDAL doesn't succeed to open the datasource.
     */
     void tryToOpenSource();
 
+    void closeSource();
+
   public:
 
     /**
@@ -80,7 +82,7 @@ class OPENFLUID_API GeoRasterValue: public openfluid::core::GeoValue
     GeoRasterValue(const std::string& FilePath, const std::string& FileName);
 
     /**
-      Closes the opened GDAL dataset.
+      Releases the opened GDAL dataset, which is closed when no other value uses it.
     */
     ~GeoRasterValue();
 
@@ -47,7 +47,7 @@ namespace openfluid { namespace core {
 
 
 GeoValue::GeoValue(const std::string& FilePath, const std::string& FileName) :
-    m_FilePath(FilePath), m_FileName(FileName)
+    m_FilePath(FilePath), m_FileName(FileName), mp_DatasetsCache(NULL)
 {
   m_AbsolutePath = computeAbsolutePath(m_FilePath, m_FileName);
 }
@@ -84,6 +84,17 @@ std::string GeoValue::getFilePath()
 }
 
 
+// =====================================================================
+// =====================================================================
+
+
+void GeoValue::setDatasetsCache(GeoDatasetsCache* DatasetsCache)
+{
+  closeSource();
+  mp_DatasetsCache = DatasetsCache;
+}
+
+
 // =====================================================================
 // =====================================================================
 
@@ -46,6 +46,9 @@
 namespace openfluid { namespace core {
 
 
+class GeoDatasetsCache;
+
+
 /**
   Abstract class for geospatial data.
 */
@@ -59,8 +62,15 @@ class OPENFLUID_API GeoValue: public openfluid::core::UnstructuredValue
 
     std::string m_AbsolutePath;
 
+    /**
+      The cache used to open the source, NULL if the source is opened by the value itself
+    */
+    GeoDatasetsCache* mp_DatasetsCache;
+
     virtual void tryToOpenSource() = 0;
 
+    virtual void closeSource() = 0;
+
 
   public:
 
@@ -70,6 +80,13 @@ class OPENFLUID_API GeoValue: public openfluid::core::UnstructuredValue
 
     std::string getFilePath();
 
+    /**
+      Sets the datasets cache used to open the source of this value on its next access.
+      The source already opened, if any, is closed.
+      @param[in] DatasetsCache The datasets cache, NULL to open the source without cache
+    */
+    void setDatasetsCache(GeoDatasetsCache* DatasetsCache);
+
     static std::string computeAbsolutePath(const std::string& FilePath, const std::string& FileName);
 
 };
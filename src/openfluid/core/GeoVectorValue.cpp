@@ -36,7 +36,7 @@
  */
 
 #include <openfluid/core/GeoVectorValue.hpp>
-
+#include <openfluid/core/GeoDatasetsCache.hpp>
 #include <openfluid/base/FrameworkException.hpp>
 
 namespace openfluid {
@@ -72,7 +72,11 @@ void GeoVectorValue::destroyDataSource()
 {
   if (mp_Data)
   {
-    OGRDataSource::DestroyDataSource(mp_Data);
+    if (mp_DatasetsCache)
+      mp_DatasetsCache->release(mp_Data);
+    else
+      OGRDataSource::DestroyDataSource(mp_Data);
+
     mp_Data = 0;
   }
 }
@@ -82,6 +86,16 @@ void GeoVectorValue::destroyDataSource()
 // =====================================================================
 
 
+void GeoVectorValue::closeSource()
+{
+  destroyDataSource();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 openfluid::core::UnstructuredValue::UnstructuredType GeoVectorValue::getType() const
 {
   return openfluid::core::UnstructuredValue::GeoVectorValue;
@@ -92,6 +106,16 @@ openfluid::core::UnstructuredValue::UnstructuredType GeoVectorValue::getType() c
 // =====================================================================
 
 
+std::string GeoVectorValue::getAbsolutePath() const
+{
+  return m_AbsolutePath;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 OGRDataSource* GeoVectorValue::data()
 {
   if (!mp_Data)
@@ -107,6 +131,15 @@ OGRDataSource* GeoVectorValue::data()
 
 void GeoVectorValue::tryToOpenSource()
 {
+  if (mp_Data)
+    return;
+
+  if (mp_DatasetsCache)
+  {
+    mp_Data = mp_DatasetsCache->acquireVector(m_AbsolutePath);
+    return;
+  }
+
   mp_Data = OGRSFDriverRegistrar::Open(m_AbsolutePath.c_str(), false);
 
   if (!mp_Data)
@@ -131,7 +164,7 @@ OGRLayer* GeoVectorValue::layer(unsigned int LayerIndex)
 
 OGRFeatureDefn* GeoVectorValue::layerDef(unsigned int LayerIndex)
 {
-  return layer(LayerIndex)->GetLayerDefn();
+  return data()->GetLayer(LayerIndex)->GetLayerDefn();
 }
 
 
@@ -59,16 +59,18 @@ class OPENFLUID_API GeoVectorValue: public openfluid::core::GeoValue
     OGRDataSource* mp_Data;
 
     /**
-      Open the OGRDataSource of this GeoVectorValue.
+      Open the OGRDataSource of this GeoVectorValue, through the datasets cache if any.
       @throw openfluid::base::FrameworkException if OGR doesn't succeed to open the datasource.
     */
     void tryToOpenSource();
 
     /**
-      Destroy the OGRDataSource.
+      Release the OGRDataSource to the datasets cache if any, destroy it otherwise.
     */
     void destroyDataSource();
 
+    void closeSource();
+
 
   public:
 
@@ -83,7 +85,7 @@ class OPENFLUID_API GeoVectorValue: public openfluid::core::GeoValue
     GeoVectorValue(const std::string& FilePath, const std::string& FileName);
 
     /**
-      Destructor. Closes the open OGR datasource.
+      Destructor. Releases the open OGR datasource.
     */
     ~GeoVectorValue();
 
@@ -92,9 +94,16 @@ class OPENFLUID_API GeoVectorValue: public openfluid::core::GeoValue
     */
     openfluid::core::UnstructuredValue::UnstructuredType getType() const;
 
+    /**
+      Returns the absolute path of the file(s) of this GeoVectorValue.
+    */
+    std::string getAbsolutePath() const;
+
     /**
       Gets the associated opened OGR datasource in read-only access.
       If the datasource is not already opened, tries to open it first.
+      The datasource is not shared with other values, so the reading cursors of its layers
+      are only moved by the users of this value.
       @return The opened OGR datasource.
       @throw openfluid::base::FrameworkException if OGR doesn't succeed to open the datasource.
     */
@@ -42,7 +42,7 @@
 
 #include <openfluid/deprecation.hpp>
 #include <openfluid/core/Value.hpp>
-#include <openfluid/core/NullValue.hpp>
+#include <openfluid/core/ValueStorage.hpp>
 #include <openfluid/core/DateTime.hpp>
 
 #include <list>
@@ -60,7 +60,7 @@ class IndexedValue
 
     TimeIndex_t m_Index;
 
-    std::shared_ptr<Value> m_Value;
+    ValueStorage m_Value;
 
 
   public:
@@ -68,21 +68,37 @@ class IndexedValue
     /**
       Default constructor
     */
-    IndexedValue() : m_Index(0),m_Value(new NullValue())
+    IndexedValue() : m_Index(0)
     { };
 
     /**
       Constructor from a time index and a value
     */
-    IndexedValue(const TimeIndex_t& Ind, const Value& Val) : m_Index(Ind),m_Value(Val.clone())
+    IndexedValue(const TimeIndex_t& Ind, const Value& Val) : m_Index(Ind),m_Value(Val)
+    { };
+
+    /**
+      Constructor from a time index and a temporary value, which is moved when possible
+    */
+    IndexedValue(const TimeIndex_t& Ind, Value&& Val) : m_Index(Ind),m_Value(std::move(Val))
     { };
 
     /**
       Copy constructor
     */
-    IndexedValue(const IndexedValue& IndValue) : m_Index(IndValue.m_Index),m_Value(IndValue.m_Value.get()->clone())
+    IndexedValue(const IndexedValue& IndValue) : m_Index(IndValue.m_Index),m_Value(IndValue.m_Value)
+    { };
+
+    /**
+      Move constructor
+    */
+    IndexedValue(IndexedValue&& IndValue) : m_Index(IndValue.m_Index),m_Value(std::move(IndValue.m_Value))
     { };
 
+    IndexedValue& operator=(const IndexedValue&) = default;
+
+    IndexedValue& operator=(IndexedValue&&) = default;
+
     /**
       Returns the time index of the indexed value
       @return the time index
@@ -122,7 +138,7 @@ class IndexedValue
       and the value is set to an openfluid::core::NullValue.
     */
     inline void clear()
-    { m_Index = 0; m_Value.reset(new NullValue()); };
+    { m_Index = 0; m_Value.reset(); };
 
 };
 
@@ -42,8 +42,12 @@
 #define __OPENFLUID_CORE_MATRIX_HPP__
 
 
+#include <algorithm>
+#include <utility>
+
 #include <openfluid/dllexport.hpp>
 #include <openfluid/base/FrameworkException.hpp>
+#include <openfluid/core/ArrayOperations.hpp>
 
 
 namespace openfluid { namespace core {
@@ -67,6 +71,8 @@ class OPENFLUID_API Matrix
 
     void init();
 
+    void checkSameSize(const Matrix& Other) const;
+
 
   public :
 
@@ -80,6 +86,11 @@ class OPENFLUID_API Matrix
      */
     Matrix(const Matrix &Matrix);
 
+    /**
+      Move constructor, the data are transferred without copy and the moved Matrix is left empty
+     */
+    Matrix(Matrix&& Matrix);
+
     /**
       Constructor, creates a Matrix containing Size elements
     */
@@ -94,7 +105,7 @@ class OPENFLUID_API Matrix
       Destructor
     */
     virtual ~Matrix()
-    { };
+    { clear(); };
 
     /**
       Returns the number of columns of the Matrix
@@ -124,7 +135,8 @@ class OPENFLUID_API Matrix
 
 
     /**
-      Returns a pointer to the content of the Matrix (like C arrays)
+      Returns a pointer to the content of the Matrix (like C arrays).
+      The content is stored column by column and aligned on openfluid::core::ArrayAlignment bytes.
     */
     T* data() const
     { return static_cast<T*>(m_Data); };
@@ -163,11 +175,30 @@ class OPENFLUID_API Matrix
     inline void set(unsigned long ColIndex, unsigned long RowIndex, T Element)
     { setElement(ColIndex,RowIndex,Element); };
 
+    /**
+      Returns a reference to the element at the given indexes, without range checking.
+      To be used in performance critical loops where the indexes are known to be valid.
+    */
+    inline T& uncheckedAt(unsigned long ColIndex, unsigned long RowIndex)
+    { return m_Data[ColIndex*m_RowsNbr+RowIndex]; };
+
+    /**
+      Returns a const reference to the element at the given indexes, without range checking.
+      To be used in performance critical loops where the indexes are known to be valid.
+    */
+    inline const T& uncheckedAt(unsigned long ColIndex, unsigned long RowIndex) const
+    { return m_Data[ColIndex*m_RowsNbr+RowIndex]; };
+
     /**
       Allocation operator
     */
     Matrix<T>& operator=(const Matrix &A);
 
+    /**
+      Move allocation operator, the data are transferred without copy and the moved Matrix is left empty
+    */
+    Matrix<T>& operator=(Matrix&& A);
+
     /**
       Fills the Matrix with given value
     */
@@ -178,6 +209,60 @@ class OPENFLUID_API Matrix
     */
     void clear();
 
+    /**
+      Returns the sum of all elements of the Matrix
+    */
+    T sum() const
+    { return sumOfArray(m_Data,size()); };
+
+    /**
+      Returns the sum of the elementwise products of the Matrix with another Matrix of the same dimensions
+      @throw openfluid::base::FrameworkException if the dimensions are different
+    */
+    T dot(const Matrix& Other) const;
+
+    /**
+      Returns the minimum value of the elements of the Matrix
+      @throw openfluid::base::FrameworkException if the Matrix is empty
+    */
+    T min() const;
+
+    /**
+      Returns the maximum value of the elements of the Matrix
+      @throw openfluid::base::FrameworkException if the Matrix is empty
+    */
+    T max() const;
+
+    /**
+      Adds A*X to the Matrix, X must have the same dimensions as the Matrix
+      @throw openfluid::base::FrameworkException if the dimensions are different
+    */
+    void axpy(const T& A, const Matrix& X);
+
+    /**
+      Adds elementwise the given Matrix of the same dimensions to the Matrix
+      @throw openfluid::base::FrameworkException if the dimensions are different
+    */
+    void add(const Matrix& X);
+
+    /**
+      Subtracts elementwise the given Matrix of the same dimensions from the Matrix
+      @throw openfluid::base::FrameworkException if the dimensions are different
+    */
+    void subtract(const Matrix& X);
+
+    /**
+      Multiplies elementwise the Matrix by the given Matrix of the same dimensions
+      @throw openfluid::base::FrameworkException if the dimensions are different
+    */
+    void multiply(const Matrix& X);
+
+    /**
+      Multiplies all elements of the Matrix by the given factor
+    */
+    void scale(const T& A)
+    { scaleArray(A,m_Data,size()); };
+
 };
 
 
@@ -213,6 +298,18 @@ Matrix<T>::Matrix(const Matrix &A)
 // =====================================================================
 
 
+template <class T>
+Matrix<T>::Matrix(Matrix&& A) :
+  m_Data(A.m_Data),m_ColsNbr(A.m_ColsNbr),m_RowsNbr(A.m_RowsNbr)
+{
+  A.init();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 template <class T>
 Matrix<T>::Matrix(unsigned long ColsNbr, unsigned long RowsNbr)
 {
@@ -263,7 +360,7 @@ bool Matrix<T>::allocate(unsigned long ColsNbr, unsigned long RowsNbr)
 {
   if (ColsNbr > 0 && RowsNbr > 0)
   {
-    m_Data = new T[ColsNbr*RowsNbr];
+    m_Data = allocateAlignedArray<T>(ColsNbr*RowsNbr);
     if (m_Data)
     {
       m_RowsNbr = RowsNbr;
@@ -345,12 +442,30 @@ Matrix<T>& Matrix<T>::operator=(const Matrix &A)
 // =====================================================================
 
 
+template <class T>
+Matrix<T>& Matrix<T>::operator=(Matrix&& A)
+{
+  if (this == &A) return *this;
+
+  clear();
+
+  m_Data = A.m_Data;
+  m_ColsNbr = A.m_ColsNbr;
+  m_RowsNbr = A.m_RowsNbr;
+  A.init();
+
+  return *this;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 template <class T>
 void Matrix<T>::fill(const T& Val)
 {
-  for (unsigned long i=0;i<m_RowsNbr;i++)
-    for (unsigned long j=0;j<m_ColsNbr;j++)
-      m_Data[i*m_ColsNbr+j] = Val;
+  std::fill(m_Data, m_Data + size(),Val);
 }
 
 
@@ -361,11 +476,116 @@ void Matrix<T>::fill(const T& Val)
 template <class T>
 void Matrix<T>::clear()
 {
-  delete [] m_Data;
+  freeAlignedArray(m_Data,size());
   init();
 }
 
 
+// =====================================================================
+// =====================================================================
+
+
+template <class T>
+void Matrix<T>::checkSameSize(const Matrix& Other) const
+{
+  if (Other.m_ColsNbr != m_ColsNbr || Other.m_RowsNbr != m_RowsNbr)
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"matrices dimensions mismatch");
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template <class T>
+T Matrix<T>::dot(const Matrix& Other) const
+{
+  checkSameSize(Other);
+
+  return dotOfArrays(m_Data,Other.m_Data,size());
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template <class T>
+T Matrix<T>::min() const
+{
+  if (size() == 0)
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"minimum of an empty matrix");
+
+  return minOfArray(m_Data,size());
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template <class T>
+T Matrix<T>::max() const
+{
+  if (size() == 0)
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"maximum of an empty matrix");
+
+  return maxOfArray(m_Data,size());
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template <class T>
+void Matrix<T>::axpy(const T& A, const Matrix& X)
+{
+  checkSameSize(X);
+
+  axpyOfArrays(A,X.m_Data,m_Data,size());
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template <class T>
+void Matrix<T>::add(const Matrix& X)
+{
+  checkSameSize(X);
+
+  addArrays(X.m_Data,m_Data,size());
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template <class T>
+void Matrix<T>::subtract(const Matrix& X)
+{
+  checkSameSize(X);
+
+  subtractArrays(X.m_Data,m_Data,size());
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template <class T>
+void Matrix<T>::multiply(const Matrix& X)
+{
+  checkSameSize(X);
+
+  multiplyArrays(X.m_Data,m_Data,size());
+}
+
+
 
 } }
 
@@ -129,6 +129,13 @@ class OPENFLUID_API MatrixValue : public CompoundValue, public Matrix<double>
                                           Matrix<double>(static_cast<const Matrix<double>& >(Val))
     { };
 
+    /**
+      Move constructor, the data are transferred without copy and the moved value is left empty
+    */
+    MatrixValue(MatrixValue&& Val) : CompoundValue(static_cast<const CompoundValue&>(Val)),
+                                     Matrix<double>(static_cast<Matrix<double>&& >(Val))
+    { };
+
     /**
       Constructor, creates a Matrix containing ColsNbr x RowsNbr elements
     */
@@ -144,6 +151,24 @@ class OPENFLUID_API MatrixValue : public CompoundValue, public Matrix<double>
 
     Value& operator =(const Value& Other);
 
+    /**
+      Copy assignment operator
+    */
+    MatrixValue& operator =(const MatrixValue& Other)
+    {
+      Matrix<double>::operator=(static_cast<const Matrix<double>&>(Other));
+      return *this;
+    };
+
+    /**
+      Move assignment operator, the data are transferred without copy and the moved value is left empty
+    */
+    MatrixValue& operator =(MatrixValue&& Other)
+    {
+      Matrix<double>::operator=(static_cast<Matrix<double>&&>(Other));
+      return *this;
+    };
+
     virtual ~MatrixValue()
     { };
 
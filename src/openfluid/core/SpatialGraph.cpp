@@ -36,7 +36,10 @@
 */
 
 
+#include <algorithm>
+
 #include <openfluid/core/SpatialGraph.hpp>
+#include <openfluid/base/FrameworkException.hpp>
 
 
 namespace openfluid { namespace core {
@@ -51,7 +54,8 @@ struct SortUnitsPtrByProcessOrder
 {
   bool operator ()(SpatialUnit*& U1,SpatialUnit*& U2) const
   {
-    return (U1->getProcessOrder() <= U2->getProcessOrder());
+    // strict ordering keeps the creation order of units sharing the same process order
+    return (U1->getProcessOrder() < U2->getProcessOrder());
   }
 
 };
@@ -61,38 +65,13 @@ struct SortUnitsPtrByProcessOrder
 // =====================================================================
 
 
-SpatialGraph::SpatialGraph()
+SpatialGraph::SpatialGraph() :
+  m_ConnectionsChangesDeferred(false)
 {
 
 }
 
 
-// =====================================================================
-// =====================================================================
-
-
-bool SpatialGraph::removeUnitFromList(UnitsPtrList_t* UnitsList,
-                                        const UnitID_t& UnitID)
-{
-
-  UnitsPtrList_t::iterator UnitsIt;
-  bool Found = false;
-
-  UnitsIt = UnitsList->begin();
-  while (!Found && UnitsIt!=UnitsList->end())
-  {
-    Found = ((*UnitsIt)->getID() == UnitID);
-
-    if (Found)
-      UnitsList->erase(UnitsIt);
-    else
-      ++UnitsIt;
-  }
-
-  return Found;
-}
-
-
 
 // =====================================================================
 // =====================================================================
@@ -104,7 +83,9 @@ bool SpatialGraph::addUnit(const SpatialUnit& aUnit)
 
   if (TheUnit != NULL)
   {
+    TheUnit->variables()->linkToChangesLog(&m_VariablesChangesLog,TheUnit);
     m_PcsOrderedUnitsGlobal.push_back(TheUnit);
+    invalidateWavefronts();
     return true;
   }
 
@@ -118,6 +99,19 @@ bool SpatialGraph::addUnit(const SpatialUnit& aUnit)
 
 bool SpatialGraph::deleteUnit(SpatialUnit* aUnit)
 {
+  m_VariablesChangesLog.discardUnit(aUnit);
+  invalidateWavefronts();
+
+  // pending connections changes involving the deleted unit are discarded
+  {
+    std::lock_guard<std::mutex> Lock(m_PendingConnectionsMutex);
+
+    m_PendingConnectionsChanges.erase(
+        std::remove_if(m_PendingConnectionsChanges.begin(),m_PendingConnectionsChanges.end(),
+                       [aUnit](const ConnectionChange& Change)
+                       { return (Change.mp_FirstUnit == aUnit || Change.mp_SecondUnit == aUnit); }),
+        m_PendingConnectionsChanges.end());
+  }
 
   std::vector<openfluid::core::UnitsClass_t> ClassVector;
 
@@ -128,7 +122,7 @@ bool SpatialGraph::deleteUnit(SpatialUnit* aUnit)
     ClassVector.push_back((*itUnitsClass).first);
 
 
-  // remove all connections
+  // remove all connections, immediately even if connections changes are deferred
 
   UnitsPtrList_t* UnitsList;
 
@@ -137,22 +131,22 @@ bool SpatialGraph::deleteUnit(SpatialUnit* aUnit)
     // from
     UnitsList = aUnit->fromSpatialUnits(ClassVector[i]);
     while (UnitsList !=NULL && !UnitsList->empty())
-      removeFromToConnection(UnitsList->front(),aUnit);
+      applyConnectionChange(ConnectionChange(ConnectionChange::REMOVE_FROMTO,UnitsList->front(),aUnit));
 
     // to
     UnitsList = aUnit->toSpatialUnits(ClassVector[i]);
     while (UnitsList !=NULL && !UnitsList->empty())
-      removeFromToConnection(aUnit, UnitsList->front());
+      applyConnectionChange(ConnectionChange(ConnectionChange::REMOVE_FROMTO,aUnit,UnitsList->front()));
 
     // children
     UnitsList = aUnit->childSpatialUnits(ClassVector[i]);
     while (UnitsList !=NULL && !UnitsList->empty())
-      removeChildParentConnection(UnitsList->front(),aUnit);
+      applyConnectionChange(ConnectionChange(ConnectionChange::REMOVE_CHILDPARENT,UnitsList->front(),aUnit));
 
     // parent
     UnitsList = aUnit->parentSpatialUnits(ClassVector[i]);
     while (UnitsList !=NULL && !UnitsList->empty())
-      removeChildParentConnection(aUnit, UnitsList->front());
+      applyConnectionChange(ConnectionChange(ConnectionChange::REMOVE_CHILDPARENT,aUnit,UnitsList->front()));
 
   }
 
@@ -209,16 +203,61 @@ bool SpatialGraph::deleteUnit(SpatialUnit* aUnit)
 // =====================================================================
 
 
+bool SpatialGraph::addFromToConnection(SpatialUnit* FromUnit,
+                                       SpatialUnit* ToUnit)
+{
+  if (FromUnit == NULL || ToUnit == NULL)
+    return false;
+
+  if (m_ConnectionsChangesDeferred)
+    return deferConnectionChange(ConnectionChange::ADD_FROMTO,FromUnit,ToUnit);
+
+  if (FromUnit->isToUnit(ToUnit))
+    return false;
+
+  invalidateWavefronts();
+  return applyConnectionChange(ConnectionChange(ConnectionChange::ADD_FROMTO,FromUnit,ToUnit));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 bool SpatialGraph::removeFromToConnection(SpatialUnit* FromUnit,
                                           SpatialUnit* ToUnit)
 {
-  if (FromUnit != NULL && ToUnit != NULL)
-  {
-    return (removeUnitFromList(FromUnit->toSpatialUnits(ToUnit->getClass()),ToUnit->getID()) &&
-            removeUnitFromList(ToUnit->fromSpatialUnits(FromUnit->getClass()),FromUnit->getID()));
-  }
-  else
+  if (FromUnit == NULL || ToUnit == NULL)
+    return false;
+
+  if (m_ConnectionsChangesDeferred)
+    return deferConnectionChange(ConnectionChange::REMOVE_FROMTO,FromUnit,ToUnit);
+
+  if (!FromUnit->isToUnit(ToUnit))
+    return false;
+
+  invalidateWavefronts();
+  return applyConnectionChange(ConnectionChange(ConnectionChange::REMOVE_FROMTO,FromUnit,ToUnit));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool SpatialGraph::addChildParentConnection(SpatialUnit* ChildUnit,
+                                            SpatialUnit* ParentUnit)
+{
+  if (ChildUnit == NULL || ParentUnit == NULL)
+    return false;
+
+  if (m_ConnectionsChangesDeferred)
+    return deferConnectionChange(ConnectionChange::ADD_CHILDPARENT,ChildUnit,ParentUnit);
+
+  if (ChildUnit->isParentUnit(ParentUnit))
     return false;
+
+  return applyConnectionChange(ConnectionChange(ConnectionChange::ADD_CHILDPARENT,ChildUnit,ParentUnit));
 }
 
 
@@ -229,13 +268,139 @@ bool SpatialGraph::removeFromToConnection(SpatialUnit* FromUnit,
 bool SpatialGraph::removeChildParentConnection(SpatialUnit* ChildUnit,
                                                SpatialUnit* ParentUnit)
 {
-  if (ChildUnit != NULL && ParentUnit != NULL)
+  if (ChildUnit == NULL || ParentUnit == NULL)
+    return false;
+
+  if (m_ConnectionsChangesDeferred)
+    return deferConnectionChange(ConnectionChange::REMOVE_CHILDPARENT,ChildUnit,ParentUnit);
+
+  if (!ChildUnit->isParentUnit(ParentUnit))
+    return false;
+
+  return applyConnectionChange(ConnectionChange(ConnectionChange::REMOVE_CHILDPARENT,ChildUnit,ParentUnit));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool SpatialGraph::deferConnectionChange(ConnectionChange::Kind Kind, SpatialUnit* FirstUnit, SpatialUnit* SecondUnit)
+{
+  const bool IsFromTo = (Kind == ConnectionChange::ADD_FROMTO || Kind == ConnectionChange::REMOVE_FROMTO);
+  const bool IsAdd = (Kind == ConnectionChange::ADD_FROMTO || Kind == ConnectionChange::ADD_CHILDPARENT);
+  const ConnectionChange::Kind AddKind = (IsFromTo ? ConnectionChange::ADD_FROMTO : ConnectionChange::ADD_CHILDPARENT);
+  const ConnectionChange::Kind RemoveKind = (IsFromTo ? ConnectionChange::REMOVE_FROMTO :
+                                                        ConnectionChange::REMOVE_CHILDPARENT);
+
+  std::lock_guard<std::mutex> Lock(m_PendingConnectionsMutex);
+
+  // the request is checked against the graph as it will be once the pending changes are applied
+  bool Connected = (IsFromTo ? FirstUnit->isToUnit(SecondUnit) : FirstUnit->isParentUnit(SecondUnit));
+
+  for (const ConnectionChange& Change : m_PendingConnectionsChanges)
   {
-    return (removeUnitFromList(ChildUnit->parentSpatialUnits(ParentUnit->getClass()),ParentUnit->getID()) &&
-            removeUnitFromList(ParentUnit->childSpatialUnits(ChildUnit->getClass()),ChildUnit->getID()));
+    if (Change.mp_FirstUnit == FirstUnit && Change.mp_SecondUnit == SecondUnit)
+    {
+      if (Change.m_Kind == AddKind)
+        Connected = true;
+      else if (Change.m_Kind == RemoveKind)
+        Connected = false;
+    }
   }
-  else
+
+  if (Connected == IsAdd)
     return false;
+
+  m_PendingConnectionsChanges.emplace_back(Kind,FirstUnit,SecondUnit);
+  return true;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool SpatialGraph::applyConnectionChange(const ConnectionChange& Change)
+{
+  SpatialUnit* First = Change.mp_FirstUnit;
+  SpatialUnit* Second = Change.mp_SecondUnit;
+
+  switch (Change.m_Kind)
+  {
+    case ConnectionChange::ADD_FROMTO :
+      return (First->addToUnit(Second) && Second->addFromUnit(First));
+
+    case ConnectionChange::REMOVE_FROMTO :
+    {
+      // both sides are always removed, so an incomplete connection cannot be left behind
+      const bool Removed = First->removeToUnit(Second);
+      return (Second->removeFromUnit(First) && Removed);
+    }
+
+    case ConnectionChange::ADD_CHILDPARENT :
+      return (First->addParentUnit(Second) && Second->addChildUnit(First));
+
+    case ConnectionChange::REMOVE_CHILDPARENT :
+    {
+      const bool Removed = First->removeParentUnit(Second);
+      return (Second->removeChildUnit(First) && Removed);
+    }
+  }
+
+  return false;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void SpatialGraph::setConnectionsChangesDeferred(bool Deferred)
+{
+  m_ConnectionsChangesDeferred = Deferred;
+
+  if (!Deferred)
+    applyConnectionsChanges();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void SpatialGraph::discardConnectionsChanges()
+{
+  std::lock_guard<std::mutex> Lock(m_PendingConnectionsMutex);
+
+  m_PendingConnectionsChanges.clear();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void SpatialGraph::applyConnectionsChanges()
+{
+  std::vector<ConnectionChange> Changes;
+
+  {
+    std::lock_guard<std::mutex> Lock(m_PendingConnectionsMutex);
+    Changes.swap(m_PendingConnectionsChanges);
+  }
+
+  bool FromToChanged = false;
+
+  for (const ConnectionChange& Change : Changes)
+  {
+    if (applyConnectionChange(Change) &&
+        (Change.m_Kind == ConnectionChange::ADD_FROMTO || Change.m_Kind == ConnectionChange::REMOVE_FROMTO))
+      FromToChanged = true;
+  }
+
+  if (FromToChanged)
+    invalidateWavefronts();
 }
 
 
@@ -321,6 +486,9 @@ bool SpatialGraph::sortUnitsByProcessOrder()
   // sort global units structure
   m_PcsOrderedUnitsGlobal.sort(SortUnitsPtrByProcessOrder());
 
+  // levels are ordered by process order inside, they must be recomputed
+  invalidateWavefronts();
+
   return true;
 }
 
@@ -328,6 +496,101 @@ bool SpatialGraph::sortUnitsByProcessOrder()
 // =====================================================================
 
 
+void SpatialGraph::computeWavefront(const UnitsClass_t& UnitsClass, UnitsWavefront_t& Wavefront) const
+{
+  Wavefront.clear();
+
+  const UnitsCollection* Units = spatialUnits(UnitsClass);
+
+  if (Units == NULL || Units->list()->empty())
+    return;
+
+
+  // rank of each unit in process order, and count of its upstream units in the same class
+
+  std::map<const SpatialUnit*,unsigned int> Ranks;
+  std::map<const SpatialUnit*,unsigned int> PendingFroms;
+  std::vector<SpatialUnit*> CurrentLevel;
+  unsigned int Rank = 0;
+
+  for (const SpatialUnit& CurrentUnit : *(Units->list()))
+  {
+    const UnitsPtrList_t* FromUnits = CurrentUnit.fromSpatialUnits(UnitsClass);
+    const unsigned int FromCount = (FromUnits != NULL ? FromUnits->size() : 0);
+
+    Ranks[&CurrentUnit] = Rank++;
+    PendingFroms[&CurrentUnit] = FromCount;
+
+    if (!FromCount)
+      CurrentLevel.push_back(const_cast<SpatialUnit*>(&CurrentUnit));
+  }
+
+
+  // levels are built front by front, a unit is released when all its upstream units are placed
+
+  unsigned int PlacedCount = 0;
+
+  while (!CurrentLevel.empty())
+  {
+    std::vector<SpatialUnit*> NextLevel;
+
+    for (SpatialUnit* CurrentUnit : CurrentLevel)
+    {
+      const UnitsPtrList_t* ToUnits = CurrentUnit->toSpatialUnits(UnitsClass);
+
+      if (ToUnits != NULL)
+      {
+        for (SpatialUnit* ToUnit : *ToUnits)
+        {
+          unsigned int& Pending = PendingFroms[ToUnit];
+
+          if (Pending > 0 && --Pending == 0)
+            NextLevel.push_back(ToUnit);
+        }
+      }
+    }
+
+    std::sort(NextLevel.begin(),NextLevel.end(),
+              [&Ranks](const SpatialUnit* U1, const SpatialUnit* U2)
+              { return Ranks.at(U1) < Ranks.at(U2); });
+
+    PlacedCount += CurrentLevel.size();
+    Wavefront.push_back(std::move(CurrentLevel));
+    CurrentLevel = std::move(NextLevel);
+  }
+
+  if (PlacedCount != Units->list()->size())
+  {
+    Wavefront.clear();
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                              "Cycle in from/to connections of units class " + UnitsClass);
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+const UnitsWavefront_t& SpatialGraph::unitsWavefront(const UnitsClass_t& UnitsClass)
+{
+  auto it = m_WavefrontsByClass.find(UnitsClass);
+
+  if (it == m_WavefrontsByClass.end())
+  {
+    UnitsWavefront_t Wavefront;
+    computeWavefront(UnitsClass,Wavefront);
+    it = m_WavefrontsByClass.insert(std::make_pair(UnitsClass,std::move(Wavefront))).first;
+  }
+
+  return it->second;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 void SpatialGraph::streamContents(std::ostream& OStream)
 {
   UnitsListByClassMap_t::iterator ClassIt;
@@ -366,6 +629,8 @@ void SpatialGraph::streamContents(std::ostream& OStream)
 
 void SpatialGraph::clearAllVariables()
 {
+  m_VariablesChangesLog.clear();
+
   for (openfluid::core::SpatialUnit* CurrentUnit : m_PcsOrderedUnitsGlobal)
     CurrentUnit->variables()->clear();
 }
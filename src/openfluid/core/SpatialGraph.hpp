@@ -39,7 +39,11 @@
 #define __OPENFLUID_CORE_SPATIALGRAPH_HPP__
 
 
+#include <vector>
+#include <mutex>
+
 #include <openfluid/core/SpatialUnit.hpp>
+#include <openfluid/core/VariablesChangesLog.hpp>
 #include <openfluid/dllexport.hpp>
 
 
@@ -49,6 +53,13 @@ class SpatialUnit;
 class UnitsCollection;
 
 
+/**
+  Units of a class grouped by wavefront levels. All units of a level can be processed
+  simultaneously once the units of the previous levels have been processed
+*/
+typedef std::vector<std::vector<SpatialUnit*>> UnitsWavefront_t;
+
+
 class OPENFLUID_API SpatialGraph
 {
   private:
@@ -57,8 +68,36 @@ class OPENFLUID_API SpatialGraph
 
     UnitsPtrList_t m_PcsOrderedUnitsGlobal;
 
-    static bool removeUnitFromList(UnitsPtrList_t* UnitsList,
-                                   const UnitID_t& UnitID);
+    VariablesChangesLog m_VariablesChangesLog;
+
+    std::map<UnitsClass_t,UnitsWavefront_t> m_WavefrontsByClass;
+
+    struct ConnectionChange
+    {
+      enum Kind { ADD_FROMTO, REMOVE_FROMTO, ADD_CHILDPARENT, REMOVE_CHILDPARENT };
+
+      Kind m_Kind;
+
+      SpatialUnit* mp_FirstUnit;
+
+      SpatialUnit* mp_SecondUnit;
+
+      ConnectionChange(Kind K, SpatialUnit* FirstUnit, SpatialUnit* SecondUnit) :
+        m_Kind(K), mp_FirstUnit(FirstUnit), mp_SecondUnit(SecondUnit)
+      { }
+    };
+
+    bool m_ConnectionsChangesDeferred;
+
+    std::vector<ConnectionChange> m_PendingConnectionsChanges;
+
+    std::mutex m_PendingConnectionsMutex;
+
+    void computeWavefront(const UnitsClass_t& UnitsClass, UnitsWavefront_t& Wavefront) const;
+
+    bool deferConnectionChange(ConnectionChange::Kind Kind, SpatialUnit* FirstUnit, SpatialUnit* SecondUnit);
+
+    bool applyConnectionChange(const ConnectionChange& Change);
 
   public:
 
@@ -68,12 +107,65 @@ class OPENFLUID_API SpatialGraph
 
     bool deleteUnit(SpatialUnit* aUnit);
 
+    /**
+      Adds a from-to connection between two units.
+      When connections changes are deferred, the connection is added by applyConnectionsChanges()
+      and its existence is checked against the graph including the pending changes
+      @return false if a unit is NULL or if the connection already exists, true otherwise
+    */
+    bool addFromToConnection(SpatialUnit* FromUnit,
+                             SpatialUnit* ToUnit);
+
+    /**
+      Removes a from-to connection between two units.
+      When connections changes are deferred, the connection is removed by applyConnectionsChanges()
+      and its existence is checked against the graph including the pending changes
+      @return false if a unit is NULL or if the connection does not exist, true otherwise
+    */
     bool removeFromToConnection(SpatialUnit* FromUnit,
                                 SpatialUnit* ToUnit);
 
+    /**
+      Adds a child-parent connection between two units.
+      When connections changes are deferred, the connection is added by applyConnectionsChanges()
+      and its existence is checked against the graph including the pending changes
+      @return false if a unit is NULL or if the connection already exists, true otherwise
+    */
+    bool addChildParentConnection(SpatialUnit* ChildUnit,
+                                  SpatialUnit* ParentUnit);
+
+    /**
+      Removes a child-parent connection between two units.
+      When connections changes are deferred, the connection is removed by applyConnectionsChanges()
+      and its existence is checked against the graph including the pending changes
+      @return false if a unit is NULL or if the connection does not exist, true otherwise
+    */
     bool removeChildParentConnection(SpatialUnit* ChildUnit,
                                      SpatialUnit* ParentUnit);
 
+    /**
+      Enables or disables the deferring of connections changes. When enabled, added and removed
+      connections are recorded (thread-safe) and the graph is left unchanged until the next call
+      to applyConnectionsChanges(), so the graph can be safely read while changes are requested.
+      Disabling the deferring applies the pending changes
+      @param[in] Deferred true to defer connections changes, false to apply them immediately
+    */
+    void setConnectionsChangesDeferred(bool Deferred);
+
+    inline bool isConnectionsChangesDeferred() const
+    { return m_ConnectionsChangesDeferred; }
+
+    /**
+      Applies the pending connections changes, in the order they were requested.
+      Changes which are no longer valid when applied (connection already added or removed) are ignored
+    */
+    void applyConnectionsChanges();
+
+    /**
+      Discards the pending connections changes without applying them
+    */
+    void discardConnectionsChanges();
+
     bool sortUnitsByProcessOrder();
 
     SpatialUnit* spatialUnit(const UnitsClass_t& UnitsClass, UnitID_t UnitID);
@@ -93,6 +185,33 @@ class OPENFLUID_API SpatialGraph
 
     bool isUnitsClassExist(const UnitsClass_t& UnitsClass) const;
 
+    /**
+      Returns the units of the given class grouped by topological levels of their from/to connections
+      inside this class. Level 0 contains the units without any upstream unit, and each unit is placed
+      one level after its deepest upstream unit. Inside a level, units are kept in process order.
+      Levels are computed on first request and kept until the next change of the spatial graph.
+      @param[in] UnitsClass the units class
+      @return the wavefront levels, empty if the class does not exist
+      @throw openfluid::base::FrameworkException if the from/to connections of the class contain a cycle
+    */
+    const UnitsWavefront_t& unitsWavefront(const UnitsClass_t& UnitsClass);
+
+    /**
+      Discards the computed wavefront levels, to be called when connections are modified
+      directly on spatial units
+    */
+    inline void invalidateWavefronts()
+    { m_WavefrontsByClass.clear(); }
+
+    /**
+      Returns the log of variables changes of all spatial units
+    */
+    inline VariablesChangesLog& variablesChangesLog()
+    { return m_VariablesChangesLog; };
+
+    inline const VariablesChangesLog& variablesChangesLog() const
+    { return m_VariablesChangesLog; };
+
     void streamContents(std::ostream& OStream);
 
     void clearAllVariables();
@@ -108,6 +227,40 @@ class OPENFLUID_API SpatialGraph
 };
 
 
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Defers the connections changes of a spatial graph for the lifetime of the object.
+  On destruction, including when an exception is thrown, the changes not applied yet are discarded
+  and the deferring is disabled
+*/
+class OPENFLUID_API ConnectionsChangesDeferral
+{
+  private:
+
+    SpatialGraph& m_Graph;
+
+  public:
+
+    ConnectionsChangesDeferral(SpatialGraph& Graph) : m_Graph(Graph)
+    {
+      m_Graph.setConnectionsChangesDeferred(true);
+    }
+
+    ConnectionsChangesDeferral(const ConnectionsChangesDeferral&) = delete;
+
+    ConnectionsChangesDeferral& operator=(const ConnectionsChangesDeferral&) = delete;
+
+    ~ConnectionsChangesDeferral()
+    {
+      m_Graph.discardConnectionsChanges();
+      m_Graph.setConnectionsChangesDeferred(false);
+    }
+};
+
+
 } } // namespaces
 
 
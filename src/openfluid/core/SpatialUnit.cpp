@@ -36,18 +36,108 @@
 */
 
 
+#include <algorithm>
+
 #include <openfluid/core/SpatialUnit.hpp>
 
 namespace openfluid { namespace core {
 
 
+LinkedUnits::LinkedUnits(const LinkedUnits& Other) :
+  m_UnitsByClass(Other.m_UnitsByClass)
+{
+  indexPositions();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+LinkedUnits& LinkedUnits::operator=(const LinkedUnits& Other)
+{
+  if (this != &Other)
+  {
+    m_UnitsByClass = Other.m_UnitsByClass;
+    indexPositions();
+  }
+
+  return *this;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void LinkedUnits::indexPositions()
+{
+  // positions are iterators on the lists, they must point to the lists of this object after a copy
+  m_Positions.clear();
+
+  for (auto& ClassUnits : m_UnitsByClass)
+  {
+    for (UnitsPtrList_t::iterator it = ClassUnits.second.begin(); it != ClassUnits.second.end(); ++it)
+      m_Positions[*it] = it;
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool LinkedUnits::add(SpatialUnit* aUnit)
+{
+  if (contains(aUnit))
+    return false;
+
+  UnitsPtrList_t& Units = m_UnitsByClass[aUnit->getClass()];
+  m_Positions[aUnit] = Units.insert(Units.end(),aUnit);
+
+  return true;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool LinkedUnits::remove(const SpatialUnit* aUnit)
+{
+  auto PosIt = m_Positions.find(aUnit);
+
+  if (PosIt == m_Positions.end())
+    return false;
+
+  m_UnitsByClass[aUnit->getClass()].erase(PosIt->second);
+  m_Positions.erase(PosIt);
+
+  return true;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+UnitsPtrList_t* LinkedUnits::list(const UnitsClass_t& aClass)
+{
+  LinkedUnitsListByClassMap_t::iterator it = m_UnitsByClass.find(aClass);
+
+  if (it != m_UnitsByClass.end())
+    return &(it->second);
+  else return NULL;
+}
+
+
 // =====================================================================
 // =====================================================================
 
 
 SpatialUnit::SpatialUnit(const UnitsClass_t& aClass, const UnitID_t anID,
                          const PcsOrd_t aPcsOrder) :
-  m_ID(anID), m_Class(aClass), m_PcsOrder(aPcsOrder)
+  m_ID(anID), m_Class(aClass), m_PcsOrder(aPcsOrder), m_IsHalo(false)
 {
 
 }
@@ -68,8 +158,7 @@ SpatialUnit::~SpatialUnit()
 
 bool SpatialUnit::addToUnit(SpatialUnit* aUnit)
 {
-  m_ToUnits[aUnit->getClass()].push_back(aUnit);
-  return true;
+  return m_ToUnits.add(aUnit);
 }
 
 // =====================================================================
@@ -78,9 +167,7 @@ bool SpatialUnit::addToUnit(SpatialUnit* aUnit)
 
 bool SpatialUnit::addFromUnit(SpatialUnit* aUnit)
 {
-  m_FromUnits[aUnit->getClass()].push_back(aUnit);
-  return true;
-
+  return m_FromUnits.add(aUnit);
 }
 
 // =====================================================================
@@ -89,8 +176,7 @@ bool SpatialUnit::addFromUnit(SpatialUnit* aUnit)
 
 bool SpatialUnit::addParentUnit(SpatialUnit* aUnit)
 {
-  m_ParentUnits[aUnit->getClass()].push_back(aUnit);
-  return true;
+  return m_ParentUnits.add(aUnit);
 }
 
 // =====================================================================
@@ -99,9 +185,7 @@ bool SpatialUnit::addParentUnit(SpatialUnit* aUnit)
 
 bool SpatialUnit::addChildUnit(SpatialUnit* aUnit)
 {
-  m_ChildrenUnits[aUnit->getClass()].push_back(aUnit);
-  return true;
-
+  return m_ChildrenUnits.add(aUnit);
 }
 
 // =====================================================================
@@ -110,7 +194,7 @@ bool SpatialUnit::addChildUnit(SpatialUnit* aUnit)
 
 const UnitsPtrList_t* SpatialUnit::toSpatialUnits(const UnitsClass_t& aClass) const
 {
-  return const_cast<UnitsPtrList_t*>(toSpatialUnits(aClass));
+  return const_cast<SpatialUnit*>(this)->toSpatialUnits(aClass);
 
 }
 
@@ -120,7 +204,7 @@ const UnitsPtrList_t* SpatialUnit::toSpatialUnits(const UnitsClass_t& aClass) co
 
 const UnitsPtrList_t* SpatialUnit::childSpatialUnits(const UnitsClass_t& aClass) const
 {
-  return const_cast<UnitsPtrList_t*>(childSpatialUnits(aClass));
+  return const_cast<SpatialUnit*>(this)->childSpatialUnits(aClass);
 }
 
 
@@ -130,7 +214,7 @@ const UnitsPtrList_t* SpatialUnit::childSpatialUnits(const UnitsClass_t& aClass)
 
 const UnitsPtrList_t* SpatialUnit::parentSpatialUnits(const UnitsClass_t& aClass) const
 {
-  return const_cast<UnitsPtrList_t*>(parentSpatialUnits(aClass));
+  return const_cast<SpatialUnit*>(this)->parentSpatialUnits(aClass);
 
 }
 
@@ -140,7 +224,7 @@ const UnitsPtrList_t* SpatialUnit::parentSpatialUnits(const UnitsClass_t& aClass
 
 const UnitsPtrList_t* SpatialUnit::fromSpatialUnits(const UnitsClass_t& aClass) const
 {
-  return const_cast<UnitsPtrList_t*>(fromSpatialUnits(aClass));
+  return const_cast<SpatialUnit*>(this)->fromSpatialUnits(aClass);
 }
 
 
@@ -150,11 +234,7 @@ const UnitsPtrList_t* SpatialUnit::fromSpatialUnits(const UnitsClass_t& aClass)
 
 UnitsPtrList_t* SpatialUnit::toSpatialUnits(const UnitsClass_t& aClass)
 {
-  LinkedUnitsListByClassMap_t::iterator it = m_ToUnits.find(aClass);
-
-  if (it != m_ToUnits.end())
-    return &(it->second);
-  else return NULL;
+  return m_ToUnits.list(aClass);
 }
 
 // =====================================================================
@@ -163,11 +243,7 @@ UnitsPtrList_t* SpatialUnit::toSpatialUnits(const UnitsClass_t& aClass)
 
 UnitsPtrList_t* SpatialUnit::fromSpatialUnits(const UnitsClass_t& aClass)
 {
-  LinkedUnitsListByClassMap_t::iterator it = m_FromUnits.find(aClass);
-
-  if (it != m_FromUnits.end())
-    return &(it->second);
-  else return NULL;
+  return m_FromUnits.list(aClass);
 }
 
 // =====================================================================
@@ -176,11 +252,7 @@ UnitsPtrList_t* SpatialUnit::fromSpatialUnits(const UnitsClass_t& aClass)
 
 UnitsPtrList_t* SpatialUnit::parentSpatialUnits(const UnitsClass_t& aClass)
 {
-  LinkedUnitsListByClassMap_t::iterator it = m_ParentUnits.find(aClass);
-
-  if (it != m_ParentUnits.end())
-    return &(it->second);
-  else return NULL;
+  return m_ParentUnits.list(aClass);
 }
 
 // =====================================================================
@@ -189,11 +261,7 @@ UnitsPtrList_t* SpatialUnit::parentSpatialUnits(const UnitsClass_t& aClass)
 
 UnitsPtrList_t* SpatialUnit::childSpatialUnits(const UnitsClass_t& aClass)
 {
-  LinkedUnitsListByClassMap_t::iterator it = m_ChildrenUnits.find(aClass);
-
-  if (it != m_ChildrenUnits.end())
-    return &(it->second);
-  else return NULL;
+  return m_ChildrenUnits.list(aClass);
 }
 
 
@@ -204,7 +272,7 @@ UnitsPtrList_t* SpatialUnit::childSpatialUnits(const UnitsClass_t& aClass)
 void SpatialUnit::streamContents(std::ostream& OStream)
 {
   UnitsPtrList_t::iterator IDIt;
-  LinkedUnitsListByClassMap_t::iterator ClassIt;
+  LinkedUnitsListByClassMap_t::const_iterator ClassIt;
   UnitsPtrList_t UnitsList;
 
   OStream << m_Class << " #"<< m_ID << " (order: " << m_PcsOrder << ")";
@@ -213,7 +281,7 @@ void SpatialUnit::streamContents(std::ostream& OStream)
   {
     OStream << " To[";
 
-    for (ClassIt=m_ToUnits.begin();ClassIt!=m_ToUnits.end();++ClassIt)
+    for (ClassIt=m_ToUnits.byClass().begin();ClassIt!=m_ToUnits.byClass().end();++ClassIt)
     {
 
       UnitsList = ClassIt->second;
@@ -231,7 +299,7 @@ void SpatialUnit::streamContents(std::ostream& OStream)
   {
     OStream << " From[";
 
-    for (ClassIt=m_FromUnits.begin();ClassIt!=m_FromUnits.end();++ClassIt)
+    for (ClassIt=m_FromUnits.byClass().begin();ClassIt!=m_FromUnits.byClass().end();++ClassIt)
     {
 
       UnitsList = ClassIt->second;
@@ -249,5 +317,25 @@ void SpatialUnit::streamContents(std::ostream& OStream)
 }
 
 
+// =====================================================================
+// =====================================================================
+
+
+void SpatialUnit::setHalo(const std::vector<VariableName_t>& Variables)
+{
+  m_IsHalo = true;
+  m_HaloVariables = Variables;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool SpatialUnit::isHaloVariable(const VariableName_t& aName) const
+{
+  return m_IsHalo && std::find(m_HaloVariables.begin(),m_HaloVariables.end(),aName) != m_HaloVariables.end();
+}
+
 
 } } // namespaces
@@ -43,6 +43,8 @@
 
 #include <map>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <openfluid/dllexport.hpp>
 #include <openfluid/deprecation.hpp>
@@ -73,6 +75,63 @@ typedef std::list<SpatialUnit*> UnitsPtrList_t;
 typedef std::map<UnitsClass_t,UnitsPtrList_t> LinkedUnitsListByClassMap_t;
 
 
+/**
+  Units linked to a unit, as lists of units by class.
+  The position of each linked unit in the lists is indexed, so a link can be added, checked
+  or removed in constant time while the lists keep the order of addition.
+  The lists must not be modified directly, to keep the index consistent.
+*/
+class OPENFLUID_API LinkedUnits
+{
+  private:
+
+    LinkedUnitsListByClassMap_t m_UnitsByClass;
+
+    std::unordered_map<const SpatialUnit*,UnitsPtrList_t::iterator> m_Positions;
+
+    void indexPositions();
+
+
+  public:
+
+    LinkedUnits()
+    { }
+
+    LinkedUnits(const LinkedUnits& Other);
+
+    LinkedUnits& operator=(const LinkedUnits& Other);
+
+    /**
+      Adds a unit at the end of the list of its class
+      @param[in] aUnit the linked unit
+      @return false if the unit is already linked, true otherwise
+    */
+    bool add(SpatialUnit* aUnit);
+
+    /**
+      Removes a linked unit. The list of its class is kept, even if empty
+      @param[in] aUnit the linked unit
+      @return false if the unit is not linked, true otherwise
+    */
+    bool remove(const SpatialUnit* aUnit);
+
+    inline bool contains(const SpatialUnit* aUnit) const
+    { return m_Positions.find(aUnit) != m_Positions.end(); }
+
+    /**
+      Returns the list of linked units of the given class, or NULL if no unit of this class has ever been linked
+      @param[in] aClass the units class
+    */
+    UnitsPtrList_t* list(const UnitsClass_t& aClass);
+
+    inline const LinkedUnitsListByClassMap_t& byClass() const
+    { return m_UnitsByClass; }
+
+    inline bool empty() const
+    { return m_UnitsByClass.empty(); }
+};
+
+
 /**
   Class defining a spatial unit
 
@@ -112,13 +171,13 @@ class OPENFLUID_API SpatialUnit
     // TODO use openfluid::core::PcsOrd_t instead
     unsigned int m_PcsOrder;
 
-    LinkedUnitsListByClassMap_t m_FromUnits;
+    LinkedUnits m_FromUnits;
 
-    LinkedUnitsListByClassMap_t m_ToUnits;
+    LinkedUnits m_ToUnits;
 
-    LinkedUnitsListByClassMap_t m_ParentUnits;
+    LinkedUnits m_ParentUnits;
 
-    LinkedUnitsListByClassMap_t m_ChildrenUnits;
+    LinkedUnits m_ChildrenUnits;
 
     Attributes m_Attributes;
 
@@ -126,6 +185,10 @@ class OPENFLUID_API SpatialUnit
 
     EventsCollection m_Events;
 
+    bool m_IsHalo;
+
+    std::vector<VariableName_t> m_HaloVariables;
+
 
   public:
 
@@ -169,6 +232,30 @@ class OPENFLUID_API SpatialUnit
 
     bool addChildUnit(SpatialUnit* aUnit);
 
+    inline bool removeToUnit(const SpatialUnit* aUnit)
+    { return m_ToUnits.remove(aUnit); }
+
+    inline bool removeFromUnit(const SpatialUnit* aUnit)
+    { return m_FromUnits.remove(aUnit); }
+
+    inline bool removeParentUnit(const SpatialUnit* aUnit)
+    { return m_ParentUnits.remove(aUnit); }
+
+    inline bool removeChildUnit(const SpatialUnit* aUnit)
+    { return m_ChildrenUnits.remove(aUnit); }
+
+    inline bool isToUnit(const SpatialUnit* aUnit) const
+    { return m_ToUnits.contains(aUnit); }
+
+    inline bool isFromUnit(const SpatialUnit* aUnit) const
+    { return m_FromUnits.contains(aUnit); }
+
+    inline bool isParentUnit(const SpatialUnit* aUnit) const
+    { return m_ParentUnits.contains(aUnit); }
+
+    inline bool isChildUnit(const SpatialUnit* aUnit) const
+    { return m_ChildrenUnits.contains(aUnit); }
+
     /**
       Returns a list of units, of the requested class, connected to this unit.
       Returns NULL if no units of the requested class are connected to this unit.
@@ -281,6 +368,24 @@ class OPENFLUID_API SpatialUnit
     void setProcessOrder(unsigned int PcsOrder)
     { m_PcsOrder = PcsOrder; };
 
+    /**
+      Marks the unit as a halo unit, simulated locally but owned by another part of a partitioned domain
+      @param[in] Variables the names of the variables whose values are received from the owning part
+    */
+    void setHalo(const std::vector<VariableName_t>& Variables);
+
+    /**
+      Returns true if the unit is a halo unit of a partitioned domain
+    */
+    inline bool isHalo() const
+    { return m_IsHalo; };
+
+    /**
+      Returns true if the values of the given variable are received from the part owning this unit
+      @param[in] aName the name of the variable
+    */
+    bool isHaloVariable(const VariableName_t& aName) const;
+
 };
 
 
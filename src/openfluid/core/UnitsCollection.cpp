@@ -49,7 +49,8 @@ struct SortByProcessOrder
 {
   bool operator ()(SpatialUnit& U1,SpatialUnit& U2) const
   {
-    return (U1.getProcessOrder() <= U2.getProcessOrder());
+    // strict ordering keeps the creation order of units sharing the same process order
+    return (U1.getProcessOrder() < U2.getProcessOrder());
   }
 
 };
@@ -0,0 +1,314 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+/**
+  @file ValueStorage.hpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@supagro.inra.fr>
+*/
+
+
+#ifndef __OPENFLUID_CORE_VALUESTORAGE_HPP__
+#define __OPENFLUID_CORE_VALUESTORAGE_HPP__
+
+
+#include <typeinfo>
+#include <type_traits>
+#include <new>
+#include <utility>
+
+#include <openfluid/core/Value.hpp>
+#include <openfluid/core/NullValue.hpp>
+#include <openfluid/core/BooleanValue.hpp>
+#include <openfluid/core/IntegerValue.hpp>
+#include <openfluid/core/DoubleValue.hpp>
+#include <openfluid/core/StringValue.hpp>
+#include <openfluid/core/VectorValue.hpp>
+#include <openfluid/core/MatrixValue.hpp>
+
+
+namespace openfluid { namespace core {
+
+
+/**
+  Owning holder for a single openfluid::core::Value.
+  Null, boolean, integer, double and string values are stored inline into a fixed-size buffer,
+  avoiding a heap allocation each time a value is stored or copied.
+  Other values (vectors, matrices, maps, trees, ...) are cloned on the heap,
+  except vectors and matrices given as rvalues, whose data are moved without copy.
+  The holder always contains a value, which is an openfluid::core::NullValue by default.
+*/
+class ValueStorage
+{
+  private:
+
+    typedef std::aligned_union<0,NullValue,BooleanValue,IntegerValue,DoubleValue,StringValue>::type InlineBuffer_t;
+
+    InlineBuffer_t m_Buffer;
+
+    Value* mp_Value;
+
+    bool m_IsInline;
+
+
+    template<typename T>
+    void constructInline(const Value& Val)
+    {
+      mp_Value = new (&m_Buffer) T(static_cast<const T&>(Val));
+      m_IsInline = true;
+    }
+
+
+    void construct(const Value& Val)
+    {
+      const std::type_info& Type = typeid(Val);
+
+      if (Type == typeid(DoubleValue))
+        constructInline<DoubleValue>(Val);
+      else if (Type == typeid(IntegerValue))
+        constructInline<IntegerValue>(Val);
+      else if (Type == typeid(BooleanValue))
+        constructInline<BooleanValue>(Val);
+      else if (Type == typeid(StringValue))
+        constructInline<StringValue>(Val);
+      else if (Type == typeid(NullValue))
+        constructInline<NullValue>(Val);
+      else
+      {
+        mp_Value = Val.clone();
+        m_IsInline = false;
+      }
+    }
+
+
+    void constructMoved(Value&& Val)
+    {
+      const std::type_info& Type = typeid(Val);
+
+      if (Type == typeid(VectorValue))
+      {
+        mp_Value = new VectorValue(std::move(static_cast<VectorValue&>(Val)));
+        m_IsInline = false;
+      }
+      else if (Type == typeid(MatrixValue))
+      {
+        mp_Value = new MatrixValue(std::move(static_cast<MatrixValue&>(Val)));
+        m_IsInline = false;
+      }
+      else
+        construct(Val);
+    }
+
+
+    void destroy()
+    {
+      if (m_IsInline)
+        mp_Value->~Value();
+      else
+        delete mp_Value;
+
+      mp_Value = nullptr;
+    }
+
+
+  public:
+
+    /**
+      Default constructor, the stored value is an openfluid::core::NullValue
+    */
+    ValueStorage()
+    {
+      mp_Value = new (&m_Buffer) NullValue();
+      m_IsInline = true;
+    }
+
+
+    /**
+      Constructor from a value, which is copied into the storage
+    */
+    explicit ValueStorage(const Value& Val)
+    {
+      construct(Val);
+    }
+
+
+    /**
+      Constructor from a temporary value, which is moved into the storage when possible
+    */
+    explicit ValueStorage(Value&& Val)
+    {
+      constructMoved(std::move(Val));
+    }
+
+
+    /**
+      Copy constructor, the value is deep-copied
+    */
+    ValueStorage(const ValueStorage& Other)
+    {
+      construct(*Other.mp_Value);
+    }
+
+
+    /**
+      Move constructor. Heap-stored values are transferred without copy,
+      the moved-from storage is left with an openfluid::core::NullValue
+    */
+    ValueStorage(ValueStorage&& Other)
+    {
+      if (Other.m_IsInline)
+        construct(*Other.mp_Value);
+      else
+      {
+        mp_Value = Other.mp_Value;
+        m_IsInline = false;
+        Other.mp_Value = new (&Other.m_Buffer) NullValue();
+        Other.m_IsInline = true;
+      }
+    }
+
+
+    ~ValueStorage()
+    {
+      destroy();
+    }
+
+
+    ValueStorage& operator=(const ValueStorage& Other)
+    {
+      if (this != &Other)
+        set(*Other.mp_Value);
+
+      return *this;
+    }
+
+
+    ValueStorage& operator=(ValueStorage&& Other)
+    {
+      if (this != &Other)
+      {
+        if (Other.m_IsInline)
+          set(*Other.mp_Value);
+        else
+        {
+          destroy();
+          mp_Value = Other.mp_Value;
+          m_IsInline = false;
+          Other.mp_Value = new (&Other.m_Buffer) NullValue();
+          Other.m_IsInline = true;
+        }
+      }
+
+      return *this;
+    }
+
+
+    /**
+      Replaces the stored value by a copy of the given value.
+      If both values are of the same type, the copy is made in place.
+      @param[in] Val the value to copy
+    */
+    void set(const Value& Val)
+    {
+      if (&Val == mp_Value)
+        return;
+
+      if (typeid(Val) == typeid(*mp_Value) && m_IsInline)
+      {
+        *mp_Value = Val;
+        return;
+      }
+
+      destroy();
+      construct(Val);
+    }
+
+
+    /**
+      Replaces the stored value by the given temporary value, which is moved when possible
+      @param[in] Val the value to move
+    */
+    void set(Value&& Val)
+    {
+      if (&Val == mp_Value)
+        return;
+
+      if (typeid(Val) == typeid(*mp_Value) && m_IsInline)
+      {
+        *mp_Value = Val;
+        return;
+      }
+
+      destroy();
+      constructMoved(std::move(Val));
+    }
+
+
+    /**
+      Replaces the stored value by an openfluid::core::NullValue
+    */
+    void reset()
+    {
+      destroy();
+      mp_Value = new (&m_Buffer) NullValue();
+      m_IsInline = true;
+    }
+
+
+    /**
+      Returns a pointer to the stored value
+      @return a pointer to the value
+    */
+    inline Value* get() const
+    { return mp_Value; }
+
+
+    inline Value& operator*() const
+    { return *mp_Value; }
+
+
+    inline Value* operator->() const
+    { return mp_Value; }
+
+
+    /**
+      Returns true if the stored value is held in the inline buffer, false if it is heap-allocated
+    */
+    inline bool isInline() const
+    { return m_IsInline; }
+};
+
+
+} }  // namespaces
+
+
+#endif /* __OPENFLUID_CORE_VALUESTORAGE_HPP__ */
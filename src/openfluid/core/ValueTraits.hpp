@@ -0,0 +1,137 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+/**
+  @file ValueTraits.hpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@supagro.inra.fr>
+*/
+
+
+#ifndef __OPENFLUID_CORE_VALUETRAITS_HPP__
+#define __OPENFLUID_CORE_VALUETRAITS_HPP__
+
+
+#include <string>
+
+#include <openfluid/core/Value.hpp>
+#include <openfluid/core/DoubleValue.hpp>
+#include <openfluid/core/IntegerValue.hpp>
+#include <openfluid/core/BooleanValue.hpp>
+#include <openfluid/core/StringValue.hpp>
+
+
+namespace openfluid { namespace core {
+
+
+/**
+  Compile-time mapping between a native C++ type and the openfluid::core::Value class storing it.
+  For each supported type T, it gives the value class (ValueClass), the value type (type())
+  and a direct read of the native value from a Value already known to be of this type (get()).
+  Only double, long, bool and std::string are supported, any other type leads to a compilation error.
+*/
+template<typename T>
+struct ValueTraits;
+
+
+// =====================================================================
+// =====================================================================
+
+
+template<>
+struct ValueTraits<double>
+{
+  typedef DoubleValue ValueClass;
+
+  static Value::Type type()
+  { return Value::DOUBLE; }
+
+  static double get(const Value& Val)
+  { return static_cast<const DoubleValue&>(Val).get(); }
+};
+
+
+// =====================================================================
+// =====================================================================
+
+
+template<>
+struct ValueTraits<long>
+{
+  typedef IntegerValue ValueClass;
+
+  static Value::Type type()
+  { return Value::INTEGER; }
+
+  static long get(const Value& Val)
+  { return static_cast<const IntegerValue&>(Val).get(); }
+};
+
+
+// =====================================================================
+// =====================================================================
+
+
+template<>
+struct ValueTraits<bool>
+{
+  typedef BooleanValue ValueClass;
+
+  static Value::Type type()
+  { return Value::BOOLEAN; }
+
+  static bool get(const Value& Val)
+  { return static_cast<const BooleanValue&>(Val).get(); }
+};
+
+
+// =====================================================================
+// =====================================================================
+
+
+template<>
+struct ValueTraits<std::string>
+{
+  typedef StringValue ValueClass;
+
+  static Value::Type type()
+  { return Value::STRING; }
+
+  static const std::string& get(const Value& Val)
+  { return static_cast<const StringValue&>(Val).data(); }
+};
+
+
+} }  // namespaces
+
+
+#endif /* __OPENFLUID_CORE_VALUETRAITS_HPP__ */
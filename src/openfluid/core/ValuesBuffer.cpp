@@ -44,8 +44,13 @@
 #include <openfluid/core/StringValue.hpp>
 #include <openfluid/core/DoubleValue.hpp>
 #include <openfluid/core/IntegerValue.hpp>
+#include <openfluid/core/VectorValue.hpp>
+#include <openfluid/core/MatrixValue.hpp>
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
+#include <mutex>
 
 
 namespace openfluid { namespace core {
@@ -55,81 +60,301 @@ class ValuesBuffer::PrivateImpl
 {
   public:
 
-    typedef  boost::circular_buffer<IndexedValue> DataContainer_t;
+    /**
+      Identical values stored at regular time indexes, held as a single value.
+      Without run-length encoding, each run holds exactly one value.
+    */
+    class Run
+    {
+      public:
+
+        TimeIndex_t m_FirstIndex;
+
+        TimeIndex_t m_Step;
+
+        unsigned int m_Count;
+
+        ValueStorage m_Value;
+
+        Run(const TimeIndex_t& anIndex, const Value& aValue) :
+          m_FirstIndex(anIndex), m_Step(0), m_Count(1), m_Value(aValue)
+        { }
+
+        Run(const TimeIndex_t& anIndex, Value&& aValue) :
+          m_FirstIndex(anIndex), m_Step(0), m_Count(1), m_Value(std::move(aValue))
+        { }
+
+        inline TimeIndex_t lastIndex() const
+        { return m_FirstIndex + (m_Count-1)*m_Step; }
+
+        inline bool contains(const TimeIndex_t& anIndex) const
+        {
+          return (anIndex >= m_FirstIndex && anIndex <= lastIndex() &&
+                  (m_Count == 1 || (anIndex-m_FirstIndex) % m_Step == 0));
+        }
+    };
+
+    typedef  boost::circular_buffer<Run> DataContainer_t;
 
     DataContainer_t m_Data;
 
-    DataContainer_t::iterator findAtIndex(const TimeIndex_t& anIndex)
+    unsigned int m_BufferSize;
+
+    unsigned int m_ValuesCount;
+
+    bool m_IsRunLengthEncoded;
+
+    mutable std::mutex m_Mutex;
+
+
+    /**
+      Locks the buffer for the lifetime of the object, only when concurrent access is enabled
+    */
+    class ScopedLock
     {
-      if (m_Data.empty()) return m_Data.end();
+      private:
 
-      if (anIndex < m_Data.front().m_Index || anIndex > m_Data.back().m_Index)
-        return m_Data.end();
+        std::mutex* mp_Mutex;
 
-      if (anIndex == m_Data.front().m_Index)
-        return m_Data.begin();
+      public:
+
+        ScopedLock(const PrivateImpl* PImpl) :
+          mp_Mutex(ValuesBufferProperties::isConcurrentAccess() ? &(PImpl->m_Mutex) : nullptr)
+        {
+          if (mp_Mutex)
+            mp_Mutex->lock();
+        }
+
+        ~ScopedLock()
+        {
+          if (mp_Mutex)
+            mp_Mutex->unlock();
+        }
+    };
 
-      if (anIndex == m_Data.back().m_Index)
-      {
-        ValuesBuffer::PrivateImpl::DataContainer_t::iterator TmpIt = m_Data.end();
-        --TmpIt;
-        return TmpIt;
-      }
 
+    PrivateImpl(unsigned int BufferSize) :
+      m_Data(BufferSize), m_BufferSize(BufferSize), m_ValuesCount(0), m_IsRunLengthEncoded(false)
+    { }
 
-      DataContainer_t::iterator Itb = m_Data.begin();
-      DataContainer_t::iterator Ite = m_Data.end();
-      DataContainer_t::iterator It = Itb;
 
-      while (It!=Ite)
+    /**
+      Returns true if both values are of the same type and hold the same data.
+      Only null, simple, vector and matrix values are compared, other values are never considered identical.
+    */
+    static bool isSameValue(const Value& Val1, const Value& Val2)
+    {
+      if (Val1.getType() != Val2.getType())
+        return false;
+
+      switch (Val1.getType())
       {
-        if ((*It).m_Index == anIndex)
-          return It;
+        case Value::NULLL:
+          return true;
+        case Value::DOUBLE:
+          return Val1.asDoubleValue().get() == Val2.asDoubleValue().get();
+        case Value::INTEGER:
+          return Val1.asIntegerValue().get() == Val2.asIntegerValue().get();
+        case Value::BOOLEAN:
+          return Val1.asBooleanValue().get() == Val2.asBooleanValue().get();
+        case Value::STRING:
+          return Val1.asStringValue().get() == Val2.asStringValue().get();
+        case Value::VECTOR:
+        {
+          const VectorValue& Vect1 = Val1.asVectorValue();
+          const VectorValue& Vect2 = Val2.asVectorValue();
+          return (Vect1.size() == Vect2.size() && std::equal(Vect1.data(),Vect1.data()+Vect1.size(),Vect2.data()));
+        }
+        case Value::MATRIX:
+        {
+          const MatrixValue& Mat1 = Val1.asMatrixValue();
+          const MatrixValue& Mat2 = Val2.asMatrixValue();
+          return (Mat1.getColsNbr() == Mat2.getColsNbr() && Mat1.getRowsNbr() == Mat2.getRowsNbr() &&
+                  std::equal(Mat1.data(),Mat1.data()+Mat1.size(),Mat2.data()));
+        }
+        default:
+          return false;
+      }
+    }
+
 
-        if ((*It).m_Index > anIndex)
-          return m_Data.end();
+    template<typename IteratorType, typename ContainerType>
+    static IteratorType findAtIndex(ContainerType& Data, const TimeIndex_t& anIndex)
+    {
+      if (Data.empty() || anIndex < Data.front().m_FirstIndex || anIndex > Data.back().lastIndex())
+        return Data.end();
+
+      // most accesses are made to the latest values
+      IteratorType It = Data.end();
+      --It;
 
-        ++It;
+      if (anIndex < (*It).m_FirstIndex)
+      {
+        // runs are ordered by time indexes, the searched run is the last one starting before the index
+        It = std::upper_bound(Data.begin(),Data.end(),anIndex,
+                              [](const TimeIndex_t& Index, const Run& R){ return Index < R.m_FirstIndex; });
+        --It;
       }
 
-      return m_Data.end();
+      if ((*It).contains(anIndex))
+        return It;
 
+      return Data.end();
+    }
+
+    DataContainer_t::iterator findAtIndex(const TimeIndex_t& anIndex)
+    {
+      return findAtIndex<DataContainer_t::iterator>(m_Data,anIndex);
     }
 
     DataContainer_t::const_iterator findAtIndex(const TimeIndex_t& anIndex) const
     {
-      if (m_Data.empty()) return m_Data.end();
+      return findAtIndex<DataContainer_t::const_iterator>(m_Data,anIndex);
+    }
+
 
-      if (anIndex < m_Data.front().m_Index || anIndex > m_Data.back().m_Index)
+    /**
+      Returns the latest time index readable from the calling thread
+    */
+    static TimeIndex_t readableIndexLimit()
+    {
+      if (ValuesBufferProperties::isReadIndexLimited())
+        return ValuesBufferProperties::getReadIndexLimit();
+
+      return std::numeric_limits<TimeIndex_t>::max();
+    }
+
+
+    /**
+      Finds the value at the given index if it is readable from the calling thread
+    */
+    DataContainer_t::const_iterator findReadableAtIndex(const TimeIndex_t& anIndex) const
+    {
+      if (anIndex > readableIndexLimit())
         return m_Data.end();
 
-      if (anIndex == m_Data.front().m_Index)
-        return m_Data.begin();
+      return findAtIndex(anIndex);
+    }
+
 
-      if (anIndex == m_Data.back().m_Index)
+    /**
+      Finds the latest value readable from the calling thread
+      @param[out] anIndex the time index of the value
+      @return the run holding the value, NULL if there is no readable value
+    */
+    const Run* findLatestReadable(TimeIndex_t& anIndex) const
+    {
+      const TimeIndex_t Limit = readableIndexLimit();
+
+      for (DataContainer_t::const_reverse_iterator rIt = m_Data.rbegin(); rIt != m_Data.rend(); ++rIt)
       {
-        ValuesBuffer::PrivateImpl::DataContainer_t::const_iterator TmpIt = m_Data.end();
-        --TmpIt;
-        return TmpIt;
+        if ((*rIt).m_FirstIndex <= Limit)
+        {
+          anIndex = (*rIt).lastIndex();
+
+          if (anIndex > Limit)
+            anIndex = (*rIt).m_FirstIndex + ((Limit-(*rIt).m_FirstIndex)/(*rIt).m_Step)*(*rIt).m_Step;
+
+          return &(*rIt);
+        }
       }
 
-      DataContainer_t::const_iterator Itb = m_Data.begin();
-      DataContainer_t::const_iterator Ite = m_Data.end();
-      DataContainer_t::const_iterator It = Itb;
+      return nullptr;
+    }
 
-      while (It!=Ite)
-      {
-        if ((*It).m_Index == anIndex)
-          return It;
 
-        if ((*It).m_Index > anIndex)
-          return m_Data.end();
+    /**
+      Makes room for runs inserted when splitting runs, which may exceed the capacity
+      if the buffer size has been reduced
+    */
+    void reserveRuns(unsigned int Count)
+    {
+      if (m_Data.size()+Count > m_Data.capacity())
+        m_Data.set_capacity(m_Data.size()+Count);
+    }
+
 
-        ++It;
+    /**
+      Drops the oldest values over the buffer size, one by one to keep the same number of values
+      as without encoding
+    */
+    void dropOldestValues()
+    {
+      while (m_ValuesCount > m_BufferSize)
+      {
+        Run& Front = m_Data.front();
+
+        if (Front.m_Count == 1)
+          m_Data.pop_front();
+        else
+        {
+          Front.m_FirstIndex += Front.m_Step;
+          Front.m_Count--;
+        }
+        m_ValuesCount--;
       }
+    }
+
+
+    void pushRun(Run&& R)
+    {
+      if (m_Data.capacity() == 0)
+        return;
+
+      // the first run is overwritten by the circular buffer when full
+      if (m_Data.full())
+        m_ValuesCount -= m_Data.front().m_Count;
+
+      m_Data.push_back(std::move(R));
+      m_ValuesCount++;
+
+      dropOldestValues();
+    }
+
+
+    /**
+      Extends the latest run with the given value if run-length encoding is enabled
+      and the value continues the run.
+      Runs are not extended when values are read concurrently, so that modifications never split runs:
+      the runs held by pipelined observers are never moved nor reallocated
+      @return true if the run has been extended
+    */
+    bool extendLastRun(const TimeIndex_t& anIndex, const Value& aValue)
+    {
+      if (!m_IsRunLengthEncoded || m_Data.empty() || ValuesBufferProperties::isConcurrentAccess())
+        return false;
+
+      Run& Back = m_Data.back();
+
+      if ((Back.m_Count > 1 && anIndex-Back.lastIndex() != Back.m_Step) || !isSameValue(*Back.m_Value,aValue))
+        return false;
+
+      if (Back.m_Count == 1)
+        Back.m_Step = anIndex-Back.m_FirstIndex;
+
+      Back.m_Count++;
+      m_ValuesCount++;
 
-      return m_Data.end();
+      dropOldestValues();
 
+      return true;
+    }
+
+
+    template<typename ListType>
+    static void prependRunValues(const Run& R, const TimeIndex_t& aBeginIndex, const TimeIndex_t& anEndIndex,
+                                 ListType& IndValueList)
+    {
+      for (unsigned int i=R.m_Count; i>0; i--)
+      {
+        const TimeIndex_t Index = R.m_FirstIndex+(i-1)*R.m_Step;
+
+        if (Index < aBeginIndex)
+          return;
+
+        if (Index <= anEndIndex)
+          IndValueList.push_front(IndexedValue(Index,*R.m_Value));
+      }
     }
 };
 
@@ -139,9 +364,9 @@ class ValuesBuffer::PrivateImpl
 
 
 ValuesBuffer::ValuesBuffer():
-    m_PImpl(new PrivateImpl)
+    m_PImpl(new PrivateImpl(BufferSize))
 {
-  m_PImpl->m_Data.set_capacity(BufferSize);
+
 }
 
 
@@ -159,13 +384,42 @@ ValuesBuffer::~ValuesBuffer()
 // =====================================================================
 
 
+bool ValuesBuffer::setRunLengthEncoding(bool Enabled)
+{
+  PrivateImpl::ScopedLock Lock(m_PImpl);
+
+  if (!m_PImpl->m_Data.empty())
+    return false;
+
+  m_PImpl->m_IsRunLengthEncoded = Enabled;
+
+  return true;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool ValuesBuffer::isRunLengthEncoded() const
+{
+  return m_PImpl->m_IsRunLengthEncoded;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 bool ValuesBuffer::getValue(const TimeIndex_t& anIndex, Value* aValue) const
 {
-  PrivateImpl::DataContainer_t::const_iterator It = m_PImpl->findAtIndex(anIndex);
+  PrivateImpl::ScopedLock Lock(m_PImpl);
+
+  PrivateImpl::DataContainer_t::const_iterator It = m_PImpl->findReadableAtIndex(anIndex);
 
   if (It != m_PImpl->m_Data.end() && aValue->getType() == (*It).m_Value.get()->getType())
   {
-    *aValue = *((*It).m_Value);
+    *aValue = *((*It).m_Value.get());
 
     return true;
   }
@@ -180,7 +434,9 @@ bool ValuesBuffer::getValue(const TimeIndex_t& anIndex, Value* aValue) const
 
 Value* ValuesBuffer::value(const TimeIndex_t& anIndex) const
 {
-  PrivateImpl::DataContainer_t::const_iterator It = m_PImpl->findAtIndex(anIndex);
+  PrivateImpl::ScopedLock Lock(m_PImpl);
+
+  PrivateImpl::DataContainer_t::const_iterator It = m_PImpl->findReadableAtIndex(anIndex);
 
   if (It != m_PImpl->m_Data.end())
   {
@@ -197,7 +453,36 @@ Value* ValuesBuffer::value(const TimeIndex_t& anIndex) const
 
 Value* ValuesBuffer::currentValue() const
 {
-  return m_PImpl->m_Data.back().m_Value.get();
+  PrivateImpl::ScopedLock Lock(m_PImpl);
+
+  if (!ValuesBufferProperties::isReadIndexLimited())
+    return m_PImpl->m_Data.back().m_Value.get();
+
+  TimeIndex_t Index;
+  const PrivateImpl::Run* R = m_PImpl->findLatestReadable(Index);
+
+  if (R)
+    return R->m_Value.get();
+
+  return (Value*)0;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+Value* ValuesBuffer::currentValueIfIndex(const TimeIndex_t& anIndex) const
+{
+  PrivateImpl::ScopedLock Lock(m_PImpl);
+
+  TimeIndex_t Index;
+  const PrivateImpl::Run* R = m_PImpl->findLatestReadable(Index);
+
+  if (R && Index == anIndex)
+    return R->m_Value.get();
+
+  return (Value*)0;
 }
 
 
@@ -207,9 +492,35 @@ Value* ValuesBuffer::currentValue() const
 
 bool ValuesBuffer::getCurrentValue(Value* aValue) const
 {
-  if(aValue->getType() == m_PImpl->m_Data.back().m_Value->getType())
+  PrivateImpl::ScopedLock Lock(m_PImpl);
+
+  TimeIndex_t Index;
+  const PrivateImpl::Run* R = m_PImpl->findLatestReadable(Index);
+
+  if(R && aValue->getType() == R->m_Value->getType())
   {
-    *aValue = *(m_PImpl->m_Data.back()).m_Value;
+    *aValue = *(R->m_Value.get());
+
+    return true;
+  }
+  return false;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool ValuesBuffer::getCurrentValueIfIndex(const TimeIndex_t& anIndex, Value* aValue) const
+{
+  PrivateImpl::ScopedLock Lock(m_PImpl);
+
+  TimeIndex_t Index;
+  const PrivateImpl::Run* R = m_PImpl->findLatestReadable(Index);
+
+  if(R && Index == anIndex && aValue->getType() == R->m_Value->getType())
+  {
+    *aValue = *(R->m_Value.get());
 
     return true;
   }
@@ -223,10 +534,15 @@ bool ValuesBuffer::getCurrentValue(Value* aValue) const
 
 bool ValuesBuffer::getLatestIndexedValue(IndexedValue& IndValue) const
 {
-  if(!m_PImpl->m_Data.empty())
+  PrivateImpl::ScopedLock Lock(m_PImpl);
+
+  TimeIndex_t Index;
+  const PrivateImpl::Run* R = m_PImpl->findLatestReadable(Index);
+
+  if(R)
   {
-    IndValue.m_Index = m_PImpl->m_Data.back().m_Index;
-    IndValue.m_Value.reset(m_PImpl->m_Data.back().m_Value->clone());
+    IndValue.m_Index = Index;
+    IndValue.m_Value = R->m_Value;
 
     return true;
   }
@@ -240,16 +556,21 @@ bool ValuesBuffer::getLatestIndexedValue(IndexedValue& IndValue) const
 
 bool ValuesBuffer::getLatestIndexedValues(const TimeIndex_t& anIndex, IndexedValueList& IndValueList) const
 {
+  PrivateImpl::ScopedLock Lock(m_PImpl);
+
   IndValueList.clear();
 
   if(!m_PImpl->m_Data.empty())
   {
+    const TimeIndex_t Limit = PrivateImpl::readableIndexLimit();
+
     PrivateImpl::DataContainer_t::const_reverse_iterator rIt = m_PImpl->m_Data.rbegin();
     PrivateImpl::DataContainer_t::const_reverse_iterator rIte = m_PImpl->m_Data.rend();
 
-    while (rIt != rIte && (*rIt).getIndex() >= anIndex)
+    while (rIt != rIte && (*rIt).lastIndex() >= anIndex)
     {
-      IndValueList.push_front(*rIt);
+      if ((*rIt).m_FirstIndex <= Limit)
+        PrivateImpl::prependRunValues(*rIt,anIndex,std::min((*rIt).lastIndex(),Limit),IndValueList);
       ++rIt;
     }
 
@@ -266,16 +587,21 @@ bool ValuesBuffer::getLatestIndexedValues(const TimeIndex_t& anIndex, IndexedVal
 bool ValuesBuffer::getIndexedValues(const TimeIndex_t& aBeginIndex, const TimeIndex_t& anEndIndex,
                                     IndexedValueList& IndValueList) const
 {
+  PrivateImpl::ScopedLock Lock(m_PImpl);
+
   IndValueList.clear();
 
-  if(!m_PImpl->m_Data.empty() && aBeginIndex <= anEndIndex)
+  const TimeIndex_t EndIndex = std::min(anEndIndex,PrivateImpl::readableIndexLimit());
+
+  if(!m_PImpl->m_Data.empty() && aBeginIndex <= EndIndex)
   {
     PrivateImpl::DataContainer_t::const_reverse_iterator rIt = m_PImpl->m_Data.rbegin();
     PrivateImpl::DataContainer_t::const_reverse_iterator rIte = m_PImpl->m_Data.rend();
 
-    while (rIt != rIte && (*rIt).getIndex() >= aBeginIndex)
+    while (rIt != rIte && (*rIt).lastIndex() >= aBeginIndex)
     {
-      if  ((*rIt).getIndex() <= anEndIndex) IndValueList.push_front(*rIt);
+      if  ((*rIt).m_FirstIndex <= EndIndex)
+        PrivateImpl::prependRunValues(*rIt,aBeginIndex,EndIndex,IndValueList);
       ++rIt;
     }
 
@@ -292,9 +618,13 @@ bool ValuesBuffer::getIndexedValues(const TimeIndex_t& aBeginIndex, const TimeIn
 
 TimeIndex_t ValuesBuffer::getCurrentIndex() const
 {
-  if (!m_PImpl->m_Data.empty())
+  PrivateImpl::ScopedLock Lock(m_PImpl);
+
+  TimeIndex_t Index;
+
+  if (m_PImpl->findLatestReadable(Index))
   {
-    return m_PImpl->m_Data.back().m_Index;
+    return Index;
   }
   return -1;
 }
@@ -306,7 +636,9 @@ TimeIndex_t ValuesBuffer::getCurrentIndex() const
 
 bool ValuesBuffer::isValueExist(const TimeIndex_t& anIndex) const
 {
-  return (!m_PImpl->m_Data.empty() && m_PImpl->findAtIndex(anIndex) != m_PImpl->m_Data.end());
+  PrivateImpl::ScopedLock Lock(m_PImpl);
+
+  return (!m_PImpl->m_Data.empty() && m_PImpl->findReadableAtIndex(anIndex) != m_PImpl->m_Data.end());
 }
 
 
@@ -316,14 +648,51 @@ bool ValuesBuffer::isValueExist(const TimeIndex_t& anIndex) const
 
 bool ValuesBuffer::modifyValue(const TimeIndex_t& anIndex, const Value& aValue)
 {
+  PrivateImpl::ScopedLock Lock(m_PImpl);
+
   PrivateImpl::DataContainer_t::iterator It = m_PImpl->findAtIndex(anIndex);
 
-  if (It != m_PImpl->m_Data.end())
+  if (It == m_PImpl->m_Data.end())
+    return false;
+
+  if ((*It).m_Count == 1)
   {
-    (*It).m_Value.reset(aValue.clone());
+    (*It).m_Value.set(aValue);
     return true;
   }
-  return false;
+
+  if (PrivateImpl::isSameValue(*(*It).m_Value,aValue))
+    return true;
+
+  // the run is split around the modified value
+  const unsigned int Position = It-m_PImpl->m_Data.begin();
+  const unsigned int BeforeCount = (anIndex-(*It).m_FirstIndex)/(*It).m_Step;
+  const unsigned int AfterCount = (*It).m_Count-BeforeCount-1;
+
+  m_PImpl->reserveRuns(2);
+  It = m_PImpl->m_Data.begin()+Position;
+
+  if (AfterCount)
+  {
+    PrivateImpl::Run After(anIndex+(*It).m_Step,*(*It).m_Value);
+    After.m_Step = (*It).m_Step;
+    After.m_Count = AfterCount;
+    m_PImpl->m_Data.insert(It+1,std::move(After));
+    It = m_PImpl->m_Data.begin()+Position;
+  }
+
+  if (BeforeCount)
+  {
+    (*It).m_Count = BeforeCount;
+    m_PImpl->m_Data.insert(It+1,PrivateImpl::Run(anIndex,aValue));
+  }
+  else
+  {
+    (*It).m_Value.set(aValue);
+    (*It).m_Count = 1;
+  }
+
+  return true;
 }
 
 
@@ -333,11 +702,23 @@ bool ValuesBuffer::modifyValue(const TimeIndex_t& anIndex, const Value& aValue)
 
 bool ValuesBuffer::modifyCurrentValue(const Value& aValue)
 {
+  PrivateImpl::ScopedLock Lock(m_PImpl);
+
   if (m_PImpl->m_Data.empty()) return false;
 
-  PrivateImpl::DataContainer_t::iterator It = m_PImpl->m_Data.end();
-  --It;
-  (*It).m_Value.reset(aValue.clone());
+  PrivateImpl::Run& Back = m_PImpl->m_Data.back();
+
+  if (Back.m_Count == 1)
+    Back.m_Value.set(aValue);
+  else if (!PrivateImpl::isSameValue(*Back.m_Value,aValue))
+  {
+    // the latest value is detached from its run
+    const TimeIndex_t LastIndex = Back.lastIndex();
+    Back.m_Count--;
+
+    m_PImpl->reserveRuns(1);
+    m_PImpl->m_Data.push_back(PrivateImpl::Run(LastIndex,aValue));
+  }
 
   return true;
 }
@@ -349,9 +730,29 @@ bool ValuesBuffer::modifyCurrentValue(const Value& aValue)
 
 bool ValuesBuffer::appendValue(const TimeIndex_t& anIndex, const openfluid::core::Value& aValue)
 {
-  if (!m_PImpl->m_Data.empty() && anIndex <= m_PImpl->m_Data.back().m_Index) return false;
+  PrivateImpl::ScopedLock Lock(m_PImpl);
+
+  if (!m_PImpl->m_Data.empty() && anIndex <= m_PImpl->m_Data.back().lastIndex()) return false;
 
-  m_PImpl->m_Data.push_back(IndexedValue(anIndex,aValue));
+  if (!m_PImpl->extendLastRun(anIndex,aValue))
+    m_PImpl->pushRun(PrivateImpl::Run(anIndex,aValue));
+
+  return true;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool ValuesBuffer::appendValue(const TimeIndex_t& anIndex, openfluid::core::Value&& aValue)
+{
+  PrivateImpl::ScopedLock Lock(m_PImpl);
+
+  if (!m_PImpl->m_Data.empty() && anIndex <= m_PImpl->m_Data.back().lastIndex()) return false;
+
+  if (!m_PImpl->extendLastRun(anIndex,aValue))
+    m_PImpl->pushRun(PrivateImpl::Run(anIndex,std::move(aValue)));
 
   return true;
 }
@@ -363,7 +764,9 @@ bool ValuesBuffer::appendValue(const TimeIndex_t& anIndex, const openfluid::core
 
 unsigned int ValuesBuffer::getValuesCount() const
 {
-  return m_PImpl->m_Data.size();
+  PrivateImpl::ScopedLock Lock(m_PImpl);
+
+  return m_PImpl->m_ValuesCount;
 }
 
 
@@ -375,7 +778,9 @@ void ValuesBuffer::displayStatus(std::ostream& OStream) const
 {
   OStream << "-- ValuesBuffer status --" << std::endl;
   OStream << "   BufferSize : " << BufferSize << std::endl;
-  OStream << "   Size : " << m_PImpl->m_Data.size() << std::endl;
+  OStream << "   Size : " << m_PImpl->m_ValuesCount << std::endl;
+  if (m_PImpl->m_IsRunLengthEncoded)
+    OStream << "   Runs : " << m_PImpl->m_Data.size() << std::endl;
   OStream << "------------------------------" << std::endl;
 }
 
@@ -385,6 +790,8 @@ void ValuesBuffer::displayStatus(std::ostream& OStream) const
 
 void ValuesBuffer::displayContent(std::ostream& OStream) const
 {
+  PrivateImpl::ScopedLock Lock(m_PImpl);
+
   OStream << "-- ValuesBuffer content --" << std::endl;
 
   PrivateImpl::DataContainer_t::const_iterator Itb = m_PImpl->m_Data.begin();
@@ -393,7 +800,8 @@ void ValuesBuffer::displayContent(std::ostream& OStream) const
 
   while (It!=Ite)
   {
-    OStream << "[" << (*It).m_Index << "|" << (*It).m_Value.get()->toString() << "]" << std::endl;
+    for (unsigned int i=0; i<(*It).m_Count; i++)
+      OStream << "[" << (*It).m_FirstIndex+i*(*It).m_Step << "|" << (*It).m_Value.get()->toString() << "]" << std::endl;
     ++It;
   }
 
@@ -47,6 +47,12 @@ namespace openfluid { namespace core {
 
 
 
+/**
+  Buffer of the latest values of a variable, indexed by time index.
+  With run-length encoding enabled, identical values appended at a regular time step are stored once,
+  which suits constant or rarely changing variables. Encoded values are accessed exactly as other values,
+  but the values returned as pointers are shared by all the time indexes of a run.
+*/
 class OPENFLUID_API ValuesBuffer: public ValuesBufferProperties
 {
 
@@ -62,18 +68,54 @@ class OPENFLUID_API ValuesBuffer: public ValuesBufferProperties
 
     ~ValuesBuffer();
 
+    /**
+      Enables or disables the run-length encoding of values. It can only be changed while the buffer is empty.
+      Values appended while concurrent access is enabled are not encoded, each of them being stored separately
+      @param[in] Enabled true to enable run-length encoding, false to disable it
+      @return true if the encoding has been changed, false if the buffer already contains values
+    */
+    bool setRunLengthEncoding(bool Enabled);
+
+    /**
+      Returns true if the run-length encoding of values is enabled
+    */
+    bool isRunLengthEncoded() const;
+
     bool getValue(const TimeIndex_t& anIndex, Value* aValue) const;
 
+    /**
+      Returns a pointer to the value at the given time index, NULL if it does not exist.
+      When values are read concurrently by pipelined observers, the pointed value remains valid
+      for the time point being observed: the buffer keeps one more value than the requested buffer size,
+      and simulators only append or modify the value at the time index they are processing
+    */
     Value* value(const TimeIndex_t& anIndex) const;
 
+    /**
+      Returns a pointer to the latest value, readable from the calling thread.
+      The validity of the pointed value is the same as for value()
+    */
     Value* currentValue() const;
 
+    /**
+      Returns a pointer to the latest value readable from the calling thread if it is at the given time index,
+      NULL otherwise. The index and the value are read together, as a single operation
+    */
+    Value* currentValueIfIndex(const TimeIndex_t& anIndex) const;
+
     TimeIndex_t getCurrentIndex() const;
 
     bool isValueExist(const TimeIndex_t& anIndex) const;
 
     bool getCurrentValue(Value* aValue) const;
 
+    /**
+      Gets a copy of the latest value readable from the calling thread if it is at the given time index.
+      The index and the value are read together, as a single operation
+      @return true if the latest value is at the given index and of the same type as the given value
+    */
+    bool getCurrentValueIfIndex(const TimeIndex_t& anIndex, Value* aValue) const;
+
     bool getLatestIndexedValue(IndexedValue& IndValue) const;
 
     bool getLatestIndexedValues(const TimeIndex_t& anIndex, IndexedValueList& IndValueList) const;
@@ -87,6 +129,8 @@ class OPENFLUID_API ValuesBuffer: public ValuesBufferProperties
 
     bool appendValue(const TimeIndex_t& anIndex, const Value& aValue);
 
+    bool appendValue(const TimeIndex_t& anIndex, Value&& aValue);
+
     unsigned int getValuesCount() const;
 
     void displayStatus(std::ostream& OStream) const;
@@ -45,6 +45,54 @@ namespace openfluid { namespace core {
 
 unsigned int ValuesBufferProperties::BufferSize = 0;
 
+bool ValuesBufferProperties::ConcurrentAccess = false;
+
+
+static thread_local bool ReadIndexLimited = false;
+
+static thread_local TimeIndex_t ReadIndexLimit = 0;
+
+
+// =====================================================================
+// =====================================================================
+
+
+void ValuesBufferProperties::setReadIndexLimit(const TimeIndex_t& anIndex)
+{
+  ReadIndexLimit = anIndex;
+  ReadIndexLimited = true;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void ValuesBufferProperties::resetReadIndexLimit()
+{
+  ReadIndexLimited = false;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool ValuesBufferProperties::isReadIndexLimited()
+{
+  return ReadIndexLimited;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+TimeIndex_t ValuesBufferProperties::getReadIndexLimit()
+{
+  return ReadIndexLimit;
+}
+
 
 } } // namespaces
 
@@ -41,6 +41,7 @@
 #define __OPENFLUID_CORE_VALUESBUFFERPROPERTIES_HPP__
 
 #include <openfluid/dllexport.hpp>
+#include <openfluid/core/DateTime.hpp>
 
 
 namespace openfluid { namespace core {
@@ -50,6 +51,8 @@ class OPENFLUID_API ValuesBufferProperties
   protected:
     static unsigned int BufferSize;
 
+    static bool ConcurrentAccess;
+
 
   public:
 
@@ -62,6 +65,40 @@ class OPENFLUID_API ValuesBufferProperties
       if (BufferSize < 2) BufferSize = 2;
     };
 
+    /**
+      Returns true if values buffers may be read and written concurrently
+      (e.g. by pipelined observers), in which case each access is serialized
+      and the storage of values is never reallocated
+    */
+    static bool isConcurrentAccess()
+    { return ConcurrentAccess; };
+
+    static void setConcurrentAccess(const bool Concurrent)
+    { ConcurrentAccess = Concurrent; };
+
+    /**
+      Limits the values read from the calling thread to the given time index and the previous ones.
+      Pipelined observers read the values as they were at the end of the time point they process,
+      while simulators are already appending the values of the next time points
+      @param[in] anIndex the latest readable time index
+    */
+    static void setReadIndexLimit(const TimeIndex_t& anIndex);
+
+    /**
+      Removes the limit of the values read from the calling thread
+    */
+    static void resetReadIndexLimit();
+
+    /**
+      Returns true if the values read from the calling thread are limited to a time index
+    */
+    static bool isReadIndexLimited();
+
+    /**
+      Returns the latest time index readable from the calling thread, valid only if isReadIndexLimited() is true
+    */
+    static TimeIndex_t getReadIndexLimit();
+
 };
 
 
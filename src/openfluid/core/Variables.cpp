@@ -44,7 +44,8 @@ namespace core {
 // =====================================================================
 
 
-Variables::Variables()
+Variables::Variables() :
+  mp_ChangesLog(NULL), mp_OwnerUnit(NULL)
 {
 
 }
@@ -90,6 +91,182 @@ bool Variables::createVariable(const VariableName_t& aName, const Value::Type& a
 }
 
 
+// =====================================================================
+// =====================================================================
+
+
+bool Variables::setRunLengthEncoding(const VariableName_t& aName, bool Enabled)
+{
+  VariablesMap_t::iterator it = m_Data.find(aName);
+
+  return (it != m_Data.end() && it->second.first.setRunLengthEncoding(Enabled));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool Variables::isRunLengthEncoded(const VariableName_t& aName) const
+{
+  VariablesMap_t::const_iterator it = m_Data.find(aName);
+
+  return (it != m_Data.end() && it->second.first.isRunLengthEncoded());
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool Variables::getAggregatedValue(const Value& aValue, double& Val)
+{
+  if (aValue.isDoubleValue())
+  {
+    Val = aValue.asDoubleValue().get();
+    return true;
+  }
+  else if (aValue.isIntegerValue())
+  {
+    Val = aValue.asIntegerValue().get();
+    return true;
+  }
+
+  return false;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void Variables::appendToAggregates(const VariableName_t& aName, const TimeIndex_t& anIndex,
+                                   bool IsNumeric, double Val)
+{
+  if (!IsNumeric)
+    return;
+
+  AggregatesMap_t::iterator it = m_Aggregates.find(aName);
+
+  if (it != m_Aggregates.end())
+  {
+    for (auto& Aggr : it->second)
+      Aggr.append(anIndex,Val);
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void Variables::modifyInAggregates(const VariableName_t& aName, const TimeIndex_t& anIndex, const Value& aValue)
+{
+  AggregatesMap_t::iterator it = m_Aggregates.find(aName);
+
+  if (it != m_Aggregates.end())
+  {
+    double Val;
+    bool IsNumeric = getAggregatedValue(aValue,Val);
+
+    for (auto& Aggr : it->second)
+    {
+      if (IsNumeric)
+        Aggr.modify(anIndex,Val);
+      else
+        Aggr.remove(anIndex);
+    }
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool Variables::registerWindowedAggregate(const VariableName_t& aName,
+                                          WindowedAggregate::Method Meth, WindowedAggregate::WindowType Type,
+                                          unsigned long long Size)
+{
+  VariablesMap_t::const_iterator it = m_Data.find(aName);
+
+  if (it == m_Data.end())
+    return false;
+
+  if (windowedAggregate(aName,Meth,Type,Size))
+    return true;
+
+  WindowedAggregate Aggr(Meth,Type,Size);
+  fillAggregate(it->second.first,Aggr);
+
+  m_Aggregates[aName].push_back(Aggr);
+
+  return true;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void Variables::fillAggregate(const ValuesBuffer& Buffer, WindowedAggregate& Aggr)
+{
+  IndexedValueList Values;
+  Buffer.getLatestIndexedValues(0,Values);
+
+  double Val;
+  for (const auto& IndValue : Values)
+  {
+    if (getAggregatedValue(*IndValue.value(),Val))
+      Aggr.append(IndValue.getIndex(),Val);
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool Variables::computeWindowedAggregate(const VariableName_t& aName,
+                                         WindowedAggregate::Method Meth, WindowedAggregate::WindowType Type,
+                                         unsigned long long Size, double& Val) const
+{
+  VariablesMap_t::const_iterator it = m_Data.find(aName);
+
+  if (it == m_Data.end())
+    return false;
+
+  WindowedAggregate Aggr(Meth,Type,Size);
+  fillAggregate(it->second.first,Aggr);
+
+  return Aggr.get(Val);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+const WindowedAggregate* Variables::windowedAggregate(const VariableName_t& aName,
+                                                      WindowedAggregate::Method Meth,
+                                                      WindowedAggregate::WindowType Type,
+                                                      unsigned long long Size) const
+{
+  AggregatesMap_t::const_iterator it = m_Aggregates.find(aName);
+
+  if (it != m_Aggregates.end())
+  {
+    for (const auto& Aggr : it->second)
+    {
+      if (Aggr.isSameDefinition(Meth,Type,Size))
+        return &Aggr;
+    }
+  }
+
+  return (WindowedAggregate*) 0;
+}
+
+
 // =====================================================================
 // =====================================================================
 
@@ -100,11 +277,20 @@ bool Variables::createVariable(const VariableName_t& aName, const Value::Type& a
 bool Variables::modifyValue(const VariableName_t& aName, const TimeIndex_t& anIndex,
     const Value& aValue)
 {
-  if (isVariableExist(aName, anIndex)
-      && (m_Data[aName].second == openfluid::core::Value::NONE
+  VariablesMap_t::iterator it = m_Data.find(aName);
+
+  if (it != m_Data.end()
+      && (it->second.second == openfluid::core::Value::NONE
           || aValue.getType() == openfluid::core::Value::NULLL
-          || m_Data[aName].second == aValue.getType()))
-    return m_Data[aName].first.modifyValue(anIndex, aValue);
+          || it->second.second == aValue.getType())
+      && it->second.first.modifyValue(anIndex, aValue))
+  {
+    if (!m_Aggregates.empty())
+      modifyInAggregates(aName,anIndex,aValue);
+
+    recordChange(it,anIndex);
+    return true;
+  }
 
   return false;
 }
@@ -118,11 +304,20 @@ bool Variables::modifyValue(const VariableName_t& aName, const TimeIndex_t& anIn
  */
 bool Variables::modifyCurrentValue(const VariableName_t& aName, const Value& aValue)
 {
-  if (isVariableExist(aName)
-      && (m_Data[aName].second == openfluid::core::Value::NONE
+  VariablesMap_t::iterator it = m_Data.find(aName);
+
+  if (it != m_Data.end()
+      && (it->second.second == openfluid::core::Value::NONE
           || aValue.getType() == openfluid::core::Value::NULLL
-          || m_Data[aName].second == aValue.getType()))
-    return m_Data[aName].first.modifyCurrentValue(aValue);
+          || it->second.second == aValue.getType())
+      && it->second.first.modifyCurrentValue(aValue))
+  {
+    if (!m_Aggregates.empty())
+      modifyInAggregates(aName,it->second.first.getCurrentIndex(),aValue);
+
+    recordChange(it,it->second.first.getCurrentIndex());
+    return true;
+  }
 
   return false;
 }
@@ -137,11 +332,43 @@ bool Variables::modifyCurrentValue(const VariableName_t& aName, const Value& aVa
  */
 bool Variables::appendValue(const VariableName_t& aName, const TimeIndex_t& anIndex, const Value& aValue)
 {
-  if (isVariableExist(aName)
-      && (m_Data[aName].second == openfluid::core::Value::NONE
-          || aValue.getType() == openfluid::core::Value::NULLL
-          || m_Data[aName].second == aValue.getType()))
-    return m_Data[aName].first.appendValue(anIndex,aValue);
+  VariablesMap_t::iterator it = m_Data.find(aName);
+
+  if (it != m_Data.end() && isAcceptedType(it,aValue) && it->second.first.appendValue(anIndex,aValue))
+  {
+    if (!m_Aggregates.empty())
+    {
+      double Val = 0.0;
+      appendToAggregates(aName,anIndex,getAggregatedValue(aValue,Val),Val);
+    }
+
+    recordChange(it,anIndex);
+    return true;
+  }
+
+  return false;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool Variables::appendValue(const VariableName_t& aName, const TimeIndex_t& anIndex, Value&& aValue)
+{
+  VariablesMap_t::iterator it = m_Data.find(aName);
+
+  // the numeric value is read before the value is moved into the buffer
+  double Val = 0.0;
+  bool IsNumeric = !m_Aggregates.empty() && getAggregatedValue(aValue,Val);
+
+  if (it != m_Data.end() && isAcceptedType(it,aValue) && it->second.first.appendValue(anIndex,std::move(aValue)))
+  {
+    appendToAggregates(aName,anIndex,IsNumeric,Val);
+
+    recordChange(it,anIndex);
+    return true;
+  }
 
   return false;
 }
@@ -179,6 +406,21 @@ const Value* Variables::value(const VariableName_t& aName, const TimeIndex_t& an
 // =====================================================================
 
 
+const ValuesBuffer* Variables::valuesBuffer(const VariableName_t& aName) const
+{
+  VariablesMap_t::const_iterator it = m_Data.find(aName);
+
+  if (it != m_Data.end())
+    return &(it->second.first);
+
+  return (ValuesBuffer*) 0;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 const Value* Variables::currentValue(const VariableName_t& aName) const
 {
   VariablesMap_t::const_iterator it = m_Data.find(aName);
@@ -250,8 +492,8 @@ Value* Variables::currentValueIfIndex(const VariableName_t& aName, const TimeInd
 {
   VariablesMap_t::const_iterator it = m_Data.find(aName);
 
-  if (it != m_Data.end() && it->second.first.getCurrentIndex() == Index)
-    return it->second.first.currentValue();
+  if (it != m_Data.end())
+    return it->second.first.currentValueIfIndex(Index);
 
   return (Value*) 0;
 }
@@ -265,8 +507,7 @@ bool Variables::getCurrentValueIfIndex(const VariableName_t& aName, const TimeIn
 {
   VariablesMap_t::const_iterator it = m_Data.find(aName);
 
-  return (it != m_Data.end() &&
-          it->second.first.getCurrentIndex() == Index && it->second.first.getCurrentValue(aValue));
+  return (it != m_Data.end() && it->second.first.getCurrentValueIfIndex(Index,aValue));
 }
 
 
@@ -386,6 +627,7 @@ bool Variables::isAllVariablesCount(unsigned int Count) const
 void Variables::clear()
 {
   m_Data.clear();
+  m_Aggregates.clear();
 }
 
 
@@ -40,6 +40,8 @@
 
 #include <openfluid/core/TypeDefs.hpp>
 #include <openfluid/core/ValuesBuffer.hpp>
+#include <openfluid/core/VariablesChangesLog.hpp>
+#include <openfluid/core/WindowedAggregate.hpp>
 #include <openfluid/dllexport.hpp>
 
 
@@ -52,16 +54,100 @@ class OPENFLUID_API Variables
     typedef std::map<VariableName_t, std::pair<ValuesBuffer,Value::Type> > VariablesMap_t;
     VariablesMap_t m_Data;
 
+    VariablesChangesLog* mp_ChangesLog;
+
+    SpatialUnit* mp_OwnerUnit;
+
+    typedef std::map<VariableName_t, std::vector<WindowedAggregate> > AggregatesMap_t;
+    AggregatesMap_t m_Aggregates;
+
+    inline void recordChange(const VariablesMap_t::const_iterator& It, const TimeIndex_t& anIndex)
+    {
+      if (mp_ChangesLog && mp_ChangesLog->isEnabled())
+        mp_ChangesLog->record(anIndex,mp_OwnerUnit,&(It->first));
+    }
+
+    inline bool isAcceptedType(const VariablesMap_t::const_iterator& It, const Value& aValue) const
+    {
+      return (It->second.second == openfluid::core::Value::NONE
+              || aValue.getType() == openfluid::core::Value::NULLL
+              || It->second.second == aValue.getType());
+    }
+
+    static bool getAggregatedValue(const Value& aValue, double& Val);
+
+    void appendToAggregates(const VariableName_t& aName, const TimeIndex_t& anIndex, bool IsNumeric, double Val);
+
+    void modifyInAggregates(const VariableName_t& aName, const TimeIndex_t& anIndex, const Value& aValue);
+
+    static void fillAggregate(const ValuesBuffer& Buffer, WindowedAggregate& Aggr);
+
   public:
 
     Variables();
 
     ~Variables();
 
+    /**
+      Links these variables to a changes log, where appended and modified values are recorded
+      @param[in] ChangesLog the changes log
+      @param[in] OwnerUnit the spatial unit owning these variables
+    */
+    void linkToChangesLog(VariablesChangesLog* ChangesLog, SpatialUnit* OwnerUnit)
+    {
+      mp_ChangesLog = ChangesLog;
+      mp_OwnerUnit = OwnerUnit;
+    }
+
     bool createVariable(const VariableName_t& aName);
 
     bool createVariable(const VariableName_t& aName, const Value::Type& aType);
 
+    /**
+      Enables or disables the run-length encoding of the values of a variable,
+      for constant or rarely changing variables. It can only be changed while the variable has no value.
+      @param[in] aName the name of the variable
+      @param[in] Enabled true to enable run-length encoding, false to disable it
+      @return true if the encoding has been changed, false otherwise
+    */
+    bool setRunLengthEncoding(const VariableName_t& aName, bool Enabled);
+
+    bool isRunLengthEncoded(const VariableName_t& aName) const;
+
+    /**
+      Registers an aggregate over a sliding window of the latest values of a variable,
+      maintained incrementally as values are appended or modified.
+      Only numeric values (double and integer) are aggregated.
+      The aggregate is initialized from the values already stored for the variable.
+      Registering an already registered aggregate has no effect
+      @param[in] aName the name of the variable
+      @param[in] Meth the aggregation method
+      @param[in] Type the window type
+      @param[in] Size the number of values or the duration in seconds of the window, must be greater than 0
+      @return false if the variable does not exist, true otherwise
+    */
+    bool registerWindowedAggregate(const VariableName_t& aName,
+                                   WindowedAggregate::Method Meth, WindowedAggregate::WindowType Type,
+                                   unsigned long long Size);
+
+    /**
+      Returns the registered aggregate matching the given definition
+      @return the aggregate, or NULL if not registered
+    */
+    const WindowedAggregate* windowedAggregate(const VariableName_t& aName,
+                                               WindowedAggregate::Method Meth, WindowedAggregate::WindowType Type,
+                                               unsigned long long Size) const;
+
+    /**
+      Computes the value of an aggregate from the buffered values readable from the calling thread,
+      for readers which cannot use the registered aggregates as they are ahead of the read time index
+      (e.g. pipelined observers). Only the values still in the buffer are taken into account
+      @return false if the variable does not exist or if the window does not contain any numeric value
+    */
+    bool computeWindowedAggregate(const VariableName_t& aName,
+                                  WindowedAggregate::Method Meth, WindowedAggregate::WindowType Type,
+                                  unsigned long long Size, double& Val) const;
+
     bool modifyValue(const VariableName_t& aName, const TimeIndex_t& anIndex,
         const Value& aValue);
 
@@ -69,6 +155,8 @@ class OPENFLUID_API Variables
 
     bool appendValue(const VariableName_t& aName, const TimeIndex_t& anIndex, const Value& aValue);
 
+    bool appendValue(const VariableName_t& aName, const TimeIndex_t& anIndex, Value&& aValue);
+
     bool getValue(const VariableName_t& aName, const TimeIndex_t& anIndex,Value* aValue) const;
 
     const Value* value(const VariableName_t& aName, const TimeIndex_t& anIndex) const;
@@ -90,6 +178,13 @@ class OPENFLUID_API Variables
 
     Value* currentValueIfIndex(const VariableName_t& aName, const TimeIndex_t& Index) const;
 
+    /**
+      Returns the values buffer of a variable, which remains valid as long as the variable exists.
+      It allows readers to access the values of a variable at each time step without looking it up by name
+      @return the values buffer, or NULL if the variable does not exist
+    */
+    const ValuesBuffer* valuesBuffer(const VariableName_t& aName) const;
+
     bool isVariableExist(const VariableName_t& aName) const;
 
     bool isVariableExist(const VariableName_t& aName, const TimeIndex_t& anIndex) const;
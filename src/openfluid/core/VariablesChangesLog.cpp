@@ -0,0 +1,228 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+/**
+  @file VariablesChangesLog.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@supagro.inra.fr>
+ */
+
+
+#include <algorithm>
+#include <atomic>
+
+#include <openfluid/core/VariablesChangesLog.hpp>
+
+
+namespace openfluid { namespace core {
+
+
+static std::atomic<unsigned long long> LastLogID(0);
+
+// buffer of the log lastly fed by the current thread, avoiding a lookup at each record
+static thread_local unsigned long long CachedLogID = 0;
+
+static thread_local void* CachedThreadChanges = nullptr;
+
+
+// =====================================================================
+// =====================================================================
+
+
+VariablesChangesLog::VariablesChangesLog() :
+  m_ID(++LastLogID), m_Enabled(false)
+{
+
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+VariablesChangesLog::ThreadChanges& VariablesChangesLog::currentThreadChanges()
+{
+  if (CachedLogID == m_ID)
+    return *static_cast<ThreadChanges*>(CachedThreadChanges);
+
+  std::lock_guard<std::mutex> Lock(m_Mutex);
+
+  std::unique_ptr<ThreadChanges>& Changes = m_ThreadsChanges[std::this_thread::get_id()];
+
+  if (!Changes)
+    Changes.reset(new ThreadChanges());
+
+  CachedLogID = m_ID;
+  CachedThreadChanges = Changes.get();
+
+  return *Changes;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void VariablesChangesLog::mergeThreadsChanges() const
+{
+  for (auto& Thread : m_ThreadsChanges)
+  {
+    std::lock_guard<std::mutex> ThreadLock(Thread.second->m_Mutex);
+
+    auto IndexIt = m_Changes.end();
+
+    for (const auto& Change : Thread.second->m_Changes)
+    {
+      // changes of a thread are mostly recorded at the same time index
+      if (IndexIt == m_Changes.end() || IndexIt->first != Change.first)
+        IndexIt = m_Changes.insert(std::make_pair(Change.first,ChangedVariablesList_t())).first;
+
+      IndexIt->second.push_back(Change.second);
+    }
+
+    Thread.second->m_Changes.clear();
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void VariablesChangesLog::setEnabled(bool Enabled)
+{
+  std::lock_guard<std::mutex> Lock(m_Mutex);
+
+  m_Enabled = Enabled;
+
+  if (!m_Enabled)
+  {
+    mergeThreadsChanges();
+    m_Changes.clear();
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void VariablesChangesLog::record(const TimeIndex_t& Index, SpatialUnit* Unit, const VariableName_t* VarName)
+{
+  ThreadChanges& Changes = currentThreadChanges();
+
+  // only contended while the buffers are merged
+  std::lock_guard<std::mutex> Lock(Changes.m_Mutex);
+
+  Changes.m_Changes.emplace_back(Index,ChangedVariable(Unit,VarName));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+ChangedVariablesList_t VariablesChangesLog::getChanges(const TimeIndex_t& Index) const
+{
+  ChangedVariablesList_t Changes;
+
+  {
+    std::lock_guard<std::mutex> Lock(m_Mutex);
+
+    mergeThreadsChanges();
+
+    auto it = m_Changes.find(Index);
+
+    if (it == m_Changes.end())
+      return Changes;
+
+    Changes = it->second;
+  }
+
+  // a variable may have been appended then modified at the same index
+  std::sort(Changes.begin(),Changes.end());
+  Changes.erase(std::unique(Changes.begin(),Changes.end()),Changes.end());
+
+  return Changes;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void VariablesChangesLog::discardUntil(const TimeIndex_t& Index)
+{
+  std::lock_guard<std::mutex> Lock(m_Mutex);
+
+  mergeThreadsChanges();
+
+  m_Changes.erase(m_Changes.begin(),m_Changes.upper_bound(Index));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void VariablesChangesLog::discardUnit(const SpatialUnit* Unit)
+{
+  std::lock_guard<std::mutex> Lock(m_Mutex);
+
+  mergeThreadsChanges();
+
+  for (auto& IndexChanges : m_Changes)
+  {
+    ChangedVariablesList_t& Changes = IndexChanges.second;
+
+    Changes.erase(std::remove_if(Changes.begin(),Changes.end(),
+                                 [Unit](const ChangedVariable& C) { return C.unit() == Unit; }),
+                  Changes.end());
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void VariablesChangesLog::clear()
+{
+  std::lock_guard<std::mutex> Lock(m_Mutex);
+
+  mergeThreadsChanges();
+
+  m_Changes.clear();
+}
+
+
+} }  // namespaces
@@ -0,0 +1,185 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+/**
+  @file VariablesChangesLog.hpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@supagro.inra.fr>
+ */
+
+
+#ifndef __OPENFLUID_CORE_VARIABLESCHANGESLOG_HPP__
+#define __OPENFLUID_CORE_VARIABLESCHANGESLOG_HPP__
+
+#include <map>
+#include <vector>
+#include <mutex>
+#include <memory>
+#include <thread>
+
+#include <openfluid/dllexport.hpp>
+#include <openfluid/core/TypeDefs.hpp>
+#include <openfluid/core/DateTime.hpp>
+
+
+namespace openfluid { namespace core {
+
+
+class SpatialUnit;
+
+
+/**
+  Reference to a variable of a spatial unit which value has been appended or modified
+*/
+class OPENFLUID_API ChangedVariable
+{
+  private:
+
+    SpatialUnit* mp_Unit;
+
+    const VariableName_t* mp_VarName;
+
+
+  public:
+
+    ChangedVariable(SpatialUnit* Unit, const VariableName_t* VarName) :
+      mp_Unit(Unit), mp_VarName(VarName)
+    { }
+
+    /**
+      Returns the spatial unit owning the changed variable
+    */
+    inline SpatialUnit* unit() const
+    { return mp_Unit; }
+
+    /**
+      Returns the name of the changed variable
+    */
+    inline const VariableName_t& getVariableName() const
+    { return *mp_VarName; }
+
+    inline bool operator<(const ChangedVariable& Other) const
+    {
+      return (mp_Unit < Other.mp_Unit || (mp_Unit == Other.mp_Unit && mp_VarName < Other.mp_VarName));
+    }
+
+    inline bool operator==(const ChangedVariable& Other) const
+    { return (mp_Unit == Other.mp_Unit && mp_VarName == Other.mp_VarName); }
+};
+
+
+typedef std::vector<ChangedVariable> ChangedVariablesList_t;
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Log of the variables values appended or modified, ordered by time index.
+  Recording is disabled by default and is thread-safe, so it can be fed by threaded simulators.
+  Each thread records its changes in its own buffer, the buffers are merged into the log
+  when the changes are read or discarded.
+*/
+class OPENFLUID_API VariablesChangesLog
+{
+  private:
+
+    struct ThreadChanges
+    {
+      std::mutex m_Mutex;
+
+      std::vector<std::pair<TimeIndex_t,ChangedVariable>> m_Changes;
+    };
+
+    mutable std::map<TimeIndex_t,ChangedVariablesList_t> m_Changes;
+
+    std::map<std::thread::id,std::unique_ptr<ThreadChanges>> m_ThreadsChanges;
+
+    const unsigned long long m_ID;
+
+    bool m_Enabled;
+
+    mutable std::mutex m_Mutex;
+
+    ThreadChanges& currentThreadChanges();
+
+    /**
+      Moves the changes recorded by threads into the log, the log mutex must be locked
+    */
+    void mergeThreadsChanges() const;
+
+
+  public:
+
+    VariablesChangesLog();
+
+    inline bool isEnabled() const
+    { return m_Enabled; }
+
+    void setEnabled(bool Enabled);
+
+    /**
+      Records a change of a variable of a spatial unit at the given time index,
+      in the buffer of the calling thread
+      @param[in] Index the time index of the changed value
+      @param[in] Unit the spatial unit owning the variable
+      @param[in] VarName the name of the variable, must remain valid while recorded
+    */
+    void record(const TimeIndex_t& Index, SpatialUnit* Unit, const VariableName_t* VarName);
+
+    /**
+      Returns the variables changed at the given time index, without duplicates
+      @param[in] Index the time index
+    */
+    ChangedVariablesList_t getChanges(const TimeIndex_t& Index) const;
+
+    /**
+      Discards changes recorded at time indexes lower or equal to the given one
+      @param[in] Index the time index
+    */
+    void discardUntil(const TimeIndex_t& Index);
+
+    /**
+      Discards all changes related to the given spatial unit
+      @param[in] Unit the spatial unit
+    */
+    void discardUnit(const SpatialUnit* Unit);
+
+    void clear();
+};
+
+
+} }  // namespaces
+
+
+#endif /* __OPENFLUID_CORE_VARIABLESCHANGESLOG_HPP__ */
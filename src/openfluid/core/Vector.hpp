@@ -42,8 +42,12 @@
 
 
 #include <iostream>
+#include <algorithm>
+#include <utility>
+
 #include <openfluid/dllexport.hpp>
 #include <openfluid/base/FrameworkException.hpp>
+#include <openfluid/core/ArrayOperations.hpp>
 
 
 namespace openfluid { namespace core {
@@ -74,6 +78,8 @@ class OPENFLUID_API Vector
 
     static void copy(const Vector& Source, Vector& Dest);
 
+    void checkSameSize(const Vector& Other) const;
+
 
   public :
 
@@ -87,6 +93,11 @@ class OPENFLUID_API Vector
 	*/
     Vector(const Vector &Vector);
 
+    /**
+      Move constructor, the data are transferred without copy and the moved vector is left empty
+    */
+    Vector(Vector&& Vector);
+
 	/**
 	  Constructor, creates a vector containing Size elements
 	*/
@@ -122,7 +133,8 @@ class OPENFLUID_API Vector
     { return getSize(); };
 
     /**
-      Returns a pointer to the content of the vector (like C arrays)
+      Returns a pointer to the content of the vector (like C arrays).
+      The content is aligned on openfluid::core::ArrayAlignment bytes.
     */
     T* data() const { return m_Data; };
 
@@ -163,11 +175,30 @@ class OPENFLUID_API Vector
     */
     T& operator[](unsigned long Index);
 
+    /**
+      Returns a reference to the element at the given index, without range checking.
+      To be used in performance critical loops where the index is known to be valid.
+    */
+    inline T& uncheckedAt(unsigned long Index)
+    { return m_Data[Index]; };
+
+    /**
+      Returns a const reference to the element at the given index, without range checking.
+      To be used in performance critical loops where the index is known to be valid.
+    */
+    inline const T& uncheckedAt(unsigned long Index) const
+    { return m_Data[Index]; };
+
     /**
       Allocation operator
     */
     Vector<T>& operator=(const Vector &A);
 
+    /**
+      Move allocation operator, the data are transferred without copy and the moved vector is left empty
+    */
+    Vector<T>& operator=(Vector&& A);
+
     /**
       Fills the vector with given value
     */
@@ -179,6 +210,60 @@ class OPENFLUID_API Vector
     */
     void clear();
 
+    /**
+      Returns the sum of the elements of the vector
+    */
+    T sum() const
+    { return sumOfArray(m_Data,m_Size); };
+
+    /**
+      Returns the dot product of the vector with another vector of the same size
+      @throw openfluid::base::FrameworkException if the sizes are different
+    */
+    T dot(const Vector& Other) const;
+
+    /**
+      Returns the minimum value of the elements of the vector
+      @throw openfluid::base::FrameworkException if the vector is empty
+    */
+    T min() const;
+
+    /**
+      Returns the maximum value of the elements of the vector
+      @throw openfluid::base::FrameworkException if the vector is empty
+    */
+    T max() const;
+
+    /**
+      Adds A*X to the vector, X must have the same size as the vector
+      @throw openfluid::base::FrameworkException if the sizes are different
+    */
+    void axpy(const T& A, const Vector& X);
+
+    /**
+      Adds elementwise the given vector of the same size to the vector
+      @throw openfluid::base::FrameworkException if the sizes are different
+    */
+    void add(const Vector& X);
+
+    /**
+      Subtracts elementwise the given vector of the same size from the vector
+      @throw openfluid::base::FrameworkException if the sizes are different
+    */
+    void subtract(const Vector& X);
+
+    /**
+      Multiplies elementwise the vector by the given vector of the same size
+      @throw openfluid::base::FrameworkException if the sizes are different
+    */
+    void multiply(const Vector& X);
+
+    /**
+      Multiplies all elements of the vector by the given factor
+    */
+    void scale(const T& A)
+    { scaleArray(A,m_Data,m_Size); };
+
     /**
       Returns an iterator referring to the first element in the vector
       @return an iterator to the first element in the vector
@@ -241,6 +326,18 @@ Vector<T>::Vector(const Vector &A)
 // =====================================================================
 
 
+template <class T>
+Vector<T>::Vector(Vector&& A) :
+  m_Data(A.m_Data),m_Size(A.m_Size)
+{
+  A.init();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 template <class T>
 Vector<T>::Vector(unsigned long Size)
 {
@@ -309,7 +406,7 @@ bool Vector<T>::allocate(unsigned long Size)
 
   if (Size > 0)
   {
-    m_Data = new T[Size];
+    m_Data = allocateAlignedArray<T>(Size);
     if (m_Data != NULL)
       m_Size = Size;
     else
@@ -399,6 +496,25 @@ Vector<T>& Vector<T>::operator=(const Vector &A)
 // =====================================================================
 
 
+template <class T>
+Vector<T>& Vector<T>::operator=(Vector&& A)
+{
+  if (this == &A) return *this;
+
+  clear();
+
+  m_Data = A.m_Data;
+  m_Size = A.m_Size;
+  A.init();
+
+  return *this;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 template <class T>
 void Vector<T>::init()
 {
@@ -425,7 +541,7 @@ void Vector<T>::fill(const T& Val)
 template <class T>
 void Vector<T>::clear()
 {
-  delete [] m_Data;
+  freeAlignedArray(m_Data,m_Size);
   init();
 }
 
@@ -446,6 +562,111 @@ void Vector<T>::copy(const Vector& Source, Vector& Dest)
 }
 
 
+// =====================================================================
+// =====================================================================
+
+
+template <class T>
+void Vector<T>::checkSameSize(const Vector& Other) const
+{
+  if (Other.m_Size != m_Size)
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"vectors sizes mismatch");
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template <class T>
+T Vector<T>::dot(const Vector& Other) const
+{
+  checkSameSize(Other);
+
+  return dotOfArrays(m_Data,Other.m_Data,m_Size);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template <class T>
+T Vector<T>::min() const
+{
+  if (m_Size == 0)
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"minimum of an empty vector");
+
+  return minOfArray(m_Data,m_Size);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template <class T>
+T Vector<T>::max() const
+{
+  if (m_Size == 0)
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"maximum of an empty vector");
+
+  return maxOfArray(m_Data,m_Size);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template <class T>
+void Vector<T>::axpy(const T& A, const Vector& X)
+{
+  checkSameSize(X);
+
+  axpyOfArrays(A,X.m_Data,m_Data,m_Size);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template <class T>
+void Vector<T>::add(const Vector& X)
+{
+  checkSameSize(X);
+
+  addArrays(X.m_Data,m_Data,m_Size);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template <class T>
+void Vector<T>::subtract(const Vector& X)
+{
+  checkSameSize(X);
+
+  subtractArrays(X.m_Data,m_Data,m_Size);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+template <class T>
+void Vector<T>::multiply(const Vector& X)
+{
+  checkSameSize(X);
+
+  multiplyArrays(X.m_Data,m_Data,m_Size);
+}
+
+
 } }  // namespaces
 
 
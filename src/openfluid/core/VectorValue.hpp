@@ -134,6 +134,14 @@ class OPENFLUID_API VectorValue : public CompoundValue, public Vector<double>
       Vector<double>(static_cast<const Vector<double>& >(Val))
     {  };
 
+    /**
+      Move constructor, the data are transferred without copy and the moved value is left empty
+    */
+    VectorValue(VectorValue&& Val) :
+      CompoundValue(static_cast<const CompoundValue&>(Val)),
+      Vector<double>(static_cast<Vector<double>&& >(Val))
+    {  };
+
     /**
       Constructor, creates a vector containing Size elements
     */
@@ -154,6 +162,24 @@ class OPENFLUID_API VectorValue : public CompoundValue, public Vector<double>
 
     Value& operator =(const Value& Other);
 
+    /**
+      Copy assignment operator
+    */
+    VectorValue& operator =(const VectorValue& Other)
+    {
+      Vector<double>::operator=(static_cast<const Vector<double>&>(Other));
+      return *this;
+    };
+
+    /**
+      Move assignment operator, the data are transferred without copy and the moved value is left empty
+    */
+    VectorValue& operator =(VectorValue&& Other)
+    {
+      Vector<double>::operator=(static_cast<Vector<double>&&>(Other));
+      return *this;
+    };
+
     virtual ~VectorValue()
     {  };
 
@@ -0,0 +1,233 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+/**
+  @file WindowedAggregate.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@supagro.inra.fr>
+*/
+
+
+#include <algorithm>
+
+#include <openfluid/core/WindowedAggregate.hpp>
+#include <openfluid/base/FrameworkException.hpp>
+
+
+namespace openfluid { namespace core {
+
+
+WindowedAggregate::WindowedAggregate(Method Meth, WindowType Type, unsigned long long Size) :
+  m_Method(Meth), m_WindowType(Type), m_Size(Size), m_Sum(0.0), m_RemovalsSinceSum(0)
+{
+  if (!Size)
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"Window size cannot be 0");
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void WindowedAggregate::pushExtremum(const TimeIndex_t& Index, double Value)
+{
+  while (!m_Extrema.empty() && isBetterOrEqual(Value,m_Extrema.back().m_Value))
+    m_Extrema.pop_back();
+
+  m_Extrema.emplace_back(Index,Value);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void WindowedAggregate::dropFront()
+{
+  const Item& Front = m_Window.front();
+
+  if (m_Method == SUM || m_Method == MEAN)
+  {
+    m_Sum -= Front.m_Value;
+    m_RemovalsSinceSum++;
+  }
+  else if (!m_Extrema.empty() && m_Extrema.front().m_Index == Front.m_Index)
+    m_Extrema.pop_front();
+
+  m_Window.pop_front();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void WindowedAggregate::shrink()
+{
+  if (m_WindowType == LASTVALUES)
+  {
+    while (m_Window.size() > m_Size)
+      dropFront();
+  }
+  else
+  {
+    const TimeIndex_t Latest = m_Window.back().m_Index;
+
+    while (Latest - m_Window.front().m_Index >= m_Size)
+      dropFront();
+  }
+
+  // the running sum is recomputed once the window has been renewed, to prevent the accumulation
+  // of rounding errors; this keeps the amortized cost constant
+  if (m_RemovalsSinceSum && m_RemovalsSinceSum >= m_Window.size())
+    rebuild();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void WindowedAggregate::rebuild()
+{
+  m_Sum = 0.0;
+  m_RemovalsSinceSum = 0;
+  m_Extrema.clear();
+
+  for (const auto& I : m_Window)
+  {
+    if (m_Method == SUM || m_Method == MEAN)
+      m_Sum += I.m_Value;
+    else
+      pushExtremum(I.m_Index,I.m_Value);
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool WindowedAggregate::append(const TimeIndex_t& Index, double Value)
+{
+  if (!m_Window.empty() && Index <= m_Window.back().m_Index)
+    return false;
+
+  m_Window.emplace_back(Index,Value);
+
+  if (m_Method == SUM || m_Method == MEAN)
+    m_Sum += Value;
+  else
+    pushExtremum(Index,Value);
+
+  shrink();
+
+  return true;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void WindowedAggregate::modify(const TimeIndex_t& Index, double Value)
+{
+  auto It = std::lower_bound(m_Window.begin(),m_Window.end(),Index,
+                             [](const Item& I, const TimeIndex_t& Idx) { return I.m_Index < Idx; });
+
+  if (It == m_Window.end() || It->m_Index != Index)
+    return;
+
+  if (m_Method == SUM || m_Method == MEAN)
+  {
+    m_Sum += Value - It->m_Value;
+    It->m_Value = Value;
+  }
+  else
+  {
+    It->m_Value = Value;
+    rebuild();
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void WindowedAggregate::remove(const TimeIndex_t& Index)
+{
+  auto It = std::lower_bound(m_Window.begin(),m_Window.end(),Index,
+                             [](const Item& I, const TimeIndex_t& Idx) { return I.m_Index < Idx; });
+
+  if (It == m_Window.end() || It->m_Index != Index)
+    return;
+
+  m_Window.erase(It);
+  rebuild();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool WindowedAggregate::get(double& Value) const
+{
+  if (m_Window.empty())
+    return false;
+
+  if (m_Method == SUM)
+    Value = m_Sum;
+  else if (m_Method == MEAN)
+    Value = m_Sum / m_Window.size();
+  else
+    Value = m_Extrema.front().m_Value;
+
+  return true;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void WindowedAggregate::clear()
+{
+  m_Window.clear();
+  m_Extrema.clear();
+  m_Sum = 0.0;
+  m_RemovalsSinceSum = 0;
+}
+
+
+} }  // namespaces
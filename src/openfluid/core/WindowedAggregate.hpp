@@ -0,0 +1,178 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+/**
+  @file WindowedAggregate.hpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@supagro.inra.fr>
+*/
+
+
+#ifndef __OPENFLUID_CORE_WINDOWEDAGGREGATE_HPP__
+#define __OPENFLUID_CORE_WINDOWEDAGGREGATE_HPP__
+
+#include <deque>
+
+#include <openfluid/dllexport.hpp>
+#include <openfluid/core/DateTime.hpp>
+
+
+namespace openfluid { namespace core {
+
+
+/**
+  Aggregate (sum, mean, min or max) of the latest values of a variable, over a sliding window
+  of a given number of values or a given duration. The aggregate is updated incrementally
+  each time a value is appended, and reading it is done in constant time.
+*/
+class OPENFLUID_API WindowedAggregate
+{
+  public:
+
+    enum Method { SUM, MEAN, MIN, MAX };
+
+    enum WindowType { LASTVALUES, LASTSECONDS };
+
+
+  private:
+
+    struct Item
+    {
+      TimeIndex_t m_Index;
+
+      double m_Value;
+
+      Item(const TimeIndex_t& Index, double Value) :
+        m_Index(Index), m_Value(Value)
+      { }
+    };
+
+    Method m_Method;
+
+    WindowType m_WindowType;
+
+    unsigned long long m_Size;
+
+    std::deque<Item> m_Window;
+
+    /**
+      Candidates for min or max value, in increasing time indexes and in strictly
+      increasing (min) or decreasing (max) values
+    */
+    std::deque<Item> m_Extrema;
+
+    double m_Sum;
+
+    /**
+      Number of values removed from the window since the running sum was last recomputed
+    */
+    unsigned long long m_RemovalsSinceSum;
+
+    inline bool isBetterOrEqual(double Value, double Other) const
+    {
+      return (m_Method == MIN ? Value <= Other : Value >= Other);
+    }
+
+    void pushExtremum(const TimeIndex_t& Index, double Value);
+
+    void dropFront();
+
+    void shrink();
+
+    void rebuild();
+
+
+  public:
+
+    /**
+      @param[in] Meth the aggregation method
+      @param[in] Type the window type, over a number of values or over a duration in seconds
+      @param[in] Size the number of values or the duration of the window, must be greater than 0
+    */
+    WindowedAggregate(Method Meth, WindowType Type, unsigned long long Size);
+
+    inline Method getMethod() const
+    { return m_Method; }
+
+    inline WindowType getWindowType() const
+    { return m_WindowType; }
+
+    inline unsigned long long getSize() const
+    { return m_Size; }
+
+    inline bool isSameDefinition(Method Meth, WindowType Type, unsigned long long Size) const
+    { return (m_Method == Meth && m_WindowType == Type && m_Size == Size); }
+
+    /**
+      Adds a value at the end of the window and removes values which fell out of it.
+      The time index must be greater than the one of the previously appended value
+      @param[in] Index the time index of the value
+      @param[in] Value the value
+      @return false if the time index is not greater than the latest one, true otherwise
+    */
+    bool append(const TimeIndex_t& Index, double Value);
+
+    /**
+      Replaces the value at the given time index if it is in the window
+      @param[in] Index the time index of the value
+      @param[in] Value the new value
+    */
+    void modify(const TimeIndex_t& Index, double Value);
+
+    /**
+      Removes the value at the given time index if it is in the window,
+      for a value replaced by a non numeric value
+      @param[in] Index the time index of the value
+    */
+    void remove(const TimeIndex_t& Index);
+
+    /**
+      Gets the current value of the aggregate
+      @param[out] Value the value of the aggregate
+      @return false if the window contains no value, true otherwise
+    */
+    bool get(double& Value) const;
+
+    /**
+      Returns the number of values currently in the window
+    */
+    inline unsigned long long getValuesCount() const
+    { return m_Window.size(); }
+
+    void clear();
+};
+
+
+} }  // namespaces
+
+
+#endif /* __OPENFLUID_CORE_WINDOWEDAGGREGATE_HPP__ */
@@ -0,0 +1,182 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+
+/**
+  @file DateTimeParser_TEST.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@supagro.inra.fr>
+ */
+
+
+#define BOOST_TEST_MAIN
+#define BOOST_AUTO_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE unittest_datetimeparser
+#include <boost/test/unit_test.hpp>
+#include <boost/test/auto_unit_test.hpp>
+#include <sstream>
+#include <vector>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <openfluid/core/DateTimeParser.hpp>
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_construction)
+{
+  BOOST_REQUIRE(openfluid::core::DateTimeParser("%Y-%m-%dT%H:%M:%S").isCompiled());
+  BOOST_REQUIRE(openfluid::core::DateTimeParser("%d/%m/%Y %Hh%Mm%Ss").isCompiled());
+  BOOST_REQUIRE(openfluid::core::DateTimeParser("%Y%m%d").isCompiled());
+
+  BOOST_REQUIRE(!openfluid::core::DateTimeParser("%Y-%b-%d").isCompiled());
+  BOOST_REQUIRE(!openfluid::core::DateTimeParser("%H:%M:%S").isCompiled());
+  BOOST_REQUIRE(!openfluid::core::DateTimeParser("%Y-%m-%d %").isCompiled());
+
+  BOOST_REQUIRE_EQUAL(openfluid::core::DateTimeParser("%Y-%m-%d").getFormat(),"%Y-%m-%d");
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_operations)
+{
+  openfluid::core::DateTime DT;
+
+  openfluid::core::DateTimeParser ISOParser("%Y-%m-%dT%H:%M:%S");
+
+  BOOST_REQUIRE(ISOParser.parse("2013-08-06T17:37:53",DT));
+  BOOST_REQUIRE(DT == openfluid::core::DateTime(2013,8,6,17,37,53));
+
+  std::string Str("2001-02-03T04:05:06");
+  BOOST_REQUIRE(ISOParser.parse(Str.data(),Str.data()+Str.size(),DT));
+  BOOST_REQUIRE(DT == openfluid::core::DateTime(2001,2,3,4,5,6));
+
+  BOOST_REQUIRE(!ISOParser.parse("2001-2-3T4:5:6",DT));
+  BOOST_REQUIRE(!ISOParser.parse("2013-13-06T17:37:53",DT));
+  BOOST_REQUIRE(!ISOParser.parse("2013-02-29T17:37:53",DT));
+  BOOST_REQUIRE(!ISOParser.parse("",DT));
+  BOOST_REQUIRE(DT == openfluid::core::DateTime(2001,2,3,4,5,6));
+
+  // characters remaining after the end of the format are ignored
+  BOOST_REQUIRE(ISOParser.parse("1999-12-31T23:59:59 12.5",DT));
+  BOOST_REQUIRE(DT == openfluid::core::DateTime(1999,12,31,23,59,59));
+  BOOST_REQUIRE(ISOParser.parse("1999-12-31T23:59:580",DT));
+  BOOST_REQUIRE(DT == openfluid::core::DateTime(1999,12,31,23,59,58));
+
+  // missing time fields are set to 0
+  BOOST_REQUIRE(ISOParser.parse("2013-08-06T17:37",DT));
+  BOOST_REQUIRE(DT == openfluid::core::DateTime(2013,8,6,17,37,0));
+
+
+  openfluid::core::DateTimeParser SpacesParser("%d/%m/%Y %Hh%Mm%Ss");
+
+  BOOST_REQUIRE(SpacesParser.parse("25/06/2012 12h35m06s",DT));
+  BOOST_REQUIRE(DT == openfluid::core::DateTime(2012,6,25,12,35,6));
+
+  BOOST_REQUIRE(SpacesParser.parse("25/06/2012\t12h35m07s",DT));
+  BOOST_REQUIRE(DT == openfluid::core::DateTime(2012,6,25,12,35,7));
+
+  BOOST_REQUIRE(!SpacesParser.parse("25/06/2012  12h35m08s",DT));
+  BOOST_REQUIRE(DT == openfluid::core::DateTime(2012,6,25,12,35,7));
+
+
+  openfluid::core::DateTimeParser DateTimeParser("%Y-%m-%d %H:%M:%S");
+
+  BOOST_REQUIRE(DateTimeParser.parse("2013-08-06",DT));
+  BOOST_REQUIRE(DT == openfluid::core::DateTime(2013,8,6,0,0,0));
+
+
+  openfluid::core::DateTimeParser DateParser("%Y%m%d");
+
+  BOOST_REQUIRE(DateParser.parse("20140315",DT));
+  BOOST_REQUIRE(DT == openfluid::core::DateTime(2014,3,15,0,0,0));
+  BOOST_REQUIRE(!DateParser.parse("2014315",DT));
+
+
+  // not compiled format, parsed using facet
+  openfluid::core::DateTimeParser FacetParser("%Y-%b-%d %H:%M:%S");
+
+  BOOST_REQUIRE(FacetParser.parse("2014-Mar-15 10:20:30",DT));
+  BOOST_REQUIRE(DT == openfluid::core::DateTime(2014,3,15,10,20,30));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_facet_compatibility)
+{
+  const std::string FormatStr("%Y-%m-%d %H:%M:%S");
+  openfluid::core::DateTimeParser Parser(FormatStr);
+
+  BOOST_REQUIRE(Parser.isCompiled());
+
+  const std::vector<std::string> Inputs = {
+    "2013-08-06 17:37:53","2013-8-6 1:2:3","2013-08-06  17:37:53","2013-08-06\t17:37:53"," 2013-08-06 17:37:53",
+    "2013-08-06 17:37:53 ","2013-08-06 17:37:53 extra","2013-08-06 17:37:530","2013-08-06x17:37:53",
+    "2013-08-06","2013-08-06 17","2013","2013-08-06 25:37:53","2013-08-06 17:37:61","2013-13-06 17:37:53",
+    "2012-02-29 00:00:00","2013-02-29 00:00:00","1399-12-31 23:59:59","1400-01-01 00:00:00","02013-08-06 17:37:53",
+    ""
+  };
+
+  for (const auto& Input : Inputs)
+  {
+    BOOST_TEST_MESSAGE(Input);
+
+    // reference parsing using the boost facet
+    boost::posix_time::time_input_facet* Facet = new boost::posix_time::time_input_facet(FormatStr);
+    std::istringstream StrS(Input);
+    StrS.imbue(std::locale(std::locale::classic(),Facet));
+    boost::posix_time::ptime Time(boost::posix_time::not_a_date_time);
+    StrS >> Time;
+
+    openfluid::core::DateTime DT(2000,1,1,0,0,0);
+    const bool Parsed = Parser.parse(Input,DT);
+
+    BOOST_REQUIRE_EQUAL(Parsed,Time != boost::posix_time::not_a_date_time);
+
+    if (Parsed)
+      BOOST_REQUIRE(DT == openfluid::core::DateTime(Time.date().year(),Time.date().month(),Time.date().day(),
+                                                    Time.time_of_day().hours(),Time.time_of_day().minutes(),
+                                                    Time.time_of_day().seconds()));
+    else
+      BOOST_REQUIRE(DT == openfluid::core::DateTime(2000,1,1,0,0,0));
+  }
+}
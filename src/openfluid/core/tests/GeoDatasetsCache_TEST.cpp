@@ -0,0 +1,164 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+/**
+  @file GeoDatasetsCache_TEST.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@supagro.inra.fr>
+ */
+
+
+#define BOOST_TEST_MAIN
+#define BOOST_AUTO_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE unittest_geodatasetscache
+#include <boost/test/unit_test.hpp>
+#include <boost/test/auto_unit_test.hpp>
+#include <tests-config.hpp>
+#include <openfluid/base/FrameworkException.hpp>
+#include <openfluid/core/GeoDatasetsCache.hpp>
+#include <openfluid/core/Datastore.hpp>
+#include <openfluid/core/DatastoreItem.hpp>
+#include <openfluid/core/GeoVectorValue.hpp>
+#include <openfluid/core/GeoRasterValue.hpp>
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_vector_reuse)
+{
+  openfluid::core::GeoDatasetsCache Cache;
+
+  openfluid::core::GeoVectorValue* Val1 =
+      new openfluid::core::GeoVectorValue(CONFIGTESTS_INPUT_MISCDATA_DIR,"GeoVectorValue/SU.shp");
+  openfluid::core::GeoVectorValue* Val2 =
+      new openfluid::core::GeoVectorValue(CONFIGTESTS_INPUT_MISCDATA_DIR,"GeoVectorValue/SU.shp");
+  Val1->setDatasetsCache(&Cache);
+  Val2->setDatasetsCache(&Cache);
+
+  // lazy opening
+  BOOST_REQUIRE_EQUAL(Cache.getDatasetsCount(),0);
+
+  OGRDataSource* DS = Val1->data();
+
+  BOOST_REQUIRE(DS);
+  BOOST_REQUIRE_EQUAL(Cache.getDatasetsCount(),1);
+  BOOST_REQUIRE_EQUAL(Cache.getReferencesCount(DS),1);
+
+  // each consumer gets its own datasource, with its own reading cursors
+  BOOST_REQUIRE(Val2->data() != DS);
+  BOOST_REQUIRE_EQUAL(Cache.getDatasetsCount(),2);
+
+  OGRFeature* Feature1 = Val1->layer()->GetNextFeature();
+  Val2->layer()->ResetReading();
+  OGRFeature* Feature2 = Val1->layer()->GetNextFeature();
+  BOOST_REQUIRE(Feature1 && Feature2);
+  BOOST_REQUIRE(Feature1->GetFID() != Feature2->GetFID());
+  OGRFeature::DestroyFeature(Feature1);
+  OGRFeature::DestroyFeature(Feature2);
+
+  // released datasource is reused for the same file, even through a non canonical path
+  delete Val1;
+  BOOST_REQUIRE(Cache.isCached(DS));
+  BOOST_REQUIRE_EQUAL(Cache.getReferencesCount(DS),0);
+
+  OGRDataSource* SameDS =
+      Cache.acquireVector(CONFIGTESTS_INPUT_MISCDATA_DIR+"/GeoVectorValue/../GeoVectorValue/./SU.shp");
+  BOOST_REQUIRE_EQUAL(SameDS,DS);
+  BOOST_REQUIRE_EQUAL(Cache.getReferencesCount(DS),1);
+  BOOST_REQUIRE_EQUAL(Cache.getDatasetsCount(),2);
+  Cache.release(SameDS);
+
+  BOOST_REQUIRE(Val2->containsField("OFLD_ID"));
+  delete Val2;
+  BOOST_REQUIRE_EQUAL(Cache.getDatasetsCount(),2);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_modes_and_kinds)
+{
+  openfluid::core::GeoDatasetsCache Cache;
+
+  GDALDataset* RasterDS = Cache.acquireRaster(CONFIGTESTS_INPUT_MISCDATA_DIR+"/GeoRasterValue/dem.Gtiff");
+  BOOST_REQUIRE(RasterDS);
+
+  openfluid::core::GeoRasterValue Val(CONFIGTESTS_INPUT_MISCDATA_DIR,"GeoRasterValue/dem.Gtiff");
+  Val.setDatasetsCache(&Cache);
+  BOOST_REQUIRE_EQUAL(Val.data(),RasterDS);
+  BOOST_REQUIRE_EQUAL(Cache.getReferencesCount(RasterDS),2);
+
+  OGRDataSource* ReadOnlyDS = Cache.acquireVector(CONFIGTESTS_INPUT_MISCDATA_DIR+"/GeoVectorValue/RS.shp");
+  OGRDataSource* UpdateDS = Cache.acquireVector(CONFIGTESTS_INPUT_MISCDATA_DIR+"/GeoVectorValue/RS.shp",
+                                                openfluid::core::GeoDatasetsCache::Update);
+  BOOST_REQUIRE(ReadOnlyDS != UpdateDS);
+  BOOST_REQUIRE_EQUAL(Cache.getDatasetsCount(),3);
+  BOOST_REQUIRE(ReadOnlyDS->GetLayer(0));
+
+  Cache.release(UpdateDS);
+  Cache.release(ReadOnlyDS);
+  Cache.release(RasterDS);
+  BOOST_REQUIRE_EQUAL(Cache.getReferencesCount(RasterDS),1);
+
+  // releasing unknown or already released handles is harmless
+  Cache.release(NULL);
+  Cache.release(ReadOnlyDS);
+  BOOST_REQUIRE_EQUAL(Cache.getReferencesCount(ReadOnlyDS),0);
+
+  BOOST_REQUIRE_THROW(Cache.acquireVector(CONFIGTESTS_INPUT_MISCDATA_DIR+"/WrongDir"),
+                      openfluid::base::FrameworkException);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_datastore_ownership)
+{
+  openfluid::core::Datastore Store;
+
+  Store.addItem(new openfluid::core::DatastoreItem("SU",CONFIGTESTS_INPUT_MISCDATA_DIR,"GeoVectorValue/SU.shp",
+                                                   openfluid::core::UnstructuredValue::GeoVectorValue));
+
+  BOOST_REQUIRE_EQUAL(Store.datasetsCache()->getDatasetsCount(),0);
+
+  openfluid::core::GeoVectorValue* Val =
+      dynamic_cast<openfluid::core::GeoVectorValue*>(Store.item("SU")->value());
+
+  BOOST_REQUIRE(Store.datasetsCache()->isCached(Val->data()));
+  BOOST_REQUIRE_EQUAL(Store.datasetsCache()->getDatasetsCount(),1);
+}
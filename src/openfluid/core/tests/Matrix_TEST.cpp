@@ -44,6 +44,9 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/test/auto_unit_test.hpp>
 #include <boost/test/floating_point_comparison.hpp>
+#include <cstdint>
+#include <utility>
+
 #include <openfluid/core/Matrix.hpp>
 
 
@@ -110,3 +113,61 @@ BOOST_AUTO_TEST_CASE(check_operations)
 // =====================================================================
 // =====================================================================
 
+
+BOOST_AUTO_TEST_CASE(check_move)
+{
+  openfluid::core::Matrix<double> M1(10,5,1.5);
+  double* Data = M1.data();
+
+  BOOST_REQUIRE_EQUAL(reinterpret_cast<std::uintptr_t>(Data) % openfluid::core::ArrayAlignment,0);
+
+  openfluid::core::Matrix<double> M2(std::move(M1));
+  BOOST_REQUIRE_EQUAL(M2.data(),Data);
+  BOOST_REQUIRE_EQUAL(M2.getColsNbr(),10);
+  BOOST_REQUIRE_EQUAL(M2.getRowsNbr(),5);
+  BOOST_REQUIRE_EQUAL(M1.size(),0);
+
+  openfluid::core::Matrix<double> M3;
+  M3 = std::move(M2);
+  BOOST_REQUIRE_EQUAL(M3.data(),Data);
+  BOOST_REQUIRE_EQUAL(M2.size(),0);
+  BOOST_REQUIRE_CLOSE(M3.uncheckedAt(9,4),1.5,0.0001);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_arithmetic)
+{
+  openfluid::core::Matrix<double> M1(20,10);
+  openfluid::core::Matrix<double> M2(20,10,2.0);
+  openfluid::core::Matrix<double> M3(10,20,2.0);
+
+  for (unsigned long i=0; i<20; i++)
+    for (unsigned long j=0; j<10; j++)
+      M1.uncheckedAt(i,j) = i*10+j;
+
+  BOOST_REQUIRE_CLOSE(M1.sum(),199*200/2.0,0.0001);
+  BOOST_REQUIRE_CLOSE(M1.dot(M2),199*200,0.0001);
+  BOOST_REQUIRE_CLOSE(M1.min(),0.0,0.0001);
+  BOOST_REQUIRE_CLOSE(M1.max(),199.0,0.0001);
+
+  M2.axpy(2.0,M1);
+  BOOST_REQUIRE_CLOSE(M2.at(1,2),26.0,0.0001);
+
+  M2.subtract(M1);
+  M2.multiply(M1);
+  M2.scale(0.5);
+  BOOST_REQUIRE_CLOSE(M2.at(1,2),84.0,0.0001);
+
+  M2.add(M1);
+  BOOST_REQUIRE_CLOSE(M2.at(1,2),96.0,0.0001);
+
+  BOOST_REQUIRE_THROW(M1.dot(M3),openfluid::base::FrameworkException);
+  BOOST_REQUIRE_THROW(M1.axpy(1.0,M3),openfluid::base::FrameworkException);
+}
+
+// =====================================================================
+// =====================================================================
@@ -43,7 +43,13 @@
 #define BOOST_TEST_MODULE unittest_spatialgraph
 #include <boost/test/unit_test.hpp>
 #include <boost/test/auto_unit_test.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
 #include <openfluid/core/SpatialGraph.hpp>
+#include <openfluid/base/FrameworkException.hpp>
 
 
 // =====================================================================
@@ -145,5 +151,243 @@ BOOST_AUTO_TEST_CASE(check_operations)
 
 }
 
+// =====================================================================
+// =====================================================================
+
+BOOST_AUTO_TEST_CASE(check_wavefront)
+{
+  openfluid::core::SpatialGraph SGraph;
+
+  // river network with 2 branches:  1 -> 3, 2 -> 3, 3 -> 5, 4 -> 5, 5 -> 6
+  for (unsigned int i=1;i<=6;i++)
+    SGraph.addUnit(openfluid::core::SpatialUnit("RS",i,i));
+
+  SGraph.addUnit(openfluid::core::SpatialUnit("SU",1,1));
+
+  SGraph.addFromToConnection(SGraph.spatialUnit("RS",1),SGraph.spatialUnit("RS",3));
+  SGraph.addFromToConnection(SGraph.spatialUnit("RS",2),SGraph.spatialUnit("RS",3));
+  SGraph.addFromToConnection(SGraph.spatialUnit("RS",3),SGraph.spatialUnit("RS",5));
+  SGraph.addFromToConnection(SGraph.spatialUnit("RS",4),SGraph.spatialUnit("RS",5));
+  SGraph.addFromToConnection(SGraph.spatialUnit("RS",5),SGraph.spatialUnit("RS",6));
+  // connections from other classes are not taken into account
+  SGraph.addFromToConnection(SGraph.spatialUnit("SU",1),SGraph.spatialUnit("RS",1));
+
+  SGraph.sortUnitsByProcessOrder();
+
+  const openfluid::core::UnitsWavefront_t* Wavefront = &SGraph.unitsWavefront("RS");
+
+  BOOST_REQUIRE_EQUAL(Wavefront->size(),4);
+  BOOST_REQUIRE_EQUAL(Wavefront->at(0).size(),3);
+  BOOST_REQUIRE_EQUAL(Wavefront->at(0)[0]->getID(),1);
+  BOOST_REQUIRE_EQUAL(Wavefront->at(0)[1]->getID(),2);
+  BOOST_REQUIRE_EQUAL(Wavefront->at(0)[2]->getID(),4);
+  BOOST_REQUIRE_EQUAL(Wavefront->at(1).size(),1);
+  BOOST_REQUIRE_EQUAL(Wavefront->at(1)[0]->getID(),3);
+  BOOST_REQUIRE_EQUAL(Wavefront->at(2).size(),1);
+  BOOST_REQUIRE_EQUAL(Wavefront->at(2)[0]->getID(),5);
+  BOOST_REQUIRE_EQUAL(Wavefront->at(3).size(),1);
+  BOOST_REQUIRE_EQUAL(Wavefront->at(3)[0]->getID(),6);
+
+  BOOST_REQUIRE_EQUAL(SGraph.unitsWavefront("SU").size(),1);
+  BOOST_REQUIRE(SGraph.unitsWavefront("WrongClass").empty());
+
+
+  // levels are updated when connections change
+  SGraph.removeFromToConnection(SGraph.spatialUnit("RS",5),SGraph.spatialUnit("RS",6));
+
+  Wavefront = &SGraph.unitsWavefront("RS");
+  BOOST_REQUIRE_EQUAL(Wavefront->size(),3);
+  BOOST_REQUIRE_EQUAL(Wavefront->at(0).size(),4);
+  BOOST_REQUIRE_EQUAL(Wavefront->at(0)[3]->getID(),6);
+
+
+  // cycles are detected
+  SGraph.addFromToConnection(SGraph.spatialUnit("RS",5),SGraph.spatialUnit("RS",1));
+  BOOST_REQUIRE_THROW(SGraph.unitsWavefront("RS"),openfluid::base::FrameworkException);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_connections_store)
+{
+  openfluid::core::SpatialGraph SGraph;
+
+  for (unsigned int i=1; i<=5; i++)
+    SGraph.addUnit(openfluid::core::SpatialUnit("LU",i,1));
+  SGraph.addUnit(openfluid::core::SpatialUnit("RS",1,1));
+
+  openfluid::core::SpatialUnit* LU1 = SGraph.spatialUnit("LU",1);
+  openfluid::core::SpatialUnit* LU2 = SGraph.spatialUnit("LU",2);
+  openfluid::core::SpatialUnit* LU3 = SGraph.spatialUnit("LU",3);
+  openfluid::core::SpatialUnit* LU4 = SGraph.spatialUnit("LU",4);
+  openfluid::core::SpatialUnit* RS1 = SGraph.spatialUnit("RS",1);
+
+  BOOST_REQUIRE(SGraph.addFromToConnection(LU1,LU2));
+  BOOST_REQUIRE(SGraph.addFromToConnection(LU1,LU3));
+  BOOST_REQUIRE(SGraph.addFromToConnection(LU1,LU4));
+  BOOST_REQUIRE(SGraph.addFromToConnection(LU1,RS1));
+  BOOST_REQUIRE(!SGraph.addFromToConnection(LU1,LU3));
+  BOOST_REQUIRE(!SGraph.addFromToConnection(LU1,NULL));
+  BOOST_REQUIRE(SGraph.addChildParentConnection(LU1,RS1));
+  BOOST_REQUIRE(!SGraph.addChildParentConnection(LU1,RS1));
+
+  BOOST_REQUIRE_EQUAL(LU1->toSpatialUnits("LU")->size(),3);
+  BOOST_REQUIRE_EQUAL(LU1->toSpatialUnits("RS")->size(),1);
+  BOOST_REQUIRE(LU1->isToUnit(LU3));
+  BOOST_REQUIRE(LU3->isFromUnit(LU1));
+  BOOST_REQUIRE(LU1->isParentUnit(RS1));
+  BOOST_REQUIRE(RS1->isChildUnit(LU1));
+
+  // removal keeps the order of the remaining connections
+  BOOST_REQUIRE(SGraph.removeFromToConnection(LU1,LU3));
+  BOOST_REQUIRE(!SGraph.removeFromToConnection(LU1,LU3));
+  BOOST_REQUIRE(!LU1->isToUnit(LU3));
+  BOOST_REQUIRE(!LU3->isFromUnit(LU1));
+  BOOST_REQUIRE_EQUAL(LU1->toSpatialUnits("LU")->size(),2);
+  BOOST_REQUIRE_EQUAL(LU1->toSpatialUnits("LU")->front()->getID(),2);
+  BOOST_REQUIRE_EQUAL(LU1->toSpatialUnits("LU")->back()->getID(),4);
+  BOOST_REQUIRE(LU3->fromSpatialUnits("LU")->empty());
+
+  BOOST_REQUIRE(SGraph.addFromToConnection(LU1,LU3));
+  BOOST_REQUIRE_EQUAL(LU1->toSpatialUnits("LU")->back()->getID(),3);
+
+  BOOST_REQUIRE(SGraph.removeChildParentConnection(LU1,RS1));
+  BOOST_REQUIRE(!SGraph.removeChildParentConnection(LU1,RS1));
+  BOOST_REQUIRE(RS1->childSpatialUnits("LU")->empty());
+
+  // copied units have their own connections index
+  openfluid::core::SpatialUnit CopiedUnit(*LU1);
+  BOOST_REQUIRE(CopiedUnit.isToUnit(LU2));
+  BOOST_REQUIRE(CopiedUnit.removeToUnit(LU2));
+  BOOST_REQUIRE(!CopiedUnit.isToUnit(LU2));
+  BOOST_REQUIRE(LU1->isToUnit(LU2));
+  BOOST_REQUIRE_EQUAL(LU1->toSpatialUnits("LU")->size(),3);
+
+  // deleted units are removed from connections
+  SGraph.deleteUnit(LU3);
+  BOOST_REQUIRE_EQUAL(LU1->toSpatialUnits("LU")->size(),2);
+  BOOST_REQUIRE(!SGraph.addFromToConnection(LU1,LU4));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_deferred_connections_changes)
+{
+  openfluid::core::SpatialGraph SGraph;
+
+  for (unsigned int i=1; i<=100; i++)
+    SGraph.addUnit(openfluid::core::SpatialUnit("LU",i,i));
+  SGraph.addUnit(openfluid::core::SpatialUnit("RS",1,1));
+
+  for (unsigned int i=1; i<100; i++)
+    SGraph.addFromToConnection(SGraph.spatialUnit("LU",i),SGraph.spatialUnit("LU",i+1));
+
+  SGraph.sortUnitsByProcessOrder();
+  BOOST_REQUIRE_EQUAL(SGraph.unitsWavefront("LU").size(),100);
+
+  SGraph.setConnectionsChangesDeferred(true);
+  BOOST_REQUIRE(SGraph.isConnectionsChangesDeferred());
+
+  // changes requested from concurrent threads are applied together
+  std::vector<std::thread> Threads;
+  std::atomic<unsigned int> RequestedCount(0);
+
+  for (unsigned int t=0; t<4; t++)
+  {
+    Threads.emplace_back([&SGraph,&RequestedCount,t]()
+    {
+      for (unsigned int i=1+t; i<100; i+=4)
+      {
+        openfluid::core::SpatialUnit* FromUnit = SGraph.spatialUnit("LU",i);
+        openfluid::core::SpatialUnit* ToUnit = SGraph.spatialUnit("LU",i+1);
+
+        if (SGraph.removeFromToConnection(FromUnit,ToUnit))
+          RequestedCount++;
+
+        if (SGraph.addFromToConnection(FromUnit,SGraph.spatialUnit("RS",1)))
+          RequestedCount++;
+      }
+    });
+  }
+
+  for (auto& Th : Threads)
+    Th.join();
+
+  BOOST_REQUIRE_EQUAL(RequestedCount,198);
+
+  // graph is unchanged until changes are applied
+  BOOST_REQUIRE(SGraph.spatialUnit("LU",1)->isToUnit(SGraph.spatialUnit("LU",2)));
+  BOOST_REQUIRE(SGraph.spatialUnit("RS",1)->fromSpatialUnits("LU") == NULL);
+  BOOST_REQUIRE_EQUAL(SGraph.unitsWavefront("LU").size(),100);
+
+  // a change already pending is rejected when requested again
+  BOOST_REQUIRE(!SGraph.addFromToConnection(SGraph.spatialUnit("LU",1),SGraph.spatialUnit("RS",1)));
+  BOOST_REQUIRE(!SGraph.removeFromToConnection(SGraph.spatialUnit("LU",1),SGraph.spatialUnit("LU",2)));
+
+  SGraph.applyConnectionsChanges();
+  BOOST_REQUIRE(SGraph.isConnectionsChangesDeferred());
+
+  BOOST_REQUIRE(!SGraph.spatialUnit("LU",1)->isToUnit(SGraph.spatialUnit("LU",2)));
+  BOOST_REQUIRE_EQUAL(SGraph.spatialUnit("RS",1)->fromSpatialUnits("LU")->size(),99);
+  BOOST_REQUIRE_EQUAL(SGraph.unitsWavefront("LU").size(),1);
+
+  // changes are applied when deferring is disabled
+  BOOST_REQUIRE(SGraph.addFromToConnection(SGraph.spatialUnit("LU",1),SGraph.spatialUnit("LU",2)));
+  BOOST_REQUIRE(SGraph.addChildParentConnection(SGraph.spatialUnit("LU",1),SGraph.spatialUnit("RS",1)));
+  BOOST_REQUIRE(!SGraph.spatialUnit("LU",1)->isToUnit(SGraph.spatialUnit("LU",2)));
+  BOOST_REQUIRE(!SGraph.spatialUnit("LU",1)->isParentUnit(SGraph.spatialUnit("RS",1)));
+
+  SGraph.setConnectionsChangesDeferred(false);
+  BOOST_REQUIRE(SGraph.spatialUnit("LU",1)->isToUnit(SGraph.spatialUnit("LU",2)));
+  BOOST_REQUIRE(SGraph.spatialUnit("LU",1)->isParentUnit(SGraph.spatialUnit("RS",1)));
+  BOOST_REQUIRE_EQUAL(SGraph.unitsWavefront("LU").size(),2);
+
+  // pending changes involving a deleted unit are discarded
+  SGraph.setConnectionsChangesDeferred(true);
+  BOOST_REQUIRE(SGraph.addFromToConnection(SGraph.spatialUnit("LU",50),SGraph.spatialUnit("LU",51)));
+  SGraph.deleteUnit(SGraph.spatialUnit("LU",51));
+  SGraph.setConnectionsChangesDeferred(false);
+  BOOST_REQUIRE(SGraph.spatialUnit("LU",50)->toSpatialUnits("LU")->empty());
+
+  // a connection added then removed during the same step is left unchanged
+  SGraph.setConnectionsChangesDeferred(true);
+  BOOST_REQUIRE(SGraph.addFromToConnection(SGraph.spatialUnit("LU",60),SGraph.spatialUnit("LU",70)));
+  BOOST_REQUIRE(SGraph.removeFromToConnection(SGraph.spatialUnit("LU",60),SGraph.spatialUnit("LU",70)));
+  BOOST_REQUIRE(!SGraph.removeFromToConnection(SGraph.spatialUnit("LU",60),SGraph.spatialUnit("LU",70)));
+  BOOST_REQUIRE(SGraph.addChildParentConnection(SGraph.spatialUnit("LU",60),SGraph.spatialUnit("RS",1)));
+  BOOST_REQUIRE(SGraph.removeChildParentConnection(SGraph.spatialUnit("LU",60),SGraph.spatialUnit("RS",1)));
+  SGraph.applyConnectionsChanges();
+  BOOST_REQUIRE(!SGraph.spatialUnit("LU",60)->isToUnit(SGraph.spatialUnit("LU",70)));
+  BOOST_REQUIRE(!SGraph.spatialUnit("LU",70)->isFromUnit(SGraph.spatialUnit("LU",60)));
+  BOOST_REQUIRE(!SGraph.spatialUnit("LU",60)->isParentUnit(SGraph.spatialUnit("RS",1)));
+
+  // a connection removed then added again during the same step (rerouting) is kept
+  BOOST_REQUIRE(SGraph.removeFromToConnection(SGraph.spatialUnit("LU",1),SGraph.spatialUnit("LU",2)));
+  BOOST_REQUIRE(SGraph.addFromToConnection(SGraph.spatialUnit("LU",1),SGraph.spatialUnit("LU",2)));
+  BOOST_REQUIRE(!SGraph.addFromToConnection(SGraph.spatialUnit("LU",1),SGraph.spatialUnit("LU",2)));
+  BOOST_REQUIRE(SGraph.removeChildParentConnection(SGraph.spatialUnit("LU",1),SGraph.spatialUnit("RS",1)));
+  BOOST_REQUIRE(SGraph.addChildParentConnection(SGraph.spatialUnit("LU",1),SGraph.spatialUnit("RS",1)));
+  SGraph.applyConnectionsChanges();
+  BOOST_REQUIRE(SGraph.spatialUnit("LU",1)->isToUnit(SGraph.spatialUnit("LU",2)));
+  BOOST_REQUIRE(SGraph.spatialUnit("LU",2)->isFromUnit(SGraph.spatialUnit("LU",1)));
+  BOOST_REQUIRE(SGraph.spatialUnit("LU",1)->isParentUnit(SGraph.spatialUnit("RS",1)));
+
+  // pending changes are discarded when the deferral scope is left
+  {
+    openfluid::core::ConnectionsChangesDeferral Deferral(SGraph);
+    BOOST_REQUIRE(SGraph.isConnectionsChangesDeferred());
+    BOOST_REQUIRE(SGraph.addFromToConnection(SGraph.spatialUnit("LU",80),SGraph.spatialUnit("LU",90)));
+  }
+  BOOST_REQUIRE(!SGraph.isConnectionsChangesDeferred());
+  BOOST_REQUIRE(!SGraph.spatialUnit("LU",80)->isToUnit(SGraph.spatialUnit("LU",90)));
+}
+
+
 // =====================================================================
 // =====================================================================
@@ -0,0 +1,191 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+
+
+/**
+  @file ValueStorage_TEST.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@supagro.inra.fr>
+ */
+
+
+#define BOOST_TEST_MAIN
+#define BOOST_AUTO_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE unittest_valuestorage
+#include <boost/test/unit_test.hpp>
+#include <boost/test/auto_unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <chrono>
+#include <iostream>
+
+#include <openfluid/core/ValueStorage.hpp>
+#include <openfluid/core/ValuesBuffer.hpp>
+#include <openfluid/core/VectorValue.hpp>
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_construction)
+{
+  openfluid::core::ValueStorage Storage;
+
+  BOOST_REQUIRE(Storage.get()->isNullValue());
+  BOOST_REQUIRE(Storage.isInline());
+
+  openfluid::core::ValueStorage DblStorage(openfluid::core::DoubleValue(1.5));
+  BOOST_REQUIRE(DblStorage.get()->isDoubleValue());
+  BOOST_REQUIRE(DblStorage.isInline());
+  BOOST_REQUIRE_CLOSE(DblStorage.get()->asDoubleValue().get(),1.5,0.00001);
+
+  openfluid::core::ValueStorage IntStorage(openfluid::core::IntegerValue(17));
+  BOOST_REQUIRE(IntStorage.isInline());
+  BOOST_REQUIRE_EQUAL(IntStorage.get()->asIntegerValue().get(),17);
+
+  openfluid::core::ValueStorage BoolStorage(openfluid::core::BooleanValue(true));
+  BOOST_REQUIRE(BoolStorage.isInline());
+  BOOST_REQUIRE_EQUAL(BoolStorage.get()->asBooleanValue().get(),true);
+
+  openfluid::core::ValueStorage StrStorage(openfluid::core::StringValue("short"));
+  BOOST_REQUIRE(StrStorage.isInline());
+  BOOST_REQUIRE_EQUAL(StrStorage.get()->asStringValue().get(),"short");
+
+  openfluid::core::ValueStorage VectStorage(openfluid::core::VectorValue(10,2.0));
+  BOOST_REQUIRE(VectStorage.get()->isVectorValue());
+  BOOST_REQUIRE(!VectStorage.isInline());
+  BOOST_REQUIRE_EQUAL(VectStorage.get()->asVectorValue().size(),10);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_operations)
+{
+  openfluid::core::ValueStorage Storage(openfluid::core::DoubleValue(2.0));
+
+  // same type, in place copy
+  Storage.set(openfluid::core::DoubleValue(3.0));
+  BOOST_REQUIRE(Storage.isInline());
+  BOOST_REQUIRE_CLOSE(Storage.get()->asDoubleValue().get(),3.0,0.00001);
+
+  // inline to heap
+  Storage.set(openfluid::core::VectorValue(5,1.0));
+  BOOST_REQUIRE(!Storage.isInline());
+  BOOST_REQUIRE_EQUAL(Storage.get()->asVectorValue().size(),5);
+
+  // heap to inline
+  Storage.set(openfluid::core::StringValue("text"));
+  BOOST_REQUIRE(Storage.isInline());
+  BOOST_REQUIRE_EQUAL(Storage.get()->asStringValue().get(),"text");
+
+  // deep copy
+  openfluid::core::ValueStorage Copy(Storage);
+  Storage.set(openfluid::core::StringValue("other"));
+  BOOST_REQUIRE_EQUAL(Copy.get()->asStringValue().get(),"text");
+  BOOST_REQUIRE_EQUAL(Storage.get()->asStringValue().get(),"other");
+
+  openfluid::core::ValueStorage HeapStorage(openfluid::core::VectorValue(3,4.0));
+  Copy = HeapStorage;
+  BOOST_REQUIRE(!Copy.isInline());
+  BOOST_REQUIRE(Copy.get() != HeapStorage.get());
+
+  // move of heap value
+  openfluid::core::Value* HeapPtr = HeapStorage.get();
+  openfluid::core::ValueStorage Moved(std::move(HeapStorage));
+  BOOST_REQUIRE_EQUAL(Moved.get(),HeapPtr);
+  BOOST_REQUIRE(HeapStorage.get()->isNullValue());
+
+  Moved.reset();
+  BOOST_REQUIRE(Moved.isInline());
+  BOOST_REQUIRE(Moved.get()->isNullValue());
+
+  // indexed values
+  openfluid::core::IndexedValue IndValue(3,openfluid::core::IntegerValue(5));
+  openfluid::core::IndexedValue IndCopy(IndValue);
+  IndValue.clear();
+  BOOST_REQUIRE(IndValue.value()->isNullValue());
+  BOOST_REQUIRE_EQUAL(IndCopy.getIndex(),3);
+  BOOST_REQUIRE_EQUAL(IndCopy.value()->asIntegerValue().get(),5);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_performance)
+{
+  const unsigned int Count = 1000000;
+
+  openfluid::core::ValuesBufferProperties::setBufferSize(10);
+
+  openfluid::core::ValuesBuffer VBuffer;
+  openfluid::core::DoubleValue DblValue;
+  openfluid::core::IndexedValue IndValue;
+
+  // append
+  auto Start = std::chrono::steady_clock::now();
+  for (unsigned int i=0; i<Count; i++)
+    VBuffer.appendValue(i,openfluid::core::DoubleValue(i*0.5));
+  auto Duration = std::chrono::duration<double>(std::chrono::steady_clock::now()-Start).count();
+  std::cout << "append: " << Count/Duration << " values/s" << std::endl;
+
+  // get
+  double Sum = 0.0;
+  Start = std::chrono::steady_clock::now();
+  for (unsigned int i=0; i<Count; i++)
+  {
+    VBuffer.getCurrentValue(&DblValue);
+    Sum += DblValue.get();
+  }
+  Duration = std::chrono::duration<double>(std::chrono::steady_clock::now()-Start).count();
+  std::cout << "get: " << Count/Duration << " values/s" << std::endl;
+  BOOST_REQUIRE_CLOSE(Sum,(Count-1)*0.5*Count,0.00001);
+
+  // clone through latest indexed value
+  Start = std::chrono::steady_clock::now();
+  for (unsigned int i=0; i<Count; i++)
+    VBuffer.getLatestIndexedValue(IndValue);
+  Duration = std::chrono::duration<double>(std::chrono::steady_clock::now()-Start).count();
+  std::cout << "clone: " << Count/Duration << " values/s" << std::endl;
+
+  BOOST_REQUIRE_EQUAL(IndValue.getIndex(),Count-1);
+  BOOST_REQUIRE(IndValue.value()->isDoubleValue());
+  BOOST_REQUIRE_CLOSE(IndValue.value()->asDoubleValue().get(),(Count-1)*0.5,0.00001);
+}
+
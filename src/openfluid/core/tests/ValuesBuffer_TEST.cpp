@@ -45,6 +45,10 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/test/auto_unit_test.hpp>
 #include <boost/test/floating_point_comparison.hpp>
+
+#include <atomic>
+#include <thread>
+
 #include <openfluid/core/ValuesBuffer.hpp>
 #include <openfluid/core/DoubleValue.hpp>
 #include <openfluid/core/NullValue.hpp>
@@ -331,3 +335,242 @@ BOOST_AUTO_TEST_CASE(check_type_operations)
 
 // =====================================================================
 // =====================================================================
+
+BOOST_AUTO_TEST_CASE(check_concurrent_access)
+{
+  BOOST_REQUIRE(!openfluid::core::ValuesBufferProperties::isConcurrentAccess());
+
+  openfluid::core::ValuesBufferProperties::setBufferSize(3);
+  openfluid::core::ValuesBufferProperties::setConcurrentAccess(true);
+  BOOST_REQUIRE(openfluid::core::ValuesBufferProperties::isConcurrentAccess());
+
+  openfluid::core::ValuesBuffer VBuffer;
+  openfluid::core::DoubleValue Value;
+  openfluid::core::IndexedValueList IValueList;
+
+  for (unsigned int i=0; i<5;i++)
+    BOOST_REQUIRE_EQUAL(VBuffer.appendValue(i,openfluid::core::DoubleValue(i*1.5)),true);
+
+  BOOST_REQUIRE_EQUAL(VBuffer.getValuesCount(),3);
+  BOOST_REQUIRE_EQUAL(VBuffer.getCurrentIndex(),4);
+  BOOST_REQUIRE_EQUAL(VBuffer.getValue(3,&Value),true);
+  BOOST_REQUIRE_CLOSE(Value.get(),4.5,0.001);
+  BOOST_REQUIRE_EQUAL(VBuffer.isValueExist(1),false);
+  BOOST_REQUIRE_EQUAL(VBuffer.modifyValue(2,openfluid::core::DoubleValue(20.0)),true);
+  BOOST_REQUIRE_EQUAL(VBuffer.getIndexedValues(2,3,IValueList),true);
+  BOOST_REQUIRE_EQUAL(IValueList.size(),2);
+  BOOST_REQUIRE_CLOSE(IValueList.front().value()->asDoubleValue().get(),20.0,0.001);
+
+  openfluid::core::ValuesBufferProperties::setConcurrentAccess(false);
+}
+
+// =====================================================================
+// =====================================================================
+
+BOOST_AUTO_TEST_CASE(check_read_index_limit)
+{
+  openfluid::core::ValuesBufferProperties::setBufferSize(10);
+
+  openfluid::core::ValuesBuffer VBuffer;
+  openfluid::core::ValuesBuffer RLEBuffer;
+  BOOST_REQUIRE(RLEBuffer.setRunLengthEncoding(true));
+
+  openfluid::core::DoubleValue Value;
+  openfluid::core::IndexedValue IValue;
+  openfluid::core::IndexedValueList IValueList;
+
+  for (unsigned int i=0; i<6;i++)
+  {
+    BOOST_REQUIRE(VBuffer.appendValue(i*10,openfluid::core::DoubleValue(i)));
+    BOOST_REQUIRE(RLEBuffer.appendValue(i*10,openfluid::core::DoubleValue(1.0)));
+  }
+
+  openfluid::core::ValuesBufferProperties::setReadIndexLimit(30);
+  BOOST_REQUIRE(openfluid::core::ValuesBufferProperties::isReadIndexLimited());
+
+  BOOST_REQUIRE_EQUAL(VBuffer.getCurrentIndex(),30);
+  BOOST_REQUIRE_CLOSE(VBuffer.currentValue()->asDoubleValue().get(),3.0,0.001);
+  BOOST_REQUIRE(VBuffer.getCurrentValue(&Value));
+  BOOST_REQUIRE_CLOSE(Value.get(),3.0,0.001);
+  BOOST_REQUIRE(VBuffer.currentValueIfIndex(30) != NULL);
+  BOOST_REQUIRE(VBuffer.currentValueIfIndex(50) == NULL);
+  BOOST_REQUIRE(VBuffer.getCurrentValueIfIndex(30,&Value));
+  BOOST_REQUIRE(!VBuffer.getCurrentValueIfIndex(50,&Value));
+  BOOST_REQUIRE(VBuffer.isValueExist(20));
+  BOOST_REQUIRE(!VBuffer.isValueExist(40));
+  BOOST_REQUIRE(VBuffer.value(40) == NULL);
+  BOOST_REQUIRE(!VBuffer.getValue(50,&Value));
+  BOOST_REQUIRE(VBuffer.getLatestIndexedValue(IValue));
+  BOOST_REQUIRE_EQUAL(IValue.getIndex(),30);
+  BOOST_REQUIRE(VBuffer.getLatestIndexedValues(10,IValueList));
+  BOOST_REQUIRE_EQUAL(IValueList.size(),3);
+  BOOST_REQUIRE_EQUAL(IValueList.back().getIndex(),30);
+  BOOST_REQUIRE(VBuffer.getIndexedValues(20,50,IValueList));
+  BOOST_REQUIRE_EQUAL(IValueList.size(),2);
+
+  // the limit falls inside a run of identical values
+  BOOST_REQUIRE_EQUAL(RLEBuffer.getCurrentIndex(),30);
+  BOOST_REQUIRE(RLEBuffer.currentValueIfIndex(30) != NULL);
+  BOOST_REQUIRE(RLEBuffer.getLatestIndexedValues(0,IValueList));
+  BOOST_REQUIRE_EQUAL(IValueList.size(),4);
+  BOOST_REQUIRE_EQUAL(IValueList.back().getIndex(),30);
+  BOOST_REQUIRE(!RLEBuffer.isValueExist(40));
+
+  // the limit only applies to the thread which has set it
+  std::atomic<unsigned int> CheckedCount(0);
+  std::thread Reader([&VBuffer,&CheckedCount]()
+  {
+    if (!openfluid::core::ValuesBufferProperties::isReadIndexLimited() && VBuffer.getCurrentIndex() == 50)
+      CheckedCount++;
+  });
+  Reader.join();
+  BOOST_REQUIRE_EQUAL(CheckedCount,1);
+
+  openfluid::core::ValuesBufferProperties::resetReadIndexLimit();
+  BOOST_REQUIRE(!openfluid::core::ValuesBufferProperties::isReadIndexLimited());
+  BOOST_REQUIRE_EQUAL(VBuffer.getCurrentIndex(),50);
+  BOOST_REQUIRE_EQUAL(RLEBuffer.getCurrentIndex(),50);
+
+  // a reader limited to the previous time point while values of the next ones are appended
+  openfluid::core::ValuesBufferProperties::setConcurrentAccess(true);
+
+  std::atomic<unsigned int> MismatchCount(0);
+  std::thread Observer([&VBuffer,&MismatchCount]()
+  {
+    openfluid::core::ValuesBufferProperties::setReadIndexLimit(50);
+
+    for (unsigned int i=0; i<1000; i++)
+    {
+      openfluid::core::DoubleValue Val;
+
+      if (!VBuffer.getCurrentValueIfIndex(50,&Val) || Val.get() != 5.0)
+        MismatchCount++;
+    }
+
+    openfluid::core::ValuesBufferProperties::resetReadIndexLimit();
+  });
+
+  for (unsigned int i=6; i<9;i++)
+    BOOST_REQUIRE(VBuffer.appendValue(i*10,openfluid::core::DoubleValue(i)));
+
+  Observer.join();
+  BOOST_REQUIRE_EQUAL(MismatchCount,0);
+
+  openfluid::core::ValuesBufferProperties::setConcurrentAccess(false);
+}
+
+// =====================================================================
+// =====================================================================
+
+BOOST_AUTO_TEST_CASE(check_run_length_encoding)
+{
+  openfluid::core::ValuesBufferProperties::setBufferSize(7);
+
+  openfluid::core::ValuesBuffer VBuffer;
+  openfluid::core::ValuesBuffer RLEBuffer;
+
+  BOOST_REQUIRE(!RLEBuffer.isRunLengthEncoded());
+  BOOST_REQUIRE(RLEBuffer.setRunLengthEncoding(true));
+  BOOST_REQUIRE(RLEBuffer.isRunLengthEncoded());
+
+  // compares all values of both buffers
+  auto checkSameContents = [&VBuffer,&RLEBuffer]()
+  {
+    BOOST_REQUIRE_EQUAL(RLEBuffer.getValuesCount(),VBuffer.getValuesCount());
+    BOOST_REQUIRE_EQUAL(RLEBuffer.getCurrentIndex(),VBuffer.getCurrentIndex());
+
+    for (openfluid::core::TimeIndex_t i=0; i<=VBuffer.getCurrentIndex()+1; i++)
+    {
+      BOOST_REQUIRE_EQUAL(RLEBuffer.isValueExist(i),VBuffer.isValueExist(i));
+      if (VBuffer.isValueExist(i))
+        BOOST_REQUIRE_EQUAL(RLEBuffer.value(i)->toString(),VBuffer.value(i)->toString());
+    }
+
+    openfluid::core::IndexedValueList List, RLEList;
+    BOOST_REQUIRE_EQUAL(RLEBuffer.getIndexedValues(3,40,RLEList),VBuffer.getIndexedValues(3,40,List));
+    BOOST_REQUIRE_EQUAL(RLEList.size(),List.size());
+
+    BOOST_REQUIRE_EQUAL(RLEBuffer.getLatestIndexedValues(0,RLEList),VBuffer.getLatestIndexedValues(0,List));
+    BOOST_REQUIRE_EQUAL(RLEList.size(),List.size());
+
+    auto It = List.begin();
+    for (auto& RLEItem : RLEList)
+    {
+      BOOST_REQUIRE_EQUAL(RLEItem.getIndex(),(*It).getIndex());
+      BOOST_REQUIRE_EQUAL(RLEItem.value()->toString(),(*It).value()->toString());
+      ++It;
+    }
+
+    openfluid::core::IndexedValue IValue, RLEIValue;
+    BOOST_REQUIRE(RLEBuffer.getLatestIndexedValue(RLEIValue) && VBuffer.getLatestIndexedValue(IValue));
+    BOOST_REQUIRE_EQUAL(RLEIValue.getIndex(),IValue.getIndex());
+  };
+
+  // constant values at a regular step, then at an irregular step, then changing values
+  const std::vector<std::pair<openfluid::core::TimeIndex_t,double>> Appended =
+    { {0,0.0}, {2,1.0}, {4,1.0}, {6,1.0}, {8,1.0}, {9,1.0}, {11,1.0}, {13,2.0}, {15,3.0}, {17,3.0},
+      {19,3.0}, {21,3.0} };
+
+  for (auto& Item : Appended)
+  {
+    BOOST_REQUIRE(VBuffer.appendValue(Item.first,openfluid::core::DoubleValue(Item.second)));
+    BOOST_REQUIRE(RLEBuffer.appendValue(Item.first,openfluid::core::DoubleValue(Item.second)));
+    checkSameContents();
+  }
+
+  BOOST_REQUIRE(!RLEBuffer.appendValue(21,openfluid::core::DoubleValue(3.0)));
+  BOOST_REQUIRE(!RLEBuffer.setRunLengthEncoding(false));
+
+  // modifications splitting runs
+  BOOST_REQUIRE_EQUAL(RLEBuffer.modifyValue(17,openfluid::core::DoubleValue(5.0)),
+                      VBuffer.modifyValue(17,openfluid::core::DoubleValue(5.0)));
+  checkSameContents();
+  BOOST_REQUIRE_EQUAL(RLEBuffer.modifyValue(16,openfluid::core::DoubleValue(5.0)),
+                      VBuffer.modifyValue(16,openfluid::core::DoubleValue(5.0)));
+  checkSameContents();
+  BOOST_REQUIRE(RLEBuffer.modifyCurrentValue(openfluid::core::DoubleValue(6.0)));
+  BOOST_REQUIRE(VBuffer.modifyCurrentValue(openfluid::core::DoubleValue(6.0)));
+  checkSameContents();
+
+  for (openfluid::core::TimeIndex_t i=23; i<=41; i+=2)
+  {
+    BOOST_REQUIRE(VBuffer.appendValue(i,openfluid::core::DoubleValue(6.0)));
+    BOOST_REQUIRE(RLEBuffer.appendValue(i,openfluid::core::DoubleValue(6.0)));
+    checkSameContents();
+  }
+
+  BOOST_REQUIRE_EQUAL(RLEBuffer.modifyValue(29,openfluid::core::DoubleValue(7.0)),
+                      VBuffer.modifyValue(29,openfluid::core::DoubleValue(7.0)));
+  checkSameContents();
+
+  // vectors
+  openfluid::core::ValuesBuffer VectBuffer;
+  BOOST_REQUIRE(VectBuffer.setRunLengthEncoding(true));
+  for (unsigned int i=0; i<100; i++)
+    BOOST_REQUIRE(VectBuffer.appendValue(i,openfluid::core::VectorValue(3,(i < 50 ? 1.5 : 2.5))));
+
+  BOOST_REQUIRE_EQUAL(VectBuffer.getValuesCount(),7);
+  BOOST_REQUIRE_EQUAL(VectBuffer.value(93)->asVectorValue()[2],2.5);
+  BOOST_REQUIRE(!VectBuffer.isValueExist(92));
+
+  // values read concurrently are not moved by modifications
+  openfluid::core::ValuesBufferProperties::setConcurrentAccess(true);
+
+  openfluid::core::ValuesBuffer ConcurrentBuffer;
+  BOOST_REQUIRE(ConcurrentBuffer.setRunLengthEncoding(true));
+  for (unsigned int i=0; i<5; i++)
+    BOOST_REQUIRE(ConcurrentBuffer.appendValue(i,openfluid::core::DoubleValue(1.0)));
+
+  const openfluid::core::Value* ObservedValue = ConcurrentBuffer.value(3);
+  BOOST_REQUIRE(ConcurrentBuffer.modifyValue(2,openfluid::core::DoubleValue(2.0)));
+  BOOST_REQUIRE(ConcurrentBuffer.modifyCurrentValue(openfluid::core::DoubleValue(3.0)));
+  BOOST_REQUIRE_EQUAL(ConcurrentBuffer.value(3),ObservedValue);
+  BOOST_REQUIRE_EQUAL(ObservedValue->asDoubleValue().get(),1.0);
+  BOOST_REQUIRE_EQUAL(ConcurrentBuffer.value(2)->asDoubleValue().get(),2.0);
+  BOOST_REQUIRE_EQUAL(ConcurrentBuffer.value(4)->asDoubleValue().get(),3.0);
+
+  openfluid::core::ValuesBufferProperties::setConcurrentAccess(false);
+}
+
+// =====================================================================
+// =====================================================================
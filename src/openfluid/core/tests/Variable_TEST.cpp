@@ -119,6 +119,9 @@ BOOST_AUTO_TEST_CASE(check_operations)
   BOOST_REQUIRE_EQUAL(Vars.isVariableExist("foo",15,openfluid::core::Value::DOUBLE),false);
   BOOST_REQUIRE_EQUAL(Vars.isVariableExist("foo",15,openfluid::core::Value::INTEGER),false);
   BOOST_REQUIRE_EQUAL(Vars.getVariableValuesCount("foo"),5);
+  BOOST_REQUIRE(Vars.valuesBuffer("foo"));
+  BOOST_REQUIRE_EQUAL(Vars.valuesBuffer("foo")->currentValue(),Vars.currentValue("foo"));
+  BOOST_REQUIRE(!Vars.valuesBuffer("bar"));
   BOOST_REQUIRE_EQUAL(Vars.getValue("foo",10,&DblValue),true);
   BOOST_REQUIRE_CLOSE(DblValue.get(),0.0,0.001);
   BOOST_REQUIRE_CLOSE((double)DblValue,0.0,0.001);
@@ -351,3 +354,116 @@ BOOST_AUTO_TEST_CASE(check_typed_operations)
 
 // =====================================================================
 // =====================================================================
+
+BOOST_AUTO_TEST_CASE(check_run_length_encoding)
+{
+  openfluid::core::ValuesBufferProperties::setBufferSize(100);
+
+  openfluid::core::Variables Vars;
+
+  BOOST_REQUIRE_EQUAL(Vars.setRunLengthEncoding("landuse",true),false);
+  BOOST_REQUIRE_EQUAL(Vars.createVariable("landuse",openfluid::core::Value::INTEGER),true);
+  BOOST_REQUIRE_EQUAL(Vars.isRunLengthEncoded("landuse"),false);
+  BOOST_REQUIRE_EQUAL(Vars.setRunLengthEncoding("landuse",true),true);
+  BOOST_REQUIRE_EQUAL(Vars.isRunLengthEncoded("landuse"),true);
+
+  for (unsigned int i=0; i<250; i++)
+    BOOST_REQUIRE_EQUAL(Vars.appendValue("landuse",i*60,openfluid::core::IntegerValue(i < 200 ? 1 : 2)),true);
+
+  BOOST_REQUIRE_EQUAL(Vars.setRunLengthEncoding("landuse",false),false);
+  BOOST_REQUIRE_EQUAL(Vars.getVariableValuesCount("landuse"),100);
+  BOOST_REQUIRE_EQUAL(Vars.isVariableExist("landuse",149*60),false);
+  BOOST_REQUIRE_EQUAL(Vars.isVariableExist("landuse",150*60),true);
+  BOOST_REQUIRE_EQUAL(Vars.isVariableExist("landuse",150*60+1),false);
+  BOOST_REQUIRE_EQUAL(Vars.value("landuse",199*60)->asIntegerValue().get(),1);
+  BOOST_REQUIRE_EQUAL(Vars.value("landuse",200*60)->asIntegerValue().get(),2);
+  BOOST_REQUIRE_EQUAL(Vars.isAllVariablesCount(100),true);
+}
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_windowed_aggregates)
+{
+  openfluid::core::ValuesBufferProperties::setBufferSize(5);
+
+  openfluid::core::Variables Vars;
+  double Value = 0.0;
+
+  BOOST_REQUIRE_EQUAL(Vars.registerWindowedAggregate("rain",openfluid::core::WindowedAggregate::SUM,
+                                                     openfluid::core::WindowedAggregate::LASTVALUES,10),false);
+
+  BOOST_REQUIRE_EQUAL(Vars.createVariable("rain",openfluid::core::Value::DOUBLE),true);
+  BOOST_REQUIRE_EQUAL(Vars.appendValue("rain",0,openfluid::core::DoubleValue(1.0)),true);
+  BOOST_REQUIRE_EQUAL(Vars.appendValue("rain",60,openfluid::core::DoubleValue(2.0)),true);
+
+  // existing values are taken into account at registration
+  BOOST_REQUIRE_EQUAL(Vars.registerWindowedAggregate("rain",openfluid::core::WindowedAggregate::SUM,
+                                                     openfluid::core::WindowedAggregate::LASTVALUES,10),true);
+  BOOST_REQUIRE_EQUAL(Vars.registerWindowedAggregate("rain",openfluid::core::WindowedAggregate::SUM,
+                                                     openfluid::core::WindowedAggregate::LASTVALUES,10),true);
+  BOOST_REQUIRE_EQUAL(Vars.registerWindowedAggregate("rain",openfluid::core::WindowedAggregate::MAX,
+                                                     openfluid::core::WindowedAggregate::LASTSECONDS,120),true);
+
+  const openfluid::core::WindowedAggregate* Sum =
+      Vars.windowedAggregate("rain",openfluid::core::WindowedAggregate::SUM,
+                             openfluid::core::WindowedAggregate::LASTVALUES,10);
+  const openfluid::core::WindowedAggregate* Max =
+      Vars.windowedAggregate("rain",openfluid::core::WindowedAggregate::MAX,
+                             openfluid::core::WindowedAggregate::LASTSECONDS,120);
+  BOOST_REQUIRE(Sum != NULL);
+  BOOST_REQUIRE(Max != NULL);
+  BOOST_REQUIRE(Vars.windowedAggregate("rain",openfluid::core::WindowedAggregate::MIN,
+                                       openfluid::core::WindowedAggregate::LASTVALUES,10) == NULL);
+
+  BOOST_REQUIRE(Sum->get(Value));
+  BOOST_REQUIRE_CLOSE(Value,3.0,0.0001);
+
+  // the aggregate window is independent from the values buffer size
+  for (unsigned int i=2; i<12; i++)
+    BOOST_REQUIRE_EQUAL(Vars.appendValue("rain",i*60,openfluid::core::DoubleValue(i+1)),true);
+
+  BOOST_REQUIRE_EQUAL(Vars.getVariableValuesCount("rain"),5);
+  BOOST_REQUIRE(Sum->get(Value));
+  BOOST_REQUIRE_CLOSE(Value,75.0,0.0001);
+  BOOST_REQUIRE(Max->get(Value));
+  BOOST_REQUIRE_CLOSE(Value,12.0,0.0001);
+
+  BOOST_REQUIRE_EQUAL(Vars.modifyCurrentValue("rain",openfluid::core::DoubleValue(2.0)),true);
+  BOOST_REQUIRE(Sum->get(Value));
+  BOOST_REQUIRE_CLOSE(Value,65.0,0.0001);
+  BOOST_REQUIRE(Max->get(Value));
+  BOOST_REQUIRE_CLOSE(Value,11.0,0.0001);
+
+  BOOST_REQUIRE_EQUAL(Vars.modifyValue("rain",600,openfluid::core::NullValue()),true);
+  BOOST_REQUIRE(Sum->get(Value));
+  BOOST_REQUIRE_CLOSE(Value,54.0,0.0001);
+  BOOST_REQUIRE(Max->get(Value));
+  BOOST_REQUIRE_CLOSE(Value,2.0,0.0001);
+
+  BOOST_REQUIRE_EQUAL(Vars.appendValue("rain",720,openfluid::core::NullValue()),true);
+  BOOST_REQUIRE_EQUAL(Sum->getValuesCount(),9);
+
+  // readers limited to a previous time index compute the aggregates from the buffered values
+  openfluid::core::ValuesBufferProperties::setReadIndexLimit(540);
+  BOOST_REQUIRE(Vars.computeWindowedAggregate("rain",openfluid::core::WindowedAggregate::MAX,
+                                              openfluid::core::WindowedAggregate::LASTSECONDS,120,Value));
+  BOOST_REQUIRE_CLOSE(Value,10.0,0.0001);
+  BOOST_REQUIRE(Vars.computeWindowedAggregate("rain",openfluid::core::WindowedAggregate::SUM,
+                                              openfluid::core::WindowedAggregate::LASTVALUES,10,Value));
+  BOOST_REQUIRE_CLOSE(Value,19.0,0.0001);
+  BOOST_REQUIRE(Vars.currentValueIfIndex("rain",540) != NULL);
+  BOOST_REQUIRE(Vars.currentValueIfIndex("rain",720) == NULL);
+  openfluid::core::ValuesBufferProperties::resetReadIndexLimit();
+  BOOST_REQUIRE(Vars.currentValueIfIndex("rain",720) != NULL);
+  BOOST_REQUIRE(!Vars.computeWindowedAggregate("wind",openfluid::core::WindowedAggregate::MAX,
+                                               openfluid::core::WindowedAggregate::LASTSECONDS,120,Value));
+
+  Vars.clear();
+  BOOST_REQUIRE(Vars.windowedAggregate("rain",openfluid::core::WindowedAggregate::SUM,
+                                       openfluid::core::WindowedAggregate::LASTVALUES,10) == NULL);
+}
+
+// =====================================================================
+// =====================================================================
@@ -0,0 +1,189 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+
+/**
+  @file VariablesChangesLog_TEST.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@supagro.inra.fr>
+ */
+
+#define BOOST_TEST_MAIN
+#define BOOST_AUTO_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE unittest_variableschangeslog
+#include <boost/test/unit_test.hpp>
+#include <boost/test/auto_unit_test.hpp>
+
+#include <thread>
+#include <vector>
+
+#include <openfluid/core/SpatialGraph.hpp>
+#include <openfluid/core/DoubleValue.hpp>
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_construction)
+{
+  openfluid::core::VariablesChangesLog Log;
+
+  BOOST_REQUIRE(!Log.isEnabled());
+  BOOST_REQUIRE(Log.getChanges(0).empty());
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_operations)
+{
+  openfluid::core::ValuesBufferProperties::setBufferSize(10);
+
+  openfluid::core::SpatialGraph SGraph;
+
+  SGraph.addUnit(openfluid::core::SpatialUnit("UA",1,1));
+  SGraph.addUnit(openfluid::core::SpatialUnit("UA",2,1));
+
+  openfluid::core::SpatialUnit* U1 = SGraph.spatialUnit("UA",1);
+  openfluid::core::SpatialUnit* U2 = SGraph.spatialUnit("UA",2);
+
+  U1->variables()->createVariable("var1");
+  U1->variables()->createVariable("var2");
+  U2->variables()->createVariable("var1");
+
+  // not recorded while disabled
+  U1->variables()->appendValue("var1",0,openfluid::core::DoubleValue(1.0));
+  BOOST_REQUIRE(SGraph.variablesChangesLog().getChanges(0).empty());
+
+  SGraph.variablesChangesLog().setEnabled(true);
+
+  U1->variables()->appendValue("var2",0,openfluid::core::DoubleValue(2.0));
+  U1->variables()->modifyValue("var2",0,openfluid::core::DoubleValue(2.5));
+  U2->variables()->appendValue("var1",0,openfluid::core::DoubleValue(3.0));
+  U1->variables()->appendValue("var1",5,openfluid::core::DoubleValue(4.0));
+  U1->variables()->modifyCurrentValue("var1",openfluid::core::DoubleValue(4.5));
+
+  // failed operations are not recorded
+  BOOST_REQUIRE(!U2->variables()->appendValue("wrongvar",5,openfluid::core::DoubleValue(0.0)));
+  BOOST_REQUIRE(!U2->variables()->modifyValue("var1",5,openfluid::core::DoubleValue(0.0)));
+
+  openfluid::core::ChangedVariablesList_t Changes = SGraph.variablesChangesLog().getChanges(0);
+  BOOST_REQUIRE_EQUAL(Changes.size(),2);
+
+  for (auto& Change : Changes)
+  {
+    if (Change.unit() == U1)
+      BOOST_REQUIRE_EQUAL(Change.getVariableName(),"var2");
+    else
+    {
+      BOOST_REQUIRE(Change.unit() == U2);
+      BOOST_REQUIRE_EQUAL(Change.getVariableName(),"var1");
+    }
+  }
+
+  Changes = SGraph.variablesChangesLog().getChanges(5);
+  BOOST_REQUIRE_EQUAL(Changes.size(),1);
+  BOOST_REQUIRE(Changes.front().unit() == U1);
+  BOOST_REQUIRE_EQUAL(Changes.front().getVariableName(),"var1");
+
+  BOOST_REQUIRE(SGraph.variablesChangesLog().getChanges(3).empty());
+
+  SGraph.variablesChangesLog().discardUntil(3);
+  BOOST_REQUIRE(SGraph.variablesChangesLog().getChanges(0).empty());
+  BOOST_REQUIRE_EQUAL(SGraph.variablesChangesLog().getChanges(5).size(),1);
+
+  SGraph.deleteUnit(U1);
+  BOOST_REQUIRE(SGraph.variablesChangesLog().getChanges(5).empty());
+
+  U2->variables()->appendValue("var1",7,openfluid::core::DoubleValue(5.0));
+  BOOST_REQUIRE_EQUAL(SGraph.variablesChangesLog().getChanges(7).size(),1);
+
+  SGraph.variablesChangesLog().setEnabled(false);
+  BOOST_REQUIRE(SGraph.variablesChangesLog().getChanges(7).empty());
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_threaded_recording)
+{
+  openfluid::core::ValuesBufferProperties::setBufferSize(10);
+
+  openfluid::core::SpatialGraph SGraph;
+
+  for (unsigned int i=1; i<=40; i++)
+  {
+    SGraph.addUnit(openfluid::core::SpatialUnit("UA",i,1));
+    SGraph.spatialUnit("UA",i)->variables()->createVariable("var1");
+  }
+
+  SGraph.variablesChangesLog().setEnabled(true);
+
+  for (unsigned int Index=0; Index<3; Index++)
+  {
+    // each thread records the changes of its own units in its own buffer
+    std::vector<std::thread> Threads;
+
+    for (unsigned int t=0; t<4; t++)
+    {
+      Threads.emplace_back([&SGraph,Index,t]()
+      {
+        for (unsigned int i=1+t; i<=40; i+=4)
+          SGraph.spatialUnit("UA",i)->variables()->appendValue("var1",Index,openfluid::core::DoubleValue(i));
+      });
+    }
+
+    for (auto& Th : Threads)
+      Th.join();
+
+    BOOST_REQUIRE_EQUAL(SGraph.variablesChangesLog().getChanges(Index).size(),40);
+    SGraph.variablesChangesLog().discardUntil(Index);
+    BOOST_REQUIRE(SGraph.variablesChangesLog().getChanges(Index).empty());
+  }
+
+  // changes still in the threads buffers are discarded with the deleted unit
+  std::thread Recorder([&SGraph]()
+  {
+    SGraph.spatialUnit("UA",1)->variables()->appendValue("var1",5,openfluid::core::DoubleValue(1.0));
+    SGraph.spatialUnit("UA",2)->variables()->appendValue("var1",5,openfluid::core::DoubleValue(1.0));
+  });
+  Recorder.join();
+
+  SGraph.deleteUnit(SGraph.spatialUnit("UA",1));
+  BOOST_REQUIRE_EQUAL(SGraph.variablesChangesLog().getChanges(5).size(),1);
+}
@@ -46,6 +46,8 @@
 
 #include <openfluid/core/VectorValue.hpp>
 #include <openfluid/core/StringValue.hpp>
+#include <openfluid/core/ValuesBuffer.hpp>
+#include <openfluid/core/ValuesBufferProperties.hpp>
 
 
 // =====================================================================
@@ -128,3 +130,37 @@ BOOST_AUTO_TEST_CASE(check_vector)
 
 
 
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_move)
+{
+  openfluid::core::VectorValue Val1(100,3.0);
+  double* Data = Val1.data();
+
+  openfluid::core::VectorValue Val2(std::move(Val1));
+  BOOST_REQUIRE_EQUAL(Val2.data(),Data);
+  BOOST_REQUIRE_EQUAL(Val1.getSize(),0);
+
+  openfluid::core::VectorValue Val3;
+  Val3 = std::move(Val2);
+  BOOST_REQUIRE_EQUAL(Val3.data(),Data);
+  BOOST_REQUIRE_CLOSE(Val3.sum(),300.0,0.000001);
+
+  // moved through the values buffer
+  openfluid::core::ValuesBufferProperties::setBufferSize(10);
+  openfluid::core::ValuesBuffer VBuffer;
+  VBuffer.appendValue(0,std::move(Val3));
+  BOOST_REQUIRE_EQUAL(Val3.getSize(),0);
+  BOOST_REQUIRE_EQUAL(VBuffer.currentValue()->asVectorValue().data(),Data);
+
+  // copied through the values buffer
+  openfluid::core::VectorValue Val4(10,1.0);
+  VBuffer.appendValue(1,Val4);
+  BOOST_REQUIRE_EQUAL(Val4.getSize(),10);
+  BOOST_REQUIRE(VBuffer.currentValue()->asVectorValue().data() != Val4.data());
+}
+
@@ -44,6 +44,9 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/test/auto_unit_test.hpp>
 #include <boost/test/floating_point_comparison.hpp>
+#include <cstdint>
+#include <utility>
+
 #include <openfluid/core/Vector.hpp>
 
 
@@ -112,3 +115,65 @@ BOOST_AUTO_TEST_CASE(check_operations)
 // =====================================================================
 // =====================================================================
 
+
+BOOST_AUTO_TEST_CASE(check_move)
+{
+  openfluid::core::Vector<double> V1(10,1.5);
+  double* Data = V1.data();
+
+  BOOST_REQUIRE_EQUAL(reinterpret_cast<std::uintptr_t>(Data) % openfluid::core::ArrayAlignment,0);
+
+  openfluid::core::Vector<double> V2(std::move(V1));
+  BOOST_REQUIRE_EQUAL(V2.data(),Data);
+  BOOST_REQUIRE_EQUAL(V2.getSize(),10);
+  BOOST_REQUIRE_EQUAL(V1.getSize(),0);
+
+  openfluid::core::Vector<double> V3(5,0.0);
+  V3 = std::move(V2);
+  BOOST_REQUIRE_EQUAL(V3.data(),Data);
+  BOOST_REQUIRE_EQUAL(V3.getSize(),10);
+  BOOST_REQUIRE_EQUAL(V2.getSize(),0);
+  BOOST_REQUIRE_CLOSE(V3.uncheckedAt(9),1.5,0.0001);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_arithmetic)
+{
+  const unsigned long Size = 1003;
+
+  openfluid::core::Vector<double> V1(Size);
+  openfluid::core::Vector<double> V2(Size,2.0);
+  openfluid::core::Vector<double> V3(3,0.0);
+
+  for (unsigned long i=0; i<Size; i++)
+    V1.uncheckedAt(i) = i;
+
+  BOOST_REQUIRE_CLOSE(V1.sum(),(Size-1)*Size/2.0,0.0001);
+  BOOST_REQUIRE_CLOSE(V1.dot(V2),(Size-1)*Size,0.0001);
+  BOOST_REQUIRE_CLOSE(V1.min(),0.0,0.0001);
+  BOOST_REQUIRE_CLOSE(V1.max(),Size-1.0,0.0001);
+
+  V2.axpy(0.5,V1);
+  BOOST_REQUIRE_CLOSE(V2[10],7.0,0.0001);
+
+  V2.subtract(V1);
+  BOOST_REQUIRE_CLOSE(V2[10],-3.0,0.0001);
+
+  V2.add(V1);
+  V2.multiply(V1);
+  BOOST_REQUIRE_CLOSE(V2[10],70.0,0.0001);
+
+  V2.scale(0.5);
+  BOOST_REQUIRE_CLOSE(V2[10],35.0,0.0001);
+
+  BOOST_REQUIRE_THROW(V1.dot(V3),openfluid::base::FrameworkException);
+  BOOST_REQUIRE_THROW(V1.add(V3),openfluid::base::FrameworkException);
+  BOOST_REQUIRE_THROW(openfluid::core::Vector<double>().min(),openfluid::base::FrameworkException);
+}
+
+// =====================================================================
+// =====================================================================
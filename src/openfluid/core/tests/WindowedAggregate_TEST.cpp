@@ -0,0 +1,240 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+
+/**
+  @file WindowedAggregate_TEST.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@supagro.inra.fr>
+ */
+
+
+#define BOOST_TEST_MAIN
+#define BOOST_AUTO_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE unittest_windowedaggregate
+#include <boost/test/unit_test.hpp>
+#include <boost/test/auto_unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <deque>
+#include <numeric>
+
+#include <openfluid/core/WindowedAggregate.hpp>
+#include <openfluid/base/FrameworkException.hpp>
+
+
+using openfluid::core::WindowedAggregate;
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_construction)
+{
+  WindowedAggregate Aggr(WindowedAggregate::MEAN,WindowedAggregate::LASTSECONDS,3600);
+  double Value = 0.0;
+
+  BOOST_REQUIRE_EQUAL(Aggr.getMethod(),WindowedAggregate::MEAN);
+  BOOST_REQUIRE_EQUAL(Aggr.getWindowType(),WindowedAggregate::LASTSECONDS);
+  BOOST_REQUIRE_EQUAL(Aggr.getSize(),3600);
+  BOOST_REQUIRE(Aggr.isSameDefinition(WindowedAggregate::MEAN,WindowedAggregate::LASTSECONDS,3600));
+  BOOST_REQUIRE(!Aggr.isSameDefinition(WindowedAggregate::MEAN,WindowedAggregate::LASTVALUES,3600));
+  BOOST_REQUIRE_EQUAL(Aggr.getValuesCount(),0);
+  BOOST_REQUIRE(!Aggr.get(Value));
+
+  BOOST_REQUIRE_THROW(WindowedAggregate(WindowedAggregate::SUM,WindowedAggregate::LASTVALUES,0),
+                      openfluid::base::FrameworkException);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_last_values)
+{
+  WindowedAggregate Sum(WindowedAggregate::SUM,WindowedAggregate::LASTVALUES,3);
+  WindowedAggregate Mean(WindowedAggregate::MEAN,WindowedAggregate::LASTVALUES,3);
+  WindowedAggregate Min(WindowedAggregate::MIN,WindowedAggregate::LASTVALUES,3);
+  WindowedAggregate Max(WindowedAggregate::MAX,WindowedAggregate::LASTVALUES,3);
+  double Value = 0.0;
+
+  const double Values[] = {4.0, 1.0, 7.0, 2.0, 2.0, 9.0};
+
+  for (unsigned int i=0; i<6; i++)
+  {
+    BOOST_REQUIRE(Sum.append(i*60,Values[i]));
+    BOOST_REQUIRE(Mean.append(i*60,Values[i]));
+    BOOST_REQUIRE(Min.append(i*60,Values[i]));
+    BOOST_REQUIRE(Max.append(i*60,Values[i]));
+  }
+
+  // window is {2.0, 2.0, 9.0}
+  BOOST_REQUIRE_EQUAL(Sum.getValuesCount(),3);
+  BOOST_REQUIRE(Sum.get(Value));
+  BOOST_REQUIRE_CLOSE(Value,13.0,0.0001);
+  BOOST_REQUIRE(Mean.get(Value));
+  BOOST_REQUIRE_CLOSE(Value,13.0/3,0.0001);
+  BOOST_REQUIRE(Min.get(Value));
+  BOOST_REQUIRE_CLOSE(Value,2.0,0.0001);
+  BOOST_REQUIRE(Max.get(Value));
+  BOOST_REQUIRE_CLOSE(Value,9.0,0.0001);
+
+  // time indexes must increase
+  BOOST_REQUIRE(!Sum.append(300,1.0));
+  BOOST_REQUIRE(!Sum.append(60,1.0));
+
+  // modification in the window
+  Sum.modify(240,5.0);
+  Max.modify(300,0.0);
+  Min.modify(180,1.0);
+  BOOST_REQUIRE(Sum.get(Value));
+  BOOST_REQUIRE_CLOSE(Value,16.0,0.0001);
+  BOOST_REQUIRE(Max.get(Value));
+  BOOST_REQUIRE_CLOSE(Value,2.0,0.0001);
+  BOOST_REQUIRE(Min.get(Value));
+  BOOST_REQUIRE_CLOSE(Value,1.0,0.0001);
+
+  // modification out of the window is ignored
+  Sum.modify(0,100.0);
+  BOOST_REQUIRE(Sum.get(Value));
+  BOOST_REQUIRE_CLOSE(Value,16.0,0.0001);
+
+  Max.remove(240);
+  BOOST_REQUIRE_EQUAL(Max.getValuesCount(),2);
+  BOOST_REQUIRE(Max.get(Value));
+  BOOST_REQUIRE_CLOSE(Value,2.0,0.0001);
+
+  Max.clear();
+  BOOST_REQUIRE_EQUAL(Max.getValuesCount(),0);
+  BOOST_REQUIRE(!Max.get(Value));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_last_seconds)
+{
+  WindowedAggregate Sum(WindowedAggregate::SUM,WindowedAggregate::LASTSECONDS,600);
+  double Value = 0.0;
+
+  // window keeps values with time index in ]latest-600,latest]
+  Sum.append(0,1.0);
+  Sum.append(300,2.0);
+  Sum.append(599,4.0);
+  BOOST_REQUIRE_EQUAL(Sum.getValuesCount(),3);
+  BOOST_REQUIRE(Sum.get(Value));
+  BOOST_REQUIRE_CLOSE(Value,7.0,0.0001);
+
+  Sum.append(600,8.0);
+  BOOST_REQUIRE_EQUAL(Sum.getValuesCount(),3);
+  BOOST_REQUIRE(Sum.get(Value));
+  BOOST_REQUIRE_CLOSE(Value,14.0,0.0001);
+
+  // irregular time steps
+  Sum.append(5000,16.0);
+  BOOST_REQUIRE_EQUAL(Sum.getValuesCount(),1);
+  BOOST_REQUIRE(Sum.get(Value));
+  BOOST_REQUIRE_CLOSE(Value,16.0,0.0001);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_against_full_scan)
+{
+  const WindowedAggregate::Method Methods[] =
+    {WindowedAggregate::SUM, WindowedAggregate::MEAN, WindowedAggregate::MIN, WindowedAggregate::MAX};
+
+  std::srand(42);
+
+  for (auto Meth : Methods)
+  {
+    for (unsigned long long Size : {1ULL, 7ULL, 50ULL})
+    {
+      WindowedAggregate ByValues(Meth,WindowedAggregate::LASTVALUES,Size);
+      WindowedAggregate BySeconds(Meth,WindowedAggregate::LASTSECONDS,Size*60);
+
+      std::deque<double> Window;
+      openfluid::core::TimeIndex_t Index = 0;
+
+      for (unsigned int i=0; i<2000; i++)
+      {
+        double Val = (std::rand() % 20001 - 10000) / 100.0;
+
+        Index += 60;
+        ByValues.append(Index,Val);
+        BySeconds.append(Index,Val);
+
+        Window.push_back(Val);
+        if (Window.size() > Size)
+          Window.pop_front();
+
+        // modification of the current value, as done by OPENFLUID_SetVariable
+        if (i % 13 == 0)
+        {
+          Val = (std::rand() % 20001 - 10000) / 100.0;
+          ByValues.modify(Index,Val);
+          BySeconds.modify(Index,Val);
+          Window.back() = Val;
+        }
+
+        double Expected = 0.0;
+        if (Meth == WindowedAggregate::SUM)
+          Expected = std::accumulate(Window.begin(),Window.end(),0.0);
+        else if (Meth == WindowedAggregate::MEAN)
+          Expected = std::accumulate(Window.begin(),Window.end(),0.0) / Window.size();
+        else if (Meth == WindowedAggregate::MIN)
+          Expected = *std::min_element(Window.begin(),Window.end());
+        else
+          Expected = *std::max_element(Window.begin(),Window.end());
+
+        double Value1 = 0.0, Value2 = 0.0;
+        BOOST_REQUIRE(ByValues.get(Value1));
+        BOOST_REQUIRE(BySeconds.get(Value2));
+        BOOST_REQUIRE_SMALL(Value1-Expected,1e-9);
+        BOOST_REQUIRE_SMALL(Value2-Expected,1e-9);
+        BOOST_REQUIRE_EQUAL(ByValues.getValuesCount(),Window.size());
+        BOOST_REQUIRE_EQUAL(BySeconds.getValuesCount(),Window.size());
+      }
+    }
+  }
+}
+
@@ -534,28 +534,27 @@ double LandRGraph::getRasterValueForEntityCentroid(const LandREntity& Entity)
 
 void LandRGraph::setAttributeFromRasterValueAtCentroid(const std::string& AttributeName)
 {
+  if (!mp_Raster)
+    throw openfluid::base::FrameworkException(
+        OPENFLUID_CODE_LOCATION,
+        "No raster associated to the PolygonGraph");
+
   addAttribute(AttributeName);
 
+  // centroids values are fetched all at once, grouped by raster block
+  std::vector<geos::geom::Coordinate> Centroids;
+  Centroids.reserve(m_Entities.size());
+
   LandRGraph::Entities_t::iterator it = m_Entities.begin();
   LandRGraph::Entities_t::iterator ite = m_Entities.end();
   for (; it != ite; ++it)
-  {
-    double* Val = new double (getRasterValueForEntityCentroid(
-        *const_cast<LandREntity*>(*it)));
+    Centroids.push_back(*(*it)->centroid()->getCoordinate());
 
-    if (!Val)
-    {
-      std::ostringstream s;
-      s << "No raster value for entity " << (*it)->getOfldId() << " centroid.";
-
-      throw openfluid::base::FrameworkException(
-          OPENFLUID_CODE_LOCATION, s.str());
-    }
-
-    (*it)->setAttributeValue(AttributeName, new core::DoubleValue(*Val));
-    delete Val;
-  }
+  std::vector<float> Values = mp_Raster->getValuesAtCoordinates(Centroids);
 
+  unsigned int i = 0;
+  for (it = m_Entities.begin(); it != ite; ++it, ++i)
+    (*it)->setAttributeValue(AttributeName, new core::DoubleValue((double) Values[i]));
 }
 
 
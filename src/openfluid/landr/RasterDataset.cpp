@@ -39,6 +39,7 @@
 #include "RasterDataset.hpp"
 
 #include <string.h>
+#include <algorithm>
 #include <gdal_alg.h>
 #include <geos/geom/Coordinate.h>
 #include <openfluid/core/GeoRasterValue.hpp>
@@ -53,7 +54,7 @@ namespace openfluid { namespace landr {
 
 
 RasterDataset::RasterDataset(openfluid::core::GeoRasterValue& Value) :
-    mp_GeoTransform(0)
+    mp_GeoTransform(0), m_BlocksCacheSize(64)
 {
   GDALAllRegister();
 
@@ -79,7 +80,7 @@ RasterDataset::RasterDataset(openfluid::core::GeoRasterValue& Value) :
 
 
 RasterDataset::RasterDataset(const RasterDataset& Other) :
-    mp_GeoTransform(0)
+    mp_GeoTransform(0), m_BlocksCacheSize(Other.m_BlocksCacheSize)
 {
   GDALAllRegister();
 
@@ -148,8 +149,11 @@ GDALRasterBand* RasterDataset::rasterBand(unsigned int RasterBandIndex)
 
 std::pair<int, int> RasterDataset::getPixelFromCoordinate(geos::geom::Coordinate Coo)
 {
-  int offsetX = int((Coo.x - computeOrigin()->x) / getPixelWidth());
-  int offsetY = int((Coo.y - computeOrigin()->y) / getPixelHeight());
+  if (!mp_GeoTransform)
+    computeGeoTransform();
+
+  int offsetX = int((Coo.x - mp_GeoTransform[0]) / mp_GeoTransform[1]);
+  int offsetY = int((Coo.y - mp_GeoTransform[3]) / mp_GeoTransform[5]);
 
   return std::make_pair(offsetX, offsetY);
 }
@@ -216,20 +220,17 @@ double RasterDataset::getPixelHeight()
 std::vector<float> RasterDataset::getValuesOfLine(int LineIndex,
                                                   unsigned int RasterBandIndex)
 {
-  std::vector<float> Val;
-
   int ColumnCount = rasterBand(RasterBandIndex)->GetXSize();
 
-  float* ScanLine = (float *) CPLMalloc(sizeof(float) * ColumnCount);
+  std::vector<float> Val(ColumnCount);
 
-  rasterBand(RasterBandIndex)->RasterIO(GF_Read, 0, LineIndex, ColumnCount,
-                                           1, ScanLine, ColumnCount, 1,
-                                           GDT_Float32, 0, 0);
-
-  for (int i = 0; i < ColumnCount; i++)
-    Val.push_back(ScanLine[i]);
-
-  CPLFree(ScanLine);
+  if (rasterBand(RasterBandIndex)->RasterIO(GF_Read, 0, LineIndex, ColumnCount,
+                                            1, Val.data(), ColumnCount, 1,
+                                            GDT_Float32, 0, 0)
+      != CE_None)
+    throw openfluid::base::FrameworkException(
+        OPENFLUID_CODE_LOCATION,
+        "Error while getting values of line from raster.");
 
   return Val;
 }
@@ -242,22 +243,45 @@ std::vector<float> RasterDataset::getValuesOfLine(int LineIndex,
 std::vector<float> RasterDataset::getValuesOfColumn(int ColIndex,
                                                     unsigned int RasterBandIndex)
 {
-  std::vector<float> Val;
-
   int LineCount = rasterBand(RasterBandIndex)->GetYSize();
 
-  float* ScanLine = (float *) CPLMalloc(sizeof(float) * LineCount);
+  std::vector<float> Val(LineCount);
 
-  rasterBand(RasterBandIndex)->RasterIO(GF_Read, ColIndex, 0, 1, LineCount,
-                                           ScanLine, 1, LineCount, GDT_Float32,
-                                           0, 0);
+  if (rasterBand(RasterBandIndex)->RasterIO(GF_Read, ColIndex, 0, 1, LineCount,
+                                            Val.data(), 1, LineCount, GDT_Float32,
+                                            0, 0)
+      != CE_None)
+    throw openfluid::base::FrameworkException(
+        OPENFLUID_CODE_LOCATION,
+        "Error while getting values of column from raster.");
 
-  for (int i = 0; i < LineCount; i++)
-    Val.push_back(ScanLine[i]);
+  return Val;
+}
 
-  CPLFree(ScanLine);
 
-  return Val;
+// =====================================================================
+// =====================================================================
+
+
+RasterDataset::BlockKey_t RasterDataset::getBlockKeyOfPixel(int ColIndex, int LineIndex,
+                                                            unsigned int RasterBandIndex)
+{
+  GDALRasterBand* Band = rasterBand(RasterBandIndex);
+
+  if (!Band)
+    throw openfluid::base::FrameworkException(
+        OPENFLUID_CODE_LOCATION,
+        "Wrong raster band index.");
+
+  if (ColIndex < 0 || LineIndex < 0 || ColIndex >= Band->GetXSize() || LineIndex >= Band->GetYSize())
+    throw openfluid::base::FrameworkException(
+        OPENFLUID_CODE_LOCATION,
+        "Error while getting value from raster: pixel is out of the raster.");
+
+  int BlockWidth, BlockHeight;
+  Band->GetBlockSize(&BlockWidth,&BlockHeight);
+
+  return std::make_pair(RasterBandIndex,std::make_pair(ColIndex / BlockWidth, LineIndex / BlockHeight));
 }
 
 
@@ -265,28 +289,73 @@ std::vector<float> RasterDataset::getValuesOfColumn(int ColIndex,
 // =====================================================================
 
 
-float RasterDataset::getValueOfPixel(int ColIndex,
-                                     int LineIndex,
-                                     unsigned int RasterBandIndex)
+const RasterDataset::CachedBlock& RasterDataset::getBlock(const BlockKey_t& Key)
 {
-  float Val;
+  std::map<BlockKey_t, BlocksList_t::iterator>::iterator itFound = m_CachedBlocksByKey.find(Key);
+
+  if (itFound != m_CachedBlocksByKey.end())
+  {
+    // block becomes the most recently used
+    m_CachedBlocks.splice(m_CachedBlocks.begin(),m_CachedBlocks,itFound->second);
+    return m_CachedBlocks.front();
+  }
+
+
+  GDALRasterBand* Band = rasterBand(Key.first);
+
+  int BlockWidth, BlockHeight;
+  Band->GetBlockSize(&BlockWidth,&BlockHeight);
 
-  float* ScanLine = (float *) CPLMalloc(sizeof(float));
+  int XOffset = Key.second.first * BlockWidth;
+  int YOffset = Key.second.second * BlockHeight;
+
+  // blocks on the right and bottom borders may be partial
+  int Width = std::min(BlockWidth,Band->GetXSize()-XOffset);
+  int Height = std::min(BlockHeight,Band->GetYSize()-YOffset);
+
+  std::vector<float> Values(Width*Height);
 
   //  The pixel values will automatically be translated from the GDALRasterBand data type as needed.
-  if (rasterBand(RasterBandIndex)->RasterIO(GF_Read, ColIndex, LineIndex, 1,
-                                               1, ScanLine, 1, 1, GDT_Float32,
-                                               0, 0)
+  if (Band->RasterIO(GF_Read, XOffset, YOffset, Width, Height,
+                     Values.data(), Width, Height, GDT_Float32, 0, 0)
       != CE_None)
     throw openfluid::base::FrameworkException(
         OPENFLUID_CODE_LOCATION,
         "Error while getting value from raster.");
 
-  Val = ScanLine[0];
 
-  CPLFree(ScanLine);
+  while (!m_CachedBlocks.empty() && m_CachedBlocks.size() >= m_BlocksCacheSize)
+  {
+    m_CachedBlocksByKey.erase(m_CachedBlocks.back().Key);
+    m_CachedBlocks.pop_back();
+  }
+
+  m_CachedBlocks.push_front(CachedBlock());
+  m_CachedBlocks.front().Key = Key;
+  m_CachedBlocks.front().Width = Width;
+  m_CachedBlocks.front().Values.swap(Values);
+  m_CachedBlocksByKey[Key] = m_CachedBlocks.begin();
 
-  return Val;
+  return m_CachedBlocks.front();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+float RasterDataset::getValueOfPixel(int ColIndex,
+                                     int LineIndex,
+                                     unsigned int RasterBandIndex)
+{
+  BlockKey_t Key = getBlockKeyOfPixel(ColIndex,LineIndex,RasterBandIndex);
+
+  int BlockWidth, BlockHeight;
+  rasterBand(RasterBandIndex)->GetBlockSize(&BlockWidth,&BlockHeight);
+
+  const CachedBlock& Block = getBlock(Key);
+
+  return Block.Values[(LineIndex % BlockHeight) * Block.Width + (ColIndex % BlockWidth)];
 }
 
 
@@ -307,6 +376,76 @@ float RasterDataset::getValueOfCoordinate(geos::geom::Coordinate Coo,
 // =====================================================================
 
 
+std::vector<float> RasterDataset::getValuesAtCoordinates(const std::vector<geos::geom::Coordinate>& Coos,
+                                                         unsigned int RasterBandIndex)
+{
+  std::vector<float> Values(Coos.size());
+
+  // pixels are grouped by block, so that each block is read and looked up in cache only once,
+  // whatever the cache size and the order of the coordinates
+  std::map<BlockKey_t, std::vector<std::pair<std::size_t, std::pair<int, int> > > > PixelsByBlock;
+
+  for (std::size_t i = 0; i < Coos.size(); i++)
+  {
+    std::pair<int, int> Pixel = getPixelFromCoordinate(Coos[i]);
+    PixelsByBlock[getBlockKeyOfPixel(Pixel.first,Pixel.second,RasterBandIndex)].push_back(std::make_pair(i,Pixel));
+  }
+
+  if (PixelsByBlock.empty())
+    return Values;
+
+  int BlockWidth, BlockHeight;
+  rasterBand(RasterBandIndex)->GetBlockSize(&BlockWidth,&BlockHeight);
+
+  for (auto& BlockPixels : PixelsByBlock)
+  {
+    const CachedBlock& Block = getBlock(BlockPixels.first);
+
+    for (auto& Pixel : BlockPixels.second)
+      Values[Pixel.first] =
+          Block.Values[(Pixel.second.second % BlockHeight) * Block.Width + (Pixel.second.first % BlockWidth)];
+  }
+
+  return Values;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void RasterDataset::setBlocksCacheSize(unsigned int Size)
+{
+  if (!Size)
+    throw openfluid::base::FrameworkException(
+        OPENFLUID_CODE_LOCATION,
+        "Blocks cache size must be greater than 0");
+
+  m_BlocksCacheSize = Size;
+
+  while (m_CachedBlocks.size() > m_BlocksCacheSize)
+  {
+    m_CachedBlocksByKey.erase(m_CachedBlocks.back().Key);
+    m_CachedBlocks.pop_back();
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void RasterDataset::clearBlocksCache()
+{
+  m_CachedBlocks.clear();
+  m_CachedBlocksByKey.clear();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 openfluid::landr::VectorDataset* RasterDataset::polygonize(const std::string& FileName,
                                                            std::string FieldName,
                                                            unsigned int RasterBandIndex)
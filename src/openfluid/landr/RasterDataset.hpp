@@ -40,6 +40,8 @@
 #define __OPENFLUID_LANDR_RASTERDATASET_HPP__
 
 #include <map>
+#include <list>
+#include <vector>
 #include "gdal_priv.h"
 #include <ogrsf_frmts.h>
 #include "cpl_conv.h" // for CPLMalloc()
@@ -79,11 +81,61 @@ class OPENFLUID_API RasterDataset
     */
     std::map<unsigned int, openfluid::landr::VectorDataset*> mp_PolygonizedByRasterBandIndex;
 
+    /**
+      @brief Key of a cached block: raster band index, block column index, block line index.
+    */
+    typedef std::pair<unsigned int, std::pair<int, int> > BlockKey_t;
+
+    /**
+      @brief A block of pixel values read from a raster band, stored line by line.
+    */
+    struct CachedBlock
+    {
+      BlockKey_t Key;
+
+      /**
+        @brief The real width of the block (smaller than the natural block width on the raster right border)
+      */
+      int Width;
+
+      std::vector<float> Values;
+    };
+
+    typedef std::list<CachedBlock> BlocksList_t;
+
+    /**
+      @brief The cached blocks, from the most recently used to the least recently used.
+    */
+    BlocksList_t m_CachedBlocks;
+
+    /**
+      @brief Index of the cached blocks by key.
+    */
+    std::map<BlockKey_t, BlocksList_t::iterator> m_CachedBlocksByKey;
+
+    /**
+      @brief The maximum number of blocks kept in cache.
+    */
+    unsigned int m_BlocksCacheSize;
+
     /**
       @brief Computes the affine transformation coefficients of this RasterDataset.
     */
     void computeGeoTransform();
 
+    /**
+      @brief Returns the key of the block containing the given pixel, according to the natural block size
+      of the raster band.
+    */
+    BlockKey_t getBlockKeyOfPixel(int ColIndex, int LineIndex, unsigned int RasterBandIndex);
+
+    /**
+      @brief Returns the cached block for the given key, reading it from the raster band if not already in cache.
+      @details The least recently used block is evicted when the cache is full.
+      @throw openfluid::base::FrameworkException if the block cannot be read
+    */
+    const CachedBlock& getBlock(const BlockKey_t& Key);
+
   public:
 
     /**
@@ -162,6 +214,7 @@ class OPENFLUID_API RasterDataset
 
     /**
       @brief Returns the pixel value with column and line index.
+      @details The value is read from the cached raster block containing the pixel.
       @param ColIndex The column index.
       @param LineIndex The line index.
       @param RasterBandIndex The raster band index (default is 1).
@@ -180,6 +233,34 @@ class OPENFLUID_API RasterDataset
     float getValueOfCoordinate(geos::geom::Coordinate Coo,
                                unsigned int RasterBandIndex = 1);
 
+    /**
+      @brief Returns the pixel values for a set of coordinates.
+      @details Lookups are grouped by raster block so that each block is read only once.
+      @param Coos The geos::geom::Coordinate to get the pixel values for.
+      @param RasterBandIndex The raster band index (default is 1).
+      @return A vector of pixel values, in the same order as the given coordinates.
+      @throw openfluid::base::FrameworkException if a coordinate is out of the raster
+    */
+    std::vector<float> getValuesAtCoordinates(const std::vector<geos::geom::Coordinate>& Coos,
+                                              unsigned int RasterBandIndex = 1);
+
+    /**
+      @brief Sets the maximum number of raster blocks kept in cache for pixel values access
+      @param Size The maximum number of blocks, must be greater than 0 (default is 64)
+    */
+    void setBlocksCacheSize(unsigned int Size);
+
+    /**
+      @brief Returns the maximum number of raster blocks kept in cache for pixel values access
+    */
+    unsigned int getBlocksCacheSize() const
+    { return m_BlocksCacheSize; }
+
+    /**
+      @brief Clears the raster blocks cache
+    */
+    void clearBlocksCache();
+
     /**
       @brief Creates a new VectorDataset with polygons for all connected regions of pixels
       in the raster sharing a common pixel value.
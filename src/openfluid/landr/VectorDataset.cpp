@@ -64,9 +64,10 @@ namespace openfluid { namespace landr {
 // =====================================================================
 
 
-VectorDataset::VectorDataset(const std::string& FileName)
+VectorDataset::VectorDataset(const std::string& FileName) :
+  mp_DataSource(nullptr), m_IsSourceView(false), m_IsInMemory(false), m_DriverName("ESRI Shapefile")
 {
-  std::string DefaultDriverName = "ESRI Shapefile";
+  std::string DefaultDriverName = m_DriverName;
   OGRRegisterAll();
 
   OGRDataSource  *poDS= OGRSFDriverRegistrar::Open( FileName.c_str(), FALSE );
@@ -110,42 +111,50 @@ VectorDataset::VectorDataset(const std::string& FileName)
 // =====================================================================
 
 
-VectorDataset::VectorDataset(openfluid::core::GeoVectorValue& Value)
+VectorDataset::VectorDataset(openfluid::core::GeoVectorValue& Value) :
+  mp_DataSource(nullptr), m_IsSourceView(true), m_IsInMemory(false), m_DriverName("ESRI Shapefile")
 {
   OGRRegisterAll();
 
-  OGRDataSource* DS = Value.data();
-  OGRSFDriver* Driver = DS->GetDriver();
+  // the file is only viewed, the data will be copied in memory if this dataset is modified
+  mp_DataSource = openView(Value.getAbsolutePath());
+}
 
-  std::string DriverName=Driver->GetName();
 
-  if (DriverName!="ESRI Shapefile")
-    throw openfluid::base::FrameworkException(
-        OPENFLUID_CODE_LOCATION,
-        "\"" + DriverName + "\" driver not supported.");
+// =====================================================================
+// =====================================================================
 
-  std::string Path = getTimestampedPath(openfluid::tools::Filesystem::basename(DS->GetName()));
 
-  mp_DataSource = Driver->CopyDataSource(DS, Path.c_str(), nullptr);
+VectorDataset::VectorDataset(const VectorDataset& Other) :
+  mp_DataSource(nullptr), m_IsSourceView(Other.m_IsSourceView), m_IsInMemory(false),
+  m_DriverName(Other.m_DriverName)
+{
+  OGRRegisterAll();
 
-  if (!mp_DataSource)
-    throw openfluid::base::FrameworkException(
-        OPENFLUID_CODE_LOCATION,
-        "Error while creating " + Path + " : "
-        + "Creation of OGRDataSource failed.");
+  if (m_IsSourceView)
+  {
+    mp_DataSource = openView(Other.source()->GetName());
+  }
+  else
+  {
+    mp_DataSource = createMemoryCopy(Other.source());
+    m_IsInMemory = true;
+  }
+}
 
-  mp_DataSource->SetDriver(Driver);
 
-  // necessary to ensure headers are written out in an orderly way and all resources are recovered
-  OGRDataSource::DestroyDataSource(mp_DataSource);
+// =====================================================================
+// =====================================================================
 
-  mp_DataSource = OGRSFDriverRegistrar::Open(Path.c_str(), true);
 
-  if (!mp_DataSource)
+void VectorDataset::checkDriverSupport(OGRDataSource* DS)
+{
+  std::string DriverName = DS->GetDriver()->GetName();
+
+  if (DriverName != "ESRI Shapefile")
     throw openfluid::base::FrameworkException(
         OPENFLUID_CODE_LOCATION,
-        "Error while opening " + Path + " : "
-        + "Creation of OGRDataSource failed.");
+        "\"" + DriverName + "\" driver not supported.");
 }
 
 
@@ -153,42 +162,73 @@ VectorDataset::VectorDataset(openfluid::core::GeoVectorValue& Value)
 // =====================================================================
 
 
-VectorDataset::VectorDataset(const VectorDataset& Other)
+OGRDataSource* VectorDataset::openView(const std::string& Path)
 {
-  OGRRegisterAll();
+  OGRDataSource* DS = OGRSFDriverRegistrar::Open(Path.c_str(), false);
 
-  OGRDataSource* DS = Other.source();
-  OGRSFDriver* Driver = DS->GetDriver();
+  if (!DS)
+    throw openfluid::base::FrameworkException(
+        OPENFLUID_CODE_LOCATION,
+        "Error while trying to open file " + Path);
+
+  try
+  {
+    checkDriverSupport(DS);
+  }
+  catch (openfluid::base::FrameworkException&)
+  {
+    OGRDataSource::DestroyDataSource(DS);
+    throw;
+  }
+
+  return DS;
+}
 
-  std::string DriverName=Driver->GetName();
 
-  if (DriverName!="ESRI Shapefile")
+// =====================================================================
+// =====================================================================
+
+
+OGRDataSource* VectorDataset::createMemoryCopy(OGRDataSource* DS)
+{
+  OGRSFDriver* MemDriver = OGRSFDriverRegistrar::GetRegistrar()->GetDriverByName("Memory");
+
+  if (!MemDriver)
     throw openfluid::base::FrameworkException(
         OPENFLUID_CODE_LOCATION,
-        "\"" + DriverName + "\" driver not supported.");
+        "\"Memory\" driver not available.");
 
-  std::string Path = getTimestampedPath(openfluid::tools::Filesystem::basename(DS->GetName()));
+  std::string Name = openfluid::tools::Filesystem::basename(DS->GetName());
 
-  mp_DataSource = Driver->CopyDataSource(DS, Path.c_str(), nullptr);
+  OGRDataSource* MemDS = MemDriver->CopyDataSource(DS, Name.c_str(), nullptr);
 
-  if (!mp_DataSource)
+  if (!MemDS)
     throw openfluid::base::FrameworkException(
         OPENFLUID_CODE_LOCATION,
-        "Error while creating " + Path + " : "
-        + "Creation of OGRDataSource failed.");
+        "Error while copying " + std::string(DS->GetName()) + " : "
+        + "Creation of in-memory OGRDataSource failed.");
 
-  mp_DataSource->SetDriver(Driver);
+  MemDS->SetDriver(MemDriver);
 
-  // necessary to ensure headers are written out in an orderly way and all resources are recovered
-  OGRDataSource::DestroyDataSource(mp_DataSource);
+  return MemDS;
+}
 
-  mp_DataSource = OGRSFDriverRegistrar::Open(Path.c_str(), true);
 
-  if (!mp_DataSource)
-    throw openfluid::base::FrameworkException(
-        OPENFLUID_CODE_LOCATION,
-        "Error while opening " + Path + " : "
-        + "Creation of OGRDataSource failed.");
+// =====================================================================
+// =====================================================================
+
+
+void VectorDataset::ensureWritable()
+{
+  if (!m_IsSourceView)
+    return;
+
+  OGRDataSource* MemDS = createMemoryCopy(mp_DataSource);
+  OGRDataSource::DestroyDataSource(mp_DataSource);
+
+  mp_DataSource = MemDS;
+  m_IsSourceView = false;
+  m_IsInMemory = true;
 }
 
 
@@ -255,6 +295,13 @@ bool VectorDataset::isAlreadyExisting(const std::string& Path)
 
 VectorDataset::~VectorDataset()
 {
+  // the viewed file is left untouched
+  if (m_IsSourceView || m_IsInMemory)
+  {
+    OGRDataSource::DestroyDataSource(mp_DataSource);
+    return;
+  }
+
   OGRSFDriver* Driver = mp_DataSource->GetDriver();
   std::string Path = mp_DataSource->GetName();
 
@@ -295,7 +342,13 @@ void VectorDataset::copyToDisk(const std::string& FilePath,
                                const std::string& FileName,
                                bool ReplaceIfExists)
 {
-  OGRSFDriver* Driver = mp_DataSource->GetDriver();
+  // in-memory and viewed datasources are written using the original driver
+  OGRSFDriver* Driver = OGRSFDriverRegistrar::GetRegistrar()->GetDriverByName(m_DriverName.c_str());
+
+  if (!Driver)
+    throw openfluid::base::FrameworkException(
+        OPENFLUID_CODE_LOCATION,
+        "\"" + m_DriverName + "\" driver not available.");
 
   if (!openfluid::tools::Filesystem::isDirectory(FilePath))
     openfluid::tools::Filesystem::makeDirectory(FilePath);
@@ -345,6 +398,8 @@ void VectorDataset::addALayer(std::string LayerName,
                               OGRwkbGeometryType LayerType,
                               OGRSpatialReference* SpatialRef)
 {
+  ensureWritable();
+
   if (mp_DataSource->GetLayerByName(LayerName.c_str()) != nullptr)
     throw openfluid::base::FrameworkException(
         OPENFLUID_CODE_LOCATION,
@@ -360,6 +415,9 @@ void VectorDataset::addALayer(std::string LayerName,
         "Error while adding a layer to " + std::string(mp_DataSource->GetName())
         + ": creation of layer " + LayerName + " failed.");
 
+  if (m_IsInMemory)
+    return;
+
   std::string Path = mp_DataSource->GetName();
 
   // necessary to ensure headers are written out in an orderly way and all resources are recovered
@@ -403,6 +461,8 @@ void VectorDataset::addAField(const std::string& FieldName,
                               OGRFieldType FieldType,
                               unsigned int LayerIndex)
 {
+  ensureWritable();
+
   OGRFieldDefn Field(FieldName.c_str(), FieldType);
 
   if (layer(LayerIndex)->CreateField(&Field) != OGRERR_NONE)
@@ -638,6 +698,8 @@ void VectorDataset::setIndexIntField(const std::string& FieldName,
           OPENFLUID_CODE_LOCATION,
           "Field \"" + FieldName + "\" is not set or is not of type Int.");
 
+    ensureWritable();
+
     OGRLayer* Layer = layer(LayerIndex);
 
     if (! Layer->TestCapability( "RandomWrite"))
@@ -679,6 +741,8 @@ OGREnvelope VectorDataset::envelope()
 
 void VectorDataset::snapVertices(double Threshold,unsigned int LayerIndex)
 {
+  ensureWritable();
+
   if (isLineType())
     snapLineNodes(Threshold,LayerIndex);
 
@@ -1049,6 +1113,8 @@ void VectorDataset::cleanOverlap(double Threshold, unsigned int LayerIndex)
         OPENFLUID_CODE_LOCATION,
         "the VectorDataset is not Polygon type.");
 
+  ensureWritable();
+
   m_Features.clear();
   m_Geometries.clear();
   std::list<std::pair<OGRFeature*,OGRFeature*> > lOverlaps=findOverlap();
@@ -77,6 +77,21 @@ class OPENFLUID_API VectorDataset
     */
     OGRDataSource* mp_DataSource;
 
+    /**
+      @brief True if the OGRDataSource is a read-only view of the file of a GeoVectorValue.
+    */
+    bool m_IsSourceView;
+
+    /**
+      @brief True if the OGRDataSource is held in memory using the OGR Memory driver.
+    */
+    bool m_IsInMemory;
+
+    /**
+      @brief The name of the driver used to write this VectorDataset to disk.
+    */
+    std::string m_DriverName;
+
     /**
       @brief A list of all features of layers of this VectorDataset, indexed by layer index.
     */
@@ -105,6 +120,25 @@ class OPENFLUID_API VectorDataset
     */
     bool isAlreadyExisting(const std::string& Path);
 
+    /**
+      @brief Opens a read-only OGRDataSource owned by this VectorDataset, viewing the given file.
+      @param Path The path of the file to view.
+      @throw openfluid::base::FrameworkException if fails.
+    */
+    static OGRDataSource* openView(const std::string& Path);
+
+    /**
+      @brief Returns a copy of a OGRDataSource held in memory.
+      @param DS The OGRDataSource to copy.
+      @throw openfluid::base::FrameworkException if fails.
+    */
+    static OGRDataSource* createMemoryCopy(OGRDataSource* DS);
+
+    /**
+      @brief Throws if the driver of a OGRDataSource is not supported.
+    */
+    static void checkDriverSupport(OGRDataSource* DS);
+
     /**
       @brief Parse the geometry of this VectorDataset.
       @param LayerIndex The index layer.
@@ -126,15 +160,18 @@ class OPENFLUID_API VectorDataset
     VectorDataset(const std::string& FileName);
 
     /**
-      @brief Creates in the openfluid temp directory a copy of Value OGRDatasource,
-      using Value filename suffixed with timestamp as filename.
-      @param Value The GeoVectorValue to copy
+      @brief Creates a read-only view of the file of Value, without copying its data.
+      The view opens its own read-only OGRDataSource on the file: it does not depend on the lifetime of Value,
+      and the reading cursors of its layers are not shared with Value nor with other views.
+      The data are copied in memory only when this VectorDataset is modified (see ensureWritable()).
+      @param Value The GeoVectorValue to view
       @throw openfluid::base::FrameworkException if fails.
     */
     VectorDataset(openfluid::core::GeoVectorValue& Value);
 
     /**
-      @brief Copy constructor.
+      @brief Copy constructor. A view of a GeoVectorValue opens its own read-only OGRDataSource on the same file,
+      other datasets are copied in memory.
       @throw openfluid::base::FrameworkException if fails.
     */
     VectorDataset(const VectorDataset& Other);
@@ -144,6 +181,21 @@ class OPENFLUID_API VectorDataset
     */
     ~VectorDataset();
 
+    /**
+      @brief Copies in memory the data of the viewed GeoVectorValue, if any,
+      so that this VectorDataset can be modified without altering the source.
+      Automatically called by the methods modifying this VectorDataset,
+      it must be called before modifying directly the layers returned by source() or layer().
+      @throw openfluid::base::FrameworkException if fails.
+    */
+    void ensureWritable();
+
+    /**
+      @brief Returns true if this VectorDataset is a read-only view of a GeoVectorValue.
+    */
+    bool isSourceView() const
+    { return m_IsSourceView; }
+
     /**
       @brief Returns the OGRDataSource associated to this VectorDataset.
     */
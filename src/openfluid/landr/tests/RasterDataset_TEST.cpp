@@ -245,6 +245,51 @@ BOOST_AUTO_TEST_CASE(check_getValueOfCoordinate)
 // =====================================================================
 
 
+BOOST_AUTO_TEST_CASE(check_getValuesAtCoordinates)
+{
+  openfluid::core::GeoRasterValue Val(
+      CONFIGTESTS_INPUT_MISCDATA_DIR + "/GeoRasterValue", "dem.jpeg");
+
+  openfluid::landr::RasterDataset* Rast = new openfluid::landr::RasterDataset(
+      Val);
+
+  BOOST_CHECK_EQUAL(Rast->getBlocksCacheSize(),64);
+
+  std::vector<geos::geom::Coordinate> Coos;
+  Coos.push_back(geos::geom::Coordinate(679288.64458,132607.541088));
+  Coos.push_back(*Rast->computeOrigin());
+  Coos.push_back(geos::geom::Coordinate(679288.64458,132607.541088));
+
+  std::vector<float> Values = Rast->getValuesAtCoordinates(Coos);
+
+  BOOST_REQUIRE_EQUAL(Values.size(),3);
+  BOOST_CHECK_EQUAL(Values[0],83);
+  BOOST_CHECK_EQUAL(Values[1],96);
+  BOOST_CHECK_EQUAL(Values[2],83);
+
+  // smallest cache, values must remain consistent with direct reads
+  Rast->setBlocksCacheSize(1);
+  BOOST_CHECK_EQUAL(Rast->getBlocksCacheSize(),1);
+
+  std::vector<float> Line19 = Rast->getValuesOfLine(19);
+  for (unsigned int i = 0; i < Line19.size(); i++)
+    BOOST_CHECK_EQUAL(Line19[i], Rast->getValueOfPixel(i,19));
+
+  Rast->clearBlocksCache();
+  BOOST_CHECK_EQUAL(Rast->getValueOfPixel(4,4),86);
+
+  BOOST_CHECK_THROW(Rast->getValueOfPixel(20,0),openfluid::base::FrameworkException);
+  BOOST_CHECK_THROW(Rast->getValueOfPixel(0,-1),openfluid::base::FrameworkException);
+  BOOST_CHECK_THROW(Rast->setBlocksCacheSize(0),openfluid::base::FrameworkException);
+
+  delete Rast;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 BOOST_AUTO_TEST_CASE(check_Polygonize)
 {
   // integer values
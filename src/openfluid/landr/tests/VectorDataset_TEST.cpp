@@ -246,6 +246,64 @@ BOOST_AUTO_TEST_CASE(check_addField)
 // =====================================================================
 
 
+BOOST_AUTO_TEST_CASE(check_copyOnWrite)
+{
+  openfluid::core::GeoVectorValue Value(
+      CONFIGTESTS_INPUT_MISCDATA_DIR + "/landr", "SU.shp");
+
+  openfluid::landr::VectorDataset* Vect = new openfluid::landr::VectorDataset(Value);
+
+  BOOST_CHECK(Vect->isSourceView());
+  BOOST_CHECK(Vect->source() != Value.data());
+
+  openfluid::landr::VectorDataset* VectCopy = new openfluid::landr::VectorDataset(*Vect);
+
+  BOOST_CHECK(VectCopy->isSourceView());
+  BOOST_CHECK(VectCopy->source() != Vect->source());
+
+  // views do not share reading cursors
+  OGRFeature* Feature1 = Vect->layer()->GetNextFeature();
+  VectCopy->layer()->ResetReading();
+  OGRFeature* Feature2 = Vect->layer()->GetNextFeature();
+  BOOST_CHECK(Feature1->GetFID() != Feature2->GetFID());
+  OGRFeature::DestroyFeature(Feature1);
+  OGRFeature::DestroyFeature(Feature2);
+
+  Vect->addAField("NewField", OFTInteger);
+
+  BOOST_CHECK(!Vect->isSourceView());
+  BOOST_CHECK(Vect->source() != Value.data());
+  BOOST_CHECK_EQUAL(Vect->layer()->GetFeatureCount(), 24);
+  BOOST_CHECK(Vect->containsField("NewField"));
+  BOOST_CHECK(!VectCopy->containsField("NewField"));
+  BOOST_CHECK_EQUAL(Value.data()->GetLayer(0)->GetLayerDefn()->GetFieldIndex("NewField"), -1);
+
+  openfluid::landr::VectorDataset* VectCopy2 = new openfluid::landr::VectorDataset(*Vect);
+
+  BOOST_CHECK(!VectCopy2->isSourceView());
+  BOOST_CHECK(VectCopy2->source() != Vect->source());
+  BOOST_CHECK(VectCopy2->containsField("NewField"));
+
+  delete VectCopy2;
+  delete VectCopy;
+  delete Vect;
+
+  // views outlive the viewed value
+  openfluid::core::GeoVectorValue* TmpValue = new openfluid::core::GeoVectorValue(
+      CONFIGTESTS_INPUT_MISCDATA_DIR + "/landr", "SU.shp");
+  Vect = new openfluid::landr::VectorDataset(*TmpValue);
+  delete TmpValue;
+
+  BOOST_CHECK_EQUAL(Vect->layer()->GetFeatureCount(), 24);
+
+  delete Vect;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 BOOST_AUTO_TEST_CASE(check_parse)
 {
   openfluid::core::GeoVectorValue Value(
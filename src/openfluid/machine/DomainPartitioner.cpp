@@ -0,0 +1,403 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+
+/**
+  @file DomainPartitioner.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@supagro.inra.fr>
+ */
+
+
+#include <algorithm>
+#include <deque>
+
+#include <openfluid/machine/DomainPartitioner.hpp>
+#include <openfluid/fluidx/SpatialDomainDescriptor.hpp>
+#include <openfluid/fluidx/SpatialUnitDescriptor.hpp>
+#include <openfluid/base/FrameworkException.hpp>
+#include <openfluid/tools/IDHelpers.hpp>
+
+
+namespace openfluid { namespace machine {
+
+
+// =====================================================================
+// =====================================================================
+
+
+DomainPartitioner::DomainPartitioner(openfluid::fluidx::SpatialDomainDescriptor& Descriptor,
+                                     unsigned int PartsCount) :
+  m_PartsCount(PartsCount)
+{
+  if (!m_PartsCount)
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"Wrong count of parts for domain partitioning");
+
+  buildGraph(Descriptor);
+  computeInitialParts();
+  refineParts();
+  computeBoundaryUnits();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void DomainPartitioner::buildGraph(openfluid::fluidx::SpatialDomainDescriptor& Descriptor)
+{
+  for (openfluid::fluidx::SpatialUnitDescriptor& UnitDesc : Descriptor.spatialUnits())
+  {
+    if (m_IndexOfUnit.insert(std::make_pair(std::make_pair(UnitDesc.getUnitsClass(),UnitDesc.getID()),
+                                            m_Units.size())).second)
+      m_Units.push_back(&UnitDesc);
+  }
+
+  m_Neighbours.resize(m_Units.size());
+
+  for (unsigned int i=0; i<m_Units.size(); i++)
+  {
+    for (auto LinksList : {&m_Units[i]->toSpatialUnits(),&m_Units[i]->parentSpatialUnits()})
+    {
+      for (const openfluid::core::UnitClassID_t& Linked : *LinksList)
+      {
+        auto itIndex = m_IndexOfUnit.find(Linked);
+
+        if (itIndex != m_IndexOfUnit.end() && itIndex->second != i)
+        {
+          m_Neighbours[i].push_back(itIndex->second);
+          m_Neighbours[itIndex->second].push_back(i);
+        }
+      }
+    }
+  }
+
+  for (std::vector<unsigned int>& UnitNeighbours : m_Neighbours)
+  {
+    std::sort(UnitNeighbours.begin(),UnitNeighbours.end());
+    UnitNeighbours.erase(std::unique(UnitNeighbours.begin(),UnitNeighbours.end()),UnitNeighbours.end());
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void DomainPartitioner::computeInitialParts()
+{
+  const unsigned int UnitsCount = m_Units.size();
+
+  // breadth-first ordering of all units, each connected component being started from a unit of lowest degree
+
+  std::vector<unsigned int> StartCandidates(UnitsCount);
+  std::vector<bool> Visited(UnitsCount,false);
+  std::vector<unsigned int> Order;
+
+  for (unsigned int i=0; i<UnitsCount; i++)
+    StartCandidates[i] = i;
+
+  std::stable_sort(StartCandidates.begin(),StartCandidates.end(),
+                   [this](unsigned int I1, unsigned int I2)
+                   { return m_Neighbours[I1].size() < m_Neighbours[I2].size(); });
+
+  Order.reserve(UnitsCount);
+
+  for (unsigned int Start : StartCandidates)
+  {
+    if (Visited[Start])
+      continue;
+
+    std::deque<unsigned int> Queue;
+    Queue.push_back(Start);
+    Visited[Start] = true;
+
+    while (!Queue.empty())
+    {
+      const unsigned int Current = Queue.front();
+      Queue.pop_front();
+      Order.push_back(Current);
+
+      for (unsigned int Neighbour : m_Neighbours[Current])
+      {
+        if (!Visited[Neighbour])
+        {
+          Visited[Neighbour] = true;
+          Queue.push_back(Neighbour);
+        }
+      }
+    }
+  }
+
+
+  // parts are contiguous ranges of equal sizes in this ordering
+
+  m_PartOfUnit.resize(UnitsCount);
+  m_PartsSizes.assign(m_PartsCount,0);
+
+  for (unsigned int Rank=0; Rank<UnitsCount; Rank++)
+  {
+    const unsigned int Part = (static_cast<unsigned long>(Rank)*m_PartsCount)/UnitsCount;
+    m_PartOfUnit[Order[Rank]] = Part;
+    m_PartsSizes[Part]++;
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void DomainPartitioner::refineParts()
+{
+  if (m_PartsCount < 2 || m_Units.empty())
+    return;
+
+  // parts may differ from their ideal size by 3%
+  const double IdealSize = double(m_Units.size())/m_PartsCount;
+  const unsigned int MaxSize = static_cast<unsigned int>(IdealSize*1.03)+1;
+  const unsigned int MinSize = static_cast<unsigned int>(IdealSize*0.97);
+
+  std::vector<unsigned int> NeighboursByPart(m_PartsCount);
+
+  for (unsigned int Pass=0; Pass<2; Pass++)
+  {
+    bool Moved = false;
+
+    for (unsigned int i=0; i<m_Units.size(); i++)
+    {
+      const unsigned int CurrentPart = m_PartOfUnit[i];
+
+      std::fill(NeighboursByPart.begin(),NeighboursByPart.end(),0);
+      for (unsigned int Neighbour : m_Neighbours[i])
+        NeighboursByPart[m_PartOfUnit[Neighbour]]++;
+
+      unsigned int BestPart = CurrentPart;
+      for (unsigned int Part=0; Part<m_PartsCount; Part++)
+      {
+        if (NeighboursByPart[Part] > NeighboursByPart[BestPart] && m_PartsSizes[Part] < MaxSize)
+          BestPart = Part;
+      }
+
+      if (BestPart != CurrentPart && m_PartsSizes[CurrentPart] > MinSize)
+      {
+        m_PartOfUnit[i] = BestPart;
+        m_PartsSizes[CurrentPart]--;
+        m_PartsSizes[BestPart]++;
+        Moved = true;
+      }
+    }
+
+    if (!Moved)
+      break;
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void DomainPartitioner::computeBoundaryUnits()
+{
+  m_BoundaryUnits.clear();
+
+  // the map of units indexes gives the units sorted by class and ID
+  for (auto& IndexOfUnit : m_IndexOfUnit)
+  {
+    const unsigned int i = IndexOfUnit.second;
+
+    for (unsigned int Neighbour : m_Neighbours[i])
+    {
+      if (m_PartOfUnit[Neighbour] != m_PartOfUnit[i])
+      {
+        m_BoundaryUnits.push_back(IndexOfUnit.first);
+        break;
+      }
+    }
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+unsigned int DomainPartitioner::getPartOfUnit(const openfluid::core::UnitClassID_t& Unit) const
+{
+  auto itIndex = m_IndexOfUnit.find(Unit);
+
+  if (itIndex == m_IndexOfUnit.end())
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                              "Unit " + openfluid::tools::classIDToString(Unit.first,Unit.second) +
+                                              " does not exist in partitioned domain");
+
+  return m_PartOfUnit[itIndex->second];
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+unsigned int DomainPartitioner::getCutConnectionsCount() const
+{
+  unsigned int Count = 0;
+
+  for (unsigned int i=0; i<m_Units.size(); i++)
+  {
+    for (unsigned int Neighbour : m_Neighbours[i])
+    {
+      if (Neighbour > i && m_PartOfUnit[Neighbour] != m_PartOfUnit[i])
+        Count++;
+    }
+  }
+
+  return Count;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::vector<bool> DomainPartitioner::getIncludedUnits(unsigned int Part) const
+{
+  std::vector<bool> Included(m_Units.size(),false);
+
+  for (unsigned int i=0; i<m_Units.size(); i++)
+  {
+    if (m_PartOfUnit[i] == Part)
+    {
+      Included[i] = true;
+
+      for (unsigned int Neighbour : m_Neighbours[i])
+        Included[Neighbour] = true;
+    }
+  }
+
+  return Included;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::vector<openfluid::core::UnitClassID_t> DomainPartitioner::getHaloUnits(unsigned int Part) const
+{
+  std::vector<openfluid::core::UnitClassID_t> HaloUnits;
+  const std::vector<bool> Included = getIncludedUnits(Part);
+
+  for (auto& IndexOfUnit : m_IndexOfUnit)
+  {
+    if (Included[IndexOfUnit.second] && m_PartOfUnit[IndexOfUnit.second] != Part)
+      HaloUnits.push_back(IndexOfUnit.first);
+  }
+
+  return HaloUnits;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void DomainPartitioner::buildPartDescriptor(unsigned int Part,
+                                            openfluid::fluidx::SpatialDomainDescriptor& Descriptor,
+                                            openfluid::fluidx::SpatialDomainDescriptor& PartDescriptor) const
+{
+  if (Part >= m_PartsCount)
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"Wrong part index for domain partitioning");
+
+  const std::vector<bool> Included = getIncludedUnits(Part);
+
+  auto isIncluded = [this,&Included](const openfluid::core::UnitClassID_t& Unit)
+  {
+    auto itIndex = m_IndexOfUnit.find(Unit);
+    return (itIndex != m_IndexOfUnit.end() && Included[itIndex->second]);
+  };
+
+
+  // units and connections
+
+  PartDescriptor.spatialUnits().clear();
+
+  for (unsigned int i=0; i<m_Units.size(); i++)
+  {
+    if (Included[i])
+    {
+      PartDescriptor.spatialUnits().push_back(*m_Units[i]);
+
+      PartDescriptor.spatialUnits().back().toSpatialUnits().remove_if(
+          [&isIncluded](const openfluid::core::UnitClassID_t& Unit) { return !isIncluded(Unit); });
+      PartDescriptor.spatialUnits().back().parentSpatialUnits().remove_if(
+          [&isIncluded](const openfluid::core::UnitClassID_t& Unit) { return !isIncluded(Unit); });
+    }
+  }
+
+
+  // attributes
+
+  PartDescriptor.attributes().clear();
+
+  for (openfluid::fluidx::AttributesDescriptor& AttrsDesc : Descriptor.attributes())
+  {
+    PartDescriptor.attributes().push_back(AttrsDesc);
+
+    openfluid::fluidx::AttributesDescriptor::UnitIDAttribute_t& UnitsAttrs =
+        PartDescriptor.attributes().back().attributes();
+    const openfluid::core::UnitsClass_t UnitsClass = AttrsDesc.getUnitsClass();
+
+    for (auto itUnit = UnitsAttrs.begin(); itUnit != UnitsAttrs.end();)
+    {
+      if (isIncluded(std::make_pair(UnitsClass,itUnit->first)))
+        ++itUnit;
+      else
+        itUnit = UnitsAttrs.erase(itUnit);
+    }
+  }
+
+
+  // events
+
+  PartDescriptor.events().clear();
+
+  for (const openfluid::fluidx::EventDescriptor& EventDesc : Descriptor.events())
+  {
+    if (isIncluded(std::make_pair(EventDesc.getUnitsClass(),EventDesc.getUnitID())))
+      PartDescriptor.events().push_back(EventDesc);
+  }
+}
+
+
+} }  // namespaces
@@ -0,0 +1,153 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+
+/**
+  @file DomainPartitioner.hpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@supagro.inra.fr>
+ */
+
+
+#ifndef __OPENFLUID_MACHINE_DOMAINPARTITIONER_HPP__
+#define __OPENFLUID_MACHINE_DOMAINPARTITIONER_HPP__
+
+
+#include <vector>
+#include <map>
+
+#include <openfluid/dllexport.hpp>
+#include <openfluid/core/TypeDefs.hpp>
+
+
+namespace openfluid { namespace fluidx {
+class SpatialDomainDescriptor;
+class SpatialUnitDescriptor;
+} }
+
+
+namespace openfluid { namespace machine {
+
+
+/**
+  Partitioning of a spatial domain into parts of balanced sizes, minimizing the count of connections
+  between units of different parts. Parts are first built as contiguous ranges of a breadth-first
+  ordering of the units (all classes and all connections), then refined by moving boundary units
+  to the neighbouring part holding most of their connected units, as long as parts stay balanced.
+
+  Units of other parts connected to units of a part are the halo of this part. They are included
+  in the descriptor of the part, their values of variables being given by their owner part.
+*/
+class OPENFLUID_API DomainPartitioner
+{
+  private:
+
+    unsigned int m_PartsCount;
+
+    std::vector<openfluid::fluidx::SpatialUnitDescriptor*> m_Units;
+
+    std::map<openfluid::core::UnitClassID_t,unsigned int> m_IndexOfUnit;
+
+    std::vector<std::vector<unsigned int>> m_Neighbours;
+
+    std::vector<unsigned int> m_PartOfUnit;
+
+    std::vector<unsigned int> m_PartsSizes;
+
+    std::vector<openfluid::core::UnitClassID_t> m_BoundaryUnits;
+
+    void buildGraph(openfluid::fluidx::SpatialDomainDescriptor& Descriptor);
+
+    void computeInitialParts();
+
+    void refineParts();
+
+    void computeBoundaryUnits();
+
+    std::vector<bool> getIncludedUnits(unsigned int Part) const;
+
+
+  public:
+
+    /**
+      Computes the partitioning of the given spatial domain
+      @param[in] Descriptor the spatial domain descriptor
+      @param[in] PartsCount the count of parts, must be greater than 0
+    */
+    DomainPartitioner(openfluid::fluidx::SpatialDomainDescriptor& Descriptor, unsigned int PartsCount);
+
+    unsigned int getPartsCount() const
+    { return m_PartsCount; }
+
+    /**
+      Returns the part owning the given unit
+      @throw openfluid::base::FrameworkException if the unit does not exist
+    */
+    unsigned int getPartOfUnit(const openfluid::core::UnitClassID_t& Unit) const;
+
+    unsigned int getPartSize(unsigned int Part) const
+    { return m_PartsSizes.at(Part); }
+
+    /**
+      Returns the count of connections between units of different parts
+    */
+    unsigned int getCutConnectionsCount() const;
+
+    /**
+      Returns the units belonging to the halo of at least one other part than their owner part,
+      sorted by class and ID. This order is the same for all parts.
+    */
+    const std::vector<openfluid::core::UnitClassID_t>& boundaryUnits() const
+    { return m_BoundaryUnits; }
+
+    /**
+      Returns the halo units of the given part, sorted by class and ID
+    */
+    std::vector<openfluid::core::UnitClassID_t> getHaloUnits(unsigned int Part) const;
+
+    /**
+      Builds the descriptor of the given part, with the units owned by the part and its halo units.
+      Connections, attributes and events are restricted to these units.
+      @param[in] Part the part index
+      @param[in] Descriptor the full spatial domain descriptor, the one given to the partitioner
+      @param[out] PartDescriptor the descriptor of the part
+    */
+    void buildPartDescriptor(unsigned int Part,
+                             openfluid::fluidx::SpatialDomainDescriptor& Descriptor,
+                             openfluid::fluidx::SpatialDomainDescriptor& PartDescriptor) const;
+};
+
+
+} }  // namespaces
+
+
+#endif /* __OPENFLUID_MACHINE_DOMAINPARTITIONER_HPP__ */
@@ -49,6 +49,7 @@
 #include <openfluid/base/RuntimeEnv.hpp>
 #include <openfluid/machine/MachineListener.hpp>
 #include <openfluid/machine/ModelInstance.hpp>
+#include <openfluid/machine/HaloExchange.hpp>
 #include <openfluid/machine/ModelItemInstance.hpp>
 #include <openfluid/machine/MonitoringInstance.hpp>
 #include <openfluid/machine/SimulationBlob.hpp>
@@ -66,7 +67,8 @@ namespace openfluid { namespace machine {
 Engine::Engine(SimulationBlob& SimBlob,
                ModelInstance& MInstance, MonitoringInstance& OLInstance,
                openfluid::machine::MachineListener* MachineListener)
-       : m_SimulationBlob(SimBlob), m_ModelInstance(MInstance), m_MonitoringInstance(OLInstance), mp_SimLogger(NULL)
+       : m_SimulationBlob(SimBlob), m_ModelInstance(MInstance), m_MonitoringInstance(OLInstance), mp_SimLogger(NULL),
+         mp_HaloExchange(NULL)
 {
 
   mp_RunEnv = openfluid::base::RuntimeEnvironment::instance();
@@ -491,16 +493,21 @@ void Engine::prepareOutputDir()
 void Engine::initialize()
 {
   m_ModelInstance.initialize(mp_SimLogger);
+  m_MonitoringInstance.setPipelined(mp_RunEnv->isPipelinedMonitoringEnabled());
   m_MonitoringInstance.initialize(mp_SimLogger);
 
+  // in pipelined mode, one more value is kept so that observers see the same values as in sequential mode
+  // while simulators append the values of the next time point
+  const unsigned int PipelinedExtraSize = (m_MonitoringInstance.isPipelined() ? 1 : 0);
+
   if (mp_RunEnv->isUserValuesBufferSize())
   {
-    openfluid::core::ValuesBufferProperties::setBufferSize(mp_RunEnv->getValuesBufferSize());
+    openfluid::core::ValuesBufferProperties::setBufferSize(mp_RunEnv->getValuesBufferSize()+PipelinedExtraSize);
   }
   else
   {
     openfluid::core::ValuesBufferProperties::setBufferSize(
-        (mp_SimStatus->getSimulationDuration()/mp_SimStatus->getDefaultDeltaT())+2);
+        (mp_SimStatus->getSimulationDuration()/mp_SimStatus->getDefaultDeltaT())+2+PipelinedExtraSize);
   }
 
 
@@ -632,10 +639,18 @@ void Engine::run()
   {
     mp_SimStatus->setCurrentStage(openfluid::base::SimulationStatus::INITIALIZERUN);
     m_ModelInstance.call_initializeRun();
+
+    // initial values of halo units are the ones of their owner parts
+    if (mp_HaloExchange != NULL)
+      mp_HaloExchange->exchange();
+
     m_MonitoringInstance.call_onInitializedRun();
   }
   catch (openfluid::base::FrameworkException& E)
   {
+    if (mp_HaloExchange != NULL)
+      mp_HaloExchange->abort();
+
     mp_MachineListener->onInitializeRunDone(openfluid::machine::MachineListener::LISTEN_ERROR);
     throw;
   }
@@ -661,12 +676,24 @@ void Engine::run()
 
   while (m_ModelInstance.hasTimePointToProcess())
   {
+    // connections changes requested during the time point are applied once all simulators have been processed,
+    // the changes still pending are discarded if the time point is interrupted
+    openfluid::core::ConnectionsChangesDeferral Deferral(m_SimulationBlob.spatialGraph());
 
     mp_SimLogger->resetCurrentWarningFlag();
 
     try
     {
       m_ModelInstance.processNextTimePoint();
+
+      // observers may still read the spatial graph for the previous time point in pipelined mode
+      m_MonitoringInstance.waitForPendingStep();
+
+      m_SimulationBlob.spatialGraph().applyConnectionsChanges();
+
+      if (mp_HaloExchange != NULL)
+        mp_HaloExchange->exchange();
+
       m_MonitoringInstance.call_onStepCompleted(mp_SimStatus->getCurrentTimeIndex());
 
       // TODO to remove? check simulation vars production at each time step
@@ -674,11 +701,33 @@ void Engine::run()
     }
     catch (openfluid::base::FrameworkException& E)
     {
+      if (mp_HaloExchange != NULL)
+        mp_HaloExchange->abort();
+
       mp_MachineListener->onRunStepDone(openfluid::machine::MachineListener::LISTEN_ERROR);
       throw;
     }
   }
 
+  // other parts of the domain may still have time points to process
+  if (mp_HaloExchange != NULL)
+    mp_HaloExchange->leave();
+
+  try
+  {
+    // observers may still process the last step in pipelined mode
+    m_MonitoringInstance.waitForPendingStep();
+  }
+  catch (openfluid::base::FrameworkException& E)
+  {
+    mp_MachineListener->onRunStepDone(openfluid::machine::MachineListener::LISTEN_ERROR);
+    throw;
+  }
+
+  // the last time points may not have been published yet
+  if (mp_MachineListener->isProgressThrottled())
+    mp_MachineListener->publishProgress();
+
   mp_MachineListener->onAfterRunSteps();
 
   mp_SimLogger->resetCurrentWarningFlag();
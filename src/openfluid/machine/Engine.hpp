@@ -64,6 +64,7 @@ class ModelInstance;
 class MonitoringInstance;
 class MachineListener;
 class SimulationBlob;
+class HaloExchange;
 
 
 // =====================================================================
@@ -92,6 +93,8 @@ class OPENFLUID_API Engine
 
      openfluid::base::SimulationLogger* mp_SimLogger;
 
+     HaloExchange* mp_HaloExchange;
+
 
 
      void checkSimulationVarsProduction(int ExpectedVarsCount);
@@ -161,6 +164,13 @@ class OPENFLUID_API Engine
     ModelInstance* modelInstance() { return &m_ModelInstance; };
 
     unsigned int getWarningsCount() const { return mp_SimLogger->getWarningsCount(); };
+
+    /**
+      Sets the exchange of halo units values used when the simulated domain is a part of a partitioned domain.
+      Values are then exchanged after each processed time point.
+      @param[in] Exchange the halo exchange, already bound to the simulated part. The engine does not own it.
+    */
+    void setHaloExchange(HaloExchange* Exchange) { mp_HaloExchange = Exchange; };
 };
 
 
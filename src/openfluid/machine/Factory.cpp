@@ -35,6 +35,11 @@
   @author Jean-Christophe FABRE <jean-christophe.fabre@supagro.inra.fr>
  */
 
+#include <algorithm>
+#include <cstdlib>
+#include <deque>
+#include <map>
+
 #include <openfluid/machine/Factory.hpp>
 #include <openfluid/fluidx/CoupledModelDescriptor.hpp>
 #include <openfluid/base/RuntimeEnv.hpp>
@@ -78,11 +83,23 @@ void Factory::buildDomainFromDescriptor(openfluid::fluidx::SpatialDomainDescript
   openfluid::core::SpatialUnit *FromUnit, *ToUnit, *ParentUnit, *ChildUnit;
 
   // creating units
-  for (itUnits = Descriptor.spatialUnits().begin();itUnits != Descriptor.spatialUnits().end();++itUnits)
+  if (openfluid::base::RuntimeEnvironment::instance()->isUnitsReorderingEnabled())
   {
-    SGraph.addUnit(openfluid::core::SpatialUnit((*itUnits).getUnitsClass(),
-                                               (*itUnits).getID(),
-                                               (*itUnits).getProcessOrder()));
+    for (openfluid::fluidx::SpatialUnitDescriptor* UnitDesc : computeUnitsLocalityOrder(Descriptor))
+    {
+      SGraph.addUnit(openfluid::core::SpatialUnit(UnitDesc->getUnitsClass(),
+                                                 UnitDesc->getID(),
+                                                 UnitDesc->getProcessOrder()));
+    }
+  }
+  else
+  {
+    for (itUnits = Descriptor.spatialUnits().begin();itUnits != Descriptor.spatialUnits().end();++itUnits)
+    {
+      SGraph.addUnit(openfluid::core::SpatialUnit((*itUnits).getUnitsClass(),
+                                                 (*itUnits).getID(),
+                                                 (*itUnits).getProcessOrder()));
+    }
   }
 
   // linking to units
@@ -205,6 +222,169 @@ void Factory::buildDomainFromDescriptor(openfluid::fluidx::SpatialDomainDescript
 
 
 
+// =====================================================================
+// =====================================================================
+
+
+std::vector<openfluid::fluidx::SpatialUnitDescriptor*>
+Factory::computeUnitsLocalityOrder(openfluid::fluidx::SpatialDomainDescriptor& Descriptor)
+{
+  std::vector<openfluid::fluidx::SpatialUnitDescriptor*> OrderedUnits;
+  std::vector<openfluid::core::UnitsClass_t> Classes;
+  std::map<openfluid::core::UnitsClass_t,std::vector<openfluid::fluidx::SpatialUnitDescriptor*>> UnitsByClass;
+
+  OrderedUnits.reserve(Descriptor.spatialUnits().size());
+
+  for (openfluid::fluidx::SpatialUnitDescriptor& UnitDesc : Descriptor.spatialUnits())
+  {
+    std::vector<openfluid::fluidx::SpatialUnitDescriptor*>& ClassUnits = UnitsByClass[UnitDesc.getUnitsClass()];
+
+    if (ClassUnits.empty())
+      Classes.push_back(UnitDesc.getUnitsClass());
+
+    ClassUnits.push_back(&UnitDesc);
+  }
+
+
+  for (const openfluid::core::UnitsClass_t& ClassName : Classes)
+  {
+    const std::vector<openfluid::fluidx::SpatialUnitDescriptor*>& ClassUnits = UnitsByClass[ClassName];
+    const unsigned int UnitsCount = ClassUnits.size();
+
+    // undirected adjacency between units of the class, using indexes in definition order
+
+    std::map<openfluid::core::UnitID_t,unsigned int> IndexOfID;
+    std::vector<std::vector<unsigned int>> Neighbours(UnitsCount);
+
+    for (unsigned int i=0; i<UnitsCount; i++)
+      IndexOfID[ClassUnits[i]->getID()] = i;
+
+    for (unsigned int i=0; i<UnitsCount; i++)
+    {
+      for (auto LinksList : {&ClassUnits[i]->toSpatialUnits(),&ClassUnits[i]->parentSpatialUnits()})
+      {
+        for (const openfluid::core::UnitClassID_t& Linked : *LinksList)
+        {
+          if (Linked.first == ClassName)
+          {
+            auto itIndex = IndexOfID.find(Linked.second);
+
+            if (itIndex != IndexOfID.end() && itIndex->second != i)
+            {
+              Neighbours[i].push_back(itIndex->second);
+              Neighbours[itIndex->second].push_back(i);
+            }
+          }
+        }
+      }
+    }
+
+    for (std::vector<unsigned int>& UnitNeighbours : Neighbours)
+    {
+      std::sort(UnitNeighbours.begin(),UnitNeighbours.end());
+      UnitNeighbours.erase(std::unique(UnitNeighbours.begin(),UnitNeighbours.end()),UnitNeighbours.end());
+    }
+
+    auto LowerDegree = [&Neighbours](unsigned int I1, unsigned int I2)
+    {
+      return (Neighbours[I1].size() < Neighbours[I2].size() ||
+              (Neighbours[I1].size() == Neighbours[I2].size() && I1 < I2));
+    };
+
+
+    // Cuthill-McKee: breadth-first traversal of each connected component,
+    // starting from a unit of lowest degree and visiting neighbours by increasing degree
+
+    std::vector<unsigned int> StartCandidates(UnitsCount);
+    std::vector<bool> Visited(UnitsCount,false);
+    std::vector<unsigned int> ClassOrder;
+
+    for (unsigned int i=0; i<UnitsCount; i++)
+      StartCandidates[i] = i;
+    std::sort(StartCandidates.begin(),StartCandidates.end(),LowerDegree);
+
+    ClassOrder.reserve(UnitsCount);
+
+    for (unsigned int Start : StartCandidates)
+    {
+      if (Visited[Start])
+        continue;
+
+      std::deque<unsigned int> Queue;
+      Queue.push_back(Start);
+      Visited[Start] = true;
+
+      while (!Queue.empty())
+      {
+        const unsigned int Current = Queue.front();
+        Queue.pop_front();
+        ClassOrder.push_back(Current);
+
+        std::vector<unsigned int> NextUnits;
+
+        for (unsigned int Neighbour : Neighbours[Current])
+        {
+          if (!Visited[Neighbour])
+          {
+            Visited[Neighbour] = true;
+            NextUnits.push_back(Neighbour);
+          }
+        }
+
+        std::sort(NextUnits.begin(),NextUnits.end(),LowerDegree);
+        Queue.insert(Queue.end(),NextUnits.begin(),NextUnits.end());
+      }
+    }
+
+    // reversed order gives the Reverse Cuthill-McKee ordering
+    for (auto itOrder = ClassOrder.rbegin(); itOrder != ClassOrder.rend(); ++itOrder)
+      OrderedUnits.push_back(ClassUnits[*itOrder]);
+  }
+
+  return OrderedUnits;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+double Factory::computeUnitsConnectionsDistance(const openfluid::core::SpatialGraph& SGraph)
+{
+  double DistancesSum = 0.0;
+  unsigned long ConnectionsCount = 0;
+
+  for (auto& ClassUnits : *(SGraph.allSpatialUnitsByClass()))
+  {
+    std::map<const openfluid::core::SpatialUnit*,long> Ranks;
+    long Rank = 0;
+
+    for (const openfluid::core::SpatialUnit& Unit : *(ClassUnits.second.list()))
+      Ranks[&Unit] = Rank++;
+
+    for (const openfluid::core::SpatialUnit& Unit : *(ClassUnits.second.list()))
+    {
+      for (auto LinkedUnits : {Unit.toSpatialUnits(ClassUnits.first),Unit.parentSpatialUnits(ClassUnits.first)})
+      {
+        if (LinkedUnits != NULL)
+        {
+          for (const openfluid::core::SpatialUnit* Linked : *LinkedUnits)
+          {
+            DistancesSum += std::abs(Ranks[Linked]-Ranks[&Unit]);
+            ConnectionsCount++;
+          }
+        }
+      }
+    }
+  }
+
+  if (!ConnectionsCount)
+    return 0.0;
+
+  return DistancesSum/ConnectionsCount;
+}
+
+
 // =====================================================================
 // =====================================================================
 
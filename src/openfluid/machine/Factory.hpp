@@ -43,6 +43,8 @@
 #define __OPENFLUID_MACHINE_FACTORY_HPP__
 
 
+#include <vector>
+
 #include <openfluid/dllexport.hpp>
 #include <openfluid/core/TypeDefs.hpp>
 #include <openfluid/fluidx/CoupledModelDescriptor.hpp>
@@ -61,6 +63,7 @@ class Datastore;
 }
 namespace fluidx {
 class SpatialDomainDescriptor;
+class SpatialUnitDescriptor;
 class RunDescriptor;
 class DatastoreDescriptor;
 } }
@@ -77,9 +80,33 @@ class OPENFLUID_API Factory
 {
   public:
 
+    /**
+      Builds the spatial graph from the given spatial domain descriptor.
+      If units reordering is enabled in the runtime environment, spatial units are created
+      following the order given by computeUnitsLocalityOrder() instead of the definition order
+    */
     static void buildDomainFromDescriptor(openfluid::fluidx::SpatialDomainDescriptor& Descriptor,
                                           openfluid::core::SpatialGraph& SGraph);
 
+    /**
+      Computes a creation order of spatial units placing connected units close to each other.
+      Units of each class are ordered using the Reverse Cuthill-McKee algorithm
+      on the from/to and child/parent connections between units of this class.
+      As units are then sorted by process order, this order only applies to units sharing the same process order
+      @param[in] Descriptor the spatial domain descriptor
+      @return the spatial units descriptors, in creation order
+    */
+    static std::vector<openfluid::fluidx::SpatialUnitDescriptor*>
+    computeUnitsLocalityOrder(openfluid::fluidx::SpatialDomainDescriptor& Descriptor);
+
+    /**
+      Computes the mean distance between connected spatial units of a same class,
+      as the count of units separating them in their class. Lower values mean a better locality
+      @param[in] SGraph the spatial graph
+      @return the mean distance, 0 if there is no connection between units of a same class
+    */
+    static double computeUnitsConnectionsDistance(const openfluid::core::SpatialGraph& SGraph);
+
     static void buildDatastoreFromDescriptor(openfluid::fluidx::DatastoreDescriptor& Descriptor,
                                              openfluid::core::Datastore& Store);
 
@@ -87,6 +87,9 @@ openfluid::base::SchedulingRequest FixedGenerator::initializeRun()
   openfluid::core::SpatialUnit* LU;
   OPENFLUID_UNITS_ORDERED_LOOP(m_UnitsClass,LU)
   {
+    // the same value is appended at each step, it is stored once per unit
+    LU->variables()->setRunLengthEncoding(m_VarName,true);
+
     if (isVectorVariable())
     {
       openfluid::core::VectorValue VV(m_VarSize,0.0);
@@ -109,13 +112,16 @@ openfluid::base::SchedulingRequest FixedGenerator::runStep()
 {
 
   openfluid::core::SpatialUnit* LU;
+  openfluid::core::VectorValue VV;
+
+  if (isVectorVariable())
+    VV = openfluid::core::VectorValue(m_VarSize,m_VarValue);
 
   OPENFLUID_UNITS_ORDERED_LOOP(m_UnitsClass,LU)
   {
 
     if (isVectorVariable())
     {
-      openfluid::core::VectorValue VV(m_VarSize,m_VarValue);
       OPENFLUID_AppendVariable(LU,m_VarName,VV);
     }
     else
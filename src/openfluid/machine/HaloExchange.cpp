@@ -0,0 +1,419 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+
+/**
+  @file HaloExchange.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@supagro.inra.fr>
+ */
+
+
+#include <openfluid/global.hpp>
+
+#if defined(OPENFLUID_OS_LINUX)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <cerrno>
+#endif
+
+#include <openfluid/machine/HaloExchange.hpp>
+#include <openfluid/machine/DomainPartitioner.hpp>
+#include <openfluid/core/SpatialGraph.hpp>
+#include <openfluid/core/DoubleValue.hpp>
+#include <openfluid/base/FrameworkException.hpp>
+
+
+namespace openfluid { namespace machine {
+
+
+#if defined(OPENFLUID_OS_LINUX)
+
+struct HaloExchange::SharedHeader
+{
+  pthread_mutex_t Mutex;
+
+  pthread_cond_t Condition;
+
+  unsigned int ActiveCount;
+
+  unsigned int ArrivedCount;
+
+  unsigned long long Generation;
+
+  int Aborted;
+};
+
+#else
+
+struct HaloExchange::SharedHeader
+{ };
+
+#endif
+
+
+// =====================================================================
+// =====================================================================
+
+
+HaloExchange::HaloExchange(const DomainPartitioner& Partitioner,
+                           const std::vector<openfluid::core::VariableName_t>& Variables) :
+  m_CreatorPID(0), m_MemorySize(0), mp_Header(nullptr), mp_Slots(nullptr),
+  m_PartsCount(Partitioner.getPartsCount()), m_BoundaryUnits(Partitioner.boundaryUnits()), m_Variables(Variables),
+  m_SlotsCount(m_BoundaryUnits.size()*m_Variables.size()), m_ExchangesCount(0), m_IsActive(false)
+{
+#if defined(OPENFLUID_OS_LINUX)
+
+  m_CreatorPID = getpid();
+  m_Name = "/openfluid-halo-" + std::to_string(m_CreatorPID);
+
+  // header followed by two buffers of slots
+  m_MemorySize = sizeof(SharedHeader) + 2*m_SlotsCount*sizeof(Slot);
+
+  int FileDesc = shm_open(m_Name.c_str(),O_CREAT | O_EXCL | O_RDWR,S_IRUSR | S_IWUSR);
+
+  if (FileDesc < 0)
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                              "Unable to create shared memory " + m_Name + " for halo exchange");
+
+  void* Memory = MAP_FAILED;
+
+  if (ftruncate(FileDesc,m_MemorySize) == 0)
+    Memory = mmap(nullptr,m_MemorySize,PROT_READ | PROT_WRITE,MAP_SHARED,FileDesc,0);
+
+  close(FileDesc);
+
+  if (Memory == MAP_FAILED)
+  {
+    shm_unlink(m_Name.c_str());
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                              "Unable to map shared memory " + m_Name + " for halo exchange");
+  }
+
+  mp_Header = static_cast<SharedHeader*>(Memory);
+  mp_Slots = reinterpret_cast<Slot*>(static_cast<char*>(Memory)+sizeof(SharedHeader));
+
+  pthread_mutexattr_t MutexAttr;
+  pthread_mutexattr_init(&MutexAttr);
+  pthread_mutexattr_setpshared(&MutexAttr,PTHREAD_PROCESS_SHARED);
+  pthread_mutexattr_setrobust(&MutexAttr,PTHREAD_MUTEX_ROBUST);
+  pthread_mutex_init(&mp_Header->Mutex,&MutexAttr);
+  pthread_mutexattr_destroy(&MutexAttr);
+
+  pthread_condattr_t CondAttr;
+  pthread_condattr_init(&CondAttr);
+  pthread_condattr_setpshared(&CondAttr,PTHREAD_PROCESS_SHARED);
+  pthread_cond_init(&mp_Header->Condition,&CondAttr);
+  pthread_condattr_destroy(&CondAttr);
+
+  mp_Header->ActiveCount = m_PartsCount;
+  mp_Header->ArrivedCount = 0;
+  mp_Header->Generation = 0;
+  mp_Header->Aborted = 0;
+
+  for (unsigned int i=0; i<2*m_SlotsCount; i++)
+    mp_Slots[i] = {0,0.0,0};
+
+#else
+
+  throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                            "Halo exchange is only available on Linux systems");
+
+#endif
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+HaloExchange::~HaloExchange()
+{
+#if defined(OPENFLUID_OS_LINUX)
+
+  if (mp_Header != nullptr)
+  {
+    if (getpid() == m_CreatorPID)
+    {
+      pthread_cond_destroy(&mp_Header->Condition);
+      pthread_mutex_destroy(&mp_Header->Mutex);
+    }
+
+    munmap(mp_Header,m_MemorySize);
+  }
+
+  if (getpid() == m_CreatorPID)
+    shm_unlink(m_Name.c_str());
+
+#endif
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void HaloExchange::lock()
+{
+#if defined(OPENFLUID_OS_LINUX)
+
+  // a part died while holding the lock, the exchange cannot be trusted anymore
+  if (pthread_mutex_lock(&mp_Header->Mutex) == EOWNERDEAD)
+  {
+    pthread_mutex_consistent(&mp_Header->Mutex);
+    mp_Header->Aborted = 1;
+    pthread_cond_broadcast(&mp_Header->Condition);
+  }
+
+#endif
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void HaloExchange::unlock()
+{
+#if defined(OPENFLUID_OS_LINUX)
+  pthread_mutex_unlock(&mp_Header->Mutex);
+#endif
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void HaloExchange::bindPart(unsigned int Part, const DomainPartitioner& Partitioner,
+                            openfluid::core::SpatialGraph& SGraph)
+{
+  m_OwnedUnits.clear();
+  m_HaloUnits.clear();
+
+  for (unsigned int i=0; i<m_BoundaryUnits.size(); i++)
+  {
+    openfluid::core::SpatialUnit* Unit = SGraph.spatialUnit(m_BoundaryUnits[i].first,m_BoundaryUnits[i].second);
+
+    if (Unit != nullptr)
+    {
+      if (Partitioner.getPartOfUnit(m_BoundaryUnits[i]) == Part)
+        m_OwnedUnits.push_back(std::make_pair(i,Unit));
+      else
+      {
+        Unit->setHalo(m_Variables);
+        m_HaloUnits.push_back(std::make_pair(i,Unit));
+      }
+    }
+  }
+
+  m_IsActive = true;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void HaloExchange::synchronize()
+{
+#if defined(OPENFLUID_OS_LINUX)
+
+  lock();
+
+  if (!mp_Header->Aborted)
+  {
+    const unsigned long long Generation = mp_Header->Generation;
+
+    mp_Header->ArrivedCount++;
+
+    if (mp_Header->ArrivedCount >= mp_Header->ActiveCount)
+    {
+      mp_Header->ArrivedCount = 0;
+      mp_Header->Generation++;
+      pthread_cond_broadcast(&mp_Header->Condition);
+    }
+    else
+    {
+      while (mp_Header->Generation == Generation && !mp_Header->Aborted)
+      {
+        if (pthread_cond_wait(&mp_Header->Condition,&mp_Header->Mutex) == EOWNERDEAD)
+        {
+          pthread_mutex_consistent(&mp_Header->Mutex);
+          mp_Header->Aborted = 1;
+        }
+      }
+    }
+  }
+
+  const bool Aborted = mp_Header->Aborted;
+
+  unlock();
+
+  if (Aborted)
+  {
+    m_IsActive = false;
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"Halo exchange aborted by another part");
+  }
+
+#endif
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void HaloExchange::exchange()
+{
+  if (!m_IsActive)
+    return;
+
+  Slot* Buffer = mp_Slots + (m_ExchangesCount%2)*m_SlotsCount;
+  openfluid::core::IndexedValue IndValue;
+
+  for (auto& OwnedUnit : m_OwnedUnits)
+  {
+    for (unsigned int v=0; v<m_Variables.size(); v++)
+    {
+      Slot& CurrentSlot = Buffer[OwnedUnit.first*m_Variables.size()+v];
+
+      if (OwnedUnit.second->variables()->getLatestIndexedValue(m_Variables[v],IndValue) &&
+          IndValue.value()->isDoubleValue())
+        CurrentSlot = {IndValue.getIndex(),IndValue.value()->asDoubleValue().get(),1};
+      else
+        CurrentSlot.IsSet = 0;
+    }
+  }
+
+  synchronize();
+
+  for (auto& HaloUnit : m_HaloUnits)
+  {
+    openfluid::core::Variables* Vars = HaloUnit.second->variables();
+
+    for (unsigned int v=0; v<m_Variables.size(); v++)
+    {
+      const Slot& CurrentSlot = Buffer[HaloUnit.first*m_Variables.size()+v];
+
+      if (CurrentSlot.IsSet && Vars->isVariableExist(m_Variables[v]))
+      {
+        const openfluid::core::DoubleValue Value(CurrentSlot.Value);
+
+        if (Vars->isVariableExist(m_Variables[v],CurrentSlot.Index))
+          Vars->modifyValue(m_Variables[v],CurrentSlot.Index,Value);
+        else
+          Vars->appendValue(m_Variables[v],CurrentSlot.Index,Value);
+      }
+    }
+  }
+
+  m_ExchangesCount++;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void HaloExchange::leave()
+{
+#if defined(OPENFLUID_OS_LINUX)
+
+  if (!m_IsActive)
+    return;
+
+  m_IsActive = false;
+
+  lock();
+
+  mp_Header->ActiveCount--;
+
+  // the leaving part may be the last one awaited by the others
+  if (mp_Header->ArrivedCount > 0 && mp_Header->ArrivedCount >= mp_Header->ActiveCount)
+  {
+    mp_Header->ArrivedCount = 0;
+    mp_Header->Generation++;
+    pthread_cond_broadcast(&mp_Header->Condition);
+  }
+
+  unlock();
+
+#endif
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void HaloExchange::abort()
+{
+#if defined(OPENFLUID_OS_LINUX)
+
+  m_IsActive = false;
+
+  lock();
+  mp_Header->Aborted = 1;
+  pthread_cond_broadcast(&mp_Header->Condition);
+  unlock();
+
+#endif
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool HaloExchange::isAborted()
+{
+#if defined(OPENFLUID_OS_LINUX)
+
+  lock();
+  const bool Aborted = mp_Header->Aborted;
+  unlock();
+
+  return Aborted;
+
+#else
+
+  return false;
+
+#endif
+}
+
+
+} }  // namespaces
@@ -0,0 +1,183 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+
+/**
+  @file HaloExchange.hpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@supagro.inra.fr>
+ */
+
+
+#ifndef __OPENFLUID_MACHINE_HALOEXCHANGE_HPP__
+#define __OPENFLUID_MACHINE_HALOEXCHANGE_HPP__
+
+
+#include <string>
+#include <vector>
+
+#include <openfluid/dllexport.hpp>
+#include <openfluid/core/TypeDefs.hpp>
+#include <openfluid/core/DateTime.hpp>
+
+
+namespace openfluid { namespace core {
+class SpatialGraph;
+class SpatialUnit;
+} }
+
+
+namespace openfluid { namespace machine {
+
+class DomainPartitioner;
+
+
+/**
+  Exchange of variables values of halo units between the parts of a partitioned domain,
+  each part being simulated by a separate local process.
+  Values are exchanged through a POSIX shared memory segment holding one slot per boundary unit
+  and exchanged variable. At each exchange, every part writes the latest values of the boundary units it owns,
+  waits for all other active parts, then reads the values of its halo units.
+  Slots are double buffered so that a single synchronization is required per exchange.
+
+  Values are exchanged once all simulators have been processed for a time point. Values of exchanged variables
+  on halo units are then only valid for the time points already completed: simulators reading them
+  at the current time index are rejected, and the models must be coupled across parts with a lag of one time point.
+
+  The shared memory is created before the processes of the parts are forked from the creating process,
+  which keeps the ownership of the segment. Only double values are exchanged.
+  Available on Linux systems only.
+*/
+class OPENFLUID_API HaloExchange
+{
+  public:
+
+    struct Slot
+    {
+      openfluid::core::TimeIndex_t Index;
+
+      double Value;
+
+      int IsSet;
+    };
+
+
+  private:
+
+    struct SharedHeader;
+
+    std::string m_Name;
+
+    int m_CreatorPID;
+
+    std::size_t m_MemorySize;
+
+    SharedHeader* mp_Header;
+
+    Slot* mp_Slots;
+
+    unsigned int m_PartsCount;
+
+    std::vector<openfluid::core::UnitClassID_t> m_BoundaryUnits;
+
+    std::vector<openfluid::core::VariableName_t> m_Variables;
+
+    unsigned int m_SlotsCount;
+
+    unsigned long long m_ExchangesCount;
+
+    bool m_IsActive;
+
+    std::vector<std::pair<unsigned int,openfluid::core::SpatialUnit*>> m_OwnedUnits;
+
+    std::vector<std::pair<unsigned int,openfluid::core::SpatialUnit*>> m_HaloUnits;
+
+    void lock();
+
+    void unlock();
+
+    void synchronize();
+
+
+  public:
+
+    /**
+      Creates the shared memory segment for the exchange
+      @param[in] Partitioner the partitioning of the domain
+      @param[in] Variables the names of the exchanged variables
+      @throw openfluid::base::FrameworkException if the shared memory cannot be created
+    */
+    HaloExchange(const DomainPartitioner& Partitioner,
+                 const std::vector<openfluid::core::VariableName_t>& Variables);
+
+    ~HaloExchange();
+
+    const std::string& getName() const
+    { return m_Name; }
+
+    unsigned int getSlotsCount() const
+    { return m_SlotsCount; }
+
+    /**
+      Binds the current process to the given part, using its spatial graph.
+      The units of the halo of the part are marked as halo units in the spatial graph.
+      @param[in] Part the index of the part simulated by the current process
+      @param[in] Partitioner the partitioning of the domain, the one given at construction
+      @param[in] SGraph the spatial graph of the part
+    */
+    void bindPart(unsigned int Part, const DomainPartitioner& Partitioner, openfluid::core::SpatialGraph& SGraph);
+
+    /**
+      Exchanges the latest values of exchanged variables with the other parts.
+      Blocks until all active parts reached the same exchange.
+      @throw openfluid::base::FrameworkException if the exchange has been aborted by another part
+    */
+    void exchange();
+
+    /**
+      Leaves the exchange, the remaining parts no longer wait for the current part
+    */
+    void leave();
+
+    /**
+      Aborts the exchange for all parts, waiting parts are released with an error
+    */
+    void abort();
+
+    bool isAborted();
+};
+
+
+} }  // namespaces
+
+
+#endif /* __OPENFLUID_MACHINE_HALOEXCHANGE_HPP__ */
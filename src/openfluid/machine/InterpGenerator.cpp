@@ -161,7 +161,7 @@ openfluid::base::SchedulingRequest InterpGenerator::initializeRun()
 
   OPENFLUID_UNITS_ORDERED_LOOP(m_UnitsClass,LU)
   {
-    if (m_DistriBindings->getValue(LU->getID(),CurrentDT,Value))
+    if (m_DistriBindings->getCurrentValue(m_DistriBindings->getSourceIndex(LU->getID()),Value))
     {
 
       if (m_IsMax && Value > m_Max) Value = m_Max;
@@ -207,7 +207,7 @@ openfluid::base::SchedulingRequest InterpGenerator::runStep()
 
   OPENFLUID_UNITS_ORDERED_LOOP(m_UnitsClass,LU)
   {
-    if (m_DistriBindings->getValue(LU->getID(),CurrentDT,Value))
+    if (m_DistriBindings->getCurrentValue(m_DistriBindings->getSourceIndex(LU->getID()),Value))
     {
 
       if (m_IsMax && Value > m_Max) Value = m_Max;
@@ -43,6 +43,70 @@
 namespace openfluid { namespace machine {
 
 
+void MachineListener::setProgressRate(unsigned int Rate)
+{
+  m_ProgressRate = Rate;
+
+  if (Rate)
+    m_ProgressPeriod = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::seconds(1))/Rate;
+
+  m_LastProgressTime = std::chrono::steady_clock::time_point();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+MachineListener::ProgressSnapshot MachineListener::getProgress() const
+{
+  ProgressSnapshot Progress;
+
+  Progress.CurrentIndex = m_ProgressIndex;
+  Progress.Duration = m_ProgressDuration;
+  Progress.TimePointsCount = m_ProgressTimePoints;
+  Progress.Warning = m_ProgressWarning;
+
+  return Progress;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void MachineListener::updateProgress(const openfluid::base::SimulationStatus* SimStatus, bool Warning)
+{
+  m_ProgressIndex.store(SimStatus->getCurrentTimeIndex(),std::memory_order_relaxed);
+  m_ProgressDuration.store(SimStatus->getSimulationDuration(),std::memory_order_relaxed);
+  m_ProgressTimePoints.fetch_add(1,std::memory_order_relaxed);
+
+  if (Warning)
+    m_ProgressWarning = true;
+
+  const std::chrono::steady_clock::time_point Now = std::chrono::steady_clock::now();
+
+  if (Now-m_LastProgressTime >= m_ProgressPeriod)
+  {
+    m_LastProgressTime = Now;
+    publishProgress();
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void MachineListener::publishProgress()
+{
+  ProgressSnapshot Progress = getProgress();
+
+  m_ProgressWarning = false;
+
+  onProgress(Progress);
+}
+
 
 } } //namespaces
 
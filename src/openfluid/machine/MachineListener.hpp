@@ -41,10 +41,14 @@
 #ifndef __OPENFLUID_MACHINE_MACHINELISTENER_HPP__
 #define __OPENFLUID_MACHINE_MACHINELISTENER_HPP__
 
+#include <atomic>
+#include <chrono>
+#include <string>
+
 #include <openfluid/dllexport.hpp>
 #include <openfluid/base/Listener.hpp>
 #include <openfluid/base/SimulationStatus.hpp>
-#include <string>
+
 
 namespace openfluid { namespace machine {
 
@@ -54,12 +58,50 @@ namespace openfluid { namespace machine {
 
 class OPENFLUID_API MachineListener : public openfluid::base::Listener
 {
+  public:
+
+    /**
+      Progress of the run steps of a simulation
+    */
+    struct ProgressSnapshot
+    {
+      /** Current time index */
+      openfluid::core::TimeIndex_t CurrentIndex;
+
+      /** Duration of the simulation */
+      openfluid::core::Duration_t Duration;
+
+      /** Number of time points processed */
+      unsigned long long TimePointsCount;
+
+      /** True if a warning has been raised since the previous published progress */
+      bool Warning;
+    };
+
+
   private:
 
+    std::atomic<openfluid::core::TimeIndex_t> m_ProgressIndex;
+
+    std::atomic<openfluid::core::Duration_t> m_ProgressDuration;
+
+    std::atomic<unsigned long long> m_ProgressTimePoints;
+
+    std::atomic<bool> m_ProgressWarning;
+
+    unsigned int m_ProgressRate;
+
+    std::chrono::steady_clock::duration m_ProgressPeriod;
+
+    std::chrono::steady_clock::time_point m_LastProgressTime;
+
 
   public:
 
-    MachineListener() {};
+    MachineListener() :
+      m_ProgressIndex(0), m_ProgressDuration(0), m_ProgressTimePoints(0), m_ProgressWarning(false),
+      m_ProgressRate(0), m_ProgressPeriod(std::chrono::steady_clock::duration::zero())
+    {};
 
     virtual ~MachineListener() {};
 
@@ -121,6 +163,46 @@ class OPENFLUID_API MachineListener : public openfluid::base::Listener
     virtual void onSimulatorFinalizeRunDone(const openfluid::base::Listener::Status& /*Status*/,
                                           const std::string& /*SimulatorID*/) {};
 
+    /**
+      Called at most at the progress rate during run steps when progress is throttled,
+      instead of the onRunStep(), onRunStepDone(), onSimulatorRunStep() and onSimulatorRunStepDone() methods
+      @param[in] Progress the current progress
+    */
+    virtual void onProgress(const ProgressSnapshot& /*Progress*/) {};
+
+    /**
+      Sets the rate of progress publication during run steps.
+      With a non-zero rate, the per time point and per simulator run step events are not sent.
+      The progress is recorded at each time point into an atomic snapshot,
+      and onProgress() is called when the period corresponding to the rate has elapsed.
+      @param[in] Rate the publication rate in Hz, 0 to send all run step events (default)
+    */
+    void setProgressRate(unsigned int Rate);
+
+    inline unsigned int getProgressRate() const
+    { return m_ProgressRate; }
+
+    inline bool isProgressThrottled() const
+    { return m_ProgressRate > 0; }
+
+    /**
+      Returns the latest recorded progress. Can be called from any thread.
+    */
+    ProgressSnapshot getProgress() const;
+
+    /**
+      Records the progress of the simulation after a processed time point,
+      and publishes it through onProgress() if the publication period has elapsed
+      @param[in] SimStatus the status of the simulation
+      @param[in] Warning true if a warning has been raised during the time point
+    */
+    void updateProgress(const openfluid::base::SimulationStatus* SimStatus, bool Warning);
+
+    /**
+      Publishes the latest recorded progress through onProgress(), whatever the elapsed time
+    */
+    void publishProgress();
+
 };
 
 
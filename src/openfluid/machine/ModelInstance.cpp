@@ -344,6 +344,7 @@ void ModelInstance::initialize(openfluid::base::SimulationLogger* SimLogger)
 
     CurrentSimulator->Body->linkToSimulationLogger(mp_SimLogger);
     CurrentSimulator->Body->linkToSimulation(&(m_SimulationBlob.simulationStatus()));
+    CurrentSimulator->Body->setTrustedMode(openfluid::base::RuntimeEnvironment::instance()->isTrustedModeEnabled());
     CurrentSimulator->Body->linkToRunEnvironment(openfluid::base::RuntimeEnvironment::instance()->wareEnvironment());
     CurrentSimulator->Body->linkToSpatialGraph(&(m_SimulationBlob.spatialGraph()));
     CurrentSimulator->Body->linkToDatastore(&(m_SimulationBlob.datastore()));
@@ -549,13 +550,20 @@ void ModelInstance::processNextTimePoint()
 
   m_TimePointList.front().sortByOriginalPosition();
 
-  mp_Listener->onRunStep(&m_SimulationBlob.simulationStatus());
+  // with throttled progress, the listener only records the progress once per time point
+  const bool ThrottledProgress = mp_Listener->isProgressThrottled();
+  bool WarningRaised = false;
+
+  if (!ThrottledProgress)
+    mp_Listener->onRunStep(&m_SimulationBlob.simulationStatus());
 
   while (m_TimePointList.front().hasItemsToProcess())
   {
     openfluid::machine::ModelItemInstance* NextItem = m_TimePointList.front().nextItem();
 
-    mp_Listener->onSimulatorRunStep(NextItem->Signature->ID);
+    if (!ThrottledProgress)
+      mp_Listener->onSimulatorRunStep(NextItem->Signature->ID);
+
     std::chrono::high_resolution_clock::time_point TimeProfileStart = std::chrono::high_resolution_clock::now();
 
     openfluid::base::SchedulingRequest SchedReq = m_TimePointList.front().processNextItem();
@@ -568,8 +576,14 @@ void ModelInstance::processNextTimePoint()
                                  );
 
     if (mp_SimLogger->isCurrentWarningFlag())
-      mp_Listener->onSimulatorRunStepDone(openfluid::machine::MachineListener::LISTEN_WARNING,NextItem->Signature->ID);
-    else
+    {
+      WarningRaised = true;
+
+      if (!ThrottledProgress)
+        mp_Listener->onSimulatorRunStepDone(openfluid::machine::MachineListener::LISTEN_WARNING,
+                                            NextItem->Signature->ID);
+    }
+    else if (!ThrottledProgress)
       mp_Listener->onSimulatorRunStepDone(openfluid::machine::MachineListener::LISTEN_OK,NextItem->Signature->ID);
 
     mp_SimLogger->resetCurrentWarningFlag();
@@ -588,7 +602,10 @@ void ModelInstance::processNextTimePoint()
     }
   }
 
-  if (mp_SimLogger->isCurrentWarningFlag())
+  if (ThrottledProgress)
+    mp_Listener->updateProgress(&m_SimulationBlob.simulationStatus(),
+                                WarningRaised || mp_SimLogger->isCurrentWarningFlag());
+  else if (mp_SimLogger->isCurrentWarningFlag())
     mp_Listener->onRunStepDone(openfluid::machine::MachineListener::LISTEN_WARNING);
   else
     mp_Listener->onRunStepDone(openfluid::machine::MachineListener::LISTEN_OK);
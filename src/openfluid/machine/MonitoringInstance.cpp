@@ -41,13 +41,16 @@
 #include <openfluid/machine/SimulationBlob.hpp>
 #include <openfluid/machine/ObserverPluginsManager.hpp>
 #include <openfluid/machine/ObserverInstance.hpp>
+#include <openfluid/core/ValuesBufferProperties.hpp>
+
+#include <QtConcurrentRun>
 
 
 namespace openfluid { namespace machine {
 
 
 MonitoringInstance::MonitoringInstance(openfluid::machine::SimulationBlob& SimulationBlob):
-    m_SimulationBlob(SimulationBlob), m_Initialized(false)
+    m_SimulationBlob(SimulationBlob), m_Initialized(false), m_Pipelined(false), mp_ObserversStatus(NULL)
 {
 
 }
@@ -59,8 +62,12 @@ MonitoringInstance::MonitoringInstance(openfluid::machine::SimulationBlob& Simul
 
 MonitoringInstance::~MonitoringInstance()
 {
+  waitForPendingStepNoThrow();
+
   if (m_Initialized)
     finalize();
+
+  delete mp_ObserversStatus;
 }
 
 
@@ -82,10 +89,47 @@ void MonitoringInstance::appendObserver(ObserverInstance* ObsInstance)
 // =====================================================================
 
 
+void MonitoringInstance::setPipelined(bool Pipelined)
+{
+  if (m_Initialized)
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                              "Trying to change pipelined mode after observers list initialization");
+
+  m_Pipelined = Pipelined;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void MonitoringInstance::updateObserversStatus() const
+{
+  if (m_Pipelined)
+    *mp_ObserversStatus = m_SimulationBlob.simulationStatus();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 void MonitoringInstance::initialize(openfluid::base::SimulationLogger* SimLogger)
 {
   openfluid::machine::ObserverPluginsManager* OPlugsMgr = openfluid::machine::ObserverPluginsManager::instance();
 
+  const openfluid::base::SimulationStatus* ObsStatus = &(m_SimulationBlob.simulationStatus());
+
+  if (m_Pipelined)
+  {
+    delete mp_ObserversStatus;
+    mp_ObserversStatus = new openfluid::base::SimulationStatus(m_SimulationBlob.simulationStatus());
+    ObsStatus = mp_ObserversStatus;
+
+    // simulators may append values while observers are reading them
+    openfluid::core::ValuesBufferProperties::setConcurrentAccess(true);
+  }
+
   std::list<ObserverInstance*>::const_iterator ObsIter;
   ObserverInstance* CurrentObserver;
 
@@ -96,7 +140,8 @@ void MonitoringInstance::initialize(openfluid::base::SimulationLogger* SimLogger
     OPlugsMgr->completeSignatureWithWareBody(CurrentObserver);
 
     CurrentObserver->Body->linkToSimulationLogger(SimLogger);
-    CurrentObserver->Body->linkToSimulation(&(m_SimulationBlob.simulationStatus()));
+    CurrentObserver->Body->linkToSimulation(ObsStatus);
+    CurrentObserver->Body->setTrustedMode(openfluid::base::RuntimeEnvironment::instance()->isTrustedModeEnabled());
     CurrentObserver->Body->linkToRunEnvironment(openfluid::base::RuntimeEnvironment::instance()->wareEnvironment());
     CurrentObserver->Body->linkToSpatialGraph(&(m_SimulationBlob.spatialGraph()));
     CurrentObserver->Body->linkToDatastore(&(m_SimulationBlob.datastore()));
@@ -119,6 +164,11 @@ void MonitoringInstance::finalize()
     throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
                                               "Trying to finalize an uninitialized observers list");
 
+  waitForPendingStepNoThrow();
+
+  if (m_Pipelined)
+    openfluid::core::ValuesBufferProperties::setConcurrentAccess(false);
+
   std::list<ObserverInstance*>::const_iterator ObsIter;
 
   // call of finalizeWare method on each observer
@@ -148,6 +198,8 @@ void MonitoringInstance::finalize()
 
 void MonitoringInstance::call_initParams() const
 {
+  updateObserversStatus();
+
   std::list<ObserverInstance*>::const_iterator ObsIter;
 
   // call of initParams method on each observer
@@ -166,6 +218,8 @@ void MonitoringInstance::call_initParams() const
 
 void MonitoringInstance::call_onPrepared() const
 {
+  updateObserversStatus();
+
   std::list<ObserverInstance*>::const_iterator ObsIter;
 
   // call of initParams method on each observer
@@ -184,6 +238,8 @@ void MonitoringInstance::call_onPrepared() const
 
 void MonitoringInstance::call_onInitializedRun() const
 {
+  updateObserversStatus();
+
   std::list<ObserverInstance*>::const_iterator ObsIter;
 
   // call of initParams method on each observer
@@ -193,6 +249,9 @@ void MonitoringInstance::call_onInitializedRun() const
     (*ObsIter)->Body->onInitializedRun();
     ++ObsIter;
   }
+
+  m_SimulationBlob.spatialGraph().variablesChangesLog().discardUntil(
+      m_SimulationBlob.simulationStatus().getCurrentTimeIndex());
 }
 
 
@@ -200,18 +259,82 @@ void MonitoringInstance::call_onInitializedRun() const
 // =====================================================================
 
 
-void MonitoringInstance::call_onStepCompleted(const openfluid::core::TimeIndex_t& TimeIndex) const
+void MonitoringInstance::processStepCompleted(const openfluid::core::TimeIndex_t TimeIndex)
 {
-  std::list<ObserverInstance*>::const_iterator ObsIter;
+  // in pipelined mode, values appended by simulators for the next time points are not visible to observers
+  if (m_Pipelined)
+    openfluid::core::ValuesBufferProperties::setReadIndexLimit(TimeIndex);
 
-  // call of initParams method on each observer
-  ObsIter = m_Observers.begin();
-  while (ObsIter != m_Observers.end())
+  try
   {
-    (*ObsIter)->Body->onStepCompleted();
-    (*ObsIter)->Body->setPreviousTimeIndex(TimeIndex);
-    ++ObsIter;
+    std::list<ObserverInstance*>::const_iterator ObsIter;
+
+    ObsIter = m_Observers.begin();
+    while (ObsIter != m_Observers.end())
+    {
+      (*ObsIter)->Body->onStepCompleted();
+      (*ObsIter)->Body->setPreviousTimeIndex(TimeIndex);
+      ++ObsIter;
+    }
+
+    // changes are no longer needed once all observers have processed them
+    m_SimulationBlob.spatialGraph().variablesChangesLog().discardUntil(TimeIndex);
+  }
+  catch (...)
+  {
+    m_PendingError = std::current_exception();
+  }
+
+  openfluid::core::ValuesBufferProperties::resetReadIndexLimit();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void MonitoringInstance::waitForPendingStep()
+{
+  m_PendingStep.waitForFinished();
+
+  if (m_PendingError)
+  {
+    std::exception_ptr Error = m_PendingError;
+    m_PendingError = nullptr;
+    std::rethrow_exception(Error);
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void MonitoringInstance::waitForPendingStepNoThrow()
+{
+  m_PendingStep.waitForFinished();
+  m_PendingError = nullptr;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void MonitoringInstance::call_onStepCompleted(const openfluid::core::TimeIndex_t& TimeIndex)
+{
+  if (!m_Pipelined)
+  {
+    processStepCompleted(TimeIndex);
+    waitForPendingStep();
+    return;
   }
+
+  // backpressure: observers are at most one step behind simulators
+  waitForPendingStep();
+
+  updateObserversStatus();
+  m_PendingStep = QtConcurrent::run(this,&MonitoringInstance::processStepCompleted,TimeIndex);
 }
 
 
@@ -221,6 +344,8 @@ void MonitoringInstance::call_onStepCompleted(const openfluid::core::TimeIndex_t
 
 void MonitoringInstance::call_onFinalizedRun() const
 {
+  updateObserversStatus();
+
   std::list<ObserverInstance*>::const_iterator ObsIter;
 
   // call of initParams method on each observer
@@ -45,6 +45,9 @@
 #include <openfluid/base/SimulationLogger.hpp>
 
 #include <list>
+#include <exception>
+
+#include <QFuture>
 
 
 namespace openfluid { namespace machine {
@@ -62,6 +65,24 @@ class OPENFLUID_API MonitoringInstance
 
     bool m_Initialized;
 
+    bool m_Pipelined;
+
+    /**
+      Copy of the simulation status frozen at the time point currently processed by observers,
+      used in pipelined mode only
+    */
+    openfluid::base::SimulationStatus* mp_ObserversStatus;
+
+    QFuture<void> m_PendingStep;
+
+    std::exception_ptr m_PendingError;
+
+    void processStepCompleted(const openfluid::core::TimeIndex_t TimeIndex);
+
+    void waitForPendingStepNoThrow();
+
+    void updateObserversStatus() const;
+
   public:
 
     MonitoringInstance(openfluid::machine::SimulationBlob& SimulationBlob);
@@ -72,6 +93,18 @@ class OPENFLUID_API MonitoringInstance
 
     const std::list<ObserverInstance*>& observers() const { return m_Observers; };
 
+    /**
+      Enables or disables the pipelined mode, where observers are processed in a separate thread
+      for the step t while simulators compute the step t+1. Must be set before initialization.
+      Observers then read the variables values up to the time index of the step t only,
+      and the spatial graph is left unchanged until the step t is processed (see waitForPendingStep()).
+      Attributes cannot be modified during the run and the simulation logger is thread-safe.
+    */
+    void setPipelined(bool Pipelined);
+
+    bool isPipelined() const
+    { return m_Pipelined; }
+
     void initialize(openfluid::base::SimulationLogger* mp_SimLogger);
 
     void finalize();
@@ -82,7 +115,13 @@ class OPENFLUID_API MonitoringInstance
 
     void call_onInitializedRun() const;
 
-    void call_onStepCompleted(const openfluid::core::TimeIndex_t& TimeIndex) const;
+    void call_onStepCompleted(const openfluid::core::TimeIndex_t& TimeIndex);
+
+    /**
+      Waits for the completion of the step processed by observers in pipelined mode.
+      Rethrows on the calling thread the exception raised by observers during this step, if any.
+    */
+    void waitForPendingStep();
 
     void call_onFinalizedRun() const;
 };
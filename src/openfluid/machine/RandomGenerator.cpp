@@ -39,6 +39,17 @@
 
 
 #include <ctime>
+#include <algorithm>
+#include <functional>
+
+#include <QtGlobal>
+
+#if QT_VERSION >= QT_VERSION_CHECK(5,0,0)
+#include <QtConcurrent>
+#endif
+
+#include <QtConcurrentRun>
+#include <QFutureSynchronizer>
 
 #include <openfluid/machine/RandomGenerator.hpp>
 #include <openfluid/tools/DataHelpers.hpp>
@@ -48,9 +59,10 @@ namespace openfluid { namespace machine {
 
 
 RandomGenerator::RandomGenerator() :
-  Generator(), m_Min(0.0), m_Max(0.0), m_DeltaT(0)
+  Generator(), m_Min(0.0), m_Max(0.0), m_DeltaT(0), m_Distribution(UNIFORM),
+  m_Mean(0.0), m_StdDev(1.0), m_Shape(1.0), m_Scale(1.0), m_Seed(std::time(0))
 {
-  m_RandomEngine.seed(std::time(0));
+
 }
 
 
@@ -81,6 +93,44 @@ void RandomGenerator::initParams(const openfluid::ware::WareParams_t& Params)
   if (OPENFLUID_GetSimulatorParameter(Params,"deltat",DeltaTStr) &&
       !openfluid::tools::convertString(DeltaTStr,&m_DeltaT))
     throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"wrong value for deltat");
+
+  std::string SeedStr;
+  if (OPENFLUID_GetSimulatorParameter(Params,"seed",SeedStr) &&
+      !openfluid::tools::convertString(SeedStr,&m_Seed))
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"wrong value for seed");
+
+  std::string DistribStr;
+  if (OPENFLUID_GetSimulatorParameter(Params,"distribution",DistribStr))
+  {
+    if (DistribStr == "uniform")
+      m_Distribution = UNIFORM;
+    else if (DistribStr == "normal")
+      m_Distribution = NORMAL;
+    else if (DistribStr == "lognormal")
+      m_Distribution = LOGNORMAL;
+    else if (DistribStr == "gamma")
+      m_Distribution = GAMMA;
+    else
+      throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                                "unknown distribution " + DistribStr + " for generator");
+  }
+
+  if (m_Distribution == NORMAL || m_Distribution == LOGNORMAL)
+  {
+    if (!OPENFLUID_GetSimulatorParameter(Params,"mean",m_Mean))
+      throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"missing mean value for generator");
+
+    if (!OPENFLUID_GetSimulatorParameter(Params,"stddev",m_StdDev))
+      throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"missing stddev value for generator");
+  }
+  else if (m_Distribution == GAMMA)
+  {
+    if (!OPENFLUID_GetSimulatorParameter(Params,"shape",m_Shape))
+      throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"missing shape value for generator");
+
+    if (!OPENFLUID_GetSimulatorParameter(Params,"scale",m_Scale))
+      throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,"missing scale value for generator");
+  }
 };
 
 
@@ -93,6 +143,14 @@ void RandomGenerator::checkConsistency()
   if ( m_Min > m_Max)
     throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
                                               "max value must be greater or equal to min value for generator");
+
+  if (m_StdDev < 0.0)
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                              "stddev value must be positive for generator");
+
+  if (m_Shape <= 0.0 || m_Scale <= 0.0)
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                              "shape and scale values must be strictly positive for generator");
 }
 
 
@@ -102,6 +160,9 @@ void RandomGenerator::checkConsistency()
 
 openfluid::base::SchedulingRequest RandomGenerator::initializeRun()
 {
+  // the random stream is specific to the produced variable
+  m_Random = openfluid::scientific::CounterBasedRandom(m_Seed,m_UnitsClass+"#"+m_VarName);
+
   openfluid::core::SpatialUnit* LU;
   OPENFLUID_UNITS_ORDERED_LOOP(m_UnitsClass,LU)
   {
@@ -123,24 +184,103 @@ openfluid::base::SchedulingRequest RandomGenerator::initializeRun()
 // =====================================================================
 
 
-openfluid::base::SchedulingRequest RandomGenerator::runStep()
+double RandomGenerator::drawValue(const openfluid::core::SpatialUnit* U, openfluid::core::TimeIndex_t TimeIndex) const
 {
-  openfluid::core::SpatialUnit* LU;
-  std::uniform_real_distribution<double> Distribution(m_Min, m_Max);
+  openfluid::scientific::CounterBasedRandom::Sequence Seq = m_Random.getSequence(U->getID(),TimeIndex);
 
-  OPENFLUID_UNITS_ORDERED_LOOP(m_UnitsClass,LU)
+  if (m_Distribution == UNIFORM)
+    return Seq.uniform(m_Min,m_Max);
+
+
+  // other distributions are truncated to the [min,max] range, by rejection
+  double Value = 0.0;
+
+  for (unsigned int i = 0; i < 100; i++)
+  {
+    if (m_Distribution == NORMAL)
+      Value = Seq.normal(m_Mean,m_StdDev);
+    else if (m_Distribution == LOGNORMAL)
+      Value = Seq.lognormal(m_Mean,m_StdDev);
+    else
+      Value = Seq.gamma(m_Shape,m_Scale);
+
+    if (Value >= m_Min && Value <= m_Max)
+      return Value;
+  }
+
+  // range far from the distribution mass
+  return std::min(std::max(Value,m_Min.get()),m_Max.get());
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void RandomGenerator::appendValues(std::vector<openfluid::core::SpatialUnit*>::const_iterator Begin,
+                                   std::vector<openfluid::core::SpatialUnit*>::const_iterator End)
+{
+  const openfluid::core::TimeIndex_t TimeIndex = OPENFLUID_GetCurrentTimeIndex();
+
+  for (std::vector<openfluid::core::SpatialUnit*>::const_iterator it = Begin; it != End; ++it)
   {
-    openfluid::core::DoubleValue Value(Distribution(m_RandomEngine));
+    openfluid::core::DoubleValue Value(drawValue(*it,TimeIndex));
 
     if (isVectorVariable())
     {
       openfluid::core::VectorValue VV(m_VarSize,Value);
-      OPENFLUID_AppendVariable(LU,m_VarName,VV);
+      OPENFLUID_AppendVariable(*it,m_VarName,VV);
     }
     else
-      OPENFLUID_AppendVariable(LU,m_VarName,Value);
+      OPENFLUID_AppendVariable(*it,m_VarName,Value);
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
 
+openfluid::base::SchedulingRequest RandomGenerator::runStep()
+{
+  std::vector<openfluid::core::SpatialUnit*> Units;
+  openfluid::core::SpatialUnit* LU;
+
+  OPENFLUID_UNITS_ORDERED_LOOP(m_UnitsClass,LU)
+  {
+    Units.push_back(LU);
+  }
+
+  const unsigned int ThreadsCount = std::max(1,OPENFLUID_GetSimulatorMaxThreads());
+
+  if (ThreadsCount > 1 && Units.size() > ThreadsCount)
+  {
+    // values do not depend on the drawing order, units are processed by chunks on each thread
+    const unsigned int ChunkSize = (Units.size()+ThreadsCount-1)/ThreadsCount;
+    QFutureSynchronizer<void> Synchronizer;
+
+    try
+    {
+      for (unsigned int i = 0; i < Units.size(); i += ChunkSize)
+      {
+        std::vector<openfluid::core::SpatialUnit*>::const_iterator ChunkBegin = Units.begin()+i;
+        std::vector<openfluid::core::SpatialUnit*>::const_iterator ChunkEnd =
+            Units.begin()+std::min<std::size_t>(i+ChunkSize,Units.size());
+
+        Synchronizer.addFuture(QtConcurrent::run(std::bind(&RandomGenerator::appendValues,this,
+                                                           ChunkBegin,ChunkEnd)));
+      }
+
+      Synchronizer.waitForFinished();
+    }
+    catch (QtConcurrent::UnhandledException& E)
+    {
+      throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                                "QtConcurrent::UnhandledException in random generator");
+    }
   }
+  else
+    appendValues(Units.begin(),Units.end());
 
   if (m_DeltaT > 0) return Duration(m_DeltaT);
   else return DefaultDeltaT();
@@ -149,4 +289,3 @@ openfluid::base::SchedulingRequest RandomGenerator::runStep()
 
 } } //namespaces
 
-
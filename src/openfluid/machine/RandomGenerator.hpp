@@ -41,24 +41,60 @@
 #ifndef __OPENFLUID_MACHINE_RANDOMGENERATOR_HPP__
 #define __OPENFLUID_MACHINE_RANDOMGENERATOR_HPP__
 
-#include <random>
+#include <vector>
 
 #include <openfluid/dllexport.hpp>
 #include <openfluid/machine/Generator.hpp>
+#include <openfluid/scientific/CounterBasedRandom.hpp>
 
 
 namespace openfluid { namespace machine {
 
 
+/**
+  Generator of random values, using a counter-based random engine.
+  Each value is determined by the seed, the produced variable, the unit ID and the time index,
+  so that the results are reproducible for a given seed whatever the number of threads used.
+*/
 class OPENFLUID_API RandomGenerator : public Generator
 {
+  public:
+
+    enum DistributionType { UNIFORM, NORMAL, LOGNORMAL, GAMMA };
+
+
   private:
+
     openfluid::core::DoubleValue m_Min;
     openfluid::core::DoubleValue m_Max;
 
     openfluid::core::Duration_t m_DeltaT;
 
-    std::mt19937 m_RandomEngine;
+    DistributionType m_Distribution;
+
+    /**
+      Mean for normal distribution, mean of the logarithm for log-normal distribution
+    */
+    double m_Mean;
+
+    /**
+      Standard deviation for normal distribution, standard deviation of the logarithm for log-normal distribution
+    */
+    double m_StdDev;
+
+    double m_Shape;
+
+    double m_Scale;
+
+    unsigned long long m_Seed;
+
+    openfluid::scientific::CounterBasedRandom m_Random;
+
+    double drawValue(const openfluid::core::SpatialUnit* U, openfluid::core::TimeIndex_t TimeIndex) const;
+
+    void appendValues(std::vector<openfluid::core::SpatialUnit*>::const_iterator Begin,
+                      std::vector<openfluid::core::SpatialUnit*>::const_iterator End);
+
 
   public:
 
@@ -76,6 +112,9 @@ class OPENFLUID_API RandomGenerator : public Generator
 
     void finalizeRun() {};
 
+    unsigned long long getSeed() const
+    { return m_Seed; }
+
 };
 
 
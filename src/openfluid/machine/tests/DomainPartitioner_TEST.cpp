@@ -0,0 +1,190 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+/**
+  @file DomainPartitioner_TEST.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@supagro.inra.fr>
+ */
+
+
+#define BOOST_TEST_MAIN
+#define BOOST_AUTO_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE unittest_DomainPartitioner
+#include <boost/test/unit_test.hpp>
+#include <boost/test/auto_unit_test.hpp>
+
+#include <set>
+
+#include <openfluid/machine/DomainPartitioner.hpp>
+#include <openfluid/fluidx/SpatialDomainDescriptor.hpp>
+#include <openfluid/fluidx/SpatialUnitDescriptor.hpp>
+#include <openfluid/base/FrameworkException.hpp>
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Builds a grid of SU units flowing from west to east, each row flowing to a RS unit
+*/
+void buildGridDomainDescriptor(openfluid::fluidx::SpatialDomainDescriptor& Descriptor,
+                               unsigned int RowsCount, unsigned int ColsCount)
+{
+  for (unsigned int r=0; r<RowsCount; r++)
+  {
+    for (unsigned int c=0; c<ColsCount; c++)
+    {
+      openfluid::fluidx::SpatialUnitDescriptor UnitDesc;
+      UnitDesc.setUnitsClass("SU");
+      UnitDesc.setID(r*ColsCount+c+1);
+      UnitDesc.setProcessOrder(c+1);
+
+      if (c < ColsCount-1)
+        UnitDesc.toSpatialUnits().push_back(std::make_pair("SU",r*ColsCount+c+2));
+      else
+        UnitDesc.toSpatialUnits().push_back(std::make_pair("RS",r+1));
+
+      Descriptor.spatialUnits().push_back(UnitDesc);
+    }
+
+    openfluid::fluidx::SpatialUnitDescriptor UnitDesc;
+    UnitDesc.setUnitsClass("RS");
+    UnitDesc.setID(r+1);
+    UnitDesc.setProcessOrder(1);
+
+    if (r < RowsCount-1)
+      UnitDesc.toSpatialUnits().push_back(std::make_pair("RS",r+2));
+
+    Descriptor.spatialUnits().push_back(UnitDesc);
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_partitioning)
+{
+  openfluid::fluidx::SpatialDomainDescriptor Descriptor;
+  buildGridDomainDescriptor(Descriptor,40,25);
+
+  BOOST_REQUIRE_THROW(openfluid::machine::DomainPartitioner(Descriptor,0),openfluid::base::FrameworkException);
+
+  openfluid::machine::DomainPartitioner SinglePart(Descriptor,1);
+  BOOST_REQUIRE_EQUAL(SinglePart.getPartSize(0),1040);
+  BOOST_REQUIRE_EQUAL(SinglePart.getCutConnectionsCount(),0);
+  BOOST_REQUIRE(SinglePart.boundaryUnits().empty());
+
+
+  openfluid::machine::DomainPartitioner Partitioner(Descriptor,4);
+
+  BOOST_REQUIRE_EQUAL(Partitioner.getPartsCount(),4);
+
+  unsigned int TotalSize = 0;
+  for (unsigned int p=0; p<4; p++)
+  {
+    BOOST_REQUIRE_GE(Partitioner.getPartSize(p),250);
+    BOOST_REQUIRE_LE(Partitioner.getPartSize(p),270);
+    TotalSize += Partitioner.getPartSize(p);
+  }
+  BOOST_REQUIRE_EQUAL(TotalSize,1040);
+
+  BOOST_REQUIRE_GT(Partitioner.getCutConnectionsCount(),0);
+  // far less than the 1039 connections of the domain
+  BOOST_REQUIRE_LT(Partitioner.getCutConnectionsCount(),100);
+
+  BOOST_REQUIRE_THROW(Partitioner.getPartOfUnit(std::make_pair("SU",5000)),openfluid::base::FrameworkException);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_parts_descriptors)
+{
+  openfluid::fluidx::SpatialDomainDescriptor Descriptor;
+  buildGridDomainDescriptor(Descriptor,20,10);
+
+  openfluid::fluidx::EventDescriptor EventDesc;
+  EventDesc.setUnitsClass("SU");
+  EventDesc.setUnitID(1);
+  Descriptor.events().push_back(EventDesc);
+
+  openfluid::machine::DomainPartitioner Partitioner(Descriptor,3);
+
+  std::set<openfluid::core::UnitClassID_t> BoundaryUnits(Partitioner.boundaryUnits().begin(),
+                                                         Partitioner.boundaryUnits().end());
+  unsigned int OwnedCount = 0;
+  unsigned int EventsCount = 0;
+
+  for (unsigned int p=0; p<3; p++)
+  {
+    openfluid::fluidx::SpatialDomainDescriptor PartDescriptor;
+    Partitioner.buildPartDescriptor(p,Descriptor,PartDescriptor);
+
+    std::vector<openfluid::core::UnitClassID_t> HaloUnits = Partitioner.getHaloUnits(p);
+    std::set<openfluid::core::UnitClassID_t> PartUnits;
+
+    for (openfluid::fluidx::SpatialUnitDescriptor& UnitDesc : PartDescriptor.spatialUnits())
+      PartUnits.insert(std::make_pair(UnitDesc.getUnitsClass(),UnitDesc.getID()));
+
+    BOOST_REQUIRE_EQUAL(PartUnits.size(),Partitioner.getPartSize(p)+HaloUnits.size());
+
+    for (const openfluid::core::UnitClassID_t& Unit : HaloUnits)
+    {
+      BOOST_REQUIRE(Partitioner.getPartOfUnit(Unit) != p);
+      BOOST_REQUIRE(BoundaryUnits.find(Unit) != BoundaryUnits.end());
+      BOOST_REQUIRE(PartUnits.find(Unit) != PartUnits.end());
+    }
+
+    // connections only target units of the part descriptor
+    for (openfluid::fluidx::SpatialUnitDescriptor& UnitDesc : PartDescriptor.spatialUnits())
+    {
+      if (Partitioner.getPartOfUnit(std::make_pair(UnitDesc.getUnitsClass(),UnitDesc.getID())) == p)
+        OwnedCount++;
+
+      for (const openfluid::core::UnitClassID_t& Linked : UnitDesc.toSpatialUnits())
+        BOOST_REQUIRE(PartUnits.find(Linked) != PartUnits.end());
+    }
+
+    EventsCount += PartDescriptor.events().size();
+  }
+
+  BOOST_REQUIRE_EQUAL(OwnedCount,220);
+  BOOST_REQUIRE_GE(EventsCount,1);
+}
+
@@ -0,0 +1,226 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+/**
+  @file Factory_TEST.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@supagro.inra.fr>
+ */
+
+
+#define BOOST_TEST_MAIN
+#define BOOST_AUTO_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE unittest_Factory
+#include <boost/test/unit_test.hpp>
+#include <boost/test/auto_unit_test.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <algorithm>
+
+#include <openfluid/machine/Factory.hpp>
+#include <openfluid/fluidx/SpatialDomainDescriptor.hpp>
+#include <openfluid/fluidx/SpatialUnitDescriptor.hpp>
+#include <openfluid/core/SpatialGraph.hpp>
+#include <openfluid/base/RuntimeEnv.hpp>
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Builds a binary tree network of river segments, flowing to the root unit #1,
+  defined in a shuffled order
+*/
+void buildTreeDomainDescriptor(openfluid::fluidx::SpatialDomainDescriptor& Descriptor, unsigned int UnitsCount,
+                               unsigned int PcsOrdersCount)
+{
+  std::vector<unsigned int> IDs(UnitsCount);
+
+  for (unsigned int i=0; i<UnitsCount; i++)
+    IDs[i] = i+1;
+
+  std::shuffle(IDs.begin(),IDs.end(),std::mt19937(42));
+
+  for (unsigned int ID : IDs)
+  {
+    openfluid::fluidx::SpatialUnitDescriptor UnitDesc;
+    UnitDesc.setUnitsClass("RS");
+    UnitDesc.setID(ID);
+    UnitDesc.setProcessOrder((ID%PcsOrdersCount)+1);
+
+    if (ID > 1)
+      UnitDesc.toSpatialUnits().push_back(std::make_pair("RS",ID/2));
+
+    Descriptor.spatialUnits().push_back(UnitDesc);
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+unsigned long long processRouting(openfluid::core::SpatialGraph& SGraph, unsigned int Passes)
+{
+  unsigned long long Sum = 0;
+
+  for (unsigned int p=0; p<Passes; p++)
+  {
+    for (openfluid::core::SpatialUnit& Unit : *(SGraph.spatialUnits("RS")->list()))
+    {
+      const openfluid::core::UnitsPtrList_t* FromUnits = Unit.fromSpatialUnits("RS");
+
+      if (FromUnits != NULL)
+      {
+        for (const openfluid::core::SpatialUnit* FromUnit : *FromUnits)
+          Sum += FromUnit->getID()+FromUnit->getProcessOrder();
+      }
+    }
+  }
+
+  return Sum;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_units_reordering)
+{
+  openfluid::fluidx::SpatialDomainDescriptor Descriptor;
+  buildTreeDomainDescriptor(Descriptor,1000,3);
+
+  std::vector<openfluid::fluidx::SpatialUnitDescriptor*> Order =
+      openfluid::machine::Factory::computeUnitsLocalityOrder(Descriptor);
+
+  BOOST_REQUIRE_EQUAL(Order.size(),1000);
+
+  std::vector<openfluid::core::UnitID_t> OrderedIDs;
+  for (openfluid::fluidx::SpatialUnitDescriptor* UnitDesc : Order)
+    OrderedIDs.push_back(UnitDesc->getID());
+  std::sort(OrderedIDs.begin(),OrderedIDs.end());
+  BOOST_REQUIRE(std::adjacent_find(OrderedIDs.begin(),OrderedIDs.end()) == OrderedIDs.end());
+
+
+  openfluid::core::SpatialGraph DefGraph;
+  openfluid::base::RuntimeEnvironment::instance()->setUnitsReorderingEnabled(false);
+  openfluid::machine::Factory::buildDomainFromDescriptor(Descriptor,DefGraph);
+
+  openfluid::core::SpatialGraph ReorderedGraph;
+  openfluid::base::RuntimeEnvironment::instance()->setUnitsReorderingEnabled(true);
+  openfluid::machine::Factory::buildDomainFromDescriptor(Descriptor,ReorderedGraph);
+  openfluid::base::RuntimeEnvironment::instance()->setUnitsReorderingEnabled(false);
+
+  // same units and connections, process order is respected
+  BOOST_REQUIRE_EQUAL(ReorderedGraph.spatialUnits("RS")->list()->size(),1000);
+  BOOST_REQUIRE_EQUAL(processRouting(DefGraph,1),processRouting(ReorderedGraph,1));
+
+  openfluid::core::PcsOrd_t LastPcsOrd = 0;
+  for (openfluid::core::SpatialUnit& Unit : *(ReorderedGraph.spatialUnits("RS")->list()))
+  {
+    BOOST_REQUIRE_GE(Unit.getProcessOrder(),LastPcsOrd);
+    LastPcsOrd = Unit.getProcessOrder();
+
+    if (Unit.getID() > 1)
+    {
+      BOOST_REQUIRE_EQUAL(Unit.toSpatialUnits("RS")->size(),1);
+      BOOST_REQUIRE_EQUAL(Unit.toSpatialUnits("RS")->front()->getID(),Unit.getID()/2);
+    }
+  }
+
+  // locality is improved, checked on units sharing the same process order
+  openfluid::fluidx::SpatialDomainDescriptor SameOrdDescriptor;
+  buildTreeDomainDescriptor(SameOrdDescriptor,1000,1);
+
+  openfluid::core::SpatialGraph SameOrdDefGraph;
+  openfluid::machine::Factory::buildDomainFromDescriptor(SameOrdDescriptor,SameOrdDefGraph);
+
+  openfluid::core::SpatialGraph SameOrdReorderedGraph;
+  openfluid::base::RuntimeEnvironment::instance()->setUnitsReorderingEnabled(true);
+  openfluid::machine::Factory::buildDomainFromDescriptor(SameOrdDescriptor,SameOrdReorderedGraph);
+  openfluid::base::RuntimeEnvironment::instance()->setUnitsReorderingEnabled(false);
+
+  const double DefDistance = openfluid::machine::Factory::computeUnitsConnectionsDistance(SameOrdDefGraph);
+  const double ReorderedDistance =
+      openfluid::machine::Factory::computeUnitsConnectionsDistance(SameOrdReorderedGraph);
+
+  std::cout << "Mean distance between connected units: " << DefDistance << " (definition order), "
+            << ReorderedDistance << " (reordered)" << std::endl;
+
+  BOOST_REQUIRE_LT(ReorderedDistance,DefDistance);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_performance)
+{
+  const unsigned int UnitsCount = 200000;
+  const unsigned int Passes = 20;
+
+  openfluid::fluidx::SpatialDomainDescriptor Descriptor;
+  buildTreeDomainDescriptor(Descriptor,UnitsCount,1);
+
+  for (bool Reordering : {false,true})
+  {
+    openfluid::core::SpatialGraph SGraph;
+
+    openfluid::base::RuntimeEnvironment::instance()->setUnitsReorderingEnabled(Reordering);
+
+    std::chrono::high_resolution_clock::time_point StartTime = std::chrono::high_resolution_clock::now();
+    openfluid::machine::Factory::buildDomainFromDescriptor(Descriptor,SGraph);
+    std::chrono::milliseconds BuildDuration =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now()-StartTime);
+
+    StartTime = std::chrono::high_resolution_clock::now();
+    unsigned long long Sum = processRouting(SGraph,Passes);
+    std::chrono::milliseconds RoutingDuration =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now()-StartTime);
+
+    std::cout << (Reordering ? "Reordered units: " : "Definition order: ")
+              << "build " << BuildDuration.count() << "ms, "
+              << Passes << " routing passes " << RoutingDuration.count() << "ms, "
+              << "mean connection distance "
+              << openfluid::machine::Factory::computeUnitsConnectionsDistance(SGraph)
+              << " (" << Sum << ")" << std::endl;
+  }
+
+  openfluid::base::RuntimeEnvironment::instance()->setUnitsReorderingEnabled(false);
+}
+
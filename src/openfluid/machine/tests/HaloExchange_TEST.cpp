@@ -0,0 +1,183 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+/**
+  @file HaloExchange_TEST.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@supagro.inra.fr>
+*/
+
+
+#define BOOST_TEST_MAIN
+#define BOOST_AUTO_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE unittest_HaloExchange
+#include <boost/test/unit_test.hpp>
+#include <boost/test/auto_unit_test.hpp>
+
+#include <openfluid/machine/HaloExchange.hpp>
+#include <openfluid/machine/DomainPartitioner.hpp>
+#include <openfluid/fluidx/SpatialDomainDescriptor.hpp>
+#include <openfluid/fluidx/SpatialUnitDescriptor.hpp>
+#include <openfluid/core/SpatialGraph.hpp>
+#include <openfluid/core/DoubleValue.hpp>
+#include <openfluid/core/ValuesBufferProperties.hpp>
+
+#if defined(OPENFLUID_OS_LINUX)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Simulates the given part of a chain of units during a few time points,
+  returns the number of halo values that do not match the values of the owning part
+*/
+unsigned int simulatePart(unsigned int Part,
+                          openfluid::fluidx::SpatialDomainDescriptor& Descriptor,
+                          const openfluid::machine::DomainPartitioner& Partitioner,
+                          openfluid::machine::HaloExchange& Exchange)
+{
+  openfluid::fluidx::SpatialDomainDescriptor PartDescriptor;
+  Partitioner.buildPartDescriptor(Part,Descriptor,PartDescriptor);
+
+  openfluid::core::SpatialGraph SGraph;
+
+  for (const openfluid::fluidx::SpatialUnitDescriptor& UnitDesc : PartDescriptor.spatialUnits())
+    SGraph.addUnit(openfluid::core::SpatialUnit(UnitDesc.getUnitsClass(),UnitDesc.getID(),
+                                                UnitDesc.getProcessOrder()));
+
+  for (openfluid::core::SpatialUnit* Unit : *SGraph.allSpatialUnits())
+    Unit->variables()->createVariable("var");
+
+  Exchange.bindPart(Part,Partitioner,SGraph);
+
+  unsigned int ErrorsCount = 0;
+
+  // halo units are marked with the exchanged variables
+  for (openfluid::core::SpatialUnit* Unit : *SGraph.allSpatialUnits())
+  {
+    bool IsOwned = (Partitioner.getPartOfUnit(std::make_pair(Unit->getClass(),Unit->getID())) == Part);
+
+    if (Unit->isHalo() == IsOwned || Unit->isHaloVariable("var") == IsOwned || Unit->isHaloVariable("other"))
+      ErrorsCount++;
+  }
+
+  for (openfluid::core::TimeIndex_t t=0; t<50; t+=10)
+  {
+    // halo units are simulated locally with wrong values, replaced by the exchange
+    for (openfluid::core::SpatialUnit* Unit : *SGraph.allSpatialUnits())
+    {
+      bool IsOwned = (Partitioner.getPartOfUnit(std::make_pair(Unit->getClass(),Unit->getID())) == Part);
+      Unit->variables()->appendValue("var",t,openfluid::core::DoubleValue(IsOwned ? Unit->getID()*1000.0+t : -1.0));
+    }
+
+    Exchange.exchange();
+
+    for (const openfluid::core::UnitClassID_t& HaloUnit : Partitioner.getHaloUnits(Part))
+    {
+      openfluid::core::DoubleValue Value;
+      SGraph.spatialUnit(HaloUnit.first,HaloUnit.second)->variables()->getValue("var",t,&Value);
+
+      if (Value.get() != HaloUnit.second*1000.0+t)
+        ErrorsCount++;
+    }
+  }
+
+  Exchange.leave();
+
+  return ErrorsCount;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_exchange)
+{
+#if defined(OPENFLUID_OS_LINUX)
+  openfluid::core::ValuesBufferProperties::setBufferSize(10);
+
+  openfluid::fluidx::SpatialDomainDescriptor Descriptor;
+
+  for (unsigned int i=1; i<=40; i++)
+  {
+    openfluid::fluidx::SpatialUnitDescriptor UnitDesc;
+    UnitDesc.setUnitsClass("SU");
+    UnitDesc.setID(i);
+    UnitDesc.setProcessOrder(1);
+
+    if (i < 40)
+      UnitDesc.toSpatialUnits().push_back(std::make_pair("SU",i+1));
+
+    Descriptor.spatialUnits().push_back(UnitDesc);
+  }
+
+  openfluid::machine::DomainPartitioner Partitioner(Descriptor,2);
+  openfluid::machine::HaloExchange Exchange(Partitioner,{"var"});
+
+  BOOST_REQUIRE(Exchange.getSlotsCount() > 0);
+  BOOST_REQUIRE(!Partitioner.getHaloUnits(0).empty());
+  BOOST_REQUIRE(!Partitioner.getHaloUnits(1).empty());
+
+  pid_t ChildPID = fork();
+  BOOST_REQUIRE(ChildPID >= 0);
+
+  if (ChildPID == 0)
+  {
+    unsigned int ErrorsCount = 1;
+
+    try
+    {
+      ErrorsCount = simulatePart(1,Descriptor,Partitioner,Exchange);
+    }
+    catch (openfluid::base::FrameworkException&)
+    { }
+
+    _exit(ErrorsCount ? 1 : 0);
+  }
+
+  BOOST_REQUIRE_EQUAL(simulatePart(0,Descriptor,Partitioner,Exchange),0);
+
+  int Status = 0;
+  waitpid(ChildPID,&Status,0);
+
+  BOOST_REQUIRE(WIFEXITED(Status));
+  BOOST_REQUIRE_EQUAL(WEXITSTATUS(Status),0);
+  BOOST_REQUIRE(!Exchange.isAborted());
+#endif
+}
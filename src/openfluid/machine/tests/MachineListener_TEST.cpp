@@ -0,0 +1,133 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+/**
+  @file MachineListener_TEST.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@supagro.inra.fr>
+*/
+
+
+#define BOOST_TEST_MAIN
+#define BOOST_AUTO_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE unittest_machinelistener
+#include <boost/test/unit_test.hpp>
+#include <boost/test/auto_unit_test.hpp>
+
+#include <chrono>
+
+#include <openfluid/machine/MachineListener.hpp>
+
+
+// =====================================================================
+// =====================================================================
+
+
+class CountingListener : public openfluid::machine::MachineListener
+{
+  public:
+
+    unsigned int ProgressCount;
+
+    bool WarningPublished;
+
+    openfluid::machine::MachineListener::ProgressSnapshot LastProgress;
+
+    CountingListener() : ProgressCount(0), WarningPublished(false)
+    { }
+
+    void onProgress(const openfluid::machine::MachineListener::ProgressSnapshot& Progress)
+    {
+      ProgressCount++;
+      WarningPublished = WarningPublished || Progress.Warning;
+      LastProgress = Progress;
+    }
+};
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_construction)
+{
+  CountingListener Listener;
+
+  BOOST_REQUIRE(!Listener.isProgressThrottled());
+  BOOST_REQUIRE_EQUAL(Listener.getProgressRate(),0);
+  BOOST_REQUIRE_EQUAL(Listener.getProgress().TimePointsCount,0);
+
+  Listener.setProgressRate(10);
+  BOOST_REQUIRE(Listener.isProgressThrottled());
+  BOOST_REQUIRE_EQUAL(Listener.getProgressRate(),10);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_throttling)
+{
+  const openfluid::core::Duration_t Duration = 1000000;
+
+  openfluid::base::SimulationStatus SimStatus(openfluid::core::DateTime(2000,1,1,0,0,0),
+                                              openfluid::core::DateTime(2000,1,1,0,0,0)+Duration,1);
+  SimStatus.setCurrentStage(openfluid::base::SimulationStatus::RUNSTEP);
+
+  CountingListener Listener;
+  Listener.setProgressRate(10);
+
+  auto Start = std::chrono::steady_clock::now();
+
+  for (openfluid::core::TimeIndex_t i=1; i<=Duration; i++)
+  {
+    SimStatus.setCurrentTimeIndex(i);
+    Listener.updateProgress(&SimStatus,(i == Duration/2));
+  }
+
+  double Elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now()-Start).count();
+
+  // first time point is published immediately, then at most once per period
+  BOOST_REQUIRE(Listener.ProgressCount >= 1);
+  BOOST_REQUIRE(Listener.ProgressCount <= 2+static_cast<unsigned int>(Elapsed*10));
+
+  BOOST_REQUIRE_EQUAL(Listener.getProgress().CurrentIndex,Duration);
+  BOOST_REQUIRE_EQUAL(Listener.getProgress().Duration,Duration);
+  BOOST_REQUIRE_EQUAL(Listener.getProgress().TimePointsCount,Duration);
+
+  Listener.publishProgress();
+  BOOST_REQUIRE_EQUAL(Listener.LastProgress.CurrentIndex,Duration);
+  BOOST_REQUIRE(Listener.WarningPublished);
+  BOOST_REQUIRE(!Listener.getProgress().Warning);
+}
@@ -42,5 +42,6 @@
 #define __OPENFLUID_SCIENTIFIC_HPP__
 
 #include <openfluid/scientific/FloatingPoint.hpp>
+#include <openfluid/scientific/CounterBasedRandom.hpp>
 
 #endif /* __OPENFLUID_SCIENTIFIC_HPP__ */
@@ -0,0 +1,299 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+
+/**
+  @file CounterBasedRandom.hpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@supagro.inra.fr>
+*/
+
+
+#ifndef __OPENFLUID_SCIENTIFIC_COUNTERBASEDRANDOM_HPP__
+#define __OPENFLUID_SCIENTIFIC_COUNTERBASEDRANDOM_HPP__
+
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+
+namespace openfluid { namespace scientific {
+
+
+/**
+  Philox-4x32-10 counter-based pseudo-random function.
+  It transforms a 128 bits counter into 128 bits of random data, using a 64 bits key.
+  The same (counter,key) pair always gives the same result, whatever the order of the calls and the thread.
+
+  @see Salmon J.K., Moraes M.A., Dror R.O., Shaw D.E. (2011). Parallel random numbers: as easy as 1, 2, 3.
+  Proceedings of the International Conference for High Performance Computing, Networking, Storage and Analysis.
+*/
+class Philox4x32
+{
+  public:
+
+    typedef std::array<std::uint32_t,4> Counter_t;
+
+    typedef std::array<std::uint32_t,2> Key_t;
+
+
+  private:
+
+    static inline void round(Counter_t& Ctr, const Key_t& Key)
+    {
+      const std::uint64_t Prod0 = std::uint64_t(0xD2511F53) * Ctr[0];
+      const std::uint64_t Prod1 = std::uint64_t(0xCD9E8D57) * Ctr[2];
+
+      Ctr = {{ std::uint32_t(Prod1 >> 32) ^ Ctr[1] ^ Key[0], std::uint32_t(Prod1),
+               std::uint32_t(Prod0 >> 32) ^ Ctr[3] ^ Key[1], std::uint32_t(Prod0) }};
+    }
+
+
+  public:
+
+    /**
+      Computes the random data for the given counter and key
+      @param[in] Ctr the counter
+      @param[in] Key the key
+      @return the 128 bits of random data
+    */
+    static inline Counter_t compute(Counter_t Ctr, Key_t Key)
+    {
+      round(Ctr,Key);
+
+      for (unsigned int i = 1; i < 10; i++)
+      {
+        Key[0] += 0x9E3779B9;
+        Key[1] += 0xBB67AE85;
+        round(Ctr,Key);
+      }
+
+      return Ctr;
+    }
+};
+
+
+// =====================================================================
+// =====================================================================
+
+
+/**
+  Reproducible random values generation based on the Philox4x32 counter-based function.
+  Random values are fully determined by the seed, the stream name (e.g. a variable name),
+  the spatial unit ID, the time index and a sub-index (e.g. the index of a value in a vector).
+  Values can thus be generated in any order and on any number of threads,
+  giving the same results from one run to another.
+
+  <I>Example</I>
+  @code
+  openfluid::scientific::CounterBasedRandom Random(12345,"SU#rain");
+
+  // draws for unit 3 at time index 86400
+  openfluid::scientific::CounterBasedRandom::Sequence Seq = Random.getSequence(3,86400);
+  double V1 = Seq.uniform(0.0,10.0);
+  double V2 = Seq.normal(5.0,1.5);
+  @endcode
+*/
+class CounterBasedRandom
+{
+  public:
+
+    /**
+      Sequence of random values for a given unit ID, time index and sub-index.
+      Each sequence provides up to 512 uniform values before overlapping the sequence of the next sub-index.
+    */
+    class Sequence
+    {
+      private:
+
+        Philox4x32::Key_t m_Key;
+
+        Philox4x32::Counter_t m_Counter;
+
+        Philox4x32::Counter_t m_Block;
+
+        unsigned int m_UsedInBlock;
+
+
+        inline double nextUniform01()
+        {
+          if (m_UsedInBlock == 2)
+          {
+            m_Block = Philox4x32::compute(m_Counter,m_Key);
+            m_Counter[3]++;
+            m_UsedInBlock = 0;
+          }
+
+          // 53 bits resolution value from two 32 bits words
+          const unsigned int i = 2*m_UsedInBlock;
+          m_UsedInBlock++;
+
+          return ((m_Block[i] >> 5) * 67108864.0 + (m_Block[i+1] >> 6)) * (1.0/9007199254740992.0);
+        }
+
+
+      public:
+
+        Sequence(const Philox4x32::Key_t& Key, std::uint32_t ID, std::uint64_t TimeIndex, std::uint32_t SubIndex) :
+          m_Key(Key), m_UsedInBlock(2)
+        {
+          m_Counter = {{ ID, std::uint32_t(TimeIndex), std::uint32_t(TimeIndex >> 32), SubIndex << 8 }};
+        }
+
+        /**
+          Draws a value from the uniform distribution in [0,1)
+        */
+        inline double uniform01()
+        { return nextUniform01(); }
+
+        /**
+          Draws a value from the uniform distribution in [Min,Max)
+        */
+        inline double uniform(double Min, double Max)
+        { return Min + (Max-Min)*nextUniform01(); }
+
+        /**
+          Draws a value from the normal distribution, using the Box-Muller transform
+          @param[in] Mean the mean of the distribution
+          @param[in] StdDev the standard deviation of the distribution
+        */
+        inline double normal(double Mean, double StdDev)
+        {
+          // first value in (0,1] to avoid log(0)
+          const double U1 = 1.0 - nextUniform01();
+          const double U2 = nextUniform01();
+
+          return Mean + StdDev * std::sqrt(-2.0*std::log(U1)) * std::cos(6.283185307179586476925*U2);
+        }
+
+        /**
+          Draws a value from the log-normal distribution
+          @param[in] Mean the mean of the logarithm of the distribution
+          @param[in] StdDev the standard deviation of the logarithm of the distribution
+        */
+        inline double lognormal(double Mean, double StdDev)
+        { return std::exp(normal(Mean,StdDev)); }
+
+        /**
+          Draws a value from the gamma distribution, using the Marsaglia-Tsang method
+          @param[in] Shape the shape (k) of the distribution, must be strictly positive
+          @param[in] Scale the scale (theta) of the distribution, must be strictly positive
+        */
+        inline double gamma(double Shape, double Scale)
+        {
+          if (Shape < 1.0)
+          {
+            // boost for shapes lower than 1
+            const double U = 1.0 - nextUniform01();
+            return gamma(Shape+1.0,Scale) * std::pow(U,1.0/Shape);
+          }
+
+          const double D = Shape - 1.0/3.0;
+          const double C = 1.0/std::sqrt(9.0*D);
+
+          while (true)
+          {
+            double X, V;
+
+            do
+            {
+              X = normal(0.0,1.0);
+              V = 1.0 + C*X;
+            }
+            while (V <= 0.0);
+
+            V = V*V*V;
+            const double U = 1.0 - nextUniform01();
+
+            if (std::log(U) < 0.5*X*X + D - D*V + D*std::log(V))
+              return D*V*Scale;
+          }
+        }
+    };
+
+
+  private:
+
+    Philox4x32::Key_t m_Key;
+
+
+  public:
+
+    /**
+      Computes a stable 32 bits hash of a string (FNV-1a), identical on all platforms
+    */
+    static inline std::uint32_t hashString(const std::string& Str)
+    {
+      std::uint32_t Hash = 2166136261u;
+
+      for (const char& C : Str)
+      {
+        Hash ^= static_cast<unsigned char>(C);
+        Hash *= 16777619u;
+      }
+
+      return Hash;
+    }
+
+    /**
+      Constructor
+      @param[in] Seed the seed
+      @param[in] StreamName the name of the stream, allowing different generators to use the same seed
+      without correlation
+    */
+    CounterBasedRandom(std::uint64_t Seed = 0, const std::string& StreamName = "")
+    {
+      Philox4x32::Counter_t Mixed =
+        Philox4x32::compute({{ hashString(StreamName), 0, 0, 0 }},
+                            {{ std::uint32_t(Seed), std::uint32_t(Seed >> 32) }});
+
+      m_Key = {{ Mixed[0], Mixed[1] }};
+    }
+
+    /**
+      Returns the sequence of random values for the given ID, time index and sub-index
+      @param[in] ID the ID (e.g. a spatial unit ID)
+      @param[in] TimeIndex the time index
+      @param[in] SubIndex the sub-index (e.g. the index of a value in a vector), lower than 2^24
+    */
+    inline Sequence getSequence(std::uint32_t ID, std::uint64_t TimeIndex, std::uint32_t SubIndex = 0) const
+    { return Sequence(m_Key,ID,TimeIndex,SubIndex); }
+
+};
+
+
+} }  // namespaces
+
+
+#endif /* __OPENFLUID_SCIENTIFIC_COUNTERBASEDRANDOM_HPP__ */
@@ -0,0 +1,157 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+
+/**
+  @file CounterBasedRandom_TEST.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@supagro.inra.fr>
+*/
+
+
+#define BOOST_TEST_MAIN
+#define BOOST_AUTO_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE unittest_counterbasedrandom
+#include <boost/test/unit_test.hpp>
+#include <boost/test/auto_unit_test.hpp>
+
+#include <algorithm>
+
+#include <openfluid/scientific/CounterBasedRandom.hpp>
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_philox)
+{
+  // known answers from the Random123 reference implementation
+  openfluid::scientific::Philox4x32::Counter_t Res =
+      openfluid::scientific::Philox4x32::compute({{0,0,0,0}},{{0,0}});
+  BOOST_REQUIRE_EQUAL(Res[0],0x6627e8d5);
+  BOOST_REQUIRE_EQUAL(Res[1],0xe169c58d);
+  BOOST_REQUIRE_EQUAL(Res[2],0xbc57ac4c);
+  BOOST_REQUIRE_EQUAL(Res[3],0x9b00dbd8);
+
+  Res = openfluid::scientific::Philox4x32::compute({{0xffffffff,0xffffffff,0xffffffff,0xffffffff}},
+                                                   {{0xffffffff,0xffffffff}});
+  BOOST_REQUIRE_EQUAL(Res[0],0x408f276d);
+  BOOST_REQUIRE_EQUAL(Res[1],0x41c83b0e);
+  BOOST_REQUIRE_EQUAL(Res[2],0xa20bc7c6);
+  BOOST_REQUIRE_EQUAL(Res[3],0x6d5451fd);
+
+  Res = openfluid::scientific::Philox4x32::compute({{0x243f6a88,0x85a308d3,0x13198a2e,0x03707344}},
+                                                   {{0xa4093822,0x299f31d0}});
+  BOOST_REQUIRE_EQUAL(Res[0],0xd16cfe09);
+  BOOST_REQUIRE_EQUAL(Res[1],0x94fdcceb);
+  BOOST_REQUIRE_EQUAL(Res[2],0x5001e420);
+  BOOST_REQUIRE_EQUAL(Res[3],0x24126ea1);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_reproducibility)
+{
+  openfluid::scientific::CounterBasedRandom Random(12345,"TU#var");
+  openfluid::scientific::CounterBasedRandom SameRandom(12345,"TU#var");
+  openfluid::scientific::CounterBasedRandom OtherSeed(12346,"TU#var");
+  openfluid::scientific::CounterBasedRandom OtherStream(12345,"TU#othervar");
+
+  double V = Random.getSequence(7,3600).uniform01();
+
+  // same values whatever the order of draws
+  Random.getSequence(8,3600).uniform01();
+  BOOST_REQUIRE_EQUAL(V,Random.getSequence(7,3600).uniform01());
+  BOOST_REQUIRE_EQUAL(V,SameRandom.getSequence(7,3600).uniform01());
+
+  BOOST_REQUIRE_NE(V,OtherSeed.getSequence(7,3600).uniform01());
+  BOOST_REQUIRE_NE(V,OtherStream.getSequence(7,3600).uniform01());
+  BOOST_REQUIRE_NE(V,Random.getSequence(8,3600).uniform01());
+  BOOST_REQUIRE_NE(V,Random.getSequence(7,7200).uniform01());
+  BOOST_REQUIRE_NE(V,Random.getSequence(7,3600,1).uniform01());
+
+  openfluid::scientific::CounterBasedRandom::Sequence Seq = Random.getSequence(7,3600);
+  BOOST_REQUIRE_EQUAL(V,Seq.uniform01());
+  BOOST_REQUIRE_NE(V,Seq.uniform01());
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_distributions)
+{
+  openfluid::scientific::CounterBasedRandom Random(42);
+
+  const unsigned int Count = 100000;
+  double UniformSum = 0.0, NormalSum = 0.0, NormalSqSum = 0.0, GammaSum = 0.0, SmallGammaSum = 0.0;
+  double UniformMin = 1000.0, UniformMax = -1000.0;
+  bool LogNormalPositive = true;
+
+  for (unsigned int i = 0; i < Count; i++)
+  {
+    openfluid::scientific::CounterBasedRandom::Sequence Seq = Random.getSequence(i,0);
+
+    double U = Seq.uniform(-5.0,15.0);
+    UniformSum += U;
+    UniformMin = std::min(U,UniformMin);
+    UniformMax = std::max(U,UniformMax);
+
+    double N = Seq.normal(10.0,2.0);
+    NormalSum += N;
+    NormalSqSum += N*N;
+
+    LogNormalPositive = LogNormalPositive && (Seq.lognormal(0.0,1.0) > 0.0);
+
+    GammaSum += Seq.gamma(3.0,2.0);
+    SmallGammaSum += Seq.gamma(0.5,1.0);
+  }
+
+  BOOST_REQUIRE(UniformMin >= -5.0);
+  BOOST_REQUIRE(UniformMax < 15.0);
+  BOOST_REQUIRE_CLOSE(UniformSum/Count,5.0,1.0);
+
+  double NormalMean = NormalSum/Count;
+  BOOST_REQUIRE_CLOSE(NormalMean,10.0,1.0);
+  BOOST_REQUIRE_CLOSE(std::sqrt(NormalSqSum/Count - NormalMean*NormalMean),2.0,2.0);
+
+  BOOST_REQUIRE(LogNormalPositive);
+
+  BOOST_REQUIRE_CLOSE(GammaSum/Count,6.0,2.0);
+  BOOST_REQUIRE_CLOSE(SmallGammaSum/Count,0.5,2.0);
+}
@@ -40,9 +40,11 @@
 
 
 #include <iostream>
-#include <fstream>
-#include <boost/algorithm/string.hpp>
-#include <boost/tokenizer.hpp>
+#include <cstring>
+#include <cctype>
+#include <climits>
+
+#include <QFile>
 
 #include <openfluid/tools/ColumnTextParser.hpp>
 #include <openfluid/tools/DataHelpers.hpp>
@@ -55,11 +57,52 @@
 namespace openfluid { namespace tools {
 
 
+/**
+  Converts a range of characters to a long int without memory allocation for plain integer values,
+  other values are converted using openfluid::tools::convertString()
+*/
+static bool convertCharsToLong(const char* Begin, const char* End, long* Converted)
+{
+  const char* Current = Begin;
+  bool IsNegative = false;
+  unsigned long Value = 0;
+
+  if (Current != End && (*Current == '-' || *Current == '+'))
+  {
+    IsNegative = (*Current == '-');
+    ++Current;
+  }
+
+  const char* DigitsBegin = Current;
+
+  while (Current != End && *Current >= '0' && *Current <= '9' && Value <= (ULONG_MAX-9)/10)
+  {
+    Value = Value*10 + (*Current - '0');
+    ++Current;
+  }
+
+  if (Current != End || Current == DigitsBegin ||
+      Value > (IsNegative ? (unsigned long)LONG_MAX+1 : (unsigned long)LONG_MAX))
+    return convertString(std::string(Begin,End),Converted);
+
+  *Converted = (IsNegative ? -(long)(Value-1)-1 : (long)Value);
+
+  return true;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 ColumnTextParser::ColumnTextParser(const std::string& CommentLineSymbol, const std::string& Delimiter):
   m_Delimiter(Delimiter), m_CommentSymbol(CommentLineSymbol),
-  m_LinesCount(0), m_ColsCount(0)
+  m_LinesCount(0), m_ColsCount(0), mp_MappedFile(nullptr)
 {
+  std::memset(m_IsDelimiter,0,sizeof(m_IsDelimiter));
 
+  for (auto C : m_Delimiter)
+    m_IsDelimiter[(unsigned char)C] = true;
 }
 
 
@@ -69,7 +112,7 @@ ColumnTextParser::ColumnTextParser(const std::string& CommentLineSymbol, const s
 
 ColumnTextParser::~ColumnTextParser()
 {
-
+  clear();
 }
 
 
@@ -77,20 +120,18 @@ ColumnTextParser::~ColumnTextParser()
 // =====================================================================
 
 
-std::vector<std::string> ColumnTextParser::tokenizeLine(const std::string& Line)
+void ColumnTextParser::clear()
 {
-  std::vector<std::string> Splitted;
+  m_Cells.clear();
+  m_UnescapedCells.clear();
+  m_OwnedContents.clear();
 
-  boost::tokenizer<boost::escaped_list_separator<char>>
-    Tokenizer(Line, boost::escaped_list_separator<char>("\\",m_Delimiter,"\""));
-
-  for (auto it=Tokenizer.begin(); it!=Tokenizer.end(); ++it)
-  {
-    if (!(*it).empty())
-      Splitted.push_back(*it);
-  }
+  // deleting the file closes it and releases the mapped memory
+  delete mp_MappedFile;
+  mp_MappedFile = nullptr;
 
-  return Splitted;
+  m_LinesCount = 0;
+  m_ColsCount = 0;
 }
 
 
@@ -98,20 +139,85 @@ std::vector<std::string> ColumnTextParser::tokenizeLine(const std::string& Line)
 // =====================================================================
 
 
-std::vector<std::string> ColumnTextParser::tokenizeString(const std::string& Str)
+bool ColumnTextParser::tokenizeRange(const char* Begin, const char* End, unsigned int& CellsCount)
 {
-  std::vector<std::string> Splitted;
+  /** @internal
 
-  boost::tokenizer<boost::escaped_list_separator<char>>
-    Tokenizer(Str, boost::escaped_list_separator<char>("\\",m_Delimiter,"\""));
+    Same rules as boost::escaped_list_separator with \ as escape character and " as quote character.
+    Plain cells are referenced in place, cells with quotes or escape sequences are unescaped
+    in a separate storage. Empty cells are ignored.
 
-  for (auto it=Tokenizer.begin(); it!=Tokenizer.end(); ++it)
+  */
+
+  const char* Current = Begin;
+
+  CellsCount = 0;
+
+  while (Current != End)
   {
-    if (!(*it).empty())
-      Splitted.push_back(*it);
+    const char* CellBegin = Current;
+
+    while (Current != End && *Current != '\\' && *Current != '"' && !m_IsDelimiter[(unsigned char)*Current])
+      ++Current;
+
+    if (Current == End || m_IsDelimiter[(unsigned char)*Current])
+    {
+      if (Current != CellBegin)
+      {
+        m_Cells.emplace_back(CellBegin,Current-CellBegin);
+        CellsCount++;
+      }
+
+      if (Current != End)
+        ++Current;
+
+      continue;
+    }
+
+    // the cell contains quotes or escape sequences
+    std::string Unescaped(CellBegin,Current);
+    bool InQuote = false;
+
+    while (Current != End)
+    {
+      const char C = *Current;
+
+      if (C == '\\')
+      {
+        ++Current;
+
+        if (Current == End)
+          return false;
+
+        if (*Current == 'n')
+          Unescaped += '\n';
+        else if (*Current == '\\' || *Current == '"' || m_IsDelimiter[(unsigned char)*Current])
+          Unescaped += *Current;
+        else
+          return false;
+      }
+      else if (m_IsDelimiter[(unsigned char)C] && !InQuote)
+        break;
+      else if (C == '"')
+        InQuote = !InQuote;
+      else
+        Unescaped += C;
+
+      ++Current;
+    }
+
+    if (Current != End)
+      ++Current;
+
+    if (!Unescaped.empty())
+    {
+      m_UnescapedCells.push_back(std::move(Unescaped));
+      m_Cells.emplace_back(m_UnescapedCells.back());
+      CellsCount++;
+    }
   }
 
-  return Splitted;
+  return true;
 }
 
 
@@ -119,26 +225,32 @@ std::vector<std::string> ColumnTextParser::tokenizeString(const std::string& Str
 // =====================================================================
 
 
-bool ColumnTextParser::checkContents()
+bool ColumnTextParser::isCommentLine(const char* Begin, const char* End) const
 {
-  unsigned int LineColCount;
-  unsigned int LineCount = m_Contents.size();
+  if (m_CommentSymbol.empty())
+    return false;
 
-  if (LineCount == 0) return true;
+  while (Begin != End && std::isspace((unsigned char)*Begin))
+    ++Begin;
 
-  // checks that all lines have the same size
-  // i.e. same columns number
-  LineColCount = m_Contents.at(0).size();
+  return (std::size_t(End-Begin) >= m_CommentSymbol.size() &&
+          std::memcmp(Begin,m_CommentSymbol.data(),m_CommentSymbol.size()) == 0);
+}
 
-  for (unsigned int i=1;i<LineCount;i++)
+
+// =====================================================================
+// =====================================================================
+
+
+bool ColumnTextParser::isEmptyLine(const char* Begin, const char* End) const
+{
+  while (Begin != End)
   {
-    if (m_Contents.at(i).size() != LineColCount)
+    if (!std::isspace((unsigned char)*Begin))
       return false;
+    ++Begin;
   }
 
-  m_LinesCount = m_Contents.size();
-  m_ColsCount = LineColCount;
-
   return true;
 }
 
@@ -147,27 +259,42 @@ bool ColumnTextParser::checkContents()
 // =====================================================================
 
 
-bool ColumnTextParser::isCommentLineStr(const std::string& LineStr)
+bool ColumnTextParser::parseLines(const char* Begin, const char* End)
 {
+  const char* LineBegin = Begin;
+  unsigned int LinesCount = 0;
+  unsigned int ColsCount = 0;
 
-  if (m_CommentSymbol.length() > 0)
+  while (LineBegin < End)
   {
-    std::string TmpStr = boost::trim_left_copy(LineStr);
-    return boost::starts_with(TmpStr,m_CommentSymbol.c_str());
-  }
+    const char* LineEnd = static_cast<const char*>(std::memchr(LineBegin,'\n',End-LineBegin));
 
-  return false;
+    if (!LineEnd)
+      LineEnd = End;
 
-}
+    if (!isEmptyLine(LineBegin,LineEnd) && !isCommentLine(LineBegin,LineEnd))
+    {
+      unsigned int CellsCount;
 
+      if (!tokenizeRange(LineBegin,LineEnd,CellsCount))
+        return false;
 
-// =====================================================================
-// =====================================================================
+      // checks that all lines have the same columns number
+      if (LinesCount == 0)
+        ColsCount = CellsCount;
+      else if (CellsCount != ColsCount)
+        return false;
 
+      LinesCount++;
+    }
 
-bool ColumnTextParser::isEmptyLineStr(const std::string& LineStr)
-{
-  return (boost::trim_copy(LineStr).empty());
+    LineBegin = LineEnd+1;
+  }
+
+  m_LinesCount = LinesCount;
+  m_ColsCount = ColsCount;
+
+  return true;
 }
 
 
@@ -177,32 +304,47 @@ bool ColumnTextParser::isEmptyLineStr(const std::string& LineStr)
 
 bool ColumnTextParser::loadFromFile(const std::string& Filename)
 {
-
-  std::string StrLine;
-
-  if (m_Contents.size()> 0 ) m_Contents.clear();
-
-  m_LinesCount = 0;
-  m_ColsCount = 0;
+  clear();
 
   // check if file exists
   if (!openfluid::tools::Filesystem::isFile(Filename))
     return false;
 
-  std::ifstream FileContent(Filename.c_str());
+  mp_MappedFile = new QFile(QString::fromStdString(Filename));
 
   // check if file is "openable"
-  if (!FileContent)
+  if (!mp_MappedFile->open(QIODevice::ReadOnly))
+  {
+    clear();
     return false;
+  }
+
+  const qint64 Size = mp_MappedFile->size();
+
+  if (Size == 0)
+    return true;
+
+  const char* Data = reinterpret_cast<const char*>(mp_MappedFile->map(0,Size));
+  std::size_t DataSize = Size;
+
+  if (!Data)
+  {
+    // the file cannot be mapped in memory, its contents are read instead
+    const QByteArray Contents = mp_MappedFile->readAll();
+    m_OwnedContents.assign(Contents.constData(),Contents.size());
+    delete mp_MappedFile;
+    mp_MappedFile = nullptr;
+    Data = m_OwnedContents.data();
+    DataSize = m_OwnedContents.size();
+  }
 
-  // parse and loads file contents
-  while(std::getline(FileContent,StrLine))
+  if (!parseLines(Data,Data+DataSize))
   {
-    if (!isCommentLineStr(StrLine) && !isEmptyLineStr(StrLine))
-      m_Contents.push_back(ColumnTextParser::tokenizeLine(StrLine));
+    clear();
+    return false;
   }
 
-  return checkContents();
+  return true;
 }
 
 
@@ -219,47 +361,46 @@ bool ColumnTextParser::setFromString(const std::string& Contents, unsigned int C
 
   */
 
+  clear();
 
-  std::vector<std::string>::iterator it;
+  if (ColumnsNbr == 0)
+    return false;
 
-  bool IsOK = true;
+  m_OwnedContents = Contents;
 
-  std::vector<std::string> Tokens = ColumnTextParser::tokenizeString(Contents);
+  unsigned int CellsCount;
 
-  if (Tokens.size() % ColumnsNbr == 0)
+  if (!tokenizeRange(m_OwnedContents.data(),m_OwnedContents.data()+m_OwnedContents.size(),CellsCount) ||
+      CellsCount % ColumnsNbr != 0)
   {
+    clear();
+    return false;
+  }
 
-    if (m_Contents.size() > 0) m_Contents.clear();
+  m_LinesCount = CellsCount / ColumnsNbr;
+  m_ColsCount = (m_LinesCount ? ColumnsNbr : 0);
 
-    std::vector<std::string> LineStr;
+  return true;
+}
 
-    it = Tokens.begin();
-    while (it != Tokens.end() && IsOK)
-    {
-      // add to the current line
-      LineStr.push_back(*it);
 
-      if (LineStr.size() == ColumnsNbr)
-      {
-        // if current line has ColumnsNbr columns, it is added to the contents
-        m_Contents.push_back(LineStr);
+// =====================================================================
+// =====================================================================
 
-        LineStr.clear();
-      }
 
-      ++it;
-    }
+std::vector<std::string> ColumnTextParser::getValues(unsigned int Line) const
+{
+  std::vector<std::string> Values;
 
-    // more tokens processed but not a complete line. not good!
-    if (LineStr.size() != 0 && LineStr.size() != ColumnsNbr)
-    {
-      IsOK = false;
-    }
+  if (Line < m_LinesCount)
+  {
+    Values.reserve(m_ColsCount);
+
+    for (unsigned int j=0;j<m_ColsCount;j++)
+      Values.push_back(cell(Line,j)->to_string());
   }
-  else
-    IsOK = false;
 
-  return IsOK && checkContents();
+  return Values;
 }
 
 
@@ -267,14 +408,14 @@ bool ColumnTextParser::setFromString(const std::string& Contents, unsigned int C
 // =====================================================================
 
 
-std::vector<std::string> ColumnTextParser::getValues(unsigned int Line) const
+boost::string_ref ColumnTextParser::getCell(unsigned int Line, unsigned int Column) const
 {
-  if (Line < m_Contents.size())
-  {
-    return m_Contents.at(Line);
-  }
+  const boost::string_ref* Cell = cell(Line,Column);
 
-  return std::vector<std::string>();
+  if (Cell)
+    return *Cell;
+
+  return boost::string_ref();
 }
 
 
@@ -284,12 +425,7 @@ std::vector<std::string> ColumnTextParser::getValues(unsigned int Line) const
 
 std::string ColumnTextParser::getValue(unsigned int Line, unsigned int Column) const
 {
-  std::vector<std::string> LineString = getValues(Line);
-
-  if (!LineString.empty() && Column < LineString.size())
-    return LineString.at(Column);
-
-  return "";
+  return getCell(Line,Column).to_string();
 }
 
 
@@ -300,11 +436,11 @@ std::string ColumnTextParser::getValue(unsigned int Line, unsigned int Column) c
 bool ColumnTextParser::getStringValue(unsigned int Line, unsigned int Column,
                                       std::string *Value) const
 {
-  std::string StrValue = getValue(Line,Column);
+  const boost::string_ref* Cell = cell(Line,Column);
 
-  if (StrValue.length() == 0) return false;
+  if (!Cell || Cell->empty()) return false;
 
-  *Value = StrValue;
+  *Value = Cell->to_string();
 
   return true;
 
@@ -317,11 +453,11 @@ bool ColumnTextParser::getStringValue(unsigned int Line, unsigned int Column,
 
 bool ColumnTextParser::getLongValue(unsigned int Line, unsigned int Column, long* Value) const
 {
-  std::string StrValue = getValue(Line,Column);
+  const boost::string_ref* Cell = cell(Line,Column);
 
-  if (StrValue.length() != 0)
+  if (Cell && !Cell->empty())
   {
-    return openfluid::tools::convertString(StrValue,Value);
+    return convertCharsToLong(Cell->begin(),Cell->end(),Value);
   }
 
   return false;
@@ -334,12 +470,11 @@ bool ColumnTextParser::getLongValue(unsigned int Line, unsigned int Column, long
 
 bool ColumnTextParser::getDoubleValue(unsigned int Line, unsigned int Column, double* Value) const
 {
+  const boost::string_ref* Cell = cell(Line,Column);
 
-  std::string StrValue = getValue(Line,Column);
-
-  if (StrValue.length() != 0)
+  if (Cell && !Cell->empty())
   {
-    return openfluid::tools::convertString(StrValue,Value);
+    return openfluid::tools::convertCharsToDouble(Cell->begin(),Cell->end(),Value);
   }
 
   return false;
@@ -350,6 +485,62 @@ bool ColumnTextParser::getDoubleValue(unsigned int Line, unsigned int Column, do
 // =====================================================================
 
 
+bool ColumnTextParser::getDoubleColumn(unsigned int Column, std::vector<double>& Values) const
+{
+  Values.clear();
+
+  if (Column >= m_ColsCount)
+    return false;
+
+  Values.resize(m_LinesCount);
+
+  for (unsigned int i=0;i<m_LinesCount;i++)
+  {
+    const boost::string_ref& Cell = m_Cells[std::size_t(i)*m_ColsCount+Column];
+
+    if (!openfluid::tools::convertCharsToDouble(Cell.begin(),Cell.end(),&Values[i]))
+    {
+      Values.clear();
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool ColumnTextParser::getLongColumn(unsigned int Column, std::vector<long>& Values) const
+{
+  Values.clear();
+
+  if (Column >= m_ColsCount)
+    return false;
+
+  Values.resize(m_LinesCount);
+
+  for (unsigned int i=0;i<m_LinesCount;i++)
+  {
+    const boost::string_ref& Cell = m_Cells[std::size_t(i)*m_ColsCount+Column];
+
+    if (!convertCharsToLong(Cell.begin(),Cell.end(),&Values[i]))
+    {
+      Values.clear();
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 void ColumnTextParser::streamContents(std::ostream& OStream) const
 {
   unsigned int i,j;
@@ -359,7 +550,7 @@ void ColumnTextParser::streamContents(std::ostream& OStream) const
   {
     for (j=0;j<m_ColsCount;j++)
     {
-      OStream << getValue(i,j) << "\t";
+      OStream << getCell(i,j) << "\t";
 
     }
     OStream << "\n";
@@ -369,4 +560,3 @@ void ColumnTextParser::streamContents(std::ostream& OStream) const
 
 
 } }
-
@@ -42,15 +42,24 @@
 
 
 #include <vector>
+#include <deque>
 #include <string>
 
+#include <boost/utility/string_ref.hpp>
+
 #include <openfluid/dllexport.hpp>
 
+
+class QFile;
+
+
 namespace openfluid { namespace tools {
 
 
 /**
-  Class for column file management and handling
+  Class for column file management and handling.
+  Files are mapped in memory and tokenized in a single pass, cells are kept as references
+  to the mapped contents. Only quoted or escaped cells are copied to be unescaped.
 */
 class OPENFLUID_API ColumnTextParser
 {
@@ -65,17 +74,32 @@ class OPENFLUID_API ColumnTextParser
     unsigned int m_LinesCount;
     unsigned int m_ColsCount;
 
-    std::vector<std::vector<std::string> > m_Contents;
+    bool m_IsDelimiter[256];
+
+    QFile* mp_MappedFile;
+
+    std::string m_OwnedContents;
 
-    std::vector<std::string> tokenizeLine(const std::string& Line);
+    std::deque<std::string> m_UnescapedCells;
 
-    std::vector<std::string> tokenizeString(const std::string& String);
+    std::vector<boost::string_ref> m_Cells;
 
-    bool checkContents();
+    void clear();
 
-    bool isCommentLineStr(const std::string& LineStr);
+    bool tokenizeRange(const char* Begin, const char* End, unsigned int& CellsCount);
 
-    bool isEmptyLineStr(const std::string& LineStr);
+    bool parseLines(const char* Begin, const char* End);
+
+    bool isCommentLine(const char* Begin, const char* End) const;
+
+    bool isEmptyLine(const char* Begin, const char* End) const;
+
+    inline const boost::string_ref* cell(unsigned int Line, unsigned int Column) const
+    {
+      if (Line < m_LinesCount && Column < m_ColsCount)
+        return &m_Cells[std::size_t(Line)*m_ColsCount+Column];
+      return nullptr;
+    }
 
 
   public:
@@ -85,6 +109,10 @@ class OPENFLUID_API ColumnTextParser
     */
     ColumnTextParser(const std::string& CommentLineSymbol = "", const std::string& Delimiter = " \t\r\n");
 
+    ColumnTextParser(const ColumnTextParser&) = delete;
+
+    ColumnTextParser& operator=(const ColumnTextParser&) = delete;
+
     /**
       Destructor
     */
@@ -99,7 +127,8 @@ class OPENFLUID_API ColumnTextParser
     bool loadFromFile(const std::string& Filename);
 
     /**
-      Parses a one-line delimiter-separated string to set contents
+      Parses a one-line delimiter-separated string to set contents.
+      The string is copied and kept by the parser
       ex: "147.2 18 15 25 36 51.3 25.1 15", for 4 columns
       @param[in] Contents the string to parse
       @param[in] ColumnsNbr the number of columns (for splitting the sting into lines)
@@ -143,6 +172,31 @@ class OPENFLUID_API ColumnTextParser
     */
     bool getDoubleValue(unsigned int Line, unsigned int Column, double* Value) const;
 
+    /**
+      Returns the value at a specified row-column, as a reference to the parsed contents.
+      The reference remains valid until the parser is destroyed or loads other contents
+      @param[in] Line the line number of the value (first line is 0)
+      @param[in] Column the column number of the value (first column is 0)
+      @return the requested value, empty if it does not exist
+    */
+    boost::string_ref getCell(unsigned int Line, unsigned int Column) const;
+
+    /**
+      Converts all values of a column to double precision floats
+      @param[in] Column the column number (first column is 0)
+      @param[out] Values the converted values, one per line
+      @return true if the column exists and all its values have been converted
+    */
+    bool getDoubleColumn(unsigned int Column, std::vector<double>& Values) const;
+
+    /**
+      Converts all values of a column to long ints
+      @param[in] Column the column number (first column is 0)
+      @param[out] Values the converted values, one per line
+      @return true if the column exists and all its values have been converted
+    */
+    bool getLongColumn(unsigned int Column, std::vector<long>& Values) const;
+
     /**
       Returns the values at a specified line
       @param[in] Line the line number of the value (first line is 0)
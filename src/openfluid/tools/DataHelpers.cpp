@@ -71,6 +71,105 @@ void tokenizeString(const std::string& StrToTokenize,
 // =====================================================================
 
 
+bool convertCharsToDouble(const char* Begin, const char* End, double* Converted)
+{
+  // exact powers of ten as doubles
+  static const double Pow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+  const char* Current = Begin;
+  bool IsNegative = false;
+  unsigned long long Mantissa = 0;
+  int SignificantDigits = 0;
+  int Exponent = 0;
+  bool HasDigits = false;
+  bool IsFastPath = true;
+
+  if (Current != End && (*Current == '-' || *Current == '+'))
+  {
+    IsNegative = (*Current == '-');
+    ++Current;
+  }
+
+  // integral part
+  while (Current != End && *Current >= '0' && *Current <= '9')
+  {
+    HasDigits = true;
+    if (Mantissa || *Current != '0')
+    {
+      Mantissa = Mantissa*10 + (*Current - '0');
+      SignificantDigits++;
+    }
+    ++Current;
+  }
+
+  // fractional part
+  if (Current != End && *Current == '.')
+  {
+    ++Current;
+    while (Current != End && *Current >= '0' && *Current <= '9')
+    {
+      HasDigits = true;
+      if (Mantissa || *Current != '0')
+      {
+        Mantissa = Mantissa*10 + (*Current - '0');
+        SignificantDigits++;
+      }
+      Exponent--;
+      ++Current;
+    }
+  }
+
+  // exponent part
+  if (HasDigits && Current != End && (*Current == 'e' || *Current == 'E'))
+  {
+    ++Current;
+    bool IsNegativeExp = false;
+    int ExpValue = 0;
+    bool HasExpDigits = false;
+
+    if (Current != End && (*Current == '-' || *Current == '+'))
+    {
+      IsNegativeExp = (*Current == '-');
+      ++Current;
+    }
+
+    while (Current != End && *Current >= '0' && *Current <= '9' && ExpValue < 10000)
+    {
+      HasExpDigits = true;
+      ExpValue = ExpValue*10 + (*Current - '0');
+      ++Current;
+    }
+
+    IsFastPath = HasExpDigits;
+    Exponent += (IsNegativeExp ? -ExpValue : ExpValue);
+  }
+
+  // the fast path is exact and correctly rounded when both the mantissa and the power of ten
+  // are exactly representable as doubles
+  IsFastPath = IsFastPath && HasDigits && Current == End &&
+               SignificantDigits <= 15 && Exponent >= -22 && Exponent <= 22;
+
+  if (!IsFastPath)
+    return convertString(std::string(Begin,End),Converted);
+
+  double Value = double(Mantissa);
+
+  if (Exponent >= 0)
+    Value *= Pow10[Exponent];
+  else
+    Value /= Pow10[-Exponent];
+
+  *Converted = (IsNegative ? -Value : Value);
+
+  return true;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 std::vector<std::string> splitString(const std::string& StrToSplit,
                                      const std::string& Separators,
                                      bool ReturnsEmpty)
@@ -98,6 +98,23 @@ inline T convertString(const std::string& StrToConvert)
 // =====================================================================
 
 
+/**
+  Converts a range of characters to a double precision floating point value.
+  Plain decimal values with at most 15 significant digits are converted in place without memory allocation,
+  other values are converted using openfluid::tools::convertString()
+  @param[in] Begin pointer to the first character to convert
+  @param[in] End pointer after the last character to convert
+  @param[out] Converted the result of the conversion
+  @return true if the conversion is correct
+*/
+bool OPENFLUID_API convertCharsToDouble(const char* Begin, const char* End, double* Converted);
+
+
+// =====================================================================
+// =====================================================================
+
+
+
 /**
   @deprecated Since version 2.1.0. Use openfluid::tools::convertString instead
 */
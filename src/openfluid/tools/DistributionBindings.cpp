@@ -45,24 +45,32 @@ namespace openfluid { namespace tools {
 
 DistributionBindings::DistributionBindings(const DistributionTables& DistriTables)
 {
-  DistributionTables::SourceIDFile_t::const_iterator itb = DistriTables.SourcesTable.begin();
-  DistributionTables::SourceIDFile_t::const_iterator ite = DistriTables.SourcesTable.end();
+  // sources are indexed in a single pass, then each unit is bound through this index
 
-  for (DistributionTables::SourceIDFile_t::const_iterator it = itb; it != ite; ++it)
+  std::map<std::string,int> SourcesIndexes;
+
+  for (auto& Source : DistriTables.SourcesTable)
   {
-    ReaderNextValue RNV;
-    RNV.Reader = new ProgressiveChronFileReader((*it).second);
-    m_ReadersNextValues.push_back(RNV);
+    SourcesIndexes[Source.first] = m_SourcesReader.addFile(Source.second);
+  }
 
-    DistributionTables::UnitIDSourceID_t::const_iterator itub = DistriTables.UnitsTable.begin();
-    DistributionTables::UnitIDSourceID_t::const_iterator itue = DistriTables.UnitsTable.end();
+  m_ReadersNextValues.resize(m_SourcesReader.getFilesCount());
 
-    for (DistributionTables::UnitIDSourceID_t::const_iterator itu = itub; itu != itue; ++itu)
-    {
-      if ((*itu).second == (*it).first)
-        m_UnitIDReaders[(*itu).first] = &m_ReadersNextValues.back();
-    }
+  m_CurrentValues.resize(m_ReadersNextValues.size(),0.0);
+  m_IsCurrentValue.resize(m_ReadersNextValues.size(),false);
+
+  m_UnitIDSources.reserve(DistriTables.UnitsTable.size());
+
+  for (auto& Unit : DistriTables.UnitsTable)
+  {
+    std::map<std::string,int>::const_iterator it = SourcesIndexes.find(Unit.second);
+
+    if (it != SourcesIndexes.end())
+      m_UnitIDSources[Unit.first] = (*it).second;
   }
+
+  // reading of sources starts while the simulation is being prepared
+  m_SourcesReader.start();
 }
 
 
@@ -72,16 +80,7 @@ DistributionBindings::DistributionBindings(const DistributionTables& DistriTable
 
 DistributionBindings::~DistributionBindings()
 {
-  // delete readers
-
-  ReadersNextValues_t::iterator it;
-  ReadersNextValues_t::iterator bit = m_ReadersNextValues.begin();
-  ReadersNextValues_t::iterator eit = m_ReadersNextValues.end();
 
-  for (it=bit;it!=eit;++it)
-  {
-    if ((*it).Reader) delete (*it).Reader;
-  }
 }
 
 
@@ -92,11 +91,13 @@ DistributionBindings::~DistributionBindings()
 void DistributionBindings::advanceToTime(const openfluid::core::DateTime& DT)
 {
   // set readers position to the first value equal or greater for each reader
+  // and updates the current values of all sources at once
   ReadersNextValues_t::iterator itb = m_ReadersNextValues.begin();
   ReadersNextValues_t::iterator ite = m_ReadersNextValues.end();
 
   for (ReadersNextValues_t::iterator it = itb; it != ite; ++it)
   {
+    const unsigned int Index = it-itb;
     bool DataFound = true;
     openfluid::tools::ChronItem_t CI;
 
@@ -107,7 +108,7 @@ void DistributionBindings::advanceToTime(const openfluid::core::DateTime& DT)
 
       while (DataFound && !(*it).isAvailable)
       {
-        DataFound = (*it).Reader->getNextValue(CI);
+        DataFound = m_SourcesReader.getNextValue(Index,CI);
         if (DataFound && CI.first >= DT)
         {
           (*it).isAvailable = true;
@@ -115,6 +116,9 @@ void DistributionBindings::advanceToTime(const openfluid::core::DateTime& DT)
         }
       }
     }
+
+    m_IsCurrentValue[Index] = ((*it).isAvailable && (*it).NextValue.first == DT);
+    m_CurrentValues[Index] = (*it).NextValue.second;
   }
 }
 
@@ -176,11 +180,11 @@ bool DistributionBindings::getValue(const openfluid::core::UnitID_t& UnitID,
 {
   // if a value is available for DT : passes the value to caller, and returns true
   // else returns false
-  UnitIDReader_t::iterator it = m_UnitIDReaders.find(UnitID);
+  const int Index = getSourceIndex(UnitID);
 
-  if (it != m_UnitIDReaders.end() && (*it).second->isAvailable && (*it).second->NextValue.first == DT)
+  if (Index >= 0 && m_ReadersNextValues[Index].isAvailable && m_ReadersNextValues[Index].NextValue.first == DT)
   {
-    Value = (*it).second->NextValue.second;
+    Value = m_ReadersNextValues[Index].NextValue.second;
     return true;
   }
 
@@ -195,12 +199,12 @@ bool DistributionBindings::getValue(const openfluid::core::UnitID_t& UnitID,
 
 void DistributionBindings::displayBindings()
 {
-  UnitIDReader_t::iterator itb = m_UnitIDReaders.begin();
-  UnitIDReader_t::iterator ite = m_UnitIDReaders.end();
+  // displayed ordered by unit ID
+  std::map<openfluid::core::UnitID_t,int> OrderedUnits(m_UnitIDSources.begin(),m_UnitIDSources.end());
 
-  for (UnitIDReader_t::iterator it = itb; it != ite; ++it)
+  for (auto& Unit : OrderedUnits)
   {
-    std::cout << (*it).first << " -> " << (*it).second->Reader->getFileName() << std::endl;
+    std::cout << Unit.first << " -> " << m_SourcesReader.getFileName(Unit.second) << std::endl;
   }
 
 
@@ -40,8 +40,11 @@
 #ifndef __OPENFLUID_TOOLS_DISTRIBUTIONBINDINGS_HPP__
 #define __OPENFLUID_TOOLS_DISTRIBUTIONBINDINGS_HPP__
 
+#include <vector>
+#include <unordered_map>
+
 #include <openfluid/tools/DistributionTables.hpp>
-#include <openfluid/tools/ProgressiveChronFileReader.hpp>
+#include <openfluid/tools/PrefetchingChronFilesReader.hpp>
 #include <openfluid/dllexport.hpp>
 
 
@@ -52,13 +55,11 @@ class ReaderNextValue
 {
   public:
 
-    ProgressiveChronFileReader* Reader;
-
     ChronItem_t NextValue;
 
     bool isAvailable;
 
-    ReaderNextValue(): Reader(NULL), isAvailable(false)
+    ReaderNextValue(): isAvailable(false)
     { }
 };
 
@@ -71,21 +72,41 @@ class OPENFLUID_API DistributionBindings
 {
   public:
 
-    typedef std::map<openfluid::core::UnitID_t,ReaderNextValue*> UnitIDReader_t;
+    typedef std::unordered_map<openfluid::core::UnitID_t,int> UnitIDSourceIndex_t;
 
-    typedef std::list<ReaderNextValue> ReadersNextValues_t;
+    typedef std::vector<ReaderNextValue> ReadersNextValues_t;
 
 
   private:
 
-    UnitIDReader_t m_UnitIDReaders;
+    UnitIDSourceIndex_t m_UnitIDSources;
+
+    /**
+      Reader of the sources files, values are read ahead on a background thread
+    */
+    PrefetchingChronFilesReader m_SourcesReader;
 
     ReadersNextValues_t m_ReadersNextValues;
 
+    /**
+      Values of the sources at the time of the last call to advanceToTime(), stored contiguously
+    */
+    std::vector<double> m_CurrentValues;
+
+    /**
+      Flags set for the sources having a value exactly at the time of the last call to advanceToTime()
+    */
+    std::vector<char> m_IsCurrentValue;
+
+
   public:
 
     DistributionBindings(const DistributionTables& DistriTables);
 
+    DistributionBindings(const DistributionBindings&) = delete;
+
+    DistributionBindings& operator=(const DistributionBindings&) = delete;
+
     ~DistributionBindings();
 
     void advanceToTime(const openfluid::core::DateTime& DT);
@@ -96,6 +117,32 @@ class OPENFLUID_API DistributionBindings
                   const openfluid::core::DateTime& DT,
                   openfluid::core::DoubleValue& Value);
 
+    /**
+      Returns the index of the source bound to a unit
+      @param[in] UnitID the ID of the unit
+      @return the index of the source, -1 if the unit is not bound to any source
+    */
+    inline int getSourceIndex(const openfluid::core::UnitID_t& UnitID) const
+    {
+      UnitIDSourceIndex_t::const_iterator it = m_UnitIDSources.find(UnitID);
+      return (it != m_UnitIDSources.end() ? (*it).second : -1);
+    }
+
+    /**
+      Gets the value of a source at the time given to the last call to advanceToTime()
+      @param[in] SourceIndex the index of the source, as returned by getSourceIndex()
+      @param[out] Value the value of the source if available
+      @return true if the source has a value at this time, false otherwise
+    */
+    inline bool getCurrentValue(int SourceIndex, openfluid::core::DoubleValue& Value) const
+    {
+      if (SourceIndex < 0 || !m_IsCurrentValue[SourceIndex])
+        return false;
+
+      Value = m_CurrentValues[SourceIndex];
+      return true;
+    }
+
     void displayBindings();
 
 };
@@ -36,8 +36,14 @@
   @author Jean-Christophe FABRE <jean-christophe.fabre@supagro.inra.fr>
 */
 
-#include <QMutex>
-#include <QMutexLocker>
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include <openfluid/tools/FileLogger.hpp>
 
@@ -45,11 +51,274 @@
 namespace openfluid { namespace tools {
 
 
+class FileLogger::PrivateImpl
+{
+  public:
+
+    /**
+      Pending messages of a single thread.
+      The mutex is only shared with the writer thread when draining, it is never contended by other threads.
+    */
+    class ThreadBuffer
+    {
+      public:
+
+        std::mutex Mutex;
+
+        std::string Data;
+
+        std::unordered_map<std::string,unsigned int> Repeats;
+    };
+
+    typedef std::unordered_map<unsigned long long,std::shared_ptr<ThreadBuffer>> ThreadBuffersMap_t;
+
+    static const std::size_t BufferCapacity = 64*1024;
+
+    static const std::size_t MaxTrackedMessages = 1024;
+
+    static std::atomic<unsigned long long> LoggersCounter;
+
+    const unsigned long long m_ID;
+
+    std::ofstream m_LogFile;
+
+    std::mutex m_FileMutex;
+
+    std::mutex m_BuffersMutex;
+
+    std::vector<std::shared_ptr<ThreadBuffer>> m_Buffers;
+
+    std::thread m_Writer;
+
+    std::mutex m_WriterMutex;
+
+    std::condition_variable m_WriterCondition;
+
+    std::condition_variable m_DrainedCondition;
+
+    bool m_WriterRunning;
+
+    bool m_DrainRequested;
+
+    std::atomic<unsigned int> m_InfosCount;
+
+    std::atomic<unsigned int> m_WarningsCount;
+
+    std::atomic<bool> m_IsError;
+
+    std::atomic<unsigned int> m_EnabledTypes;
+
+    std::atomic<unsigned int> m_RepeatsLimit;
+
+
+    PrivateImpl() :
+      m_ID(++LoggersCounter), m_WriterRunning(false), m_DrainRequested(false),
+      m_InfosCount(0), m_WarningsCount(0), m_IsError(false), m_EnabledTypes(~0u), m_RepeatsLimit(0)
+    { }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    ThreadBuffer& threadBuffer()
+    {
+      // buffers are shared with the logger, they stay valid for the thread after the logger is destroyed
+      thread_local ThreadBuffersMap_t ThreadBuffers;
+
+      std::shared_ptr<ThreadBuffer>& Buffer = ThreadBuffers[m_ID];
+
+      if (!Buffer)
+      {
+        // buffers of destroyed loggers are only referenced by the thread
+        for (ThreadBuffersMap_t::iterator It = ThreadBuffers.begin(); It != ThreadBuffers.end();)
+        {
+          if (It->second && It->second.use_count() == 1)
+            It = ThreadBuffers.erase(It);
+          else
+            ++It;
+        }
+
+        Buffer = std::make_shared<ThreadBuffer>();
+
+        std::lock_guard<std::mutex> Lock(m_BuffersMutex);
+        m_Buffers.push_back(Buffer);
+      }
+
+      return *Buffer;
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    static void appendSuppressed(ThreadBuffer& Buffer, unsigned int Limit)
+    {
+      for (auto& Repeat : Buffer.Repeats)
+      {
+        if (Limit && Repeat.second > Limit)
+        {
+          Buffer.Data += Repeat.first;
+          Buffer.Data += " (";
+          Buffer.Data += std::to_string(Repeat.second-Limit);
+          Buffer.Data += " identical messages suppressed)\n";
+        }
+      }
+
+      Buffer.Repeats.clear();
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    /**
+      Writes the pending messages of all threads into the file
+      @param[in] Final if true, the suppressed messages are reported and the repeats counts are reset
+    */
+    void drain(bool Final)
+    {
+      std::lock_guard<std::mutex> FileLock(m_FileMutex);
+
+      std::vector<std::shared_ptr<ThreadBuffer>> Buffers;
+
+      {
+        std::lock_guard<std::mutex> Lock(m_BuffersMutex);
+        Buffers = m_Buffers;
+      }
+
+      std::string Data;
+
+      for (auto& Buffer : Buffers)
+      {
+        {
+          std::lock_guard<std::mutex> Lock(Buffer->Mutex);
+
+          if (Final)
+            appendSuppressed(*Buffer,m_RepeatsLimit);
+
+          // the emptied string keeps its capacity for the next messages of the thread
+          Data.swap(Buffer->Data);
+        }
+
+        if (!Data.empty())
+        {
+          m_LogFile << Data;
+          Data.clear();
+        }
+      }
+
+      m_LogFile.flush();
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    void runWriter()
+    {
+      std::unique_lock<std::mutex> Lock(m_WriterMutex);
+
+      while (m_WriterRunning)
+      {
+        m_WriterCondition.wait_for(Lock,std::chrono::milliseconds(100),
+                                   [this](){ return m_DrainRequested || !m_WriterRunning; });
+        m_DrainRequested = false;
+
+        Lock.unlock();
+        drain(false);
+        Lock.lock();
+
+        m_DrainedCondition.notify_all();
+      }
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    /**
+      Waits until the given buffer of the current thread has been drained by the writer thread,
+      or drains it directly if the writer is not running
+    */
+    void waitForDrain(ThreadBuffer& Buffer)
+    {
+      std::unique_lock<std::mutex> Lock(m_WriterMutex);
+
+      if (!m_WriterRunning)
+      {
+        Lock.unlock();
+        drain(false);
+        return;
+      }
+
+      m_DrainRequested = true;
+      m_WriterCondition.notify_one();
+
+      m_DrainedCondition.wait(Lock,[this,&Buffer]()
+      {
+        if (!m_WriterRunning)
+          return true;
+
+        std::lock_guard<std::mutex> BufferLock(Buffer.Mutex);
+        return Buffer.Data.size() < BufferCapacity;
+      });
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    void startWriter()
+    {
+      std::lock_guard<std::mutex> Lock(m_WriterMutex);
+
+      if (!m_WriterRunning)
+      {
+        m_WriterRunning = true;
+        m_Writer = std::thread(&PrivateImpl::runWriter,this);
+      }
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    void stopWriter()
+    {
+      {
+        std::lock_guard<std::mutex> Lock(m_WriterMutex);
+
+        if (!m_WriterRunning)
+          return;
+
+        m_WriterRunning = false;
+        m_WriterCondition.notify_all();
+        m_DrainedCondition.notify_all();
+      }
+
+      m_Writer.join();
+    }
+};
+
+
+std::atomic<unsigned long long> FileLogger::PrivateImpl::LoggersCounter(0);
+
+
+// =====================================================================
+// =====================================================================
+
 
 FileLogger::FileLogger() :
-    m_InfosCount(0), m_WarningsCount(0), m_IsError(false)
+    m_PImpl(new PrivateImpl())
 {
-  mp_LogMutex = new QMutex;
+
 }
 
 
@@ -60,7 +329,7 @@ FileLogger::FileLogger() :
 FileLogger::~FileLogger()
 {
   close();
-  delete mp_LogMutex;
+  delete m_PImpl;
 }
 
 
@@ -91,7 +360,12 @@ std::string FileLogger::logTypeToString(LogType LType)
 
 void FileLogger::init(const std::string& FilePath)
 {
-  m_LogFile.open(FilePath.c_str(),std::ios::out);
+  {
+    std::lock_guard<std::mutex> Lock(m_PImpl->m_FileMutex);
+    m_PImpl->m_LogFile.open(FilePath.c_str(),std::ios::out);
+  }
+
+  m_PImpl->startWriter();
 }
 
 
@@ -101,8 +375,13 @@ void FileLogger::init(const std::string& FilePath)
 
 void FileLogger::close()
 {
-  if (m_LogFile.is_open())
-    m_LogFile.close();
+  m_PImpl->stopWriter();
+  m_PImpl->drain(true);
+
+  std::lock_guard<std::mutex> Lock(m_PImpl->m_FileMutex);
+
+  if (m_PImpl->m_LogFile.is_open())
+    m_PImpl->m_LogFile.close();
 }
 
 
@@ -110,20 +389,134 @@ void FileLogger::close()
 // =====================================================================
 
 
-void FileLogger::add(LogType LType, const std::string& Sender, const std::string& Msg)
+void FileLogger::flush()
 {
-  QMutexLocker Locker(mp_LogMutex);
+  m_PImpl->drain(false);
+}
 
-  std::string LTypeStr = logTypeToString(LType);
+
+// =====================================================================
+// =====================================================================
+
+
+void FileLogger::add(LogType LType, const std::string& Sender, const std::string& Msg)
+{
+  if (!isLogTypeEnabled(LType))
+    return;
 
   if (LType == LOG_INFO)
-    m_InfosCount++;
+    m_PImpl->m_InfosCount++;
   else  if (LType == LOG_WARNING)
-    m_WarningsCount++;
+    m_PImpl->m_WarningsCount++;
   else if (LType == LOG_ERROR)
-    m_IsError = true;
+    m_PImpl->m_IsError = true;
+
+
+  std::string Line;
+  Line.reserve(Sender.size()+Msg.size()+16);
+  Line += "[";
+  Line += logTypeToString(LType);
+  Line += "][";
+  Line += Sender;
+  Line += "] ";
+  Line += Msg;
+
+  PrivateImpl::ThreadBuffer& Buffer = m_PImpl->threadBuffer();
+  const unsigned int Limit = m_PImpl->m_RepeatsLimit;
+
+  {
+    std::lock_guard<std::mutex> Lock(Buffer.Mutex);
+
+    if (Limit)
+    {
+      if (Buffer.Repeats.size() >= PrivateImpl::MaxTrackedMessages && Buffer.Repeats.find(Line) == Buffer.Repeats.end())
+        PrivateImpl::appendSuppressed(Buffer,Limit);
+
+      if (++Buffer.Repeats[Line] > Limit)
+        return;
+    }
+
+    Buffer.Data += Line;
+    Buffer.Data += "\n";
+
+    if (Buffer.Data.size() < PrivateImpl::BufferCapacity)
+      return;
+  }
+
+  m_PImpl->waitForDrain(Buffer);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool FileLogger::isLogTypeEnabled(LogType LType) const
+{
+  return m_PImpl->m_EnabledTypes & (1u << LType);
+}
+
+
+// =====================================================================
+// =====================================================================
+
 
-  m_LogFile << "[" << LTypeStr << "]" << "[" << Sender << "] " << Msg << "\n";
+void FileLogger::setLogTypeEnabled(LogType LType, bool Enabled)
+{
+  if (Enabled)
+    m_PImpl->m_EnabledTypes |= (1u << LType);
+  else
+    m_PImpl->m_EnabledTypes &= ~(1u << LType);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void FileLogger::setRepeatedMessagesLimit(unsigned int Limit)
+{
+  m_PImpl->m_RepeatsLimit = Limit;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+unsigned int FileLogger::getRepeatedMessagesLimit() const
+{
+  return m_PImpl->m_RepeatsLimit;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+unsigned int FileLogger::getInfosCount() const
+{
+  return m_PImpl->m_InfosCount;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool FileLogger::isError() const
+{
+  return m_PImpl->m_IsError;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+unsigned int FileLogger::getWarningsCount() const
+{
+  return m_PImpl->m_WarningsCount;
 }
 
 
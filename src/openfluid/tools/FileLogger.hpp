@@ -41,33 +41,39 @@
 #define __OPENFLUID_TOOLS_FILELOGGER_HPP__
 
 #include <fstream>
-#include <openfluid/dllexport.hpp>
+#include <string>
 
-class QMutex;
+#include <openfluid/dllexport.hpp>
 
 
 namespace openfluid { namespace tools {
 
 
+/**
+  Logger writing messages to a file.
+  Messages are formatted into a buffer owned by the calling thread, so that threads logging concurrently
+  do not wait for each other. Buffers are drained into the file by a background writer thread.
+  A thread whose buffer is full waits until the writer has drained it, which bounds the memory used by pending
+  messages. Messages of a same thread are written in order, but messages of different threads are not
+  interleaved in the order they were added: the buffers are written one after the other.
+  Identical messages repeated by a thread beyond a limit, if set, are suppressed and reported once
+  at closing, as "N identical messages suppressed". Messages of disabled types are discarded before any formatting.
+*/
 class OPENFLUID_API FileLogger
 {
-  private:
-
-    QMutex* mp_LogMutex;
+  public:
 
-    std::ofstream m_LogFile;
+    enum LogType {LOG_INFO, LOG_WARNING, LOG_ERROR, LOG_DEBUG };
 
-    unsigned int m_InfosCount;
 
-    unsigned int m_WarningsCount;
+  private:
 
-    bool m_IsError;
+    class PrivateImpl;
+    PrivateImpl* m_PImpl;
 
 
   public:
 
-    enum LogType {LOG_INFO, LOG_WARNING, LOG_ERROR, LOG_DEBUG };
-
     FileLogger();
 
     ~FileLogger();
@@ -77,18 +83,43 @@ class OPENFLUID_API FileLogger
 
     void init(const std::string& FilePath);
 
+    /**
+      Writes all pending messages, stops the writer thread and closes the log file
+    */
     void close();
 
+    /**
+      Writes all pending messages of all threads into the log file
+    */
+    void flush();
+
     void add(LogType LType, const std::string& Context, const std::string& Msg);
 
-    unsigned int getInfosCount() const
-    { return m_InfosCount; }
+    /**
+      Returns true if messages of the given type are logged, false if they are discarded
+    */
+    bool isLogTypeEnabled(LogType LType) const;
+
+    /**
+      Enables or disables logging of messages of the given type. All types are enabled by default.
+      Discarded messages are not counted.
+    */
+    void setLogTypeEnabled(LogType LType, bool Enabled);
+
+    /**
+      Sets the number of times an identical message can be written by a thread
+      before further occurrences are suppressed. Suppressed messages are still counted.
+      @param[in] Limit the maximum number of identical messages, 0 for no limit (default is 0)
+    */
+    void setRepeatedMessagesLimit(unsigned int Limit);
+
+    unsigned int getRepeatedMessagesLimit() const;
+
+    unsigned int getInfosCount() const;
 
-    bool isError() const
-    { return m_IsError; }
+    bool isError() const;
 
-    unsigned int getWarningsCount() const
-    { return m_WarningsCount; }
+    unsigned int getWarningsCount() const;
 
 };
 
@@ -0,0 +1,383 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+/**
+  @file PrefetchingChronFilesReader.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@supagro.inra.fr>
+*/
+
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <openfluid/tools/PrefetchingChronFilesReader.hpp>
+#include <openfluid/tools/ProgressiveChronFileReader.hpp>
+#include <openfluid/base/FrameworkException.hpp>
+
+
+namespace openfluid { namespace tools {
+
+
+class PrefetchingChronFilesReader::PrivateImpl
+{
+  public:
+
+    /**
+      Read-ahead state of a single file.
+      The ring buffer is written by the I/O thread only and read by the consumer only,
+      positions are ever-increasing counters of written and read values.
+    */
+    class Source
+    {
+      public:
+
+        std::unique_ptr<ProgressiveChronFileReader> Reader;
+
+        std::vector<ChronItem_t> Buffer;
+
+        std::atomic<unsigned long long> WrittenCount;
+
+        std::atomic<unsigned long long> ReadCount;
+
+        std::atomic<bool> EndReached;
+
+        std::atomic<bool> RefillRequested;
+
+        /**
+          Error raised while reading the file, set before the end is flagged
+        */
+        std::exception_ptr Error;
+
+        Source(ProgressiveChronFileReader* R, unsigned int WindowSize) :
+          Reader(R), Buffer(WindowSize), WrittenCount(0), ReadCount(0), EndReached(false), RefillRequested(false)
+        { }
+    };
+
+
+    const unsigned int m_WindowSize;
+
+    std::vector<std::unique_ptr<Source>> m_Sources;
+
+    std::thread m_IOThread;
+
+    bool m_Started;
+
+    bool m_Stop;
+
+    bool m_WorkRequested;
+
+    std::mutex m_Mutex;
+
+    std::condition_variable m_WorkCondition;
+
+    std::condition_variable m_DataCondition;
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    PrivateImpl(unsigned int WindowSize) :
+      m_WindowSize(WindowSize < 2 ? 2 : WindowSize), m_Started(false), m_Stop(false), m_WorkRequested(true)
+    { }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    /**
+      Fills the ring buffer of a source if it is at least half empty
+      @return true if the source has been filled, false otherwise
+    */
+    bool fill(Source& S)
+    {
+      if (S.EndReached.load(std::memory_order_relaxed))
+        return false;
+
+      unsigned long long Written = S.WrittenCount.load(std::memory_order_relaxed);
+
+      if (Written-S.ReadCount.load(std::memory_order_acquire) > m_WindowSize/2)
+        return false;
+
+      S.RefillRequested.store(false);
+
+      while (Written-S.ReadCount.load(std::memory_order_acquire) < m_WindowSize)
+      {
+        bool Found = false;
+
+        try
+        {
+          Found = S.Reader->getNextValue(S.Buffer[Written % m_WindowSize]);
+        }
+        catch (...)
+        {
+          S.Error = std::current_exception();
+        }
+
+        if (!Found)
+        {
+          S.EndReached.store(true,std::memory_order_release);
+          break;
+        }
+
+        Written++;
+        S.WrittenCount.store(Written,std::memory_order_release);
+      }
+
+      return true;
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    void runIO()
+    {
+      while (true)
+      {
+        {
+          std::unique_lock<std::mutex> Lock(m_Mutex);
+
+          m_WorkCondition.wait(Lock,[this](){ return m_Stop || m_WorkRequested; });
+
+          if (m_Stop)
+            return;
+
+          m_WorkRequested = false;
+        }
+
+        // sources are filled until all of them are more than half full or at their end
+        bool Filled = true;
+
+        while (Filled)
+        {
+          Filled = false;
+
+          for (auto& S : m_Sources)
+          {
+            if (fill(*S))
+            {
+              Filled = true;
+
+              // the lock ensures that a consumer checking for values before waiting is notified
+              { std::lock_guard<std::mutex> Lock(m_Mutex); }
+              m_DataCondition.notify_all();
+            }
+          }
+        }
+      }
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    void requestWork()
+    {
+      {
+        std::lock_guard<std::mutex> Lock(m_Mutex);
+        m_WorkRequested = true;
+      }
+      m_WorkCondition.notify_one();
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    void start()
+    {
+      if (m_Started)
+        return;
+
+      m_Started = true;
+
+      if (!m_Sources.empty())
+        m_IOThread = std::thread(&PrivateImpl::runIO,this);
+    }
+
+
+    // =====================================================================
+    // =====================================================================
+
+
+    void stop()
+    {
+      if (!m_IOThread.joinable())
+        return;
+
+      {
+        std::lock_guard<std::mutex> Lock(m_Mutex);
+        m_Stop = true;
+      }
+      m_WorkCondition.notify_all();
+
+      m_IOThread.join();
+    }
+};
+
+
+// =====================================================================
+// =====================================================================
+
+
+PrefetchingChronFilesReader::PrefetchingChronFilesReader(unsigned int WindowSize) :
+  m_PImpl(new PrivateImpl(WindowSize))
+{
+
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+PrefetchingChronFilesReader::~PrefetchingChronFilesReader()
+{
+  m_PImpl->stop();
+  delete m_PImpl;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+unsigned int PrefetchingChronFilesReader::addFile(const std::string& FileName,
+                                                  const std::string& DateFormat,
+                                                  const std::string& ColSeparators)
+{
+  if (m_PImpl->m_Started)
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                              "Cannot add file " + FileName + " once read-ahead is started");
+
+  // the file is opened here to report opening errors to the caller
+  m_PImpl->m_Sources.emplace_back(
+    new PrivateImpl::Source(new ProgressiveChronFileReader(FileName,DateFormat,ColSeparators),
+                            m_PImpl->m_WindowSize));
+
+  return m_PImpl->m_Sources.size()-1;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void PrefetchingChronFilesReader::start()
+{
+  m_PImpl->start();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+unsigned int PrefetchingChronFilesReader::getFilesCount() const
+{
+  return m_PImpl->m_Sources.size();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::string PrefetchingChronFilesReader::getFileName(unsigned int Index) const
+{
+  return m_PImpl->m_Sources.at(Index)->Reader->getFileName();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool PrefetchingChronFilesReader::getNextValue(unsigned int Index, ChronItem_t& Value)
+{
+  m_PImpl->start();
+
+  PrivateImpl::Source& S = *(m_PImpl->m_Sources.at(Index));
+  const unsigned int WindowSize = m_PImpl->m_WindowSize;
+
+  const unsigned long long Read = S.ReadCount.load(std::memory_order_relaxed);
+  unsigned long long Written = S.WrittenCount.load(std::memory_order_acquire);
+
+  if (Read == Written)
+  {
+    // no value read ahead, waits for the I/O thread
+    if (!S.EndReached.load(std::memory_order_acquire))
+    {
+      m_PImpl->requestWork();
+
+      std::unique_lock<std::mutex> Lock(m_PImpl->m_Mutex);
+      m_PImpl->m_DataCondition.wait(Lock,[&S,Read]()
+      {
+        return S.WrittenCount.load(std::memory_order_acquire) != Read || S.EndReached.load(std::memory_order_acquire);
+      });
+    }
+
+    // values may have been written before the end of file was flagged
+    Written = S.WrittenCount.load(std::memory_order_acquire);
+
+    if (Read == Written)
+    {
+      if (S.Error)
+        std::rethrow_exception(S.Error);
+
+      return false;
+    }
+  }
+
+  Value = S.Buffer[Read % WindowSize];
+  S.ReadCount.store(Read+1,std::memory_order_release);
+
+  if (Written-Read-1 <= WindowSize/2 && !S.EndReached.load(std::memory_order_relaxed) &&
+      !S.RefillRequested.exchange(true))
+    m_PImpl->requestWork();
+
+  return true;
+}
+
+
+} } // namespaces
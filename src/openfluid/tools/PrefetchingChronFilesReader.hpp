@@ -0,0 +1,129 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+/**
+  @file PrefetchingChronFilesReader.hpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@supagro.inra.fr>
+*/
+
+
+#ifndef __OPENFLUID_TOOLS_PREFETCHINGCHRONFILESREADER_HPP__
+#define __OPENFLUID_TOOLS_PREFETCHINGCHRONFILESREADER_HPP__
+
+
+#include <string>
+
+#include <openfluid/tools/ChronologicalSerie.hpp>
+#include <openfluid/dllexport.hpp>
+
+
+namespace openfluid { namespace tools {
+
+
+/**
+  Reader of several chronological files, with read-ahead on a background thread.
+  Each file is read and parsed by a single I/O thread into a ring buffer of values, refilled as soon as
+  it is half empty. Values are then consumed from the buffers without waiting for the file reading,
+  unless the consumer is faster than the I/O thread.
+  Errors occurring while reading a file are reported when the value in error is requested.
+*/
+class OPENFLUID_API PrefetchingChronFilesReader
+{
+  private:
+
+    class PrivateImpl;
+    PrivateImpl* m_PImpl;
+
+
+  public:
+
+    /**
+      Constructor
+      @param[in] WindowSize the number of values read ahead for each file (minimum is 2)
+    */
+    PrefetchingChronFilesReader(unsigned int WindowSize = 64);
+
+    PrefetchingChronFilesReader(const PrefetchingChronFilesReader&) = delete;
+
+    PrefetchingChronFilesReader& operator=(const PrefetchingChronFilesReader&) = delete;
+
+    /**
+      Destructor, stops the I/O thread
+    */
+    ~PrefetchingChronFilesReader();
+
+    /**
+      Adds a file to read. Files must be added before the start of the read-ahead
+      @param[in] FileName the file to read
+      @param[in] DateFormat the format of the dates in the file
+      @param[in] ColSeparators the columns separators of the file
+      @return the index of the file
+      @throw openfluid::base::FrameworkException if the file cannot be opened or the read-ahead is already started
+    */
+    unsigned int addFile(const std::string& FileName,
+                         const std::string& DateFormat = "%Y-%m-%dT%H:%M:%S",
+                         const std::string& ColSeparators = " \t\r\n");
+
+    /**
+      Starts the read-ahead of all added files on the I/O thread
+    */
+    void start();
+
+    /**
+      Returns the number of added files
+    */
+    unsigned int getFilesCount() const;
+
+    /**
+      Returns the name of a file
+      @param[in] Index the index of the file
+    */
+    std::string getFileName(unsigned int Index) const;
+
+    /**
+      Gets the next value of a file, waiting for the I/O thread only if no value has been read ahead.
+      The read-ahead is started if it was not already.
+      @param[in] Index the index of the file
+      @param[out] Value the read value
+      @return true if a value has been read, false if the end of file is reached
+      @throw openfluid::base::FrameworkException if the date or the value is wrong
+    */
+    bool getNextValue(unsigned int Index, ChronItem_t& Value);
+
+};
+
+
+} } // namespaces
+
+
+#endif /* __OPENFLUID_TOOLS_PREFETCHINGCHRONFILESREADER_HPP__ */
@@ -50,7 +50,7 @@ namespace openfluid { namespace tools {
 ProgressiveChronFileReader::ProgressiveChronFileReader(const std::string& FileName,
                                                        const std::string& DateFormat,
                                                        const std::string& ColSeparators):
-  ProgressiveColumnFileReader(FileName,ColSeparators), m_DateFormat(DateFormat)
+  ProgressiveColumnFileReader(FileName,ColSeparators), m_DateParser(DateFormat)
 {
 
 }
@@ -62,18 +62,43 @@ ProgressiveChronFileReader::ProgressiveChronFileReader(const std::string& FileNa
 
 bool ProgressiveChronFileReader::getNextValue(ChronItem_t& Value)
 {
-  std::vector<std::string> Values;
-  openfluid::core::DateTime DT;
+  const char* LineBegin;
+  const char* LineEnd;
   double Val;
 
-  while (getNextLine(Values))
+  while (getNextLine(LineBegin,LineEnd))
   {
-    if (Values.size() == 2)
+    // in place tokenization of the line, only lines with exactly 2 columns are taken into account
+    const char* Tokens[2][2];
+    unsigned int TokensCount = 0;
+    const char* Current = LineBegin;
+
+    while (Current != LineEnd && TokensCount <= 2)
+    {
+      while (Current != LineEnd && isColSeparator(*Current))
+        ++Current;
+
+      if (Current != LineEnd)
+      {
+        const char* TokenBegin = Current;
+
+        while (Current != LineEnd && !isColSeparator(*Current))
+          ++Current;
+
+        if (TokensCount < 2)
+        {
+          Tokens[TokensCount][0] = TokenBegin;
+          Tokens[TokensCount][1] = Current;
+        }
+        TokensCount++;
+      }
+    }
+
+    if (TokensCount == 2)
     {
-      if (DT.setFromString(Values.front(),m_DateFormat) &&
-          openfluid::tools::convertString(Values.back(),&Val))
+      if (m_DateParser.parse(Tokens[0][0],Tokens[0][1],Value.first) &&
+          openfluid::tools::convertCharsToDouble(Tokens[1][0],Tokens[1][1],&Val))
       {
-        Value.first = DT;
         Value.second = Val;
         return true;
       }
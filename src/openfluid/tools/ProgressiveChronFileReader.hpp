@@ -43,6 +43,7 @@
 
 #include <openfluid/tools/ProgressiveColumnFileReader.hpp>
 #include <openfluid/tools/ChronologicalSerie.hpp>
+#include <openfluid/core/DateTimeParser.hpp>
 #include <openfluid/dllexport.hpp>
 
 
@@ -54,7 +55,7 @@ class OPENFLUID_API ProgressiveChronFileReader : public ProgressiveColumnFileRea
   private:
 
 
-    std::string m_DateFormat;
+    openfluid::core::DateTimeParser m_DateParser;
 
   public:
 
@@ -66,6 +67,13 @@ class OPENFLUID_API ProgressiveChronFileReader : public ProgressiveColumnFileRea
     { };
 
 
+    /**
+      Gets the next value in the file. Lines are tokenized in place,
+      the date format is compiled once at construction of the reader.
+      @param[out] Value the read value
+      @return true if a value has been read, false if the end of file is reached
+      @throw openfluid::base::FrameworkException if the date or the value is wrong
+    */
     bool getNextValue(ChronItem_t& Value);
 
 };
@@ -38,7 +38,10 @@
  */
 
 
-#include <boost/algorithm/string.hpp>
+#include <cctype>
+
+#include <QFile>
+
 #include <openfluid/tools/DataHelpers.hpp>
 
 #include <openfluid/tools/ProgressiveColumnFileReader.hpp>
@@ -50,11 +53,80 @@ namespace openfluid { namespace tools {
 
 ProgressiveColumnFileReader::ProgressiveColumnFileReader(const std::string& FileName,
                                                          const std::string& ColSeparators):
-    m_File(FileName.c_str()), m_ColSeparators(ColSeparators), m_FileName(FileName)
+    mp_File(new QFile(QString::fromStdString(FileName))),
+    mp_Begin(nullptr), mp_End(nullptr), mp_Current(nullptr),
+    m_FileName(FileName), m_ColSeparators(ColSeparators)
 {
-  if (!m_File.is_open())
+  if (!mp_File->open(QIODevice::ReadOnly))
+  {
+    delete mp_File;
     throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
                                               "Can not open file " + FileName);
+  }
+
+  qint64 Size = mp_File->size();
+
+  if (Size > 0)
+  {
+    uchar* Data = mp_File->map(0,Size);
+
+    if (Data)
+    {
+      mp_Begin = reinterpret_cast<const char*>(Data);
+      mp_End = mp_Begin + Size;
+    }
+    else
+    {
+      QByteArray Content = mp_File->readAll();
+      m_Buffer.assign(Content.constData(),Content.size());
+      mp_Begin = m_Buffer.data();
+      mp_End = mp_Begin + m_Buffer.size();
+    }
+  }
+
+  mp_Current = mp_Begin;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+ProgressiveColumnFileReader::~ProgressiveColumnFileReader()
+{
+  // closing the file also unmaps it
+  mp_File->close();
+  delete mp_File;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+bool ProgressiveColumnFileReader::getNextLine(const char*& LineBegin, const char*& LineEnd)
+{
+  if (mp_Current == mp_End)
+    return false;
+
+  LineBegin = mp_Current;
+
+  while (mp_Current != mp_End && *mp_Current != '\n')
+    ++mp_Current;
+
+  LineEnd = mp_Current;
+
+  if (mp_Current != mp_End)
+    ++mp_Current;
+
+  // trimming of whitespaces
+  while (LineBegin != LineEnd && isspace(static_cast<unsigned char>(*LineBegin)))
+    ++LineBegin;
+
+  while (LineEnd != LineBegin && isspace(static_cast<unsigned char>(*(LineEnd-1))))
+    --LineEnd;
+
+  return true;
 }
 
 
@@ -64,10 +136,12 @@ ProgressiveColumnFileReader::ProgressiveColumnFileReader(const std::string& File
 
 bool ProgressiveColumnFileReader::getNextLine(std::string& Line)
 {
-  if (!m_File.eof())
+  const char* LineBegin;
+  const char* LineEnd;
+
+  if (getNextLine(LineBegin,LineEnd))
   {
-    std::getline(m_File,Line);
-    boost::algorithm::trim(Line);
+    Line.assign(LineBegin,LineEnd);
     return true;
   }
   return false;
@@ -97,11 +171,7 @@ bool ProgressiveColumnFileReader::getNextLine(std::vector<std::string>& Values)
 
 void ProgressiveColumnFileReader::reset()
 {
-  if (m_File.is_open())
-  {
-    m_File.clear();
-    m_File.seekg(0,std::ios::beg);
-  }
+  mp_Current = mp_Begin;
 }
 
 
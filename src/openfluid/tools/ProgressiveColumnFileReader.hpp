@@ -41,30 +41,52 @@
 #define __OPENFLUID_TOOLS_PROGRESSIVECOLUMNFILEREADER_HPP__
 
 
-#include <fstream>
+#include <string>
 #include <vector>
 
 #include <openfluid/dllexport.hpp>
 
 
+class QFile;
+
+
 namespace openfluid { namespace tools {
 
 /**
-  Progressive reader for column text files
+  Progressive reader for column text files.
+  The file content is memory-mapped when possible (or read at once otherwise), lines are then read in place.
 */
 class OPENFLUID_API ProgressiveColumnFileReader
 {
   private:
 
-    std::ifstream m_File;
+    QFile* mp_File;
 
-    std::string m_ColSeparators;
+    /**
+      Buffer used for the file content when the file cannot be memory-mapped
+    */
+    std::string m_Buffer;
+
+    const char* mp_Begin;
+
+    const char* mp_End;
+
+    const char* mp_Current;
+
+    ProgressiveColumnFileReader(const ProgressiveColumnFileReader&);
+
+    ProgressiveColumnFileReader& operator=(const ProgressiveColumnFileReader&);
 
 
   protected:
 
     std::string m_FileName;
 
+    std::string m_ColSeparators;
+
+    inline bool isColSeparator(char C) const
+    { return (m_ColSeparators.find(C) != std::string::npos); }
+
 
   public:
 
@@ -76,8 +98,16 @@ class OPENFLUID_API ProgressiveColumnFileReader
     ProgressiveColumnFileReader(const std::string& FileName,
     		                    const std::string& ColSeparators = " \t\r\n");
 
-    virtual ~ProgressiveColumnFileReader()
-    { };
+    virtual ~ProgressiveColumnFileReader();
+
+    /**
+      Gets the next line of data in the file, in place.
+      The given pointers remain valid until the reader is destroyed
+      @param[out] LineBegin pointer to the first character of the line, leading whitespaces excluded
+      @param[out] LineEnd pointer after the last character of the line, trailing whitespaces excluded
+      @return true if the next line has been read, false otherwise
+    */
+    bool getNextLine(const char*& LineBegin, const char*& LineEnd);
 
     /**
       Gets the next line of data in the file, as a single string
@@ -44,7 +44,12 @@
 #define BOOST_TEST_MODULE unittest_coltextparser
 #include <boost/test/unit_test.hpp>
 #include <boost/test/auto_unit_test.hpp>
+
+#include <chrono>
+#include <fstream>
+
 #include <openfluid/tools/ColumnTextParser.hpp>
+#include <openfluid/tools/Filesystem.hpp>
 #include <openfluid/core/StringValue.hpp>
 #include <openfluid/core/DoubleValue.hpp>
 #include <openfluid/core/MapValue.hpp>
@@ -116,3 +121,136 @@ BOOST_AUTO_TEST_CASE(check_from_file)
 
   checkParsing(Parser);
 }
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_typed_columns)
+{
+  openfluid::tools::ColumnTextParser Parser("%",";");
+
+  BOOST_REQUIRE(Parser.setFromString("1;0.5;a;-20;2;1e3;\"b;c\";30;d\\;e;1.0E-30;f;-9223372036854775808",4));
+  BOOST_REQUIRE_EQUAL(Parser.getLinesCount(),3);
+  BOOST_REQUIRE_EQUAL(Parser.getColsCount(),4);
+
+  BOOST_REQUIRE_EQUAL(Parser.getCell(1,2),"b;c");
+  BOOST_REQUIRE_EQUAL(Parser.getCell(2,0),"d;e");
+  BOOST_REQUIRE(Parser.getCell(3,0).empty());
+  BOOST_REQUIRE(Parser.getCell(0,4).empty());
+
+  std::vector<long> Longs;
+  BOOST_REQUIRE(!Parser.getLongColumn(0,Longs));
+  BOOST_REQUIRE(Longs.empty());
+  BOOST_REQUIRE(Parser.getLongColumn(3,Longs));
+  BOOST_REQUIRE_EQUAL(Longs.size(),3);
+  BOOST_REQUIRE_EQUAL(Longs[0],-20);
+  BOOST_REQUIRE_EQUAL(Longs[1],30);
+  BOOST_REQUIRE_EQUAL(Longs[2],-9223372036854775807L-1);
+
+  std::vector<double> Doubles;
+  BOOST_REQUIRE(!Parser.getDoubleColumn(2,Doubles));
+  BOOST_REQUIRE(!Parser.getDoubleColumn(4,Doubles));
+  BOOST_REQUIRE(Parser.getDoubleColumn(1,Doubles));
+  BOOST_REQUIRE_EQUAL(Doubles.size(),3);
+  BOOST_REQUIRE_CLOSE(Doubles[0],0.5,0.00001);
+  BOOST_REQUIRE_CLOSE(Doubles[1],1000.0,0.00001);
+  BOOST_REQUIRE_CLOSE(Doubles[2],1.0E-30,0.00001);
+
+  long LongVal;
+  BOOST_REQUIRE(!Parser.getLongValue(0,1,&LongVal));
+  BOOST_REQUIRE(Parser.getLongValue(0,0,&LongVal));
+  BOOST_REQUIRE_EQUAL(LongVal,1);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_wrong_contents)
+{
+  openfluid::tools::ColumnTextParser Parser("#");
+
+  BOOST_REQUIRE(!Parser.setFromString("1 2 3",2));
+  BOOST_REQUIRE(!Parser.setFromString("1 2",0));
+  BOOST_REQUIRE(!Parser.setFromString("1 \\x",2));
+  BOOST_REQUIRE(!Parser.setFromString("1 2\\",2));
+  BOOST_REQUIRE_EQUAL(Parser.getLinesCount(),0);
+  BOOST_REQUIRE_EQUAL(Parser.getColsCount(),0);
+
+  BOOST_REQUIRE(Parser.setFromString("",2));
+  BOOST_REQUIRE_EQUAL(Parser.getLinesCount(),0);
+
+  const std::string FilePath = CONFIGTESTS_OUTPUT_DATA_DIR+"/ColumnTextParser/wrongcols.txt";
+  openfluid::tools::Filesystem::makeDirectory(CONFIGTESTS_OUTPUT_DATA_DIR+"/ColumnTextParser");
+
+  std::ofstream OutFile(FilePath);
+  OutFile << "# comment\n1 2 3\n\n4 5\n";
+  OutFile.close();
+
+  BOOST_REQUIRE(!Parser.loadFromFile(FilePath));
+  BOOST_REQUIRE_EQUAL(Parser.getLinesCount(),0);
+  BOOST_REQUIRE(!Parser.loadFromFile(CONFIGTESTS_OUTPUT_DATA_DIR+"/ColumnTextParser/doesnotexist.txt"));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_performance)
+{
+  // size of the generated file, kept small for regular test runs, set to 1024 for benchmarking on 1 GB inputs
+  const unsigned int SizeInMB = 2;
+
+  const std::string FilePath = CONFIGTESTS_OUTPUT_DATA_DIR+"/ColumnTextParser/performance.txt";
+  openfluid::tools::Filesystem::makeDirectory(CONFIGTESTS_OUTPUT_DATA_DIR+"/ColumnTextParser");
+
+  unsigned int LinesCount = 0;
+  double ExpectedSum = 0.0;
+
+  {
+    std::ofstream OutFile(FilePath);
+    const std::string Line = "2016-01-01\t12:00:00\t127.25\t18\n";
+    const std::size_t Size = std::size_t(SizeInMB)*1024*1024;
+    OutFile << "# generated file for performance test\n";
+    for (std::size_t i=0; i<Size; i+=Line.size())
+    {
+      OutFile << Line;
+      LinesCount++;
+      ExpectedSum += 127.25;
+    }
+  }
+
+  openfluid::tools::ColumnTextParser Parser("#");
+
+  auto Start = std::chrono::steady_clock::now();
+  BOOST_REQUIRE(Parser.loadFromFile(FilePath));
+  auto Duration = std::chrono::duration<double>(std::chrono::steady_clock::now()-Start).count();
+  std::cout << "load: " << SizeInMB/Duration << " MB/s" << std::endl;
+
+  BOOST_REQUIRE_EQUAL(Parser.getLinesCount(),LinesCount);
+  BOOST_REQUIRE_EQUAL(Parser.getColsCount(),4);
+
+  std::vector<double> Values;
+  Start = std::chrono::steady_clock::now();
+  BOOST_REQUIRE(Parser.getDoubleColumn(2,Values));
+  Duration = std::chrono::duration<double>(std::chrono::steady_clock::now()-Start).count();
+  std::cout << "double column: " << LinesCount/Duration << " values/s" << std::endl;
+
+  double Sum = 0.0;
+  for (auto V : Values)
+    Sum += V;
+  BOOST_REQUIRE_CLOSE(Sum,ExpectedSum,0.00001);
+
+  std::vector<long> Longs;
+  Start = std::chrono::steady_clock::now();
+  BOOST_REQUIRE(Parser.getLongColumn(3,Longs));
+  Duration = std::chrono::duration<double>(std::chrono::steady_clock::now()-Start).count();
+  std::cout << "long column: " << LinesCount/Duration << " values/s" << std::endl;
+  BOOST_REQUIRE_EQUAL(Longs.back(),18);
+
+  openfluid::tools::Filesystem::removeFile(FilePath);
+}
@@ -101,6 +101,23 @@ BOOST_AUTO_TEST_CASE(check_operations)
   openfluid::tools::tokenizeString(Str,StrArray,"-");
   BOOST_REQUIRE_EQUAL(StrArray.size(),1);
 
+  Str = "12.5";
+  BOOST_REQUIRE(openfluid::tools::convertCharsToDouble(Str.data(),Str.data()+Str.size(),&DoubleValue));
+  BOOST_REQUIRE_EQUAL(DoubleValue,12.5);
+  Str = "-0.001";
+  BOOST_REQUIRE(openfluid::tools::convertCharsToDouble(Str.data(),Str.data()+Str.size(),&DoubleValue));
+  BOOST_REQUIRE_EQUAL(DoubleValue,-0.001);
+  Str = "3.2e-5";
+  BOOST_REQUIRE(openfluid::tools::convertCharsToDouble(Str.data(),Str.data()+Str.size(),&DoubleValue));
+  BOOST_REQUIRE_EQUAL(DoubleValue,3.2e-5);
+  Str = "1.23456789012345678901e100";
+  BOOST_REQUIRE(openfluid::tools::convertCharsToDouble(Str.data(),Str.data()+Str.size(),&DoubleValue));
+  BOOST_REQUIRE_EQUAL(DoubleValue,1.23456789012345678901e100);
+  Str = "1.5xx";
+  BOOST_REQUIRE(!openfluid::tools::convertCharsToDouble(Str.data(),Str.data()+Str.size(),&DoubleValue));
+  Str = "";
+  BOOST_REQUIRE(!openfluid::tools::convertCharsToDouble(Str.data(),Str.data()+Str.size(),&DoubleValue));
+
 }
 
 
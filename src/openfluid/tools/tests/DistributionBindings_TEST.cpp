@@ -128,6 +128,23 @@ BOOST_AUTO_TEST_CASE(check_operations)
   BOOST_REQUIRE(ValueFound);
   BOOST_REQUIRE_CLOSE(Value.get(),7.0,0.0001);
 
+  // indexed access
+
+  BOOST_REQUIRE_EQUAL(DistriBindings.getSourceIndex(1),DistriBindings.getSourceIndex(3));
+  BOOST_REQUIRE_EQUAL(DistriBindings.getSourceIndex(2),DistriBindings.getSourceIndex(4));
+  BOOST_REQUIRE(DistriBindings.getSourceIndex(1) != DistriBindings.getSourceIndex(2));
+  BOOST_REQUIRE_EQUAL(DistriBindings.getSourceIndex(99),-1);
+  BOOST_REQUIRE(!DistriBindings.getCurrentValue(-1,Value));
+
+  DistriBindings.advanceToTime(openfluid::core::DateTime(2000,1,1,0,7,0));
+
+  BOOST_REQUIRE(DistriBindings.getCurrentValue(DistriBindings.getSourceIndex(5),Value));
+  BOOST_REQUIRE_CLOSE(Value.get(),7.0,0.0001);
+
+  DistriBindings.advanceToTime(openfluid::core::DateTime(2000,1,1,0,7,30));
+
+  BOOST_REQUIRE(!DistriBindings.getCurrentValue(DistriBindings.getSourceIndex(5),Value));
+
 
 }
 
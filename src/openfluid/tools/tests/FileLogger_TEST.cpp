@@ -44,6 +44,11 @@
 #define BOOST_TEST_MODULE unittest_filelogger
 #include <boost/test/unit_test.hpp>
 #include <boost/test/auto_unit_test.hpp>
+
+#include <fstream>
+#include <thread>
+#include <vector>
+
 #include <openfluid/tools/FileLogger.hpp>
 #include <tests-config.hpp>
 
@@ -52,6 +57,23 @@
 // =====================================================================
 
 
+std::vector<std::string> readLogLines(const std::string& FilePath)
+{
+  std::vector<std::string> Lines;
+  std::ifstream InFile(FilePath.c_str());
+  std::string Line;
+
+  while (std::getline(InFile,Line))
+    Lines.push_back(Line);
+
+  return Lines;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 BOOST_AUTO_TEST_CASE(check_operations_1)
 {
   openfluid::tools::FileLogger Log;
@@ -94,3 +116,124 @@ BOOST_AUTO_TEST_CASE(check_operations_2)
   BOOST_REQUIRE(!Log.isError());
 }
 
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_filtering)
+{
+  openfluid::tools::FileLogger Log;
+
+  Log.init(CONFIGTESTS_OUTPUT_DATA_DIR+"/filelogger3.log");
+
+  BOOST_REQUIRE(Log.isLogTypeEnabled(openfluid::tools::FileLogger::LOG_DEBUG));
+  Log.setLogTypeEnabled(openfluid::tools::FileLogger::LOG_DEBUG,false);
+  Log.setLogTypeEnabled(openfluid::tools::FileLogger::LOG_INFO,false);
+  BOOST_REQUIRE(!Log.isLogTypeEnabled(openfluid::tools::FileLogger::LOG_DEBUG));
+  BOOST_REQUIRE(Log.isLogTypeEnabled(openfluid::tools::FileLogger::LOG_WARNING));
+
+  Log.add(openfluid::tools::FileLogger::LOG_INFO,"test","info 1");
+  Log.add(openfluid::tools::FileLogger::LOG_DEBUG,"test","debug 1");
+  Log.add(openfluid::tools::FileLogger::LOG_WARNING,"test","warning 1");
+
+  BOOST_REQUIRE_EQUAL(Log.getWarningsCount(),1);
+  BOOST_REQUIRE_EQUAL(Log.getInfosCount(),0);
+
+  Log.close();
+
+  std::vector<std::string> Lines = readLogLines(CONFIGTESTS_OUTPUT_DATA_DIR+"/filelogger3.log");
+  BOOST_REQUIRE_EQUAL(Lines.size(),1);
+  BOOST_REQUIRE_EQUAL(Lines[0],"[Warning][test] warning 1");
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_repeated)
+{
+  openfluid::tools::FileLogger Log;
+
+  Log.init(CONFIGTESTS_OUTPUT_DATA_DIR+"/filelogger4.log");
+  Log.setRepeatedMessagesLimit(3);
+
+  for (unsigned int i=0; i<10; i++)
+  {
+    Log.add(openfluid::tools::FileLogger::LOG_WARNING,"test","same warning");
+    Log.add(openfluid::tools::FileLogger::LOG_WARNING,"test","warning "+std::to_string(i));
+  }
+
+  BOOST_REQUIRE_EQUAL(Log.getWarningsCount(),20);
+
+  Log.close();
+
+  std::vector<std::string> Lines = readLogLines(CONFIGTESTS_OUTPUT_DATA_DIR+"/filelogger4.log");
+  BOOST_REQUIRE_EQUAL(Lines.size(),14);
+  BOOST_REQUIRE_EQUAL(Lines[0],"[Warning][test] same warning");
+  BOOST_REQUIRE_EQUAL(Lines[1],"[Warning][test] warning 0");
+  BOOST_REQUIRE_EQUAL(Lines[13],"[Warning][test] same warning (7 identical messages suppressed)");
+
+
+  // no limit by default
+  openfluid::tools::FileLogger UnlimitedLog;
+
+  UnlimitedLog.init(CONFIGTESTS_OUTPUT_DATA_DIR+"/filelogger6.log");
+  BOOST_REQUIRE_EQUAL(UnlimitedLog.getRepeatedMessagesLimit(),0);
+
+  for (unsigned int i=0; i<200; i++)
+    UnlimitedLog.add(openfluid::tools::FileLogger::LOG_WARNING,"test","same warning");
+
+  UnlimitedLog.close();
+
+  Lines = readLogLines(CONFIGTESTS_OUTPUT_DATA_DIR+"/filelogger6.log");
+  BOOST_REQUIRE_EQUAL(Lines.size(),200);
+  BOOST_REQUIRE_EQUAL(Lines[199],"[Warning][test] same warning");
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_threads)
+{
+  const unsigned int ThreadsCount = 8;
+  const unsigned int MessagesCount = 20000;
+
+  openfluid::tools::FileLogger Log;
+
+  Log.init(CONFIGTESTS_OUTPUT_DATA_DIR+"/filelogger5.log");
+
+  std::vector<std::thread> Threads;
+
+  for (unsigned int t=0; t<ThreadsCount; t++)
+  {
+    Threads.push_back(std::thread([&Log,t,MessagesCount]()
+    {
+      for (unsigned int i=0; i<MessagesCount; i++)
+        Log.add(openfluid::tools::FileLogger::LOG_INFO,"thread"+std::to_string(t),"message "+std::to_string(i));
+    }));
+  }
+
+  for (auto& Thread : Threads)
+    Thread.join();
+
+  BOOST_REQUIRE_EQUAL(Log.getInfosCount(),ThreadsCount*MessagesCount);
+
+  Log.close();
+
+  std::vector<std::string> Lines = readLogLines(CONFIGTESTS_OUTPUT_DATA_DIR+"/filelogger5.log");
+  BOOST_REQUIRE_EQUAL(Lines.size(),ThreadsCount*MessagesCount);
+
+  // messages of each thread are written in order
+  std::vector<unsigned int> NextMessage(ThreadsCount,0);
+
+  for (const std::string& Line : Lines)
+  {
+    unsigned int t = std::stoul(Line.substr(Line.find("[thread")+7));
+    BOOST_REQUIRE_EQUAL(Line.substr(Line.find("] ")+2),"message "+std::to_string(NextMessage[t]));
+    NextMessage[t]++;
+  }
+}
@@ -0,0 +1,183 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+/**
+  @file PrefetchingChronFilesReader_TEST.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@supagro.inra.fr>
+*/
+
+
+#define BOOST_TEST_MAIN
+#define BOOST_AUTO_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE unittest_prefetchingchronfilesreader
+#include <boost/test/unit_test.hpp>
+#include <boost/test/auto_unit_test.hpp>
+
+#include <fstream>
+#include <memory>
+
+#include <openfluid/tools/PrefetchingChronFilesReader.hpp>
+#include <openfluid/tools/ProgressiveChronFileReader.hpp>
+#include <openfluid/tools/Filesystem.hpp>
+#include <openfluid/base/FrameworkException.hpp>
+
+#include <tests-config.hpp>
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_construction)
+{
+  openfluid::tools::PrefetchingChronFilesReader Reader;
+
+  BOOST_REQUIRE_EQUAL(Reader.getFilesCount(),0);
+
+  Reader.start();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void checkReading(unsigned int WindowSize)
+{
+  const std::vector<std::string> Files = { CONFIGTESTS_INPUT_MISCDATA_DIR+"/ChronFiles/temp.dat",
+                                           CONFIGTESTS_INPUT_MISCDATA_DIR+"/ChronFiles/rain.dat",
+                                           CONFIGTESTS_INPUT_MISCDATA_DIR+"/ChronFiles/measured_ticks.dat" };
+
+  openfluid::tools::PrefetchingChronFilesReader Reader(WindowSize);
+
+  for (unsigned int i=0; i<Files.size(); i++)
+    BOOST_REQUIRE_EQUAL(Reader.addFile(Files[i]),i);
+
+  BOOST_REQUIRE_EQUAL(Reader.getFilesCount(),3);
+  BOOST_REQUIRE_EQUAL(Reader.getFileName(1),Files[1]);
+
+  Reader.start();
+
+  BOOST_REQUIRE_THROW(Reader.addFile(Files[0]),openfluid::base::FrameworkException);
+
+  // files are read alternately, values must be the same as read synchronously
+  std::vector<std::unique_ptr<openfluid::tools::ProgressiveChronFileReader>> CheckReaders;
+  for (auto& F : Files)
+    CheckReaders.emplace_back(new openfluid::tools::ProgressiveChronFileReader(F));
+
+  std::vector<bool> Ended(Files.size(),false);
+  std::vector<unsigned int> Counts(Files.size(),0);
+  unsigned int EndedCount = 0;
+
+  while (EndedCount < Files.size())
+  {
+    for (unsigned int i=0; i<Files.size(); i++)
+    {
+      if (!Ended[i])
+      {
+        openfluid::tools::ChronItem_t CI, CheckCI;
+        bool Found = Reader.getNextValue(i,CI);
+
+        BOOST_REQUIRE_EQUAL(Found,CheckReaders[i]->getNextValue(CheckCI));
+
+        if (Found)
+        {
+          BOOST_REQUIRE(CI.first == CheckCI.first);
+          BOOST_REQUIRE_EQUAL(CI.second,CheckCI.second);
+          Counts[i]++;
+        }
+        else
+        {
+          Ended[i] = true;
+          EndedCount++;
+        }
+      }
+    }
+  }
+
+  BOOST_REQUIRE_EQUAL(Counts[0],152);
+  BOOST_REQUIRE_EQUAL(Counts[1],8807);
+  BOOST_REQUIRE_EQUAL(Counts[2],9);
+
+  openfluid::tools::ChronItem_t CI;
+  BOOST_REQUIRE(!Reader.getNextValue(0,CI));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_reading)
+{
+  checkReading(2);
+  checkReading(3);
+  checkReading(64);
+  checkReading(10000);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_errors)
+{
+  openfluid::tools::PrefetchingChronFilesReader Reader(4);
+
+  BOOST_REQUIRE_THROW(Reader.addFile(CONFIGTESTS_INPUT_MISCDATA_DIR+"/ChronFiles/doesnotexist.dat"),
+                      openfluid::base::FrameworkException);
+
+  const std::string FilePath = CONFIGTESTS_OUTPUT_DATA_DIR+"/PrefetchingChronFilesReader/wrong.dat";
+  openfluid::tools::Filesystem::makeDirectory(CONFIGTESTS_OUTPUT_DATA_DIR+"/PrefetchingChronFilesReader");
+
+  {
+    std::ofstream OutFile(FilePath);
+    for (unsigned int i=0; i<10; i++)
+      OutFile << "2013-01-01T00:00:0" << i << " " << i << "\n";
+    OutFile << "2013-01-01T00:00:10 wrong\n";
+  }
+
+  BOOST_REQUIRE_EQUAL(Reader.addFile(FilePath),0);
+
+  // the error is reported when the wrong value is reached, not when it is read ahead
+  openfluid::tools::ChronItem_t CI;
+  for (unsigned int i=0; i<10; i++)
+  {
+    BOOST_REQUIRE(Reader.getNextValue(0,CI));
+    BOOST_REQUIRE_EQUAL(CI.second,i);
+  }
+
+  BOOST_REQUIRE_THROW(Reader.getNextValue(0,CI),openfluid::base::FrameworkException);
+}
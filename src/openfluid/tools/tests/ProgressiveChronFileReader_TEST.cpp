@@ -95,6 +95,23 @@ BOOST_AUTO_TEST_CASE(check_operations)
   while (PChronFR.getNextValue(CI)) std::cout << CI.second << " at " << CI.first.getAsISOString() << std::endl;
 
 
+  // ========================================================
+
+  openfluid::tools::ProgressiveChronFileReader PChronFRCheck(CONFIGTESTS_INPUT_MISCDATA_DIR+"/ChronFiles/temp.dat");
+
+  BOOST_REQUIRE(PChronFRCheck.getNextValue(CI));
+  BOOST_REQUIRE(CI.first == openfluid::core::DateTime(2013,1,1,0,0,0));
+  BOOST_REQUIRE_EQUAL(CI.second,20);
+
+  BOOST_REQUIRE(PChronFRCheck.getNextValue(CI));
+  BOOST_REQUIRE(CI.first == openfluid::core::DateTime(2013,1,2,4,0,0));
+  BOOST_REQUIRE_EQUAL(CI.second,20);
+
+  PChronFRCheck.reset();
+  BOOST_REQUIRE(PChronFRCheck.getNextValue(CI));
+  BOOST_REQUIRE(CI.first == openfluid::core::DateTime(2013,1,1,0,0,0));
+
+
 
 }
 
@@ -125,7 +125,8 @@ RunSimulationListener::RunSimulationListener()
     m_PausedByUser(false), m_ConfirmedPauseByUser(false),
     m_AbortedByUser(false)
 {
-
+  // run steps progress is published at a fixed rate to avoid flooding the GUI event loop
+  setProgressRate(10);
 };
 
 
@@ -247,6 +248,23 @@ void RunSimulationListener::onRunStep(const openfluid::base::SimulationStatus* S
 // =====================================================================
 
 
+void RunSimulationListener::onProgress(const openfluid::machine::MachineListener::ProgressSnapshot& Progress)
+{
+  HANDLE_USER_PAUSE_ABORT;
+
+  if (m_SimDuration == 0)
+  {
+    m_SimDuration = Progress.Duration;
+    emit progressMaxChanged(m_SimDuration);
+  }
+  emit progressValueChanged(Progress.CurrentIndex);
+};
+
+
+// =====================================================================
+// =====================================================================
+
+
 void RunSimulationListener::onFinalizeRun()
 {
   HANDLE_USER_PAUSE_ABORT;
@@ -129,6 +129,8 @@ class OPENFLUID_API RunSimulationListener : public QObject, public openfluid::ma
 
     void onRunStep(const openfluid::base::SimulationStatus* SimStatus);
 
+    void onProgress(const openfluid::machine::MachineListener::ProgressSnapshot& Progress);
+
     void onFinalizeRun();
 
     void onFinalizeRunDone(const openfluid::base::Listener::Status& /*Status*/);
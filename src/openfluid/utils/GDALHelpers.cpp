@@ -77,6 +77,12 @@ const GDALDriversFilesExts_t getOGRFilesDriversForOpenFLUID()
     Drivers["MapInfo File"].FilesExts.push_back("tab");
   }
 
+  if (OGRGetDriverByName("GPKG"))
+  {
+    Drivers["GPKG"].Label = "GeoPackage";
+    Drivers["GPKG"].FilesExts.push_back("gpkg");
+  }
+
   return Drivers;
 }
 
@@ -0,0 +1,207 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+/**
+  @file ZipArchiveWriter.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@supagro.inra.fr>
+*/
+
+
+#include <fstream>
+#include <vector>
+
+#include <cpl_conv.h>
+#include <cpl_string.h>
+#include <cpl_vsi.h>
+
+#include <openfluid/utils/ZipArchiveWriter.hpp>
+#include <openfluid/base/FrameworkException.hpp>
+
+
+namespace openfluid { namespace utils {
+
+
+// =====================================================================
+// =====================================================================
+
+
+ZipArchiveWriter::ZipArchiveWriter(const std::string& FilePath, bool Compressed) :
+  mp_Zip(nullptr), m_FilePath(FilePath), m_IsCompressed(Compressed), m_IsEntryOpen(false)
+{
+  // the GDAL zip writer appends to existing archives
+  VSIUnlink(m_FilePath.c_str());
+
+  mp_Zip = CPLCreateZip(m_FilePath.c_str(),nullptr);
+
+  if (!mp_Zip)
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                              "Cannot create zip archive " + m_FilePath);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+ZipArchiveWriter::~ZipArchiveWriter()
+{
+  close();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void ZipArchiveWriter::openEntry(const std::string& EntryName)
+{
+  if (!mp_Zip)
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                              "Zip archive " + m_FilePath + " is closed");
+
+  closeEntry();
+
+  char** Options = nullptr;
+
+  if (!m_IsCompressed)
+    Options = CSLSetNameValue(Options,"COMPRESSED","NO");
+
+  CPLErr Err = CPLCreateFileInZip(mp_Zip,EntryName.c_str(),Options);
+
+  CSLDestroy(Options);
+
+  if (Err != CE_None)
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                              "Cannot create entry " + EntryName + " in zip archive " + m_FilePath);
+
+  m_IsEntryOpen = true;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void ZipArchiveWriter::write(const char* Data, std::size_t Size)
+{
+  if (!m_IsEntryOpen)
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                              "No open entry in zip archive " + m_FilePath);
+
+  if (!Size)
+    return;
+
+  if (CPLWriteFileInZip(mp_Zip,Data,static_cast<int>(Size)) != CE_None)
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                              "Cannot write data in zip archive " + m_FilePath);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void ZipArchiveWriter::write(const std::string& Data)
+{
+  write(Data.data(),Data.size());
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void ZipArchiveWriter::closeEntry()
+{
+  if (m_IsEntryOpen)
+  {
+    CPLCloseFileInZip(mp_Zip);
+    m_IsEntryOpen = false;
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void ZipArchiveWriter::addEntry(const std::string& EntryName, const std::string& Content)
+{
+  openEntry(EntryName);
+  write(Content);
+  closeEntry();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void ZipArchiveWriter::addFile(const std::string& EntryName, const std::string& FilePath)
+{
+  std::ifstream InFile(FilePath.c_str(),std::ios::in | std::ios::binary);
+
+  if (!InFile.is_open())
+    throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
+                                              "Cannot read file " + FilePath);
+
+  std::vector<char> Buffer(64*1024);
+
+  openEntry(EntryName);
+
+  while (InFile)
+  {
+    InFile.read(Buffer.data(),Buffer.size());
+    write(Buffer.data(),InFile.gcount());
+  }
+
+  closeEntry();
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void ZipArchiveWriter::close()
+{
+  if (mp_Zip)
+  {
+    closeEntry();
+    CPLCloseZip(mp_Zip);
+    mp_Zip = nullptr;
+  }
+}
+
+
+} }  // namespaces
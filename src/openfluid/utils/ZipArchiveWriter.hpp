@@ -0,0 +1,162 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+/**
+  @file ZipArchiveWriter.hpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@supagro.inra.fr>
+*/
+
+
+#ifndef __OPENFLUID_UTILS_ZIPARCHIVEWRITER_HPP__
+#define __OPENFLUID_UTILS_ZIPARCHIVEWRITER_HPP__
+
+#include <string>
+
+#include <openfluid/dllexport.hpp>
+
+
+namespace openfluid { namespace utils {
+
+/**
+  Writer of zip archives, streaming the entries directly into the archive file without any temporary file.
+  It relies on the zip support provided by GDAL. Only one entry can be written at a time.
+
+  @code{.cpp}
+  openfluid::utils::ZipArchiveWriter Archive("/path/to/archive.kmz");
+
+  Archive.addEntry("doc.kml",DocContent);
+
+  Archive.openEntry("data/values.csv");
+  Archive.write("1;2;3\n");
+  Archive.write("4;5;6\n");
+  Archive.closeEntry();
+
+  Archive.addFile("images/plot.png","/path/to/plot.png");
+
+  Archive.close();
+  @endcode
+*/
+class OPENFLUID_API ZipArchiveWriter
+{
+  private:
+
+    void* mp_Zip;
+
+    std::string m_FilePath;
+
+    bool m_IsCompressed;
+
+    bool m_IsEntryOpen;
+
+    ZipArchiveWriter(const ZipArchiveWriter&) = delete;
+
+    ZipArchiveWriter& operator=(const ZipArchiveWriter&) = delete;
+
+
+  public:
+
+    /**
+      Creates the archive file, replacing any existing file at the same path
+      @param[in] FilePath the path of the archive file
+      @param[in] Compressed entries are compressed using the deflate method if true (default), stored otherwise
+      @throw openfluid::base::FrameworkException if the archive file cannot be created
+    */
+    ZipArchiveWriter(const std::string& FilePath, bool Compressed = true);
+
+    /**
+      Closes the archive if still open
+    */
+    ~ZipArchiveWriter();
+
+    /**
+      Opens a new entry in the archive, closing the current one if any
+      @param[in] EntryName the path of the entry in the archive, using '/' as separator
+      @throw openfluid::base::FrameworkException if the entry cannot be created
+    */
+    void openEntry(const std::string& EntryName);
+
+    /**
+      Appends data to the currently open entry
+      @throw openfluid::base::FrameworkException if no entry is open or if the data cannot be written
+    */
+    void write(const char* Data, std::size_t Size);
+
+    /**
+      Appends a string to the currently open entry
+      @throw openfluid::base::FrameworkException if no entry is open or if the data cannot be written
+    */
+    void write(const std::string& Data);
+
+    /**
+      Closes the currently open entry, if any
+    */
+    void closeEntry();
+
+    /**
+      Adds a complete entry to the archive
+      @param[in] EntryName the path of the entry in the archive
+      @param[in] Content the content of the entry
+    */
+    void addEntry(const std::string& EntryName, const std::string& Content);
+
+    /**
+      Adds an existing file as an entry of the archive. The file is read and written by blocks.
+      @param[in] EntryName the path of the entry in the archive
+      @param[in] FilePath the path of the file to add
+      @throw openfluid::base::FrameworkException if the file cannot be read
+    */
+    void addFile(const std::string& EntryName, const std::string& FilePath);
+
+    /**
+      Closes the archive, writing its central directory. The archive cannot be used anymore afterwards.
+    */
+    void close();
+
+    /**
+      Returns true if the archive is open for writing
+    */
+    bool isOpen() const
+    { return mp_Zip != nullptr; }
+
+    /**
+      Returns the path of the archive file
+    */
+    std::string getFilePath() const
+    { return m_FilePath; }
+};
+
+
+} }  // namespaces
+
+
+#endif /* __OPENFLUID_UTILS_ZIPARCHIVEWRITER_HPP__ */
@@ -0,0 +1,126 @@
+/*
+
+  This file is part of OpenFLUID software
+  Copyright(c) 2007, INRA - Montpellier SupAgro
+
+
+ == GNU General Public License Usage ==
+
+  OpenFLUID is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OpenFLUID is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OpenFLUID. If not, see <http://www.gnu.org/licenses/>.
+
+
+ == Other Usage ==
+
+  Other Usage means a use of OpenFLUID that is inconsistent with the GPL
+  license, and requires a written agreement between You and INRA.
+  Licensees for Other Usage of OpenFLUID may use this file in accordance
+  with the terms contained in the written agreement between You and INRA.
+  
+*/
+
+
+
+/**
+  @file ZipArchiveWriter_TEST.cpp
+
+  @author Jean-Christophe FABRE <jean-christophe.fabre@supagro.inra.fr>
+*/
+
+
+#define BOOST_TEST_MAIN
+#define BOOST_AUTO_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE unittest_ziparchivewriter
+#include <boost/test/unit_test.hpp>
+#include <boost/test/auto_unit_test.hpp>
+
+#include <cpl_vsi.h>
+
+#include <openfluid/utils/ZipArchiveWriter.hpp>
+#include <openfluid/base/FrameworkException.hpp>
+#include <openfluid/tools/Filesystem.hpp>
+
+#include <tests-config.hpp>
+
+
+// =====================================================================
+// =====================================================================
+
+
+std::string readZipEntry(const std::string& ArchivePath, const std::string& EntryName)
+{
+  std::string Content;
+
+  VSILFILE* Entry = VSIFOpenL(std::string("/vsizip/"+ArchivePath+"/"+EntryName).c_str(),"rb");
+
+  if (Entry)
+  {
+    char Buffer[1024];
+    size_t ReadSize;
+
+    while ((ReadSize = VSIFReadL(Buffer,1,sizeof(Buffer),Entry)) > 0)
+      Content.append(Buffer,ReadSize);
+
+    VSIFCloseL(Entry);
+  }
+
+  return Content;
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+BOOST_AUTO_TEST_CASE(check_operations)
+{
+  const std::string OutputDir = CONFIGTESTS_OUTPUT_DATA_DIR+"/ZipArchiveWriter";
+  const std::string ArchivePath = OutputDir+"/archive.kmz";
+  const std::string LoremIpsumPath = CONFIGTESTS_INPUT_MISCDATA_DIR+"/FileDownloader/lorem_ipsum.txt";
+
+  openfluid::tools::Filesystem::makeDirectory(OutputDir);
+
+  std::string BigContent;
+  for (unsigned int i=0; i<10000;i++)
+    BigContent += "<Placemark><name>unit "+std::to_string(i)+"</name></Placemark>\n";
+
+  for (bool Compressed : {true,false})
+  {
+    openfluid::utils::ZipArchiveWriter Archive(ArchivePath,Compressed);
+
+    BOOST_REQUIRE(Archive.isOpen());
+    BOOST_REQUIRE_THROW(Archive.write("orphan data"),openfluid::base::FrameworkException);
+
+    Archive.addEntry("doc.kml","<kml></kml>");
+
+    Archive.openEntry("data/t_1.kml");
+    Archive.write(BigContent.substr(0,BigContent.size()/2));
+    Archive.write(BigContent.substr(BigContent.size()/2));
+    Archive.closeEntry();
+
+    Archive.addFile("data/lorem_ipsum.txt",LoremIpsumPath);
+
+    BOOST_REQUIRE_THROW(Archive.addFile("data/wrong.txt",OutputDir+"/does_not_exist.txt"),
+                        openfluid::base::FrameworkException);
+
+    Archive.close();
+    BOOST_REQUIRE(!Archive.isOpen());
+    BOOST_REQUIRE_THROW(Archive.openEntry("after_close.txt"),openfluid::base::FrameworkException);
+
+    BOOST_REQUIRE_EQUAL(readZipEntry(ArchivePath,"doc.kml"),"<kml></kml>");
+    BOOST_REQUIRE_EQUAL(readZipEntry(ArchivePath,"data/t_1.kml"),BigContent);
+    BOOST_REQUIRE_EQUAL(readZipEntry(ArchivePath,"data/lorem_ipsum.txt").substr(0,11),"Lorem ipsum");
+  }
+}
+
@@ -105,6 +105,29 @@ void GeneratorSignature::setRandomInfo()
 
   HandledData.UsedParams.push_back(
       openfluid::ware::SignatureDataItem("deltat","DeltaT to use instead of the default DeltaT","s"));
+
+  HandledData.UsedParams.push_back(
+      openfluid::ware::SignatureDataItem("seed","Seed of the random values, for reproducible values","-"));
+
+  HandledData.UsedParams.push_back(
+      openfluid::ware::SignatureDataItem("distribution",
+                                         "Distribution of the random values: uniform (default), normal, "
+                                         "lognormal or gamma","-"));
+
+  HandledData.UsedParams.push_back(
+      openfluid::ware::SignatureDataItem("mean","Mean of the normal distribution, "
+                                                "or mean of the logarithm of the lognormal distribution","-"));
+
+  HandledData.UsedParams.push_back(
+      openfluid::ware::SignatureDataItem("stddev","Standard deviation of the normal distribution, "
+                                                  "or standard deviation of the logarithm of the lognormal "
+                                                  "distribution","-"));
+
+  HandledData.UsedParams.push_back(
+      openfluid::ware::SignatureDataItem("shape","Shape of the gamma distribution","-"));
+
+  HandledData.UsedParams.push_back(
+      openfluid::ware::SignatureDataItem("scale","Scale of the gamma distribution","-"));
 }
 
 
@@ -72,6 +72,39 @@ void PluggableObserver::initializeWare(const WareID_t& ID)
 }
 
 
+// =====================================================================
+// =====================================================================
+
+
+void PluggableObserver::OPENFLUID_EnableVariablesChangesTracking()
+{
+  // observers onPrepared() method is called during the CHECKCONSISTENCY stage
+  REQUIRE_SIMULATION_STAGE_LE(openfluid::base::SimulationStatus::CHECKCONSISTENCY,
+                              "Variables changes tracking can only be enabled during INITPARAMS, PREPAREDATA"
+                              " and CHECKCONSISTENCY stages")
+
+  mp_SpatialData->variablesChangesLog().setEnabled(true);
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+openfluid::core::ChangedVariablesList_t PluggableObserver::OPENFLUID_GetChangedVariables() const
+{
+  REQUIRE_SIMULATION_STAGE_GE(openfluid::base::SimulationStatus::INITIALIZERUN,
+                              "Changed variables can be accessed only during INITIALIZERUN,"
+                              "RUNSTEP and FINALIZERUN stages")
+
+  if (!mp_SpatialData->variablesChangesLog().isEnabled())
+    throw openfluid::base::FrameworkException(computeFrameworkContext(OPENFLUID_CODE_LOCATION),
+                                              "Variables changes tracking is not enabled");
+
+  return mp_SpatialData->variablesChangesLog().getChanges(OPENFLUID_GetCurrentTimeIndex());
+}
+
+
 }  // namespace ware
 
 
@@ -89,6 +89,22 @@ namespace openfluid { namespace ware {
 
 class OPENFLUID_API PluggableObserver : public SimulationInspectorWare
 {
+  protected:
+
+    /**
+      Enables the tracking of variables changes, required by OPENFLUID_GetChangedVariables().
+      Must be called before the INITIALIZERUN stage, usually in the onPrepared() method.
+    */
+    void OPENFLUID_EnableVariablesChangesTracking();
+
+    /**
+      Returns the variables of spatial units which values have been appended or modified
+      at the current time index. This allows observers to process only what has changed
+      instead of checking every configured variable.
+      @return the list of changed variables, without duplicates
+    */
+    openfluid::core::ChangedVariablesList_t OPENFLUID_GetChangedVariables() const;
+
 
   public:
 
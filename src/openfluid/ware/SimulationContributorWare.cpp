@@ -38,6 +38,8 @@
  */
 
 
+#include <utility>
+
 #include <openfluid/ware/SimulationContributorWare.hpp>
 #include <openfluid/tools/IDHelpers.hpp>
 
@@ -307,6 +309,44 @@ void SimulationContributorWare::OPENFLUID_AppendVariable(openfluid::core::Spatia
 // =====================================================================
 
 
+void SimulationContributorWare::OPENFLUID_AppendVariable(openfluid::core::SpatialUnit *UnitPtr,
+                                                         const openfluid::core::VariableName_t& VarName,
+                                                         openfluid::core::Value&& Val)
+{
+  OPENFLUID_AppendVariable(*UnitPtr,VarName,std::move(Val));
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void SimulationContributorWare::OPENFLUID_AppendVariable(openfluid::core::SpatialUnit& aUnit,
+                                                         const openfluid::core::VariableName_t& VarName,
+                                                         openfluid::core::Value&& Val)
+{
+  REQUIRE_SIMULATION_STAGE(openfluid::base::SimulationStatus::RUNSTEP,
+                           "Variables values cannot be added outside RUNSTEP stage")
+
+  if (&aUnit != NULL)
+  {
+    if (!aUnit.variables()->appendValue(VarName,OPENFLUID_GetCurrentTimeIndex(),std::move(Val)))
+    {
+      openfluid::base::ExceptionContext Context = computeFrameworkContext(OPENFLUID_CODE_LOCATION)
+          .addSpatialUnit(openfluid::tools::classIDToString(aUnit.getClass(),aUnit.getID()));
+      throw openfluid::base::FrameworkException(Context,
+                                                "Error appending value for variable "+ VarName);
+    }
+  }
+  else
+    throw openfluid::base::FrameworkException(computeFrameworkContext(OPENFLUID_CODE_LOCATION),"Unit is NULL");
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 void SimulationContributorWare::OPENFLUID_AppendVariable(openfluid::core::SpatialUnit *UnitPtr,
                                                          const openfluid::core::VariableName_t& VarName,
                                                          const double& Val)
@@ -546,6 +586,34 @@ void SimulationContributorWare::OPENFLUID_SetVariable(openfluid::core::SpatialUn
 // =====================================================================
 
 
+void SimulationContributorWare::OPENFLUID_RegisterWindowedAggregate(openfluid::core::SpatialUnit *UnitPtr,
+                                                                    const openfluid::core::VariableName_t& VarName,
+                                                                    openfluid::core::WindowedAggregate::Method Meth,
+                                                                    openfluid::core::WindowedAggregate::WindowType Type,
+                                                                    unsigned long long Size)
+{
+  REQUIRE_SIMULATION_STAGE(openfluid::base::SimulationStatus::INITIALIZERUN,
+                           "Windowed aggregates can be registered during INITIALIZERUN stage only")
+
+  if (UnitPtr != NULL)
+  {
+    if (!Size || !UnitPtr->variables()->registerWindowedAggregate(VarName,Meth,Type,Size))
+    {
+      openfluid::base::ExceptionContext Context = computeFrameworkContext(OPENFLUID_CODE_LOCATION)
+          .addSpatialUnit(openfluid::tools::classIDToString(UnitPtr->getClass(),UnitPtr->getID()));
+      throw openfluid::base::FrameworkException(Context,
+                                                "Error registering windowed aggregate for variable "+ VarName);
+    }
+  }
+  else
+    throw openfluid::base::FrameworkException(computeFrameworkContext(OPENFLUID_CODE_LOCATION),"Unit is NULL");
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 void SimulationContributorWare::OPENFLUID_AppendEvent(openfluid::core::SpatialUnit *UnitPtr,
                                                       openfluid::core::Event& Ev)
 {
@@ -652,7 +720,7 @@ bool SimulationContributorWare::OPENFLUID_AddFromToConnection(openfluid::core::S
 
   if (FromUnit != NULL || ToUnit != NULL)
   {
-    return (FromUnit->addToUnit(ToUnit) && ToUnit->addFromUnit(FromUnit));
+    return mp_SpatialData->addFromToConnection(FromUnit,ToUnit);
   }
   else
     throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
@@ -746,7 +814,7 @@ bool SimulationContributorWare::OPENFLUID_AddChildParentConnection(openfluid::co
 
   if (ChildUnit != NULL || ParentUnit != NULL)
   {
-    return (ChildUnit->addParentUnit(ParentUnit) && ParentUnit->addChildUnit(ChildUnit));
+    return mp_SpatialData->addChildParentConnection(ChildUnit,ParentUnit);
   }
   else
     throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION,
@@ -188,6 +188,32 @@ class OPENFLUID_API SimulationContributorWare : public SimulationInspectorWare
                                   const openfluid::core::VariableName_t& VarName,
                                   const openfluid::core::Value& Val);
 
+    /**
+      Appends a distributed variable value for a unit at the end
+      of the previously added values for this variable.
+      The temporary value is moved into the variable storage when possible (vectors, matrices)
+      instead of being copied.
+      @param[in] UnitPtr a Unit
+      @param[in] VarName the name of the variable
+      @param[in] Val the added value of the variable
+    */
+    void OPENFLUID_AppendVariable(openfluid::core::SpatialUnit *UnitPtr,
+                                  const openfluid::core::VariableName_t& VarName,
+                                  openfluid::core::Value&& Val);
+
+    /**
+      Appends a distributed variable value for a unit at the end
+      of the previously added values for this variable.
+      The temporary value is moved into the variable storage when possible (vectors, matrices)
+      instead of being copied.
+      @param[in] aUnit a Unit
+      @param[in] VarName the name of the variable
+      @param[in] Val the added value of the variable
+    */
+    void OPENFLUID_AppendVariable(openfluid::core::SpatialUnit& aUnit,
+                                  const openfluid::core::VariableName_t& VarName,
+                                  openfluid::core::Value&& Val);
+
     /**
       Appends a distributed double variable value for a unit at the end
       of the previously added values for this variable
@@ -285,6 +311,25 @@ class OPENFLUID_API SimulationContributorWare : public SimulationInspectorWare
                                const openfluid::core::VariableName_t& VarName,
                                const std::string& Val);
 
+    /**
+      Registers an aggregate over the latest values of a variable for a unit.
+      The aggregate is maintained incrementally each time a value is appended or modified,
+      and can be read in constant time using OPENFLUID_GetWindowedAggregate(),
+      instead of getting the values list at each time step.
+      Aggregates can be registered during INITIALIZERUN stage only, as they are read without locking
+      by the other wares during the RUNSTEP stage
+      @param[in] UnitPtr a Unit
+      @param[in] VarName the name of the variable
+      @param[in] Meth the aggregation method (SUM, MEAN, MIN or MAX)
+      @param[in] Type the window type, over the last values (LASTVALUES) or the last seconds (LASTSECONDS)
+      @param[in] Size the number of values or the duration of the window, must be greater than 0
+    */
+    void OPENFLUID_RegisterWindowedAggregate(openfluid::core::SpatialUnit *UnitPtr,
+                                             const openfluid::core::VariableName_t& VarName,
+                                             openfluid::core::WindowedAggregate::Method Meth,
+                                             openfluid::core::WindowedAggregate::WindowType Type,
+                                             unsigned long long Size);
+
     /**
       Appends an event on a unit
       @param[in] UnitPtr a Unit
@@ -315,7 +360,9 @@ class OPENFLUID_API SimulationContributorWare : public SimulationInspectorWare
 
 
     /**
-      Adds a from-to connection between two units
+      Adds a from-to connection between two units.
+      During RUNSTEP stage, the connection is added at the end of the current time point,
+      so the connections read by simulators do not change during a time point
       @param[in] ClassNameFrom class name of the "from" unit
       @param[in] IDFrom ID of the "from" unit
       @param[in] ClassNameTo class name of the "to" unit
@@ -328,7 +375,9 @@ class OPENFLUID_API SimulationContributorWare : public SimulationInspectorWare
                                        openfluid::core::UnitID_t IDTo);
 
     /**
-      Adds a from-to connection between two units
+      Adds a from-to connection between two units.
+      During RUNSTEP stage, the connection is added at the end of the current time point,
+      so the connections read by simulators do not change during a time point
       @param[in] FromUnit pointer to the "from" unit
       @param[in] ToUnit pointer to the "to" unit
       @return false if the connection already exists
@@ -337,7 +386,9 @@ class OPENFLUID_API SimulationContributorWare : public SimulationInspectorWare
                                        openfluid::core::SpatialUnit* ToUnit);
 
     /**
-      Removes a from-to connection between two units
+      Removes a from-to connection between two units.
+      During RUNSTEP stage, the connection is removed at the end of the current time point,
+      so the connections read by simulators do not change during a time point
       @param[in] ClassNameFrom class name of the "from" unit
       @param[in] IDFrom ID of the "from" unit
       @param[in] ClassNameTo class name of the "to" unit
@@ -350,7 +401,9 @@ class OPENFLUID_API SimulationContributorWare : public SimulationInspectorWare
                                           openfluid::core::UnitID_t IDTo);
 
     /**
-      Removes a from-to connection between two units
+      Removes a from-to connection between two units.
+      During RUNSTEP stage, the connection is removed at the end of the current time point,
+      so the connections read by simulators do not change during a time point
       @param[in] FromUnit pointer to the "from" unit
       @param[in] ToUnit pointer to the "to" unit
       @return false if the connection does not exist
@@ -360,7 +413,9 @@ class OPENFLUID_API SimulationContributorWare : public SimulationInspectorWare
 
 
     /**
-      Adds a child-parent connection between two units
+      Adds a child-parent connection between two units.
+      During RUNSTEP stage, the connection is added at the end of the current time point,
+      so the connections read by simulators do not change during a time point
       @param[in] ClassNameChild class name of the "child" unit
       @param[in] IDChild ID of the "child" unit
       @param[in] ClassNameParent class name of the "parent" unit
@@ -373,7 +428,9 @@ class OPENFLUID_API SimulationContributorWare : public SimulationInspectorWare
                                             openfluid::core::UnitID_t IDParent);
 
     /**
-      Adds a child-parent connection between two units
+      Adds a child-parent connection between two units.
+      During RUNSTEP stage, the connection is added at the end of the current time point,
+      so the connections read by simulators do not change during a time point
       @param[in] ChildUnit pointer to the "child" unit
       @param[in] ParentUnit pointer to the "parent" unit
       @return false if the connection already exists
@@ -383,7 +440,9 @@ class OPENFLUID_API SimulationContributorWare : public SimulationInspectorWare
 
 
     /**
-      Removes a child-parent connection between two units
+      Removes a child-parent connection between two units.
+      During RUNSTEP stage, the connection is removed at the end of the current time point,
+      so the connections read by simulators do not change during a time point
       @param[in] ClassNameChild class name of the "child" unit
       @param[in] IDChild ID of the "child" unit
       @param[in] ClassNameParent class name of the "parent" unit
@@ -396,7 +455,9 @@ class OPENFLUID_API SimulationContributorWare : public SimulationInspectorWare
                                                openfluid::core::UnitID_t IDParent);
 
     /**
-      Removes a child-parent connection between two units
+      Removes a child-parent connection between two units.
+      During RUNSTEP stage, the connection is removed at the end of the current time point,
+      so the connections read by simulators do not change during a time point
       @param[in] ChildUnit pointer to the "child" unit
       @param[in] ParentUnit pointer to the "parent" unit
       @return false if the connection does not exist
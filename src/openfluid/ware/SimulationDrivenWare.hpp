@@ -48,24 +48,39 @@
 #include <openfluid/base/FrameworkException.hpp>
 #include <openfluid/dllexport.hpp>
 #include <openfluid/deprecation.hpp>
+#include <openfluid/config.hpp>
+
+
+/*
+  Per-call validation of the primitives.
+  Always enabled in debug builds, removed from release builds when trusted primitives are enabled at build time,
+  and otherwise disabled at runtime for wares running in trusted mode.
+*/
+#if !defined(NDEBUG)
+  #define OPENFLUID_PRIMITIVES_CHECKED true
+#elif OPENFLUID_TRUSTEDPRIMITIVES_ENABLED
+  #define OPENFLUID_PRIMITIVES_CHECKED false
+#else
+  #define OPENFLUID_PRIMITIVES_CHECKED (!isTrustedMode())
+#endif
 
 
 #define REQUIRE_SIMULATION_STAGE(stage,msg) \
-  if (OPENFLUID_GetCurrentStage() != (stage)) \
+  if (OPENFLUID_PRIMITIVES_CHECKED && OPENFLUID_GetCurrentStage() != (stage)) \
   { \
     openfluid::base::ExceptionContext Context = computeFrameworkContext(OPENFLUID_CODE_LOCATION); \
     throw openfluid::base::FrameworkException(Context,msg); \
   }
 
 #define REQUIRE_SIMULATION_STAGE_GE(stage,msg) \
-  if (OPENFLUID_GetCurrentStage() < (stage)) \
+  if (OPENFLUID_PRIMITIVES_CHECKED && OPENFLUID_GetCurrentStage() < (stage)) \
   { \
     openfluid::base::ExceptionContext Context = computeFrameworkContext(OPENFLUID_CODE_LOCATION); \
     throw openfluid::base::FrameworkException(Context,msg); \
   }
 
 #define REQUIRE_SIMULATION_STAGE_LE(stage,msg) \
-  if (OPENFLUID_GetCurrentStage() > (stage)) \
+  if (OPENFLUID_PRIMITIVES_CHECKED && OPENFLUID_GetCurrentStage() > (stage)) \
   { \
     openfluid::base::ExceptionContext Context = computeFrameworkContext(OPENFLUID_CODE_LOCATION); \
     throw openfluid::base::FrameworkException(Context,msg); \
@@ -80,9 +95,13 @@
 
 
 // Log macros for warnings
+// Messages are formatted only if their type is enabled in the simulation logger
 
 #define OPENFLUID_LogWarning(_stream) \
-  appendToLog(openfluid::tools::FileLogger::LOG_WARNING,_STREAMTOSTRING(_stream))
+  do { \
+    if (isLogEnabled(openfluid::tools::FileLogger::LOG_WARNING)) \
+      appendToLog(openfluid::tools::FileLogger::LOG_WARNING,_STREAMTOSTRING(_stream)); \
+  } while (0)
 
 #define OPENFLUID_DisplayWarning(_stream) \
   displayToConsole(openfluid::tools::FileLogger::LOG_WARNING,_STREAMTOSTRING(_stream))
@@ -95,7 +114,10 @@
 // Log macros for infos
 
 #define OPENFLUID_LogInfo(_stream) \
-  appendToLog(openfluid::tools::FileLogger::LOG_INFO,_STREAMTOSTRING(_stream))
+  do { \
+    if (isLogEnabled(openfluid::tools::FileLogger::LOG_INFO)) \
+      appendToLog(openfluid::tools::FileLogger::LOG_INFO,_STREAMTOSTRING(_stream)); \
+  } while (0)
 
 #define OPENFLUID_DisplayInfo(_stream) \
   displayToConsole(openfluid::tools::FileLogger::LOG_INFO,_STREAMTOSTRING(_stream))
@@ -110,7 +132,10 @@
 #ifndef NDEBUG
 
 #define OPENFLUID_LogDebug(_stream) \
-  appendToLog(openfluid::tools::FileLogger::LOG_DEBUG,_STREAMTOSTRING(_stream))
+  do { \
+    if (isLogEnabled(openfluid::tools::FileLogger::LOG_DEBUG)) \
+      appendToLog(openfluid::tools::FileLogger::LOG_DEBUG,_STREAMTOSTRING(_stream)); \
+  } while (0)
 
 #define OPENFLUID_DisplayDebug(_stream) \
   displayToConsole(openfluid::tools::FileLogger::LOG_DEBUG,_STREAMTOSTRING(_stream))
@@ -147,6 +172,8 @@ class OPENFLUID_API SimulationDrivenWare : public PluggableWare
 
     openfluid::core::TimeIndex_t m_PreviousTimeIndex;
 
+    bool m_TrustedMode;
+
 
   protected:
 
@@ -156,6 +183,12 @@ class OPENFLUID_API SimulationDrivenWare : public PluggableWare
 
     void appendToLog(openfluid::tools::FileLogger::LogType LType, const std::string& Msg) const;
 
+    /**
+      Returns false if messages of the given type are discarded by the simulation logger
+    */
+    inline bool isLogEnabled(openfluid::tools::FileLogger::LogType LType) const
+    { return (mp_SimLogger == NULL || mp_SimLogger->isLogTypeEnabled(LType)); }
+
     void displayToConsole(openfluid::tools::FileLogger::LogType LType, const std::string& Msg) const;
 
 
@@ -254,7 +287,7 @@ class OPENFLUID_API SimulationDrivenWare : public PluggableWare
     virtual void OPENFLUID_RaiseError(const std::string& Source, const std::string& Msg) OPENFLUID_DEPRECATED;
 
     SimulationDrivenWare(WareType WType) : PluggableWare(WType),
-        mp_SimStatus(NULL), mp_SimLogger(NULL), m_PreviousTimeIndex(0) { };
+        mp_SimStatus(NULL), mp_SimLogger(NULL), m_PreviousTimeIndex(0), m_TrustedMode(false) { };
 
 
   public:
@@ -274,6 +307,17 @@ class OPENFLUID_API SimulationDrivenWare : public PluggableWare
     void setPreviousTimeIndex(const openfluid::core::TimeIndex_t& TimeIndex)
     { m_PreviousTimeIndex = TimeIndex; };
 
+    /**
+      Sets the trusted mode of the ware. In trusted mode and in release builds,
+      the simulation stage is not checked on each call of primitives:
+      the engine only calls wares during the stages they are designed for
+    */
+    void setTrustedMode(bool Trusted)
+    { m_TrustedMode = Trusted; };
+
+    bool isTrustedMode() const
+    { return m_TrustedMode; };
+
 };
 
 
@@ -40,6 +40,7 @@
 
 #include <openfluid/ware/SimulationInspectorWare.hpp>
 #include <openfluid/tools/IDHelpers.hpp>
+#include <openfluid/core/ValuesBufferProperties.hpp>
 
 
 namespace openfluid { namespace ware {
@@ -69,6 +70,51 @@ bool SimulationInspectorWare::IsUnitIDInPtrList(const openfluid::core::UnitsPtrL
 // =====================================================================
 
 
+void SimulationInspectorWare::throwWrongValueType(const openfluid::core::SpatialUnit* UnitPtr,
+                                                  const std::string& ValueDesc,
+                                                  openfluid::core::Value::Type ExpectedType,
+                                                  openfluid::core::Value::Type FoundType) const
+{
+  openfluid::base::ExceptionContext Context = computeFrameworkContext(OPENFLUID_CODE_LOCATION)
+      .addSpatialUnit(openfluid::tools::classIDToString(UnitPtr->getClass(),UnitPtr->getID()));
+  throw openfluid::base::FrameworkException(Context,
+                                            "Value for "+ ValueDesc +" is not the right type " +
+                                            "(" +
+                                            openfluid::core::Value::getStringFromValueType(ExpectedType) +
+                                            " expected but " +
+                                            openfluid::core::Value::getStringFromValueType(FoundType) +
+                                            " found)");
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
+void SimulationInspectorWare::checkHaloVariableAccess(const openfluid::core::SpatialUnit* UnitPtr,
+                                                      const openfluid::core::VariableName_t& VarName,
+                                                      const openfluid::core::TimeIndex_t Index) const
+{
+  // values of halo units are received from their owner parts once the time point is completed
+  if (OPENFLUID_PRIMITIVES_CHECKED && OPENFLUID_GetWareType() == SIMULATOR &&
+      UnitPtr->isHaloVariable(VarName) && Index >= OPENFLUID_GetCurrentTimeIndex() &&
+      (OPENFLUID_GetCurrentStage() == openfluid::base::SimulationStatus::INITIALIZERUN ||
+       OPENFLUID_GetCurrentStage() == openfluid::base::SimulationStatus::RUNSTEP))
+  {
+    openfluid::base::ExceptionContext Context = computeFrameworkContext(OPENFLUID_CODE_LOCATION)
+        .addSpatialUnit(openfluid::tools::classIDToString(UnitPtr->getClass(),UnitPtr->getID()));
+    throw openfluid::base::FrameworkException(Context,
+                                              "Variable "+ VarName +" of a halo unit cannot be read "
+                                              "at the current time index, its values are exchanged with "
+                                              "the other parts of the domain at the end of each time point");
+  }
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 void SimulationInspectorWare::OPENFLUID_GetAttribute(const openfluid::core::SpatialUnit *UnitPtr,
                                                      const openfluid::core::AttributeName_t& AttrName,
                                                      openfluid::core::Value& Val) const
@@ -118,9 +164,7 @@ void SimulationInspectorWare::OPENFLUID_GetAttribute(const openfluid::core::Spat
                                                      const openfluid::core::AttributeName_t& AttrName,
                                                      double& Val) const
 {
-  openfluid::core::DoubleValue TmpDoubleVal;
-  OPENFLUID_GetAttribute(UnitPtr,AttrName,TmpDoubleVal);
-  Val = TmpDoubleVal.get();
+  Val = OPENFLUID_GetAttribute<double>(UnitPtr,AttrName);
 }
 
 
@@ -132,9 +176,7 @@ void SimulationInspectorWare::OPENFLUID_GetAttribute(const openfluid::core::Spat
                                                      const openfluid::core::AttributeName_t& AttrName,
                                                      long& Val) const
 {
-  openfluid::core::IntegerValue TmpLongVal;
-  OPENFLUID_GetAttribute(UnitPtr,AttrName,TmpLongVal);
-  Val = TmpLongVal.get();
+  Val = OPENFLUID_GetAttribute<long>(UnitPtr,AttrName);
 }
 
 
@@ -146,9 +188,7 @@ void SimulationInspectorWare::OPENFLUID_GetAttribute(const openfluid::core::Spat
                                                      const openfluid::core::AttributeName_t& AttrName,
                                                      std::string& Val) const
 {
-  openfluid::core::StringValue TmpStrVal;
-  OPENFLUID_GetAttribute(UnitPtr,AttrName,TmpStrVal);
-  Val = TmpStrVal.get();
+  Val = OPENFLUID_GetAttribute<std::string>(UnitPtr,AttrName);
 }
 
 
@@ -218,6 +258,8 @@ void SimulationInspectorWare::OPENFLUID_GetVariable(const openfluid::core::Spati
 
   if (UnitPtr != NULL)
   {
+    checkHaloVariableAccess(UnitPtr,VarName,Index);
+
     if (!UnitPtr->variables()->getValue(VarName,Index,&Val))
     {
       openfluid::base::ExceptionContext Context = computeFrameworkContext(OPENFLUID_CODE_LOCATION)
@@ -240,9 +282,7 @@ void SimulationInspectorWare::OPENFLUID_GetVariable(const openfluid::core::Spati
                                                     const openfluid::core::TimeIndex_t Index,
                                                     double& Val) const
 {
-  openfluid::core::DoubleValue TmpVal(Val);
-  OPENFLUID_GetVariable(UnitPtr,VarName,Index,TmpVal);
-  Val = TmpVal.get();
+  Val = OPENFLUID_GetVariable<double>(UnitPtr,VarName,Index);
 }
 
 
@@ -255,9 +295,7 @@ void SimulationInspectorWare::OPENFLUID_GetVariable(const openfluid::core::Spati
                                                     const openfluid::core::TimeIndex_t Index,
                                                     long& Val) const
 {
-  openfluid::core::IntegerValue TmpVal(Val);
-  OPENFLUID_GetVariable(UnitPtr,VarName,Index,TmpVal);
-  Val = TmpVal.get();
+  Val = OPENFLUID_GetVariable<long>(UnitPtr,VarName,Index);
 }
 
 
@@ -270,9 +308,7 @@ void SimulationInspectorWare::OPENFLUID_GetVariable(const openfluid::core::Spati
                                                     const openfluid::core::TimeIndex_t Index,
                                                     bool& Val) const
 {
-  openfluid::core::BooleanValue TmpVal(Val);
-  OPENFLUID_GetVariable(UnitPtr,VarName,Index,TmpVal);
-  Val = TmpVal.get();
+  Val = OPENFLUID_GetVariable<bool>(UnitPtr,VarName,Index);
 }
 
 
@@ -285,9 +321,7 @@ void SimulationInspectorWare::OPENFLUID_GetVariable(const openfluid::core::Spati
                                                     const openfluid::core::TimeIndex_t Index,
                                                     std::string& Val) const
 {
-  openfluid::core::StringValue TmpVal(Val);
-  OPENFLUID_GetVariable(UnitPtr,VarName,Index,TmpVal);
-  Val = TmpVal.get();
+  Val = OPENFLUID_GetVariable<std::string>(UnitPtr,VarName,Index);
 }
 
 
@@ -306,6 +340,8 @@ const openfluid::core::Value* SimulationInspectorWare::OPENFLUID_GetVariable(
 
   if (UnitPtr != NULL)
   {
+    checkHaloVariableAccess(UnitPtr,VarName,Index);
+
     const openfluid::core::Value* PtrVal = UnitPtr->variables()->value(VarName,Index);
     if (!PtrVal)
     {
@@ -336,6 +372,8 @@ void SimulationInspectorWare::OPENFLUID_GetVariable(const openfluid::core::Spati
 
   if (UnitPtr != NULL)
   {
+    checkHaloVariableAccess(UnitPtr,VarName,OPENFLUID_GetCurrentTimeIndex());
+
     if (!UnitPtr->variables()->getValue(VarName,OPENFLUID_GetCurrentTimeIndex(),&Val))
     {
       openfluid::base::ExceptionContext Context = computeFrameworkContext(OPENFLUID_CODE_LOCATION)
@@ -357,9 +395,7 @@ void SimulationInspectorWare::OPENFLUID_GetVariable(const openfluid::core::Spati
                                                     const openfluid::core::VariableName_t& VarName,
                                                     double& Val) const
 {
-  openfluid::core::DoubleValue TmpVal(Val);
-  OPENFLUID_GetVariable(UnitPtr,VarName,TmpVal);
-  Val = TmpVal.get();
+  Val = OPENFLUID_GetVariable<double>(UnitPtr,VarName);
 }
 
 
@@ -371,9 +407,7 @@ void SimulationInspectorWare::OPENFLUID_GetVariable(const openfluid::core::Spati
                                                     const openfluid::core::VariableName_t& VarName,
                                                     long& Val) const
 {
-  openfluid::core::IntegerValue TmpVal(Val);
-  OPENFLUID_GetVariable(UnitPtr,VarName,TmpVal);
-  Val = TmpVal.get();
+  Val = OPENFLUID_GetVariable<long>(UnitPtr,VarName);
 }
 
 
@@ -385,9 +419,7 @@ void SimulationInspectorWare::OPENFLUID_GetVariable(const openfluid::core::Spati
                                                     const openfluid::core::VariableName_t& VarName,
                                                     bool& Val) const
 {
-  openfluid::core::BooleanValue TmpVal(Val);
-  OPENFLUID_GetVariable(UnitPtr,VarName,TmpVal);
-  Val = TmpVal.get();
+  Val = OPENFLUID_GetVariable<bool>(UnitPtr,VarName);
 }
 
 
@@ -399,9 +431,7 @@ void SimulationInspectorWare::OPENFLUID_GetVariable(const openfluid::core::Spati
                                                     const openfluid::core::VariableName_t& VarName,
                                                     std::string& Val) const
 {
-  openfluid::core::StringValue TmpVal(Val);
-  OPENFLUID_GetVariable(UnitPtr,VarName,TmpVal);
-  Val = TmpVal.get();
+  Val = OPENFLUID_GetVariable<std::string>(UnitPtr,VarName);
 }
 
 
@@ -419,6 +449,8 @@ const openfluid::core::Value* SimulationInspectorWare::OPENFLUID_GetVariable(
 
   if (UnitPtr != NULL)
   {
+    checkHaloVariableAccess(UnitPtr,VarName,OPENFLUID_GetCurrentTimeIndex());
+
     const openfluid::core::Value* PtrVal = UnitPtr->variables()->value(VarName,OPENFLUID_GetCurrentTimeIndex());
     if (!PtrVal)
     {
@@ -456,6 +488,8 @@ void SimulationInspectorWare::OPENFLUID_GetLatestVariable(const openfluid::core:
        throw openfluid::base::FrameworkException(Context,
                                                  "Indexed value for variable "+ VarName +" does not exist or is empty");
      }
+
+     checkHaloVariableAccess(UnitPtr,VarName,IndVal.getIndex());
    }
   else
     throw openfluid::base::FrameworkException(computeFrameworkContext(OPENFLUID_CODE_LOCATION),"Unit is NULL");
@@ -483,6 +517,8 @@ openfluid::core::IndexedValue SimulationInspectorWare::OPENFLUID_GetLatestVariab
        throw openfluid::base::FrameworkException(Context,
                                                  "Indexed value for variable "+ VarName +" does not exist or is empty");
      }
+
+     checkHaloVariableAccess(UnitPtr,VarName,IndVal.getIndex());
      return IndVal;
    }
   else
@@ -511,6 +547,9 @@ void SimulationInspectorWare::OPENFLUID_GetLatestVariables(const openfluid::core
       throw openfluid::base::FrameworkException(Context,
                                                 "Indexed values for variable "+ VarName +" does not exist or is empty");
     }
+
+    if (!IndValList.empty())
+      checkHaloVariableAccess(UnitPtr,VarName,IndValList.back().getIndex());
   }
   else
     throw openfluid::base::FrameworkException(computeFrameworkContext(OPENFLUID_CODE_LOCATION),"Unit is NULL");
@@ -539,6 +578,9 @@ openfluid::core::IndexedValueList SimulationInspectorWare::OPENFLUID_GetLatestVa
       throw openfluid::base::FrameworkException(Context,
                                                 "Indexed values for variable "+ VarName +" does not exist or is empty");
     }
+
+    if (!IndValList.empty())
+      checkHaloVariableAccess(UnitPtr,VarName,IndValList.back().getIndex());
     return IndValList;
   }
   else
@@ -569,6 +611,9 @@ void SimulationInspectorWare::OPENFLUID_GetVariables(const openfluid::core::Spat
                                                 "Indexed values for variable "+ VarName +
                                                 " does not exist or is empty");
     }
+
+    if (!IndValList.empty())
+      checkHaloVariableAccess(UnitPtr,VarName,IndValList.back().getIndex());
   }
   else
     throw openfluid::base::FrameworkException(computeFrameworkContext(OPENFLUID_CODE_LOCATION),"Unit is NULL");
@@ -599,6 +644,9 @@ openfluid::core::IndexedValueList SimulationInspectorWare::OPENFLUID_GetVariable
                                                 "Indexed values for variable "+ VarName +
                                                 " does not exist or is empty");
     }
+
+    if (!IndValList.empty())
+      checkHaloVariableAccess(UnitPtr,VarName,IndValList.back().getIndex());
     return IndValList;
   }
   else
@@ -610,6 +658,50 @@ openfluid::core::IndexedValueList SimulationInspectorWare::OPENFLUID_GetVariable
 // =====================================================================
 
 
+bool SimulationInspectorWare::OPENFLUID_GetWindowedAggregate(const openfluid::core::SpatialUnit* UnitPtr,
+                                                             const openfluid::core::VariableName_t& VarName,
+                                                             openfluid::core::WindowedAggregate::Method Meth,
+                                                             openfluid::core::WindowedAggregate::WindowType Type,
+                                                             unsigned long long Size,
+                                                             double& Value) const
+{
+  REQUIRE_SIMULATION_STAGE_GE(openfluid::base::SimulationStatus::RUNSTEP,
+                              "Windowed aggregates can be accessed only during RUNSTEP and FINALIZERUN stages")
+
+  if (UnitPtr != NULL)
+  {
+    const openfluid::core::WindowedAggregate* Aggr =
+        UnitPtr->variables()->windowedAggregate(VarName,Meth,Type,Size);
+
+    if (!Aggr)
+    {
+      openfluid::base::ExceptionContext Context = computeFrameworkContext(OPENFLUID_CODE_LOCATION)
+               .addSpatialUnit(openfluid::tools::classIDToString(UnitPtr->getClass(),UnitPtr->getID()));
+      throw openfluid::base::FrameworkException(Context,
+                                                "Windowed aggregate for variable "+ VarName +
+                                                " is not registered");
+    }
+
+    // the aggregate includes the value of the current time index once produced
+    if (UnitPtr->isHaloVariable(VarName) &&
+        UnitPtr->variables()->isVariableExist(VarName,OPENFLUID_GetCurrentTimeIndex()))
+      checkHaloVariableAccess(UnitPtr,VarName,OPENFLUID_GetCurrentTimeIndex());
+
+    // pipelined observers read the values of a time point while the aggregate is already updated for the next ones
+    if (openfluid::core::ValuesBufferProperties::isReadIndexLimited())
+      return UnitPtr->variables()->computeWindowedAggregate(VarName,Meth,Type,Size,Value);
+
+    return Aggr->get(Value);
+  }
+  else
+    throw openfluid::base::FrameworkException(computeFrameworkContext(OPENFLUID_CODE_LOCATION),"Unit is NULL");
+}
+
+
+// =====================================================================
+// =====================================================================
+
+
 bool SimulationInspectorWare::OPENFLUID_IsVariableExist(const openfluid::core::SpatialUnit *UnitPtr,
                                                         const openfluid::core::VariableName_t& VarName) const
 {
@@ -44,6 +44,7 @@
 #include <openfluid/ware/SimulationDrivenWare.hpp>
 #include <openfluid/core/BooleanValue.hpp>
 #include <openfluid/core/MatrixValue.hpp>
+#include <openfluid/core/ValueTraits.hpp>
 #include <openfluid/core/Datastore.hpp>
 #include <openfluid/core/SpatialGraph.hpp>
 
@@ -61,6 +62,26 @@ class OPENFLUID_API SimulationInspectorWare : public SimulationDrivenWare
 
     openfluid::core::Datastore* mp_Datastore;
 
+    [[noreturn]] void throwWrongValueType(const openfluid::core::SpatialUnit* UnitPtr,
+                                          const std::string& ValueDesc,
+                                          openfluid::core::Value::Type ExpectedType,
+                                          openfluid::core::Value::Type FoundType) const;
+
+    void checkHaloVariableAccess(const openfluid::core::SpatialUnit* UnitPtr,
+                                 const openfluid::core::VariableName_t& VarName,
+                                 const openfluid::core::TimeIndex_t Index) const;
+
+    template<typename T>
+    T getVariableValueAs(const openfluid::core::SpatialUnit* UnitPtr,
+                         const openfluid::core::VariableName_t& VarName,
+                         const openfluid::core::Value* ValPtr) const
+    {
+      if (ValPtr->getType() != openfluid::core::ValueTraits<T>::type())
+        throwWrongValueType(UnitPtr,"variable "+VarName,openfluid::core::ValueTraits<T>::type(),ValPtr->getType());
+
+      return openfluid::core::ValueTraits<T>::get(*ValPtr);
+    }
+
 
   protected:
 
@@ -175,6 +196,35 @@ class OPENFLUID_API SimulationInspectorWare : public SimulationDrivenWare
     const openfluid::core::Value* OPENFLUID_GetAttribute(const openfluid::core::SpatialUnit *UnitPtr,
                                                          const openfluid::core::AttributeName_t& AttrName) const;
 
+    /**
+      Returns attribute for a unit, as a native type (double, long, bool or std::string).
+      The value is read directly from the stored attribute when it is of the corresponding type,
+      without any intermediate openfluid::core::Value, otherwise a conversion is attempted.
+      @code
+        double Area = OPENFLUID_GetAttribute<double>(U,"area");
+      @endcode
+      @param[in] UnitPtr a Unit
+      @param[in] AttrName the name of the requested attribute
+      @return the value of the requested attribute
+    */
+    template<typename T>
+    T OPENFLUID_GetAttribute(const openfluid::core::SpatialUnit *UnitPtr,
+                             const openfluid::core::AttributeName_t& AttrName) const
+    {
+      const openfluid::core::Value* ValPtr = OPENFLUID_GetAttribute(UnitPtr,AttrName);
+
+      if (ValPtr->getType() == openfluid::core::ValueTraits<T>::type())
+        return openfluid::core::ValueTraits<T>::get(*ValPtr);
+
+      // try to convert to compatible type
+      typename openfluid::core::ValueTraits<T>::ValueClass TmpVal;
+
+      if (!ValPtr->convert(TmpVal))
+        throwWrongValueType(UnitPtr,"attribute "+AttrName,TmpVal.getType(),ValPtr->getType());
+
+      return TmpVal.get();
+    }
+
     /**
        Returns true if a distributed variable exists, false otherwise
        @param[in] UnitPtr a Unit
@@ -301,6 +351,26 @@ class OPENFLUID_API SimulationInspectorWare : public SimulationDrivenWare
                                                           const openfluid::core::VariableName_t& VarName,
                                                           const openfluid::core::TimeIndex_t Index) const;
 
+      /**
+        Returns the distributed variable value for a unit at a time index, as a native type
+        (double, long, bool or std::string). The value is read directly from the stored variable,
+        without any intermediate openfluid::core::Value.
+        @code
+          double Volume = OPENFLUID_GetVariable<double>(U,"water.surf.V.runoff",OPENFLUID_GetPreviousRunTimeIndex());
+        @endcode
+        @param[in] UnitPtr a Unit
+        @param[in] VarName the name of the requested variable
+        @param[in] Index the time index for the value of the requested variable
+        @return the value of the requested variable
+      */
+      template<typename T>
+      T OPENFLUID_GetVariable(const openfluid::core::SpatialUnit* UnitPtr,
+                              const openfluid::core::VariableName_t& VarName,
+                              const openfluid::core::TimeIndex_t Index) const
+      {
+        return getVariableValueAs<T>(UnitPtr,VarName,OPENFLUID_GetVariable(UnitPtr,VarName,Index));
+      }
+
     /**
       Gets the distributed variable value for a unit at the current time index
       @param[in] UnitPtr a Unit
@@ -360,6 +430,24 @@ class OPENFLUID_API SimulationInspectorWare : public SimulationDrivenWare
     const openfluid::core::Value* OPENFLUID_GetVariable(const openfluid::core::SpatialUnit* UnitPtr,
                                                         const openfluid::core::VariableName_t& VarName) const;
 
+    /**
+      Returns the distributed variable value for a unit at the current time index, as a native type
+      (double, long, bool or std::string). The value is read directly from the stored variable,
+      without any intermediate openfluid::core::Value.
+      @code
+        long Count = OPENFLUID_GetVariable<long>(U,"count");
+      @endcode
+      @param[in] UnitPtr a Unit
+      @param[in] VarName the name of the requested variable
+      @return the value of the requested variable
+    */
+    template<typename T>
+    T OPENFLUID_GetVariable(const openfluid::core::SpatialUnit* UnitPtr,
+                            const openfluid::core::VariableName_t& VarName) const
+    {
+      return getVariableValueAs<T>(UnitPtr,VarName,OPENFLUID_GetVariable(UnitPtr,VarName));
+    }
+
 
     /**
       Gets the latest available variable for a unit
@@ -431,6 +519,26 @@ class OPENFLUID_API SimulationInspectorWare : public SimulationDrivenWare
                                                              const openfluid::core::TimeIndex_t BeginIndex,
                                                              const openfluid::core::TimeIndex_t EndIndex) const;
 
+    /**
+      Gets the value of an aggregate over the latest values of a variable for a unit,
+      previously registered using OPENFLUID_RegisterWindowedAggregate().
+      When read by pipelined observers, the aggregate is computed from the values of the observed time point
+      still in the values buffer
+      @param[in] UnitPtr a Unit
+      @param[in] VarName the name of the variable
+      @param[in] Meth the aggregation method
+      @param[in] Type the window type
+      @param[in] Size the number of values or the duration of the window
+      @param[out] Value the value of the aggregate
+      @return false if the window does not contain any numeric value yet, true otherwise
+    */
+    bool OPENFLUID_GetWindowedAggregate(const openfluid::core::SpatialUnit* UnitPtr,
+                                        const openfluid::core::VariableName_t& VarName,
+                                        openfluid::core::WindowedAggregate::Method Meth,
+                                        openfluid::core::WindowedAggregate::WindowType Type,
+                                        unsigned long long Size,
+                                        double& Value) const;
+
     /**
       Gets discrete events happening on a unit during a time period
       @param[in] UnitPtr a Unit
@@ -163,6 +163,54 @@
 
 
 
+#define _WAVEFRONTID(_id) _M_##_id##_Wavefront
+
+#define _WAVEFRONTLEVELID(_id) _M_##_id##_WavefrontLevel
+
+
+#define _OPENFLUID_UNITS_WAVEFRONT_LOOP_WITHID(id,unitsclass,funcptr,...) \
+  for (const std::vector<openfluid::core::SpatialUnit*>& _WAVEFRONTLEVELID(id) : \
+       mp_SpatialData->unitsWavefront(unitsclass)) \
+  { \
+    QFutureSynchronizer<void> _THREADSYNCID(id); \
+    for (openfluid::core::SpatialUnit* _UNITID(id) : _WAVEFRONTLEVELID(id)) \
+    { \
+      try \
+      { \
+        _THREADSYNCID(id).addFuture(QtConcurrent::run(std::bind(&funcptr,\
+                                                                  this,\
+                                                                  _UNITID(id),## __VA_ARGS__)));\
+        if (_THREADSYNCID(id).futures().size() == OPENFLUID_GetSimulatorMaxThreads())\
+        { \
+          _THREADSYNCID(id).waitForFinished(); \
+          _THREADSYNCID(id).clearFutures(); \
+        }\
+      }\
+      catch (QtConcurrent::UnhandledException& E) \
+      { \
+        throw openfluid::base::FrameworkException(OPENFLUID_CODE_LOCATION, \
+                                                  "QtConcurrent::UnhandledException in threaded loop"); \
+      } \
+    } \
+    _THREADSYNCID(id).waitForFinished(); \
+    _THREADSYNCID(id).clearFutures(); \
+  }
+
+/**
+  Macro for applying a threaded simulator to each unit of a class, following the wavefront levels
+  computed from the from/to connections between units of this class.
+  All units of a level are processed in parallel, after all units of the upstream levels
+  have been processed. Manually given process orders are not used.
+  @param[in] unitsclass name of the units class
+  @param[in] funcptr member simulator name
+  @param[in] ... extra parameters to pass to the member simulator
+*/
+#define OPENFLUID_UNITS_WAVEFRONT_LOOP(unitsclass,funcptr,...) \
+    _OPENFLUID_UNITS_WAVEFRONT_LOOP_WITHID(__LINE__,unitsclass,funcptr,## __VA_ARGS__)
+
+
+
+
 // =====================================================================
 // =====================================================================
 
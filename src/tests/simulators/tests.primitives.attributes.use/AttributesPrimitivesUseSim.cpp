@@ -310,6 +310,9 @@ class AttributesPrimitivesUseSimulator : public openfluid::ware::PluggableSimula
         if (!openfluid::scientific::isVeryClose(VarDouble,RefDouble))
           OPENFLUID_RaiseError("incorrect OPENFLUID_GetAttribute (indataDouble3 wrongvalue)");
 
+        if (!openfluid::scientific::isVeryClose(OPENFLUID_GetAttribute<double>(TU,"indataDouble"),1.1))
+          OPENFLUID_RaiseError("incorrect OPENFLUID_GetAttribute (indataDouble wrongvalue) get by typed return");
+
 
         // long
 
@@ -334,6 +337,13 @@ class AttributesPrimitivesUseSimulator : public openfluid::ware::PluggableSimula
         if (!openfluid::scientific::isVeryClose(VarDoubleVal.get(),RefLong))
           OPENFLUID_RaiseError("incorrect OPENFLUID_GetAttribute (indataLong3 conversion to double)");
 
+        if (OPENFLUID_GetAttribute<long>(TU,"indataLong3") != RefLong)
+          OPENFLUID_RaiseError("incorrect OPENFLUID_GetAttribute (indataLong3 wrongvalue) get by typed return");
+
+        if (!openfluid::scientific::isVeryClose(OPENFLUID_GetAttribute<double>(TU,"indataLong3"),RefLong))
+          OPENFLUID_RaiseError("incorrect OPENFLUID_GetAttribute (indataLong3 conversion to double) "
+                               "get by typed return");
+
 
 
         // bool
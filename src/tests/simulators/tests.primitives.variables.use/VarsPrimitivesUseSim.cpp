@@ -283,6 +283,14 @@ class VarsPrimitivesUseSimulator : public openfluid::ware::PluggableSimulator
           if (!openfluid::scientific::isCloseEnough(VarDouble,RefDouble,0.00001))
             OPENFLUID_RaiseError("incorrect double value (tests.double, by return, without index)");
 
+          VarDouble = OPENFLUID_GetVariable<double>(TU,"tests.double",CurrIndex);
+          if (!openfluid::scientific::isCloseEnough(VarDouble,RefDouble,0.00001))
+            OPENFLUID_RaiseError("incorrect double value (tests.double, by typed return)");
+
+          VarDouble = OPENFLUID_GetVariable<double>(TU,"tests.double");
+          if (!openfluid::scientific::isCloseEnough(VarDouble,RefDouble,0.00001))
+            OPENFLUID_RaiseError("incorrect double value (tests.double, by typed return, without index)");
+
           OPENFLUID_GetLatestVariable(TU,"tests.double",IndValue);
           if (IndValue.getIndex() != OPENFLUID_GetCurrentTimeIndex())
             OPENFLUID_RaiseError("incorrect time index (tests.double, by reference, latest variable)");
@@ -491,6 +499,10 @@ class VarsPrimitivesUseSimulator : public openfluid::ware::PluggableSimulator
           if (VarBool != RefBool)
             OPENFLUID_RaiseError("incorrect bool value (tests.bool, by return, without time index)");
 
+          VarBool = OPENFLUID_GetVariable<bool>(TU,"tests.bool",CurrIndex);
+          if (VarBool != RefBool)
+            OPENFLUID_RaiseError("incorrect bool value (tests.bool, by typed return)");
+
 
           OPENFLUID_SetVariable(TU,"tests.bool",NewBool);
 
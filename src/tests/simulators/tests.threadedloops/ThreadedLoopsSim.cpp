@@ -42,6 +42,8 @@
 #include <openfluid/ware/PluggableSimulator.hpp>
 #include <cmath>
 #include <chrono>
+#include <mutex>
+#include <set>
 
 // =====================================================================
 // =====================================================================
@@ -78,6 +80,10 @@ class ThreadedLoopsSimulator : public openfluid::ware::PluggableSimulator
 
     openfluid::core::PcsOrd_t m_LastOrd;
 
+    std::set<openfluid::core::UnitID_t> m_ProcessedUnits;
+
+    std::mutex m_ProcessedUnitsMutex;
+
   public:
 
 
@@ -202,6 +208,31 @@ class ThreadedLoopsSimulator : public openfluid::ware::PluggableSimulator
   // =====================================================================
 
 
+  void processUnitAfterUpstream(openfluid::core::SpatialUnit* aUnit)
+  {
+    openfluid::core::SpatialUnit* UpU;
+
+    {
+      std::lock_guard<std::mutex> Lock(m_ProcessedUnitsMutex);
+
+      OPENFLUID_UNITSLIST_LOOP(aUnit->fromSpatialUnits("TU"),UpU)
+      {
+        if (m_ProcessedUnits.find(UpU->getID()) == m_ProcessedUnits.end())
+          OPENFLUID_RaiseError("upstream unit not processed");
+      }
+    }
+
+    openfluid::tools::sleep(100);
+
+    std::lock_guard<std::mutex> Lock(m_ProcessedUnitsMutex);
+    m_ProcessedUnits.insert(aUnit->getID());
+  }
+
+
+  // =====================================================================
+  // =====================================================================
+
+
 
   openfluid::base::SchedulingRequest runStep()
   {
@@ -263,6 +294,16 @@ class ThreadedLoopsSimulator : public openfluid::ware::PluggableSimulator
     Duration = std::chrono::duration_cast<std::chrono::milliseconds>(EndTime - StartTime);
     std::cout << "TU Threaded 3 times: " << Duration.count() << "ms"  << std::endl;
 
+    StartTime = std::chrono::high_resolution_clock::now();
+    m_ProcessedUnits.clear();
+    OPENFLUID_UNITS_WAVEFRONT_LOOP("TU",ThreadedLoopsSimulator::processUnitAfterUpstream);
+    EndTime = std::chrono::high_resolution_clock::now();
+    Duration = std::chrono::duration_cast<std::chrono::milliseconds>(EndTime - StartTime);
+    std::cout << "TU Wavefront: " << Duration.count() << "ms"  << std::endl;
+
+    if (m_ProcessedUnits.size() != mp_SpatialData->spatialUnits("TU")->list()->size())
+      OPENFLUID_RaiseError("wrong number of units processed by wavefront loop");
+
     // _-_-_-_-_-_-_-_-_-_-_-_-_
 
 